@@ -0,0 +1,68 @@
+#include <fstream>
+#include <fmt/format.h>
+
+#include "binary_stream.h"
+
+namespace mb
+{
+	binary_writer& binary_writer::write_string(std::string_view value)
+	{
+		write<std::uint32_t>(static_cast<std::uint32_t>(value.size()));
+		_buffer.append(value.data(), value.size());
+
+		return *this;
+	}
+
+	binary_reader::binary_reader(std::string_view data)
+		: _data{ data }, _position{ 0 }
+	{}
+
+	void binary_reader::assert_available(size_t size) const
+	{
+		if (_data.size() - _position < size)
+		{
+			throw mb_exception{ fmt::format("Unexpected end of binary data reading {0} bytes at position {1}", size, _position) };
+		}
+	}
+
+	std::string binary_reader::read_string()
+	{
+		std::uint32_t size{ read<std::uint32_t>() };
+		assert_available(size);
+
+		std::string value{ _data.substr(_position, size) };
+		_position += size;
+
+		return value;
+	}
+
+	std::string read_binary_file(const std::filesystem::path& path)
+	{
+		std::ifstream stream{ path, std::ios::in | std::ios::binary };
+
+		if (!stream.is_open())
+		{
+			throw mb_exception{ fmt::format("Could not open file {}", path.string()) };
+		}
+
+		return std::string{ (std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>() };
+	}
+
+	void write_binary_file(const std::filesystem::path& path, std::string_view content)
+	{
+		std::filesystem::path tempPath{ path };
+		tempPath += ".tmp";
+
+		{
+			std::ofstream stream{ tempPath, std::ios::out | std::ios::binary | std::ios::trunc };
+			stream.write(content.data(), content.size());
+
+			if (!stream.good())
+			{
+				throw mb_exception{ fmt::format("Could not write file {}", tempPath.string()) };
+			}
+		}
+
+		std::filesystem::rename(tempPath, path);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+#include "common/exceptions/mb_exception.h"
+
+namespace mb
+{
+	class binary_writer
+	{
+	private:
+		std::string _buffer;
+
+	public:
+		template<typename T>
+		binary_writer& write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "binary_writer can only write trivially copyable types");
+
+			_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+			return *this;
+		}
+
+		binary_writer& write_string(std::string_view value);
+
+		const std::string& data() const noexcept { return _buffer; }
+		void clear() noexcept { _buffer.clear(); }
+	};
+
+	class binary_reader
+	{
+	private:
+		std::string_view _data;
+		size_t _position;
+
+		void assert_available(size_t size) const;
+
+	public:
+		explicit binary_reader(std::string_view data);
+
+		template<typename T>
+		T read()
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "binary_reader can only read trivially copyable types");
+
+			assert_available(sizeof(T));
+
+			T value;
+			std::memcpy(&value, _data.data() + _position, sizeof(T));
+			_position += sizeof(T);
+
+			return value;
+		}
+
+		std::string read_string();
+
+		bool at_end() const noexcept { return _position == _data.size(); }
+	};
+
+	std::string read_binary_file(const std::filesystem::path& path);
+	void write_binary_file(const std::filesystem::path& path, std::string_view content);
+}
\ No newline at end of file
@@ -31,6 +31,14 @@ namespace mb
 			return _json[paramName.data()].template get<T>();
 		}
 
+		template<typename T>
+		T get_or_default(std::string_view paramName, T defaultValue) const
+		{
+			return has_member(paramName)
+				? get<T>(paramName)
+				: std::move(defaultValue);
+		}
+
 		template<typename T>
 		T get(int index) const
 		{
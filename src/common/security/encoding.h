@@ -1,6 +1,7 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <iomanip>
 #include <stdexcept>
 
 #include <openssl/evp.h>
@@ -63,4 +64,4 @@ namespace mb
 
         return stream.str();
     }
-}
+}
\ No newline at end of file
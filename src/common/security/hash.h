@@ -1,33 +1,59 @@
 #pragma once
 
+#include <array>
+#include <climits>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include <openssl/sha.h>
 #include <openssl/evp.h>
-#include <openssl/hmac.h>
 
 namespace mb
 {
     namespace internal
     {
+        inline EVP_MD_CTX* thread_digest_context()
+        {
+            // Reinitialised by every digest, so one context per thread serves all of them
+            thread_local std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> context{ EVP_MD_CTX_new(), &EVP_MD_CTX_free };
+            if (!context)
+            {
+                throw std::runtime_error("cannot create EVP_MD_CTX");
+            }
+
+            return context.get();
+        }
+
+        template<typename Hash, typename... Parts>
+        void digest(Hash& hash, const EVP_MD* hashAlgorithm, const Parts&... parts)
+        {
+            EVP_MD_CTX* context = thread_digest_context();
+
+            EVP_DigestInit_ex(context, hashAlgorithm, nullptr);
+            (EVP_DigestUpdate(context, parts.data(), parts.size()), ...);
+            EVP_DigestFinal_ex(context, hash.data(), nullptr);
+        }
+
         template<typename Source, typename Key>
         std::vector<unsigned char> hmac(const Source& source, const Key& key, const EVP_MD* hashAlgorithm, unsigned int length)
         {
             std::vector<unsigned char> hash(length);
+            size_t hashLength = 0;
+
+            // OpenSSL rejects a null key, which an empty container may hand us
+            const void* keyData = key.size() > 0 ? static_cast<const void*>(key.data()) : "";
 
-            HMAC_CTX* context = HMAC_CTX_new();
-            if (context == nullptr)
+            if (EVP_Q_mac(
+                nullptr, "HMAC", nullptr, EVP_MD_get0_name(hashAlgorithm), nullptr,
+                keyData, key.size(),
+                reinterpret_cast<const unsigned char*>(source.data()), source.size(),
+                hash.data(), hash.size(), &hashLength) == nullptr)
             {
-                throw std::runtime_error("cannot create HMAC_CTX");
+                throw std::runtime_error("cannot compute HMAC");
             }
 
-            HMAC_Init_ex(context, key.data(), key.size(), hashAlgorithm, NULL);
-            HMAC_Update(context, reinterpret_cast<const unsigned char*>(source.data()), source.size());
-            HMAC_Final(context, hash.data(), &length);
-
-            HMAC_CTX_free(context);
-
             return hash;
         }
     }
@@ -36,11 +62,16 @@ namespace mb
     std::vector<unsigned char> sha256(const Data& data)
     {
         std::vector<unsigned char> hash(SHA256_DIGEST_LENGTH);
+        internal::digest(hash, EVP_sha256(), data);
 
-        SHA256_CTX context;
-        SHA256_Init(&context);
-        SHA256_Update(&context, data.data(), data.size());
-        SHA256_Final(hash.data(), &context);
+        return hash;
+    }
+
+    template<typename... Parts>
+    std::array<unsigned char, SHA256_DIGEST_LENGTH> sha256_digest(const Parts&... parts)
+    {
+        std::array<unsigned char, SHA256_DIGEST_LENGTH> hash;
+        internal::digest(hash, EVP_sha256(), parts...);
 
         return hash;
     }
@@ -49,11 +80,7 @@ namespace mb
     std::vector<unsigned char> sha512(const Data& data)
     {
         std::vector<unsigned char> hash(SHA512_DIGEST_LENGTH);
-
-        SHA512_CTX context;
-        SHA512_Init(&context);
-        SHA512_Update(&context, data.data(), data.size());
-        SHA512_Final(hash.data(), &context);
+        internal::digest(hash, EVP_sha512(), data);
 
         return hash;
     }
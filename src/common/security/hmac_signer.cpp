@@ -0,0 +1,151 @@
+#include <atomic>
+#include <memory>
+
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+
+#include "hmac_signer.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace
+{
+	using namespace mb;
+
+	static constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+
+	std::atomic<std::uint64_t> nextSignerId{ 1 };
+
+	EVP_MAC* hmac_algorithm()
+	{
+		// Fetching searches the loaded providers, so it happens once and the algorithm is shared by every thread
+		static std::unique_ptr<EVP_MAC, decltype(&EVP_MAC_free)> algorithm{ EVP_MAC_fetch(nullptr, OSSL_MAC_NAME_HMAC, nullptr), &EVP_MAC_free };
+		if (!algorithm)
+		{
+			throw mb_exception{ "cannot fetch HMAC algorithm" };
+		}
+
+		return algorithm.get();
+	}
+
+	struct working_context
+	{
+		std::unique_ptr<EVP_MAC_CTX, decltype(&EVP_MAC_CTX_free)> context;
+		std::uint64_t signerId;
+	};
+
+	working_context create_working_context()
+	{
+		EVP_MAC_CTX* context = EVP_MAC_CTX_new(hmac_algorithm());
+		if (context == nullptr)
+		{
+			throw mb_exception{ "cannot create EVP_MAC_CTX" };
+		}
+
+		return working_context{ { context, &EVP_MAC_CTX_free }, 0 };
+	}
+
+	working_context& thread_working_context()
+	{
+		// Stays keyed for the last signer used on this thread, which is usually the only one,
+		// so a sign only resets the digest state and never allocates
+		thread_local working_context working{ create_working_context() };
+		return working;
+	}
+}
+
+namespace mb
+{
+	hmac_signer::hmac_signer(const EVP_MD* hashAlgorithm, const void* key, size_t keySize)
+		:
+		_key{ static_cast<const unsigned char*>(key), static_cast<const unsigned char*>(key) + keySize },
+		_digestName{ EVP_MD_get0_name(hashAlgorithm) },
+		_digestSize{ static_cast<unsigned int>(EVP_MD_get_size(hashAlgorithm)) },
+		_id{ nextSignerId++ }
+	{
+		// Keys the calling thread's context now, so an unusable key or digest fails here rather than on the first request
+		begin();
+	}
+
+	EVP_MAC_CTX* hmac_signer::begin() const
+	{
+		working_context& working{ thread_working_context() };
+
+		if (working.signerId == _id)
+		{
+			// A null key restarts the digest with the key already set, skipping the key schedule
+			if (EVP_MAC_init(working.context.get(), nullptr, 0, nullptr) != 1)
+			{
+				throw mb_exception{ "cannot reset HMAC context" };
+			}
+
+			return working.context.get();
+		}
+
+		// OpenSSL takes a null key to mean keep the current one, which an empty vector may hand us
+		static constexpr unsigned char emptyKey = 0;
+
+		OSSL_PARAM parameters[]
+		{
+			OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>(_digestName), 0),
+			OSSL_PARAM_construct_end()
+		};
+
+		working.signerId = 0;
+
+		if (EVP_MAC_init(working.context.get(), _key.empty() ? &emptyKey : _key.data(), _key.size(), parameters) != 1)
+		{
+			throw mb_exception{ "cannot initialise HMAC key" };
+		}
+
+		working.signerId = _id;
+		return working.context.get();
+	}
+
+	void hmac_signer::update(EVP_MAC_CTX* context, const void* data, size_t size)
+	{
+		EVP_MAC_update(context, static_cast<const unsigned char*>(data), size);
+	}
+
+	unsigned int hmac_signer::finish(EVP_MAC_CTX* context, digest& output) const
+	{
+		size_t length = 0;
+		EVP_MAC_final(context, output.data(), &length, output.size());
+
+		return static_cast<unsigned int>(length);
+	}
+
+	void hmac_signer::hex_encode(const digest& signature, unsigned int size, std::string& output)
+	{
+		output.resize(size * 2);
+
+		for (unsigned int i = 0; i < size; ++i)
+		{
+			output[2 * i] = HEX_DIGITS[signature[i] >> 4];
+			output[2 * i + 1] = HEX_DIGITS[signature[i] & 0x0F];
+		}
+	}
+
+	void hmac_signer::base64_encode(const digest& signature, unsigned int size, std::string& output)
+	{
+		// EVP_EncodeBlock writes a trailing null terminator on top of the encoded length
+		output.resize(4 * ((size + 2) / 3) + 1);
+
+		int length = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(output.data()), signature.data(), static_cast<int>(size));
+		output.resize(length);
+	}
+
+	hmac_signer create_hmac_sha256_signer(std::string_view key)
+	{
+		return hmac_signer{ EVP_sha256(), key };
+	}
+
+	hmac_signer create_hmac_sha256_signer(const std::vector<unsigned char>& key)
+	{
+		return hmac_signer{ EVP_sha256(), key };
+	}
+
+	hmac_signer create_hmac_sha512_signer(const std::vector<unsigned char>& key)
+	{
+		return hmac_signer{ EVP_sha512(), key };
+	}
+}
\ No newline at end of file
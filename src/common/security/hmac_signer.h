@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <openssl/evp.h>
+
+namespace mb
+{
+	class hmac_signer
+	{
+	public:
+		using digest = std::array<unsigned char, EVP_MAX_MD_SIZE>;
+
+	private:
+		std::vector<unsigned char> _key;
+		const char* _digestName;
+		unsigned int _digestSize;
+		std::uint64_t _id;
+
+		EVP_MAC_CTX* begin() const;
+		unsigned int finish(EVP_MAC_CTX* context, digest& output) const;
+
+		static void update(EVP_MAC_CTX* context, const void* data, size_t size);
+
+	public:
+		hmac_signer(const EVP_MD* hashAlgorithm, const void* key, size_t keySize);
+
+		template<typename Key>
+		hmac_signer(const EVP_MD* hashAlgorithm, const Key& key)
+			: hmac_signer{ hashAlgorithm, key.data(), key.size() }
+		{}
+
+		unsigned int digest_size() const noexcept { return _digestSize; }
+
+		template<typename... Parts>
+		unsigned int sign(digest& output, const Parts&... parts) const
+		{
+			EVP_MAC_CTX* context = begin();
+			(update(context, parts.data(), parts.size()), ...);
+
+			return finish(context, output);
+		}
+
+		// Reuses the output's capacity, so a caller keeping one buffer per thread signs without allocating
+		template<typename... Parts>
+		void sign_hex_into(std::string& output, const Parts&... parts) const
+		{
+			digest signature;
+			hex_encode(signature, sign(signature, parts...), output);
+		}
+
+		template<typename... Parts>
+		std::string sign_hex(const Parts&... parts) const
+		{
+			std::string output;
+			sign_hex_into(output, parts...);
+
+			return output;
+		}
+
+		template<typename... Parts>
+		void sign_base64_into(std::string& output, const Parts&... parts) const
+		{
+			digest signature;
+			base64_encode(signature, sign(signature, parts...), output);
+		}
+
+		template<typename... Parts>
+		std::string sign_base64(const Parts&... parts) const
+		{
+			std::string output;
+			sign_base64_into(output, parts...);
+
+			return output;
+		}
+
+		static void hex_encode(const digest& signature, unsigned int size, std::string& output);
+		static void base64_encode(const digest& signature, unsigned int size, std::string& output);
+	};
+
+	hmac_signer create_hmac_sha256_signer(std::string_view key);
+	hmac_signer create_hmac_sha256_signer(const std::vector<unsigned char>& key);
+	hmac_signer create_hmac_sha512_signer(const std::vector<unsigned char>& key);
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "common/exceptions/mb_exception.h"
+
+namespace mb
+{
+	// Uses an integral or enum value as its own key
+	struct set_queue_index
+	{
+		template<typename T>
+		constexpr std::size_t operator()(const T& value) const noexcept
+		{
+			return static_cast<std::size_t>(value);
+		}
+	};
+
+	/*
+	* A bounded multi-producer multi-consumer queue that drops items whose key is already queued, without a mutex.
+	* Unlike set_queue, keys are dense indices in [0, keyCount) fixed at construction. Each one has an atomic pending
+	* flag, so at most keyCount items are ever queued and the ring never has to reject a push.
+	* It is not lock-free: a push can wait for a consumer that has freed its key but not yet its cell, and pop waits
+	* for a producer that has claimed the head cell but not yet filled it, so a descheduled thread stalls the other.
+	*/
+	template<typename T, typename KeyOf = set_queue_index>
+	class bounded_index_set_queue
+	{
+	private:
+		static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+		struct cell
+		{
+			std::atomic<std::size_t> sequence;
+			std::optional<T> value;
+		};
+
+		std::size_t _keyCount;
+		std::size_t _mask;
+		KeyOf _keyOf;
+		std::unique_ptr<cell[]> _cells;
+		std::unique_ptr<std::atomic<bool>[]> _pending;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _enqueuePosition;
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _dequeuePosition;
+
+		static std::size_t ring_capacity(std::size_t keyCount) noexcept
+		{
+			std::size_t capacity = 1;
+			while (capacity < keyCount)
+			{
+				capacity <<= 1;
+			}
+
+			return capacity;
+		}
+
+		std::size_t checked_key(const T& item) const
+		{
+			std::size_t key = _keyOf(item);
+			if (key >= _keyCount)
+			{
+				throw mb_exception{ fmt::format("Set queue key {} is outside of the {} keys it was created with", key, _keyCount) };
+			}
+
+			return key;
+		}
+
+	public:
+		explicit bounded_index_set_queue(std::size_t keyCount, KeyOf keyOf = KeyOf{})
+			: _keyCount{ keyCount },
+			_mask{ ring_capacity(keyCount) - 1 },
+			_keyOf{ std::move(keyOf) },
+			_cells{ std::make_unique<cell[]>(_mask + 1) },
+			_pending{ std::make_unique<std::atomic<bool>[]>(keyCount) },
+			_enqueuePosition{ 0 },
+			_dequeuePosition{ 0 }
+		{
+			for (std::size_t i = 0; i <= _mask; ++i)
+			{
+				_cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+
+			for (std::size_t i = 0; i < keyCount; ++i)
+			{
+				_pending[i].store(false, std::memory_order_relaxed);
+			}
+		}
+
+		bounded_index_set_queue(const bounded_index_set_queue&) = delete;
+		bounded_index_set_queue& operator=(const bounded_index_set_queue&) = delete;
+
+		std::size_t key_count() const noexcept { return _keyCount; }
+
+		void push(T&& item)
+		{
+			std::size_t key = checked_key(item);
+
+			if (_pending[key].exchange(true, std::memory_order_acq_rel))
+			{
+				return;
+			}
+
+			std::size_t position = _enqueuePosition.fetch_add(1, std::memory_order_relaxed);
+			cell& target{ _cells[position & _mask] };
+
+			// The pending flags cap the queued items at the ring capacity, so the cell can only still be held
+			// by a consumer that has cleared its key but not yet handed the cell back
+			while (target.sequence.load(std::memory_order_acquire) != position)
+			{
+				std::this_thread::yield();
+			}
+
+			target.value.emplace(std::move(item));
+			target.sequence.store(position + 1, std::memory_order_release);
+		}
+
+		std::optional<T> try_pop()
+		{
+			std::size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+
+			for (;;)
+			{
+				cell& target{ _cells[position & _mask] };
+				std::size_t sequence = target.sequence.load(std::memory_order_acquire);
+				std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+				if (difference == 0)
+				{
+					if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						std::optional<T> item{ std::move(target.value) };
+						target.value.reset();
+
+						// Clearing the key before freeing the cell means a push racing with this pop is queued, not lost
+						_pending[_keyOf(*item)].store(false, std::memory_order_release);
+						target.sequence.store(position + _mask + 1, std::memory_order_release);
+
+						return item;
+					}
+				}
+				else if (difference < 0)
+				{
+					// The next cell has not been published yet, either because the queue is empty or a producer is mid-push
+					return std::nullopt;
+				}
+				else
+				{
+					position = _dequeuePosition.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// Unlike try_pop, waits for a push that has claimed its cell to publish it, so pop after !empty() does not throw
+		T pop()
+		{
+			for (;;)
+			{
+				std::optional<T> item{ try_pop() };
+				if (item)
+				{
+					return std::move(*item);
+				}
+
+				if (empty())
+				{
+					throw mb_exception{ "Cannot pop from an empty set queue" };
+				}
+
+				std::this_thread::yield();
+			}
+		}
+
+		// Approximate while other threads are pushing or popping
+		std::size_t size() const noexcept
+		{
+			std::size_t dequeued = _dequeuePosition.load(std::memory_order_acquire);
+			std::size_t enqueued = _enqueuePosition.load(std::memory_order_acquire);
+
+			return enqueued > dequeued
+				? enqueued - dequeued
+				: 0;
+		}
+
+		bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+	};
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace mb
+{
+	namespace internal
+	{
+		constexpr std::size_t READER_SLOT_COUNT = 64;
+
+		// Spreads reader threads over the slots so each one usually counts itself on a cache line of its own
+		inline std::size_t reader_slot() noexcept
+		{
+			static std::atomic<std::size_t> nextSlot{ 0 };
+			thread_local std::size_t slot{ nextSlot.fetch_add(1, std::memory_order_relaxed) % READER_SLOT_COUNT };
+
+			return slot;
+		}
+	}
+
+	/*
+	* An alternative to concurrent_wrapper for data that is read far more often than it is written. Readers only
+	* increment a per-thread-slot counter to pin the current version, so they never wait and never share a counter
+	* with readers on other cores. Writers edit a copy, publish it and then wait for readers of the old version to finish.
+	* As with concurrent_wrapper, a thread must not take a unique lock while it holds a shared lock on the same wrapper.
+	*/
+	template<typename T>
+	class read_mostly_wrapper
+	{
+	private:
+		struct alignas(64) reader_slot
+		{
+			std::atomic<std::size_t> readers[2]{ 0, 0 };
+		};
+
+		std::atomic<T*> _current;
+		std::atomic<int> _phase;
+		std::unique_ptr<reader_slot[]> _slots;
+		std::mutex _writeMutex;
+
+		void wait_for_readers(int phase)
+		{
+			for (std::size_t i = 0; i < internal::READER_SLOT_COUNT; ++i)
+			{
+				while (_slots[i].readers[phase].load() != 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		void publish(std::unique_ptr<T> item)
+		{
+			std::unique_ptr<T> previous{ _current.exchange(item.release()) };
+
+			// A reader that saw the previous version counted itself before the exchange, in one phase or the other.
+			// Each phase is drained while new readers are sent to the other one, so a stream of readers cannot stall it.
+			for (int i = 0; i < 2; ++i)
+			{
+				int drainedPhase = _phase.load();
+				_phase.store(drainedPhase ^ 1);
+				wait_for_readers(drainedPhase);
+			}
+		}
+
+	public:
+		class shared_locked_object
+		{
+		private:
+			std::atomic<std::size_t>* _readers;
+			const T* _item;
+
+		public:
+			shared_locked_object(std::atomic<std::size_t>& readers, const std::atomic<T*>& current)
+				: _readers{ &readers }, _item{ nullptr }
+			{
+				_readers->fetch_add(1);
+				_item = current.load();
+			}
+
+			shared_locked_object(const shared_locked_object&) = delete;
+			shared_locked_object& operator=(const shared_locked_object&) = delete;
+
+			shared_locked_object(shared_locked_object&& other) noexcept
+				: _readers{ other._readers }, _item{ other._item }
+			{
+				other._readers = nullptr;
+			}
+
+			~shared_locked_object()
+			{
+				if (_readers)
+				{
+					_readers->fetch_sub(1);
+				}
+			}
+
+			const T* operator->() const { return _item; }
+
+			const T& operator*() const { return *_item; }
+		};
+
+		class unique_locked_object
+		{
+		private:
+			read_mostly_wrapper<T>* _owner;
+			std::unique_lock<std::mutex> _lock;
+			std::unique_ptr<T> _item;
+
+		public:
+			unique_locked_object(read_mostly_wrapper<T>& owner)
+				: _owner{ &owner }, _lock{ owner._writeMutex }, _item{ std::make_unique<T>(*owner._current.load()) }
+			{}
+
+			unique_locked_object(unique_locked_object&& other) noexcept = default;
+
+			~unique_locked_object()
+			{
+				if (_item)
+				{
+					_owner->publish(std::move(_item));
+				}
+			}
+
+			T* operator->() { return _item.get(); }
+
+			T& operator*() { return *_item; }
+		};
+
+		read_mostly_wrapper()
+			: read_mostly_wrapper{ T{} }
+		{}
+
+		read_mostly_wrapper(T item)
+			: _current{ new T{ std::move(item) } }, _phase{ 0 }, _slots{ std::make_unique<reader_slot[]>(internal::READER_SLOT_COUNT) }, _writeMutex{}
+		{}
+
+		read_mostly_wrapper(const read_mostly_wrapper&) = delete;
+		read_mostly_wrapper& operator=(const read_mostly_wrapper&) = delete;
+
+		~read_mostly_wrapper()
+		{
+			delete _current.load();
+		}
+
+		// Edits a copy of the current version, which readers see once the returned object is destroyed
+		unique_locked_object unique_lock()
+		{
+			return unique_locked_object{ *this };
+		}
+
+		shared_locked_object shared_lock() const
+		{
+			return shared_locked_object{ _slots[internal::reader_slot()].readers[_phase.load()], _current };
+		}
+	};
+}
@@ -3,6 +3,7 @@
 #include <queue>
 #include <unordered_set>
 #include <mutex>
+#include <optional>
 
 namespace mb
 {
@@ -14,6 +15,20 @@ namespace mb
 		std::unordered_set<std::reference_wrapper<T>, std::hash<T>, std::equal_to<T>> _set;
 		mutable std::mutex _mutex;
 
+		// The set refers into the queue's own elements, so it is rebuilt rather than copied from another queue
+		void index_queue()
+		{
+			_set.clear();
+
+			std::queue<T> indexed{ std::move(_queue) };
+			while (!indexed.empty())
+			{
+				_queue.push(std::move(indexed.front()));
+				_set.emplace(std::ref(_queue.back()));
+				indexed.pop();
+			}
+		}
+
 	public:
 		set_queue()
 			: _queue{}, _set{}, _mutex{}
@@ -24,11 +39,11 @@ namespace mb
 		{
 			std::lock_guard<std::mutex> lock{ other._mutex };
 			_queue = other._queue;
-			_set = other._set;
+			index_queue();
 		}
 
 		set_queue(set_queue<T>&& other) noexcept
-			: _queue{}, _mutex{}
+			: _queue{}, _set{}, _mutex{}
 		{
 			std::lock_guard<std::mutex> lock{ other._mutex };
 			_queue = std::move(other._queue);
@@ -41,7 +56,7 @@ namespace mb
 			std::lock_guard<std::mutex> otherLock{ other._mutex };
 
 			_queue = other._queue;
-			_set = other._set;
+			index_queue();
 
 			return *this;
 		}
@@ -95,5 +110,22 @@ namespace mb
 
 			return item;
 		}
+
+		std::optional<T> try_pop()
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+
+			if (_queue.empty())
+			{
+				return std::nullopt;
+			}
+
+			_set.erase(_queue.front());
+
+			std::optional<T> item{ std::move(_queue.front()) };
+			_queue.pop();
+
+			return item;
+		}
 	};
 };
\ No newline at end of file
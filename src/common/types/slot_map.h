@@ -0,0 +1,176 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+namespace mb
+{
+	template<typename T>
+	class slot_map
+	{
+	public:
+		using key_type = std::uint64_t;
+
+	private:
+		struct slot
+		{
+			std::optional<T> value;
+			std::uint32_t generation;
+		};
+
+		std::vector<slot> _slots;
+		std::vector<std::uint32_t> _freeSlots;
+		std::size_t _size;
+
+		static constexpr key_type make_key(std::uint32_t index, std::uint32_t generation) noexcept
+		{
+			return (static_cast<key_type>(index) << 32) | generation;
+		}
+
+		const slot* find_slot(key_type key) const noexcept
+		{
+			std::size_t index = key >> 32;
+			if (index >= _slots.size())
+			{
+				return nullptr;
+			}
+
+			const slot& candidate{ _slots[index] };
+			if (!candidate.value || candidate.generation != static_cast<std::uint32_t>(key))
+			{
+				return nullptr;
+			}
+
+			return &candidate;
+		}
+
+	public:
+		slot_map()
+			: _slots{}, _freeSlots{}, _size{ 0 }
+		{}
+
+		key_type insert(T value)
+		{
+			std::uint32_t index;
+
+			if (_freeSlots.empty())
+			{
+				index = static_cast<std::uint32_t>(_slots.size());
+				_slots.emplace_back(slot{ std::nullopt, 1 });
+			}
+			else
+			{
+				index = _freeSlots.back();
+				_freeSlots.pop_back();
+			}
+
+			slot& target{ _slots[index] };
+			target.value.emplace(std::move(value));
+			++_size;
+
+			return make_key(index, target.generation);
+		}
+
+		bool erase(key_type key)
+		{
+			slot* target{ const_cast<slot*>(find_slot(key)) };
+			if (!target)
+			{
+				return false;
+			}
+
+			target->value.reset();
+			++target->generation;
+			_freeSlots.emplace_back(static_cast<std::uint32_t>(key >> 32));
+			--_size;
+
+			return true;
+		}
+
+		T* find(key_type key) noexcept
+		{
+			slot* target{ const_cast<slot*>(find_slot(key)) };
+			return target ? &*target->value : nullptr;
+		}
+
+		const T* find(key_type key) const noexcept
+		{
+			const slot* target{ find_slot(key) };
+			return target ? &*target->value : nullptr;
+		}
+
+		bool contains(key_type key) const noexcept { return find_slot(key) != nullptr; }
+		std::size_t size() const noexcept { return _size; }
+		bool empty() const noexcept { return _size == 0; }
+
+		void clear()
+		{
+			_slots.clear();
+			_freeSlots.clear();
+			_size = 0;
+		}
+
+		template<typename Function>
+		void for_each(Function function) const
+		{
+			for (std::size_t i = 0; i < _slots.size(); ++i)
+			{
+				if (_slots[i].value)
+				{
+					function(make_key(static_cast<std::uint32_t>(i), _slots[i].generation), *_slots[i].value);
+				}
+			}
+		}
+
+		template<typename Writer, typename WriteValue>
+		void save(Writer& writer, WriteValue writeValue) const
+		{
+			writer.template write<std::uint32_t>(static_cast<std::uint32_t>(_slots.size()));
+			for (std::size_t i = 0; i < _slots.size(); ++i)
+			{
+				writer.write(_slots[i].generation);
+				writer.write(_slots[i].value.has_value());
+
+				if (_slots[i].value)
+				{
+					writeValue(writer, make_key(static_cast<std::uint32_t>(i), _slots[i].generation), *_slots[i].value);
+				}
+			}
+
+			writer.template write<std::uint32_t>(static_cast<std::uint32_t>(_freeSlots.size()));
+			for (std::uint32_t index : _freeSlots)
+			{
+				writer.write(index);
+			}
+		}
+
+		template<typename Reader, typename ReadValue>
+		void load(Reader& reader, ReadValue readValue)
+		{
+			clear();
+
+			std::uint32_t slotCount{ reader.template read<std::uint32_t>() };
+			_slots.reserve(slotCount);
+			for (std::uint32_t i = 0; i < slotCount; ++i)
+			{
+				std::uint32_t generation{ reader.template read<std::uint32_t>() };
+				bool occupied{ reader.template read<bool>() };
+
+				slot& target{ _slots.emplace_back(slot{ std::nullopt, generation }) };
+				if (occupied)
+				{
+					target.value.emplace(readValue(reader, make_key(i, generation)));
+					++_size;
+				}
+			}
+
+			std::uint32_t freeSlotCount{ reader.template read<std::uint32_t>() };
+			_freeSlots.reserve(freeSlotCount);
+			for (std::uint32_t i = 0; i < freeSlotCount; ++i)
+			{
+				_freeSlots.emplace_back(reader.template read<std::uint32_t>());
+			}
+		}
+	};
+}
\ No newline at end of file
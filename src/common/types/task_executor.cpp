@@ -0,0 +1,76 @@
+#include <algorithm>
+
+#include "task_executor.h"
+
+namespace
+{
+	static constexpr size_t MIN_SHARED_THREAD_COUNT = 4;
+}
+
+namespace mb
+{
+	task_executor::task_executor(size_t threadCount)
+		: _stopping{ false }
+	{
+		_workers.reserve(threadCount);
+
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			_workers.emplace_back(&task_executor::run_worker, this);
+		}
+	}
+
+	task_executor::~task_executor()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+			_stopping = true;
+		}
+
+		_taskAvailable.notify_all();
+
+		for (auto& worker : _workers)
+		{
+			worker.join();
+		}
+	}
+
+	task_executor& task_executor::instance()
+	{
+		static task_executor executor{ std::max<size_t>(MIN_SHARED_THREAD_COUNT, std::thread::hardware_concurrency()) };
+		return executor;
+	}
+
+	void task_executor::enqueue(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+			_tasks.push_back(std::move(task));
+		}
+
+		_taskAvailable.notify_one();
+	}
+
+	void task_executor::run_worker()
+	{
+		while (true)
+		{
+			std::function<void()> task;
+
+			{
+				std::unique_lock<std::mutex> lock{ _mutex };
+				_taskAvailable.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+
+				if (_tasks.empty())
+				{
+					return;
+				}
+
+				task = std::move(_tasks.front());
+				_tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mb
+{
+	class task_executor
+	{
+	private:
+		std::vector<std::thread> _workers;
+		std::deque<std::function<void()>> _tasks;
+		std::mutex _mutex;
+		std::condition_variable _taskAvailable;
+		bool _stopping;
+
+		void run_worker();
+		void enqueue(std::function<void()> task);
+
+	public:
+		explicit task_executor(size_t threadCount);
+		~task_executor();
+
+		task_executor(const task_executor&) = delete;
+		task_executor& operator=(const task_executor&) = delete;
+
+		static task_executor& instance();
+
+		size_t thread_count() const noexcept { return _workers.size(); }
+
+		template<typename Task>
+		auto submit(Task task) -> std::future<decltype(task())>
+		{
+			using Result = decltype(task());
+
+			auto packagedTask{ std::make_shared<std::packaged_task<Result()>>(std::move(task)) };
+			std::future<Result> future{ packagedTask->get_future() };
+
+			enqueue([packagedTask]() { (*packagedTask)(); });
+
+			return future;
+		}
+	};
+
+	template<typename... Futures>
+	void wait_all(Futures&... futures)
+	{
+		(futures.wait(), ...);
+	}
+}
\ No newline at end of file
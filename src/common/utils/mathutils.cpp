@@ -39,4 +39,16 @@ namespace mb
 	{
 		return !double_equal(a, b) && a > b;
 	}
+
+	void compensated_sum::add(double value) noexcept
+	{
+		// Neumaier summation, so long-running add/remove windows do not drift away from a fresh rescan
+		double sum = _sum + value;
+
+		_compensation += std::abs(_sum) >= std::abs(value)
+			? (_sum - sum) + value
+			: (value - sum) + _sum;
+
+		_sum = sum;
+	}
 }
\ No newline at end of file
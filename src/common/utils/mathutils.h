@@ -63,4 +63,20 @@ namespace mb
 			count = 0;
 		}
 	};
+
+	class compensated_sum
+	{
+	private:
+		double _sum;
+		double _compensation;
+
+	public:
+		constexpr compensated_sum()
+			: _sum{ 0.0 }, _compensation{ 0.0 }
+		{}
+
+		void add(double value) noexcept;
+		void clear() noexcept { _sum = 0.0; _compensation = 0.0; }
+		double value() const noexcept { return _sum + _compensation; }
+	};
 }
\ No newline at end of file
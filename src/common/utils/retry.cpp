@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cmath>
+
+#include "retry.h"
+
+namespace
+{
+	static constexpr int DEFAULT_MAX_RETRIES = 3;
+	static constexpr double DEFAULT_BUDGET_RATIO = 0.1;
+
+	// Allows a short burst of retries before any requests have been recorded
+	static constexpr double MAX_BUDGET_TOKENS = 10.0;
+}
+
+namespace mb
+{
+	std::chrono::milliseconds jittered_backoff(std::chrono::milliseconds baseDelay, std::chrono::milliseconds maxDelay, int attempt, std::mt19937& randomEngine)
+	{
+		// Full jitter: a uniform delay up to the exponential backoff ceiling
+		// spreads out clients that failed together instead of retrying in lockstep
+		double ceiling = std::min(
+			static_cast<double>(maxDelay.count()),
+			static_cast<double>(baseDelay.count()) * std::pow(2.0, attempt));
+
+		std::uniform_real_distribution<double> distribution{ 0.0, ceiling };
+		return std::chrono::milliseconds{ static_cast<long long>(distribution(randomEngine)) };
+	}
+
+	std::chrono::milliseconds jittered_backoff(std::chrono::milliseconds baseDelay, std::chrono::milliseconds maxDelay, int attempt)
+	{
+		thread_local std::mt19937 randomEngine{ std::random_device{}() };
+		return jittered_backoff(baseDelay, maxDelay, attempt, randomEngine);
+	}
+
+	retry_policy_config::retry_policy_config()
+		: retry_policy_config{ DEFAULT_MAX_RETRIES, DEFAULT_RETRY_BASE_DELAY, DEFAULT_RETRY_MAX_DELAY, DEFAULT_BUDGET_RATIO, std::chrono::milliseconds::zero() }
+	{}
+
+	retry_policy_config::retry_policy_config(
+		int maxRetries,
+		std::chrono::milliseconds baseDelay,
+		std::chrono::milliseconds maxDelay,
+		double budgetRatio,
+		std::chrono::milliseconds hedgeDelay)
+		:
+		_maxRetries{ std::max(maxRetries, 0) },
+		_baseDelay{ std::max(baseDelay, std::chrono::milliseconds::zero()) },
+		_maxDelay{ std::max(maxDelay, _baseDelay) },
+		_budgetRatio{ std::max(budgetRatio, 0.0) },
+		_hedgeDelay{ std::max(hedgeDelay, std::chrono::milliseconds::zero()) }
+	{}
+
+	retry_policy::retry_policy(retry_policy_config config)
+		: _config{ std::move(config) }, _budgetTokens{ MAX_BUDGET_TOKENS }, _randomEngine{ std::random_device{}() }
+	{}
+
+	void retry_policy::record_request()
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+		_budgetTokens = std::min(MAX_BUDGET_TOKENS, _budgetTokens + _config.budget_ratio());
+	}
+
+	bool retry_policy::try_acquire_retry(int attempt)
+	{
+		if (attempt >= _config.max_retries())
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock{ _mutex };
+
+		if (_budgetTokens < 1.0)
+		{
+			return false;
+		}
+
+		_budgetTokens -= 1.0;
+		return true;
+	}
+
+	std::chrono::milliseconds retry_policy::backoff_delay(int attempt)
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+		return jittered_backoff(_config.base_delay(), _config.max_delay(), attempt, _randomEngine);
+	}
+
+	double retry_policy::budget() const
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+		return _budgetTokens;
+	}
+}
\ No newline at end of file
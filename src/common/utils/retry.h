@@ -1,13 +1,75 @@
 #pragma once
 
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
 #include "logging/logger.h"
 #include "common/exceptions/mb_exception.h"
 #include "common/types/result.h"
 
 namespace mb
 {
+	constexpr std::chrono::milliseconds DEFAULT_RETRY_BASE_DELAY{ 100 };
+	constexpr std::chrono::milliseconds DEFAULT_RETRY_MAX_DELAY{ 2000 };
+
+	std::chrono::milliseconds jittered_backoff(std::chrono::milliseconds baseDelay, std::chrono::milliseconds maxDelay, int attempt, std::mt19937& randomEngine);
+	std::chrono::milliseconds jittered_backoff(std::chrono::milliseconds baseDelay, std::chrono::milliseconds maxDelay, int attempt);
+
+	class retry_policy_config
+	{
+	private:
+		int _maxRetries;
+		std::chrono::milliseconds _baseDelay;
+		std::chrono::milliseconds _maxDelay;
+		double _budgetRatio;
+		std::chrono::milliseconds _hedgeDelay;
+
+	public:
+		retry_policy_config();
+		retry_policy_config(
+			int maxRetries,
+			std::chrono::milliseconds baseDelay,
+			std::chrono::milliseconds maxDelay,
+			double budgetRatio,
+			std::chrono::milliseconds hedgeDelay);
+
+		constexpr int max_retries() const noexcept { return _maxRetries; }
+		constexpr std::chrono::milliseconds base_delay() const noexcept { return _baseDelay; }
+		constexpr std::chrono::milliseconds max_delay() const noexcept { return _maxDelay; }
+		constexpr double budget_ratio() const noexcept { return _budgetRatio; }
+		constexpr std::chrono::milliseconds hedge_delay() const noexcept { return _hedgeDelay; }
+	};
+
+	class retry_policy
+	{
+	private:
+		retry_policy_config _config;
+
+		mutable std::mutex _mutex;
+		double _budgetTokens;
+		std::mt19937 _randomEngine;
+
+	public:
+		explicit retry_policy(retry_policy_config config);
+
+		const retry_policy_config& config() const noexcept { return _config; }
+		bool hedging_enabled() const noexcept { return _config.hedge_delay() > std::chrono::milliseconds::zero(); }
+
+		void record_request();
+		bool try_acquire_retry(int attempt);
+		std::chrono::milliseconds backoff_delay(int attempt);
+		double budget() const;
+	};
+
 	template<typename Value, typename Action, typename ResultConverter>
-	Value retry_on_fail(const Action& action, const ResultConverter& toResult, int maxRetries)
+	Value retry_on_fail(
+		const Action& action,
+		const ResultConverter& toResult,
+		int maxRetries,
+		std::chrono::milliseconds baseDelay = DEFAULT_RETRY_BASE_DELAY,
+		std::chrono::milliseconds maxDelay = DEFAULT_RETRY_MAX_DELAY)
 	{
 		logger& log{ logger::instance() };
 
@@ -22,7 +84,12 @@ namespace mb
 			}
 
 			log.error(result.error());
-			log.warning("Retrying attempt {0}/{1}...", i + 1, maxRetries);
+
+			if (i < maxRetries)
+			{
+				log.warning("Retrying attempt {0}/{1}...", i + 1, maxRetries);
+				std::this_thread::sleep_for(jittered_backoff(baseDelay, maxDelay, i));
+			}
 		}
 
 		throw mb_exception{ "Max number of retries exceeded" };
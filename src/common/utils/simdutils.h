@@ -0,0 +1,7 @@
+#pragma once
+
+// Defines MB_SSE2 on targets where SSE2 intrinsics can be used without extra compiler flags
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MB_SSE2
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "async_exchange.h"
+
+namespace mb
+{
+	async_exchange::async_exchange(std::shared_ptr<exchange> api, task_executor& executor)
+		: _exchange{ std::move(api) }, _executor{ &executor }
+	{}
+
+	std::future<exchange_status> async_exchange::get_status() const
+	{
+		return submit([](exchange& api) { return api.get_status(); });
+	}
+
+	std::future<std::vector<tradable_pair>> async_exchange::get_tradable_pairs() const
+	{
+		return submit([](exchange& api) { return api.get_tradable_pairs(); });
+	}
+
+	std::future<std::vector<ohlcv_data>> async_exchange::get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const
+	{
+		return submit([tradablePair, interval, count](exchange& api) { return api.get_ohlcv(tradablePair, interval, count); });
+	}
+
+	std::future<double> async_exchange::get_price(const tradable_pair& tradablePair) const
+	{
+		return submit([tradablePair](exchange& api) { return api.get_price(tradablePair); });
+	}
+
+	std::future<std::unordered_map<tradable_pair, double>> async_exchange::get_prices(std::vector<tradable_pair> pairs) const
+	{
+		return submit([pairs = std::move(pairs)](exchange& api) { return api.get_prices(pairs); });
+	}
+
+	std::future<order_book_state> async_exchange::get_order_book(const tradable_pair& tradablePair, int depth) const
+	{
+		return submit([tradablePair, depth](exchange& api) { return api.get_order_book(tradablePair, depth); });
+	}
+
+	std::future<std::unordered_map<tradable_pair, order_book_state>> async_exchange::get_order_books(std::vector<tradable_pair> pairs, int depth) const
+	{
+		return submit([pairs = std::move(pairs), depth](exchange& api) { return api.get_order_books(pairs, depth); });
+	}
+
+	std::future<std::unordered_map<std::string, double>> async_exchange::get_balances() const
+	{
+		return submit([](exchange& api) { return api.get_balances(); });
+	}
+
+	std::future<double> async_exchange::get_fee(const tradable_pair& tradablePair) const
+	{
+		return submit([tradablePair](exchange& api) { return api.get_fee(tradablePair); });
+	}
+
+	std::future<std::vector<order_description>> async_exchange::get_open_orders() const
+	{
+		return submit([](exchange& api) { return api.get_open_orders(); });
+	}
+
+	std::future<std::vector<order_description>> async_exchange::get_closed_orders() const
+	{
+		return submit([](exchange& api) { return api.get_closed_orders(); });
+	}
+
+	std::future<std::string> async_exchange::add_order(order_request description) const
+	{
+		return submit([description = std::move(description)](exchange& api) { return api.add_order(description); });
+	}
+
+	std::future<order_confirmation> async_exchange::add_order_confirm(order_request description) const
+	{
+		return submit([description = std::move(description)](exchange& api) { return api.add_order_confirm(description); });
+	}
+
+	std::future<void> async_exchange::cancel_order(std::string orderId) const
+	{
+		return submit([orderId = std::move(orderId)](exchange& api) { api.cancel_order(orderId); });
+	}
+
+	std::vector<async_exchange> to_async_exchanges(const std::vector<std::shared_ptr<exchange>>& exchanges)
+	{
+		std::vector<async_exchange> asyncExchanges;
+		asyncExchanges.reserve(exchanges.size());
+
+		for (auto& api : exchanges)
+		{
+			asyncExchanges.emplace_back(api);
+		}
+
+		return asyncExchanges;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <future>
+
+#include "exchange.h"
+#include "common/types/task_executor.h"
+
+namespace mb
+{
+	class async_exchange
+	{
+	private:
+		std::shared_ptr<exchange> _exchange;
+		task_executor* _executor;
+
+		template<typename Call>
+		auto submit(Call call) const
+		{
+			return _executor->submit([api = _exchange, call = std::move(call)]() { return call(*api); });
+		}
+
+	public:
+		explicit async_exchange(std::shared_ptr<exchange> api, task_executor& executor = task_executor::instance());
+
+		std::string_view id() const noexcept { return _exchange->id(); }
+		const std::shared_ptr<exchange>& api() const noexcept { return _exchange; }
+
+		std::future<exchange_status> get_status() const;
+		std::future<std::vector<tradable_pair>> get_tradable_pairs() const;
+		std::future<std::vector<ohlcv_data>> get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const;
+		std::future<double> get_price(const tradable_pair& tradablePair) const;
+		std::future<std::unordered_map<tradable_pair, double>> get_prices(std::vector<tradable_pair> pairs) const;
+		std::future<order_book_state> get_order_book(const tradable_pair& tradablePair, int depth) const;
+		std::future<std::unordered_map<tradable_pair, order_book_state>> get_order_books(std::vector<tradable_pair> pairs, int depth) const;
+
+		std::future<std::unordered_map<std::string, double>> get_balances() const;
+		std::future<double> get_fee(const tradable_pair& tradablePair) const;
+		std::future<std::vector<order_description>> get_open_orders() const;
+		std::future<std::vector<order_description>> get_closed_orders() const;
+		std::future<std::string> add_order(order_request description) const;
+		std::future<order_confirmation> add_order_confirm(order_request description) const;
+		std::future<void> cancel_order(std::string orderId) const;
+	};
+
+	std::vector<async_exchange> to_async_exchanges(const std::vector<std::shared_ptr<exchange>>& exchanges);
+}
\ No newline at end of file
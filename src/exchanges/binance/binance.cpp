@@ -1,8 +1,6 @@
 #include "binance.h"
 #include "binance_results.h"
 #include "exchanges/exchange_ids.h"
-#include "common/security/hash.h"
-#include "common/security/encoding.h"
 #include "common/file/config_file_reader.h"
 #include "common/utils/containerutils.h"
 #include "common/utils/mathutils.h"
@@ -64,6 +62,14 @@ namespace
 		return symbols;
 	}
 
+	std::string create_order_book_query(const tradable_pair& pair, int depth)
+	{
+		return url_query_builder{}
+			.add_parameter("symbol", pair.to_string())
+			.add_parameter("limit", std::to_string(depth))
+			.to_string();
+	}
+
 	bool is_limit_order(order_type orderType)
 	{
 		return orderType == order_type::LIMIT ||
@@ -117,30 +123,35 @@ namespace mb
 		exchange{ exchange_ids::BINANCE, websocketStream },
 		_baseUrl{ select_base_url(enableTesting) },
 		_apiKey{ std::move(config.api_key()) },
-		_secretKey{ std::move(config.secret_key()) },
+		_signer{ create_hmac_sha256_signer(config.secret_key()) },
 		_httpService{ std::move(httpService) }
-	{}
+	{
+		_httpService->set_rate_limiter(std::make_shared<rate_limiter>(config.rate_limit()));
+	}
 
-	std::string binance_api::compute_api_sign(std::string query) const
+	std::string_view binance_api::compute_api_sign(std::string_view query) const
 	{
-		return hex_encode(hmac_sha256(query, _secretKey));
+		thread_local std::string signature;
+		_signer.sign_hex_into(signature, query);
+
+		return signature;
 	}
 
 	exchange_status binance_api::get_status() const
 	{
-		return send_public_request<exchange_status>("/api/v3/time", binance::read_system_status);
+		return send_cached_public_request<exchange_status>("/api/v3/time", internal::STATUS_CACHE_TTL, binance::read_system_status);
 	}
 
 	std::vector<tradable_pair> binance_api::get_tradable_pairs() const
 	{
-		_orderFilters = send_public_request<std::unordered_map<tradable_pair, internal::binance_order_filters>>("/api/v3/exchangeInfo", binance::read_tradable_pairs);
+		std::unordered_map<tradable_pair, internal::binance_order_filters> orderFilters{ send_cached_public_request<std::unordered_map<tradable_pair, internal::binance_order_filters>>("/api/v3/exchangeInfo", internal::TRADABLE_PAIRS_CACHE_TTL, binance::read_tradable_pairs) };
 
 		std::vector<tradable_pair> pairs;
-		pairs.reserve(_orderFilters.size());
+		pairs.reserve(orderFilters.size());
 
 		double minValue = 0.0;
 
-		for (auto& [pair, filter] : _orderFilters)
+		for (auto& [pair, filter] : orderFilters)
 		{
 			pairs.emplace_back(pair);
 
@@ -150,9 +161,38 @@ namespace mb
 			}
 		}
 
+		std::unique_lock<std::shared_mutex> lock{ _orderFiltersMutex };
+		_orderFilters = std::move(orderFilters);
+
 		return pairs;
 	}
 
+	internal::binance_order_filters binance_api::get_order_filters(const tradable_pair& pair) const
+	{
+		std::shared_lock<std::shared_mutex> lock{ _orderFiltersMutex };
+
+		auto it = _orderFilters.find(pair);
+		return it != _orderFilters.end()
+			? it->second
+			: internal::binance_order_filters{};
+	}
+
+	int binance_api::get_price_precision(const tradable_pair& pair) const
+	{
+		bool filtersLoaded = false;
+		{
+			std::shared_lock<std::shared_mutex> lock{ _orderFiltersMutex };
+			filtersLoaded = !_orderFilters.empty();
+		}
+
+		if (!filtersLoaded)
+		{
+			get_tradable_pairs();
+		}
+
+		return get_order_filters(pair).price_precision();
+	}
+
 	std::vector<ohlcv_data> binance_api::get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const
 	{
 		std::string query = url_query_builder{}
@@ -185,17 +225,22 @@ namespace mb
 
 	order_book_state binance_api::get_order_book(const tradable_pair& tradablePair, int depth) const
 	{
-		std::string query = url_query_builder{}
-			.add_parameter("symbol", tradablePair.to_string())
-			.add_parameter("limit", std::to_string(depth))
-			.to_string();
+		return send_public_request<order_book_state>("/api/v3/depth", binance::read_order_book, create_order_book_query(tradablePair, depth));
+	}
 
-		return send_public_request<order_book_state>("/api/v3/depth", binance::read_order_book, query);
+	std::unordered_map<tradable_pair, order_book_state> binance_api::get_order_books(const std::vector<tradable_pair>& pairs, int depth) const
+	{
+		std::vector<std::string> queries{ to_vector<std::string>(pairs, [depth](const tradable_pair& pair) { return create_order_book_query(pair, depth); }) };
+
+		return internal::create_pair_result_map(pairs, send_public_requests<order_book_state>("/api/v3/depth", binance::read_order_book, queries));
 	}
 
 	double binance_api::get_fee(const tradable_pair& tradablePair) const
 	{
-		return send_private_request<double>(http_verb::GET, "/api/v3/account", binance::read_fee);
+		return _responseCache.get<double>("/api/v3/account/fee", "", internal::FEE_CACHE_TTL, [this]()
+		{
+			return send_private_request<double>(http_verb::GET, "/api/v3/account", binance::read_fee);
+		});
 	}
 
 	std::unordered_map<std::string, double> binance_api::get_balances() const
@@ -215,13 +260,13 @@ namespace mb
 
 	std::string binance_api::add_order(const order_request& request)
 	{
-		url_query_builder query{ create_order_query(request, _orderFilters[request.pair()])};
+		url_query_builder query{ create_order_query(request, get_order_filters(request.pair()))};
 		return send_private_request<std::string>(http_verb::POST, "/api/v3/order", binance::read_add_order, query);
 	}
 
 	order_confirmation binance_api::add_order_confirm(const order_request& request)
 	{
-		url_query_builder query{ create_order_query(request, _orderFilters[request.pair()]) };
+		url_query_builder query{ create_order_query(request, get_order_filters(request.pair())) };
 		return send_private_request<order_confirmation>(http_verb::POST, "/api/v3/order", binance::read_add_order_confirm, query);
 	}
 
@@ -259,9 +304,13 @@ namespace mb
 			nullptr,
 			false) };
 
+		// The stream owns the api, so the lookup's raw pointer lives as long as the stream does
+		const binance_api* priceApi{ marketApi.get() };
+
 		return std::make_unique<internal::binance_websocket_stream>(
 			std::make_unique<websocket_connection_factory>(),
-			std::move(marketApi));
+			std::move(marketApi),
+			[priceApi](const tradable_pair& pair) { return priceApi->get_price_precision(pair); });
 	}
 
 	template<>
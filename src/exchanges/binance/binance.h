@@ -1,11 +1,15 @@
 #pragma once
 
+#include <shared_mutex>
+
 #include "binance_config.h"
 #include "binance_websocket.h"
 #include "binance_order_filters.h"
 #include "exchanges/exchange.h"
 #include "exchanges/exchange_common.h"
+#include "common/security/hmac_signer.h"
 #include "networking/http/http_service.h"
+#include "networking/http/response_cache.h"
 #include "networking/url.h"
 #include "common/utils/timeutils.h"
 
@@ -14,13 +18,18 @@ namespace mb
 	class binance_api : public exchange
 	{
 	public:
-		std::string compute_api_sign(std::string query) const;
+		// The signature is only valid until the calling thread signs again
+		std::string_view compute_api_sign(std::string_view query) const;
 	private:
 		std::string_view _baseUrl;
 		std::string _apiKey;
-		std::string _secretKey;
+		hmac_signer _signer;
 		std::unique_ptr<http_service> _httpService;
+		mutable response_cache _responseCache;
 		mutable std::unordered_map<tradable_pair, internal::binance_order_filters> _orderFilters;
+		mutable std::shared_mutex _orderFiltersMutex;
+
+		internal::binance_order_filters get_order_filters(const tradable_pair& pair) const;
 
 		template<typename Value, typename ResponseReader>
 		Value send_public_request(std::string_view path, const ResponseReader& reader, std::string_view query = "") const
@@ -29,14 +38,33 @@ namespace mb
 			return internal::send_http_request<Value>(*_httpService, request, reader);
 		}
 
+		template<typename Value, typename ResponseReader>
+		Value send_cached_public_request(std::string_view path, std::chrono::milliseconds ttl, const ResponseReader& reader, std::string_view query = "") const
+		{
+			return _responseCache.get<Value>(path, query, ttl, [&]() { return send_public_request<Value>(path, reader, query); });
+		}
+
+		template<typename Value, typename ResponseReader>
+		std::vector<Value> send_public_requests(std::string_view path, const ResponseReader& reader, const std::vector<std::string>& queries) const
+		{
+			std::vector<http_request> requests;
+			requests.reserve(queries.size());
+
+			for (auto& query : queries)
+			{
+				requests.emplace_back(http_verb::GET, build_url(_baseUrl, path, query));
+			}
+
+			return internal::send_http_requests<Value>(*_httpService, requests, reader);
+		}
+
 		template<typename Value, typename ResponseReader>
 		Value send_private_request(http_verb verb, std::string_view path, const ResponseReader& reader, url_query_builder query = url_query_builder{}) const
 		{
 			std::string timeStamp{ std::to_string(time_since_epoch<std::chrono::milliseconds>()) };
 			query.add_parameter("timestamp", std::move(timeStamp));
 
-			std::string sign{ compute_api_sign(query.to_string()) };
-			query.add_parameter("signature", std::move(sign));
+			query.add_parameter("signature", compute_api_sign(query.to_string()));
 
 			http_request request{ verb, build_url(_baseUrl, path, query.to_string()) };
 
@@ -54,10 +82,12 @@ namespace mb
 
 		exchange_status get_status() const override;
 		std::vector<tradable_pair> get_tradable_pairs() const override;
+		int get_price_precision(const tradable_pair& pair) const;
 		std::vector<ohlcv_data> get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const override;
 		double get_price(const tradable_pair& tradablePair) const override;
 		std::unordered_map<tradable_pair, double> get_prices(const std::vector<tradable_pair>& pairs) const override;
 		order_book_state get_order_book(const tradable_pair& tradablePair, int depth) const override;
+		std::unordered_map<tradable_pair, order_book_state> get_order_books(const std::vector<tradable_pair>& pairs, int depth) const override;
 		double get_fee(const tradable_pair& tradablePair) const override;
 		std::unordered_map<std::string, double> get_balances() const override;
 		std::vector<order_description> get_open_orders() const override;
@@ -2,21 +2,40 @@
 
 namespace
 {
+	using namespace mb;
+
 	namespace json_property_names
 	{
 		static constexpr std::string_view API_KEY = "apiKey";
 		static constexpr std::string_view SECRET_KEY = "secretKey";
 	}
+
+	rate_limit_config default_rate_limit()
+	{
+		return rate_limit_config
+		{
+			1200.0,
+			20.0,
+			{
+				{ "/api/v3/exchangeInfo", 20.0 },
+				{ "/api/v3/depth", 5.0 },
+				{ "/api/v3/ticker/price", 2.0 },
+				{ "/api/v3/klines", 2.0 },
+				{ "/api/v3/account", 20.0 },
+				{ "/api/v3/openOrders", 40.0 }
+			}
+		};
+	}
 }
 
 namespace mb
 {
 	binance_config::binance_config()
-		: _apiKey{}, _secretKey{}
+		: _apiKey{}, _secretKey{}, _rateLimit{ default_rate_limit() }
 	{};
 
-	binance_config::binance_config(std::string publicKey, std::string privateKey)
-		: _apiKey{ std::move(publicKey) }, _secretKey{ std::move(privateKey) }
+	binance_config::binance_config(std::string publicKey, std::string privateKey, rate_limit_config rateLimit)
+		: _apiKey{ std::move(publicKey) }, _secretKey{ std::move(privateKey) }, _rateLimit{ std::move(rateLimit) }
 	{}
 
 	template<>
@@ -25,7 +44,8 @@ namespace mb
 		return binance_config
 		{
 			json.get<std::string>(json_property_names::API_KEY),
-			json.get<std::string>(json_property_names::SECRET_KEY)
+			json.get<std::string>(json_property_names::SECRET_KEY),
+			read_rate_limit_config(json, default_rate_limit())
 		};
 	}
 
@@ -34,5 +54,6 @@ namespace mb
 	{
 		writer.add(json_property_names::API_KEY, config.api_key());
 		writer.add(json_property_names::SECRET_KEY, config.secret_key());
+		write_rate_limit_config(config.rate_limit(), writer);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/json/json.h"
+#include "networking/http/rate_limiter.h"
 
 namespace mb
 {
@@ -9,15 +10,17 @@ namespace mb
 	private:
 		std::string _apiKey;
 		std::string _secretKey;
+		rate_limit_config _rateLimit;
 
 	public:
 		binance_config();
-		binance_config(std::string publicKey, std::string privateKey);
+		binance_config(std::string publicKey, std::string privateKey, rate_limit_config rateLimit);
 
 		static std::string name() noexcept { return "binance"; }
 
 		constexpr const std::string& api_key() const noexcept { return _apiKey; }
 		constexpr const std::string& secret_key() const noexcept { return _secretKey; }
+		const rate_limit_config& rate_limit() const noexcept { return _rateLimit; }
 	};
 
 	template<>
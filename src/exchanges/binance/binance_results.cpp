@@ -1,6 +1,7 @@
 #include "binance_results.h"
 #include "common/json/json.h"
 #include "common/utils/stringutils.h"
+#include "trading/decimal.h"
 
 #include "common/exceptions/not_implemented_exception.h"
 
@@ -137,9 +138,9 @@ namespace mb::binance
 				std::string priceUnit{ pairElement.get<std::string>("quoteAsset") };
 				tradable_pair pair{ std::move(asset), std::move(priceUnit) };
 
-				double tickSize = 0.0;
+				int priceScale = 0;
 				double minQty = 0.0;
-				double qtyStepSize = 0.0;
+				int qtyScale = 0;
 				double minValue = 0.0;
 				json_element filtersElement{ pairElement.element("filters") };
 
@@ -150,12 +151,12 @@ namespace mb::binance
 
 					if (filterType == "PRICE_FILTER")
 					{
-						tickSize = std::stod(filter.get<std::string>("tickSize"));
+						priceScale = decimal_scale(filter.get<std::string>("tickSize"));
 					}
 					else if (filterType == "LOT_SIZE")
 					{
 						minQty = std::stod(filter.get<std::string>("minQty"));
-						qtyStepSize = std::stod(filter.get<std::string>("stepSize"));
+						qtyScale = decimal_scale(filter.get<std::string>("stepSize"));
 					}
 					else if (filterType == "MIN_NOTIONAL")
 					{
@@ -165,8 +166,8 @@ namespace mb::binance
 
 				pairs.emplace(std::move(pair), internal::binance_order_filters
 					{
-						static_cast<int>(-std::log10(tickSize)),
-						static_cast<int>(-std::log10(qtyStepSize)),
+						priceScale,
+						qtyScale,
 						minQty,
 						minValue
 					});
@@ -44,13 +44,15 @@ namespace
 			throw mb_exception{ "Websocket channel not supported on Binance" };
 		}
 	}
+
 }
 
 namespace mb::internal
 {
 	binance_websocket_stream::binance_websocket_stream(
 		std::unique_ptr<websocket_connection_factory> connectionFactory,
-		std::unique_ptr<market_api> marketApi)
+		std::unique_ptr<market_api> marketApi,
+		price_scale_lookup priceScaleLookup)
 		: 
 		exchange_websocket_stream
 		{ 
@@ -59,9 +61,15 @@ namespace mb::internal
 			'\0',
 			std::move(connectionFactory) 
 		},
-		_marketApi{ std::move(marketApi) }
+		_marketApi{ std::move(marketApi) },
+		_priceScaleLookup{ std::move(priceScaleLookup) }
 	{}
 
+	binance_websocket_stream::~binance_websocket_stream()
+	{
+		shutdown();
+	}
+
 	void binance_websocket_stream::process_trade_message(const json_document& json)
 	{
 		std::string symbol{ json.get<std::string>("s") };
@@ -92,44 +100,45 @@ namespace mb::internal
 		update_ohlcv(std::move(symbol), parse_ohlcv_interval(interval), std::move(ohlcv));
 	}
 
-	void binance_websocket_stream::process_order_book_message(const json_document& json)
+	void binance_websocket_stream::read_order_book_levels(const std::string& symbol, order_book_side side, const json_element& element, std::vector<order_book_level_update>& levels) const
 	{
-		std::string symbol{ json.get<std::string>("s") };
-
-		if (!contains(_orderBookIds, symbol))
+		for (auto it = element.begin(); it != element.end(); ++it)
 		{
-			order_book_state snapshot{ _marketApi->get_order_book(_pairs.shared_lock()->at(symbol), 100)};
-			_orderBookIds[symbol] = snapshot.time_stamp();
-			initialise_order_book(symbol, from_snapshot(snapshot));
-			return;
+			json_element levelElement{ it.value() };
+			levels.emplace_back(
+				side,
+				parse_order_book_price(symbol, levelElement.get<std::string>(0)),
+				std::stod(levelElement.get<std::string>(1)));
 		}
+	}
 
-		std::time_t lastUpdate{ _orderBookIds[symbol] };
+	void binance_websocket_stream::process_order_book_message(const json_document& json)
+	{
+		std::string symbol{ json.get<std::string>("s") };
+		std::time_t firstUpdateId{ json.get<std::time_t>("U") };
 		std::time_t finalUpdateId{ json.get<std::time_t>("u") };
 
-		if (finalUpdateId <= lastUpdate)
-		{
-			return;
-		}
+		std::vector<order_book_level_update> levels;
+		read_order_book_levels(symbol, order_book_side::ASK, json.element("a"), levels);
+		read_order_book_levels(symbol, order_book_side::BID, json.element("b"), levels);
 
-		process_order_book_element(order_book_side::ASK, symbol, finalUpdateId, json.element("a"));
-		process_order_book_element(order_book_side::BID, symbol, finalUpdateId, json.element("b"));
+		update_order_book(std::move(symbol), order_book_update_batch{ finalUpdateId, firstUpdateId, finalUpdateId, std::move(levels) });
+	}
 
-		_orderBookIds[symbol] = finalUpdateId;
+	sequenced_order_book binance_websocket_stream::fetch_order_book_snapshot(const tradable_pair& pair)
+	{
+		// The snapshot's time stamp is Binance's lastUpdateId, which the depth stream's update ids continue from
+		order_book_state snapshot{ _marketApi->get_order_book(pair, 100) };
+		std::time_t lastUpdateId{ snapshot.time_stamp() };
+
+		return sequenced_order_book{ std::move(snapshot), lastUpdateId };
 	}
 
-	void binance_websocket_stream::process_order_book_element(order_book_side side, std::string_view pair, std::time_t id, const json_element& element)
+	int binance_websocket_stream::get_price_scale(const tradable_pair& pair)
 	{
-		for (auto it = element.begin(); it != element.end(); ++it)
-		{
-			json_element entryElement{ it.value() };
-			update_order_book(std::string{ pair }, id, order_book_entry
-				{
-					std::stod(entryElement.get<std::string>(0)),
-					std::stod(entryElement.get<std::string>(1)),
-					side
-				});
-		}
+		return _priceScaleLookup
+			? _priceScaleLookup(pair)
+			: DEFAULT_PRICE_SCALE;
 	}
 
 	void binance_websocket_stream::on_message(std::string_view message)
@@ -167,12 +176,12 @@ namespace mb::internal
 	void binance_websocket_stream::send_subscribe(const websocket_subscription& subscription)
 	{
 		std::string message{ create_message("SUBSCRIBE", get_channel_name(subscription), subscription.pair_item()) };
-		_connection->send_message(std::move(message));
+		send_message(std::move(message));
 	}
 
 	void binance_websocket_stream::send_unsubscribe(const websocket_subscription& subscription)
 	{
 		std::string message{ create_message("UNSUBSCRIBE", get_channel_name(subscription), subscription.pair_item()) };
-		_connection->send_message(std::move(message));
+		send_message(std::move(message));
 	}
 }
\ No newline at end of file
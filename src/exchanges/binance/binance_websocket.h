@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "common/json/json.h"
 #include "exchanges/exchange.h"
 #include "exchanges/websockets/exchange_websocket_stream.h"
@@ -8,22 +10,31 @@ namespace mb::internal
 {
 	class binance_websocket_stream : public exchange_websocket_stream
 	{
+	public:
+		using price_scale_lookup = std::function<int(const tradable_pair&)>;
+
 	private:
 		std::unique_ptr<market_api> _marketApi;
-		std::unordered_map<std::string, std::time_t> _orderBookIds;
+		price_scale_lookup _priceScaleLookup;
+
+		void read_order_book_levels(const std::string& symbol, order_book_side side, const json_element& element, std::vector<order_book_level_update>& levels) const;
 
 		void process_trade_message(const json_document& json);
 		void process_ohlcv_message(const json_document& json);
 		void process_order_book_message(const json_document& json);
-		void process_order_book_element(order_book_side side, std::string_view pair, std::time_t id, const json_element& element);
 
 		void on_message(std::string_view message) override;
+		sequenced_order_book fetch_order_book_snapshot(const tradable_pair& pair) override;
+		int get_price_scale(const tradable_pair& pair) override;
 		void send_subscribe(const websocket_subscription& subscription) override;
 		void send_unsubscribe(const websocket_subscription& subscription) override;
 
 	public:
 		binance_websocket_stream(
 			std::unique_ptr<websocket_connection_factory> connectionFactory,
-			std::unique_ptr<market_api> marketApi);
+			std::unique_ptr<market_api> marketApi,
+			price_scale_lookup priceScaleLookup = nullptr);
+
+		~binance_websocket_stream() override;
 	};
 }
\ No newline at end of file
@@ -1,8 +1,7 @@
 #include "bybit.h"
 #include "bybit_websocket.h"
-#include "common/security/hash.h"
-#include "common/security/encoding.h"
 #include "common/file/config_file_reader.h"
+#include "common/utils/containerutils.h"
 
 namespace
 {
@@ -33,6 +32,21 @@ namespace
 		return volume;
 	}
 
+	std::string create_price_query(const tradable_pair& pair)
+	{
+		return url_query_builder{}
+			.add_parameter("symbol", pair.to_string())
+			.to_string();
+	}
+
+	std::string create_order_book_query(const tradable_pair& pair, int depth)
+	{
+		return url_query_builder{}
+			.add_parameter("symbol", pair.to_string())
+			.add_parameter("limit", std::to_string(depth))
+			.to_string();
+	}
+
 	std::string to_side_string(trade_action action)
 	{
 		return action == trade_action::BUY
@@ -57,30 +71,34 @@ namespace mb
 		exchange{ exchange_ids::BYBIT, std::move(websocketStream) },
 		_baseUrl{ select_base_url(enableTesting) },
 		_apiKey{ config.api_key() },
-		_apiSecret{ config.api_secret() },
+		_signer{ create_hmac_sha256_signer(config.api_secret()) },
 		_fee{ config.fee() },
 		_httpService{ std::move(httpService) }
-	{}
+	{
+		_httpService->set_rate_limiter(std::make_shared<rate_limiter>(config.rate_limit()));
+	}
 
 	std::string bybit_api::get_time_stamp() const
 	{
 		return std::to_string(time_since_epoch<std::chrono::milliseconds>());
 	}
 
-	std::string bybit_api::compute_api_sign(std::string_view query) const
+	std::string_view bybit_api::compute_api_sign(std::string_view query) const
 	{
-		std::vector<unsigned char> signData{ hmac_sha256(query, _apiSecret) };
-		return hex_encode(signData);
+		thread_local std::string signature;
+		_signer.sign_hex_into(signature, query);
+
+		return signature;
 	}
 
 	exchange_status bybit_api::get_status() const
 	{
-		return send_public_request<exchange_status>("spot/v1/time", bybit::read_system_status);
+		return send_cached_public_request<exchange_status>("spot/v1/time", internal::STATUS_CACHE_TTL, bybit::read_system_status);
 	}
 
 	std::vector<tradable_pair> bybit_api::get_tradable_pairs() const
 	{
-		return send_public_request<std::vector<tradable_pair>>("spot/v1/symbols", bybit::read_tradable_pairs);
+		return send_cached_public_request<std::vector<tradable_pair>>("spot/v1/symbols", internal::TRADABLE_PAIRS_CACHE_TTL, bybit::read_tradable_pairs);
 	}
 
 	std::vector<ohlcv_data> bybit_api::get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const
@@ -96,21 +114,26 @@ namespace mb
 
 	double bybit_api::get_price(const tradable_pair& tradablePair) const
 	{
-		std::string query = url_query_builder{}
-			.add_parameter("symbol", tradablePair.to_string())
-			.to_string();
+		return send_public_request<double>("/spot/quote/v1/ticker/price", bybit::read_price, create_price_query(tradablePair));
+	}
 
-		return send_public_request<double>("/spot/quote/v1/ticker/price", bybit::read_price, query);
+	std::unordered_map<tradable_pair, double> bybit_api::get_prices(const std::vector<tradable_pair>& pairs) const
+	{
+		std::vector<std::string> queries{ to_vector<std::string>(pairs, create_price_query) };
+
+		return internal::create_pair_result_map(pairs, send_public_requests<double>("/spot/quote/v1/ticker/price", bybit::read_price, queries));
 	}
 
 	order_book_state bybit_api::get_order_book(const tradable_pair& tradablePair, int depth) const
 	{
-		std::string query = url_query_builder{}
-			.add_parameter("symbol", tradablePair.to_string())
-			.add_parameter("limit", std::to_string(depth))
-			.to_string();
+		return send_public_request<order_book_state>("/spot/quote/v1/depth", bybit::read_order_book, create_order_book_query(tradablePair, depth));
+	}
+
+	std::unordered_map<tradable_pair, order_book_state> bybit_api::get_order_books(const std::vector<tradable_pair>& pairs, int depth) const
+	{
+		std::vector<std::string> queries{ to_vector<std::string>(pairs, [depth](const tradable_pair& pair) { return create_order_book_query(pair, depth); }) };
 
-		return send_public_request<order_book_state>("/spot/quote/v1/depth", bybit::read_order_book, query);
+		return internal::create_pair_result_map(pairs, send_public_requests<order_book_state>("/spot/quote/v1/depth", bybit::read_order_book, queries));
 	}
 
 	double bybit_api::get_fee(const tradable_pair& tradablePair) const
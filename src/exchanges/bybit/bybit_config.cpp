@@ -2,22 +2,34 @@
 
 namespace
 {
+	using namespace mb;
+
 	namespace json_property_names
 	{
 		static constexpr std::string_view API_KEY = "apiKey";
 		static constexpr std::string_view API_SECRET = "apiSecret";
 		static constexpr std::string_view FEE = "fee";
 	}
+
+	rate_limit_config default_rate_limit()
+	{
+		return rate_limit_config
+		{
+			50.0,
+			20.0,
+			{}
+		};
+	}
 }
 
 namespace mb
 {
 	bybit_config::bybit_config()
-		: _apiKey{}, _apiSecret{}, _fee{ 0.1 }
+		: _apiKey{}, _apiSecret{}, _fee{ 0.1 }, _rateLimit{ default_rate_limit() }
 	{};
 
-	bybit_config::bybit_config(std::string apiKey, std::string apiSecret, double fee)
-		: _apiKey{ std::move(apiKey) }, _apiSecret{ std::move(apiSecret) }, _fee{ fee }
+	bybit_config::bybit_config(std::string apiKey, std::string apiSecret, double fee, rate_limit_config rateLimit)
+		: _apiKey{ std::move(apiKey) }, _apiSecret{ std::move(apiSecret) }, _fee{ fee }, _rateLimit{ std::move(rateLimit) }
 	{}
 
 	template<>
@@ -27,7 +39,8 @@ namespace mb
 		{
 			json.get<std::string>(json_property_names::API_KEY),
 			json.get<std::string>(json_property_names::API_SECRET),
-			json.get<double>(json_property_names::FEE)
+			json.get<double>(json_property_names::FEE),
+			read_rate_limit_config(json, default_rate_limit())
 		};
 	}
 
@@ -37,5 +50,6 @@ namespace mb
 		writer.add(json_property_names::API_KEY, config.api_key());
 		writer.add(json_property_names::API_SECRET, config.api_secret());
 		writer.add(json_property_names::FEE, config.fee());
+		write_rate_limit_config(config.rate_limit(), writer);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/json/json.h"
+#include "networking/http/rate_limiter.h"
 
 namespace mb
 {
@@ -10,16 +11,18 @@ namespace mb
 		std::string _apiKey;
 		std::string _apiSecret;
 		double _fee;
+		rate_limit_config _rateLimit;
 
 	public:
 		bybit_config();
-		bybit_config(std::string apiKey, std::string apiSecret, double fee);
+		bybit_config(std::string apiKey, std::string apiSecret, double fee, rate_limit_config rateLimit);
 
 		static std::string name() noexcept { return "bybit"; }
 
 		constexpr const std::string& api_key() const noexcept { return _apiKey; }
 		constexpr const std::string& api_secret() const noexcept { return _apiSecret; }
 		constexpr double fee() const noexcept { return _fee; }
+		const rate_limit_config& rate_limit() const noexcept { return _rateLimit; }
 	};
 
 	template<>
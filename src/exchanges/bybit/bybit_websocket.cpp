@@ -68,23 +68,23 @@ namespace
 
 	order_book_cache create_order_book_cache(std::time_t timeStamp, int depth, const json_element& asksElement, const json_element& bidsElement)
 	{
-		ask_cache askCache;
-		bid_cache bidCache;
+		std::vector<order_book_entry> askCache;
+		std::vector<order_book_entry> bidCache;
 		
 		for (int i = 0; i < depth; ++i)
 		{
 			if (i < asksElement.size())
 			{
-				askCache.emplace(create_order_book_entry(order_book_side::ASK, asksElement.element(i)));
+				askCache.push_back(create_order_book_entry(order_book_side::ASK, asksElement.element(i)));
 			}
 
 			if (i < bidsElement.size())
 			{
-				bidCache.emplace(create_order_book_entry(order_book_side::BID, bidsElement.element(i)));
+				bidCache.push_back(create_order_book_entry(order_book_side::BID, bidsElement.element(i)));
 			}
 		}
 
-		return order_book_cache{ timeStamp, std::move(askCache), std::move(bidCache) };
+		return order_book_cache{ timeStamp, askCache, bidCache };
 	}
 }
 
@@ -101,6 +101,11 @@ namespace mb::internal
 		}
 	{}
 
+	bybit_websocket_stream::~bybit_websocket_stream()
+	{
+		shutdown();
+	}
+
 	void bybit_websocket_stream::on_message(std::string_view message)
 	{
 		json_document json{ parse_json(message) };
@@ -179,18 +184,31 @@ namespace mb::internal
 			return;
 		}
 
+		std::vector<order_book_level_update> levels;
+		levels.reserve(asksElement.size() + bidsElement.size());
+
 		for (int i = 0; i < depth; ++i)
 		{
 			if (i < asksElement.size())
 			{
-				update_order_book(pairName, timeStamp, create_order_book_entry(order_book_side::ASK, asksElement.element(i)));
+				json_element entryElement{ asksElement.element(i) };
+				levels.emplace_back(
+					order_book_side::ASK,
+					parse_order_book_price(pairName, entryElement.get<std::string>(0)),
+					std::stod(entryElement.get<std::string>(1)));
 			}
 
 			if (i < bidsElement.size())
 			{
-				update_order_book(pairName, timeStamp, create_order_book_entry(order_book_side::BID, bidsElement.element(i)));
+				json_element entryElement{ bidsElement.element(i) };
+				levels.emplace_back(
+					order_book_side::BID,
+					parse_order_book_price(pairName, entryElement.get<std::string>(0)),
+					std::stod(entryElement.get<std::string>(1)));
 			}
 		}
+
+		update_order_book(std::move(pairName), timeStamp, std::move(levels));
 	}
 
 	void bybit_websocket_stream::send_subscribe(const websocket_subscription& subscription)
@@ -198,7 +216,7 @@ namespace mb::internal
 		std::string topic{ get_topic(subscription) };
 		std::string message{ create_message(topic, "sub", subscription.pair_item()) };
 
-		_connection->send_message(message);
+		send_message(message);
 	}
 
 	void bybit_websocket_stream::send_unsubscribe(const websocket_subscription& subscription)
@@ -206,6 +224,6 @@ namespace mb::internal
 		std::string topic{ get_topic(subscription) };
 		std::string message{ create_message(topic, "cancel", subscription.pair_item()) };
 
-		_connection->send_message(message);
+		send_message(message);
 	}
 }
\ No newline at end of file
@@ -18,5 +18,7 @@ namespace mb::internal
 
 	public:
 		bybit_websocket_stream(std::unique_ptr<websocket_connection_factory> connectionFactory);
+
+		~bybit_websocket_stream() override;
 	};
 }
\ No newline at end of file
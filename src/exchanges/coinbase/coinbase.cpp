@@ -1,9 +1,9 @@
 #include "coinbase.h"
 #include "coinbase_results.h"
 #include "common/utils/timeutils.h"
-#include "common/security/hash.h"
 #include "common/security/encoding.h"
 #include "common/file/config_file_reader.h"
+#include "common/utils/containerutils.h"
 
 namespace
 {
@@ -39,6 +39,22 @@ namespace
 		}
 	}
 
+	std::string create_product_path(const tradable_pair& pair, char pairSeparator, std::string_view resource)
+	{
+		return "/products/" + pair.to_string(pairSeparator) + "/" + std::string{ resource };
+	}
+
+	std::string create_order_book_query(int depth)
+	{
+		int level = depth == 1 
+			? 1 
+			: 2;
+
+		return url_query_builder{}
+			.add_parameter("level", std::to_string(level))
+			.to_string();
+	}
+
 	constexpr bool is_stop_order(order_type orderType)
 	{
 		return orderType == order_type::STOP_LOSS || orderType == order_type::TAKE_PROFIT;
@@ -57,28 +73,33 @@ namespace mb
 		_baseUrl{ select_base_url(enableTesting) },
 		_userAgentId{ get_timestamp() },
 		_apiKey{ config.api_key() },
-		_decodedApiSecret{ b64_decode(config.api_secret()) },
+		_signer{ create_hmac_sha256_signer(b64_decode(config.api_secret())) },
 		_apiPassphrase{ config.api_passphrase() },
 		_httpService{ std::move(httpService) }
-	{}
+	{
+		_httpService->set_rate_limiter(std::make_shared<rate_limiter>(config.rate_limit()));
+	}
 
 	std::string coinbase_api::get_timestamp() const
 	{
 		return std::to_string(time_since_epoch<std::chrono::seconds>());
 	}
 
-	std::string coinbase_api::compute_access_sign(std::string_view timestamp, http_verb httpVerb, std::string_view path, std::string_view query, std::string_view body) const
+	std::string_view coinbase_api::compute_access_sign(std::string_view timestamp, http_verb httpVerb, std::string_view path, std::string_view query, std::string_view body) const
 	{
-		std::string message;
-		message.append(timestamp);
-		message.append(to_string(httpVerb));
-		message.append(path);
-		append_query(message, query);
-		message.append(body);
-		
-		auto hmac = hmac_sha256(message, _decodedApiSecret);
-		auto encoded = b64_encode(hmac);
-		return encoded;
+		thread_local std::string signature;
+		std::string_view verb{ to_string(httpVerb) };
+
+		if (query.empty())
+		{
+			_signer.sign_base64_into(signature, timestamp, verb, path, body);
+		}
+		else
+		{
+			_signer.sign_base64_into(signature, timestamp, verb, path, std::string_view{ "?" }, query, body);
+		}
+
+		return signature;
 	}
 
 	exchange_status coinbase_api::get_status() const
@@ -88,7 +109,7 @@ namespace mb
 
 	std::vector<tradable_pair> coinbase_api::get_tradable_pairs() const
 	{
-		return send_public_request<std::vector<tradable_pair>>("/products", coinbase::read_tradable_pairs);
+		return send_cached_public_request<std::vector<tradable_pair>>("/products", internal::TRADABLE_PAIRS_CACHE_TTL, coinbase::read_tradable_pairs);
 	}
 
 	std::vector<ohlcv_data> coinbase_api::get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const
@@ -107,32 +128,40 @@ namespace mb
 
 	double coinbase_api::get_price(const tradable_pair& tradablePair) const
 	{
-		std::string path = "/products/" + tradablePair.to_string(_pairSeparator) + "/ticker";
+		return send_public_request<double>(create_product_path(tradablePair, _pairSeparator, "ticker"), coinbase::read_price);
+	}
 
-		return send_public_request<double>(path, coinbase::read_price);
+	std::unordered_map<tradable_pair, double> coinbase_api::get_prices(const std::vector<tradable_pair>& pairs) const
+	{
+		std::vector<std::string> paths{ to_vector<std::string>(pairs, [](const tradable_pair& pair) { return create_product_path(pair, _pairSeparator, "ticker"); }) };
+
+		return internal::create_pair_result_map(pairs, send_public_requests<double>(paths, coinbase::read_price));
 	}
 
 	order_book_state coinbase_api::get_order_book(const tradable_pair& tradablePair, int depth) const
 	{
-		std::string path = "/products/" + tradablePair.to_string(_pairSeparator) + "/book";
-
-		int level = depth == 1 
-			? 1 
-			: 2;
+		return send_public_request<order_book_state>(
+			create_product_path(tradablePair, _pairSeparator, "book"), 
+			[depth](std::string_view jsonResult) { return coinbase::read_order_book(jsonResult, depth); },
+			create_order_book_query(depth));
+	}
 
-		std::string query{ url_query_builder{}
-			.add_parameter("level", std::to_string(level))
-			.to_string() };
+	std::unordered_map<tradable_pair, order_book_state> coinbase_api::get_order_books(const std::vector<tradable_pair>& pairs, int depth) const
+	{
+		std::vector<std::string> paths{ to_vector<std::string>(pairs, [](const tradable_pair& pair) { return create_product_path(pair, _pairSeparator, "book"); }) };
 
-		return send_public_request<order_book_state>(
-			path, 
+		return internal::create_pair_result_map(pairs, send_public_requests<order_book_state>(
+			paths,
 			[depth](std::string_view jsonResult) { return coinbase::read_order_book(jsonResult, depth); },
-			query);
+			create_order_book_query(depth)));
 	}
 
 	double coinbase_api::get_fee(const tradable_pair& tradablePair) const
 	{
-		return send_private_request<double>(http_verb::GET, "/fees", coinbase::read_fee);
+		return _responseCache.get<double>("/fees", "", internal::FEE_CACHE_TTL, [this]()
+		{
+			return send_private_request<double>(http_verb::GET, "/fees", coinbase::read_fee);
+		});
 	}
 
 	std::unordered_map<std::string,double> coinbase_api::get_balances() const
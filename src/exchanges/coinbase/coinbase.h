@@ -5,7 +5,9 @@
 #include "exchanges/exchange.h"
 #include "exchanges/exchange_ids.h"
 #include "exchanges/exchange_common.h"
+#include "common/security/hmac_signer.h"
 #include "networking/http/http_service.h"
+#include "networking/http/response_cache.h"
 #include "networking/url.h"
 
 namespace mb
@@ -18,18 +20,25 @@ namespace mb
 
 		std::string _userAgentId;
 		std::string _apiKey;
-		std::vector<unsigned char> _decodedApiSecret;
+		hmac_signer _signer;
 		std::string _apiPassphrase;
 		std::unique_ptr<http_service> _httpService;
+		mutable response_cache _responseCache;
 
 		std::string get_timestamp() const;
-		std::string compute_access_sign(std::string_view timestamp, http_verb httpVerb, std::string_view path, std::string_view query, std::string_view body) const;
+		// The signature is only valid until the calling thread signs again
+		std::string_view compute_access_sign(std::string_view timestamp, http_verb httpVerb, std::string_view path, std::string_view query, std::string_view body) const;
 
-		template<typename Value, typename ResponseReader>
-		Value send_request(http_request& request, const ResponseReader& reader) const
+		void add_common_headers(http_request& request) const
 		{
 			request.add_header(common_http_headers::USER_AGENT, _userAgentId);
 			request.add_header(common_http_headers::ACCEPT, common_http_headers::APPLICATION_JSON);
+		}
+
+		template<typename Value, typename ResponseReader>
+		Value send_request(http_request& request, const ResponseReader& reader) const
+		{
+			add_common_headers(request);
 			
 			return internal::send_http_request<Value>(*_httpService, request, reader);
 		}
@@ -41,6 +50,26 @@ namespace mb
 			return send_request<Value>(request, reader);
 		}
 
+		template<typename Value, typename ResponseReader>
+		Value send_cached_public_request(std::string_view path, std::chrono::milliseconds ttl, const ResponseReader& reader, std::string_view query = "") const
+		{
+			return _responseCache.get<Value>(path, query, ttl, [&]() { return send_public_request<Value>(path, reader, query); });
+		}
+
+		template<typename Value, typename ResponseReader>
+		std::vector<Value> send_public_requests(const std::vector<std::string>& paths, const ResponseReader& reader, std::string_view query = "") const
+		{
+			std::vector<http_request> requests;
+			requests.reserve(paths.size());
+
+			for (auto& path : paths)
+			{
+				add_common_headers(requests.emplace_back(http_verb::GET, build_url(_baseUrl, path, query)));
+			}
+
+			return internal::send_http_requests<Value>(*_httpService, requests, reader);
+		}
+
 		template<typename Value, typename ResponseReader>
 		Value send_private_request(http_verb httpVerb, std::string path, const ResponseReader& reader, std::string_view query = "", std::string_view content = "") const
 		{
@@ -73,7 +102,9 @@ namespace mb
 		std::vector<tradable_pair> get_tradable_pairs() const override;
 		std::vector<ohlcv_data> get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const override;
 		double get_price(const tradable_pair& tradablePair) const override;
+		std::unordered_map<tradable_pair, double> get_prices(const std::vector<tradable_pair>& pairs) const override;
 		order_book_state get_order_book(const tradable_pair& tradablePair, int depth) const override;
+		std::unordered_map<tradable_pair, order_book_state> get_order_books(const std::vector<tradable_pair>& pairs, int depth) const override;
 		double get_fee(const tradable_pair& tradablePair) const override;
 		std::unordered_map<std::string,double> get_balances() const override;
 		std::vector<order_description> get_open_orders() const override;
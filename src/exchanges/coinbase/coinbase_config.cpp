@@ -2,25 +2,38 @@
 
 namespace
 {
+	using namespace mb;
+
 	namespace json_property_names
 	{
 		static constexpr std::string_view API_KEY = "apiKey";
 		static constexpr std::string_view API_SECRET = "apiSecret";
 		static constexpr std::string_view API_PASSPHRASE = "apiPassphrase";
 	}
+
+	rate_limit_config default_rate_limit()
+	{
+		return rate_limit_config
+		{
+			15.0,
+			10.0,
+			{}
+		};
+	}
 }
 
 namespace mb
 {
 	coinbase_config::coinbase_config()
-		: _apiKey{}, _apiSecret{}, _apiPassphrase{}
+		: _apiKey{}, _apiSecret{}, _apiPassphrase{}, _rateLimit{ default_rate_limit() }
 	{};
 
-	coinbase_config::coinbase_config(std::string apiKey, std::string apiSecret, std::string apiPassphrase)
+	coinbase_config::coinbase_config(std::string apiKey, std::string apiSecret, std::string apiPassphrase, rate_limit_config rateLimit)
 		: 
 		_apiKey{ std::move(apiKey) }, 
 		_apiSecret{ std::move(apiSecret) }, 
-		_apiPassphrase{std::move(apiPassphrase)}
+		_apiPassphrase{std::move(apiPassphrase)},
+		_rateLimit{ std::move(rateLimit) }
 	{}
 
 	template<>
@@ -30,7 +43,7 @@ namespace mb
 		std::string apiSecret{ json.get<std::string>(json_property_names::API_SECRET) };
 		std::string apiPassphrase{ json.get<std::string>(json_property_names::API_PASSPHRASE) };
 
-		return coinbase_config{ std::move(apiKey), std::move(apiSecret), std::move(apiPassphrase) };
+		return coinbase_config{ std::move(apiKey), std::move(apiSecret), std::move(apiPassphrase), read_rate_limit_config(json, default_rate_limit()) };
 	}
 
 	template<>
@@ -39,5 +52,6 @@ namespace mb
 		writer.add(json_property_names::API_KEY, config.api_key());
 		writer.add(json_property_names::API_SECRET, config.api_secret());
 		writer.add(json_property_names::API_PASSPHRASE, config.api_passphrase());
+		write_rate_limit_config(config.rate_limit(), writer);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/json/json.h"
+#include "networking/http/rate_limiter.h"
 
 namespace mb
 {
@@ -10,16 +11,18 @@ namespace mb
 		std::string _apiKey;
 		std::string _apiSecret;
 		std::string _apiPassphrase;
+		rate_limit_config _rateLimit;
 
 	public:
 		coinbase_config();
-		coinbase_config(std::string apiKey, std::string apiSecret, std::string apiPassphrase);
+		coinbase_config(std::string apiKey, std::string apiSecret, std::string apiPassphrase, rate_limit_config rateLimit);
 
 		static std::string name() noexcept { return "coinbase"; }
 
 		const std::string& api_key() const noexcept { return _apiKey; }
 		const std::string& api_secret() const noexcept { return _apiSecret; }
 		const std::string& api_passphrase() const noexcept { return _apiPassphrase; }
+		const rate_limit_config& rate_limit() const noexcept { return _rateLimit; }
 	};
 
 	template<>
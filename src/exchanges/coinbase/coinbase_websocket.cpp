@@ -76,6 +76,11 @@ namespace mb::internal
 			}}
 	{}
 
+	coinbase_websocket_stream::~coinbase_websocket_stream()
+	{
+		shutdown();
+	}
+
 	void coinbase_websocket_stream::process_trade_message(const json_document& json)
 	{
 		double price{ std::stod(json.get<std::string>("price")) };
@@ -100,25 +105,25 @@ namespace mb::internal
 
 		int maxDepth = std::max(asks.size(), bids.size());
 
-		ask_cache askCache;
-		bid_cache bidCache;
+		std::vector<order_book_entry> askCache;
+		std::vector<order_book_entry> bidCache;
 		std::time_t timeStamp{ now_t() };
 
 		for (int i = 0; i < maxDepth; ++i)
 		{
 			if (i < asks.size())
 			{
-				askCache.emplace(create_order_book_entry(order_book_side::ASK, asks.element(i)));
+				askCache.push_back(create_order_book_entry(order_book_side::ASK, asks.element(i)));
 			}
 
 			if (i < bids.size())
 			{
-				bidCache.emplace(create_order_book_entry(order_book_side::BID, bids.element(i)));
+				bidCache.push_back(create_order_book_entry(order_book_side::BID, bids.element(i)));
 			}
 		}
 
 		std::string pairName{ json.get<std::string>("product_id") };
-		initialise_order_book(std::move(pairName), order_book_cache{ timeStamp, std::move(askCache), std::move(bidCache) });
+		initialise_order_book(std::move(pairName), order_book_cache{ timeStamp, askCache, bidCache });
 	}
 
 	void coinbase_websocket_stream::process_order_book_update(const json_document& json)
@@ -127,6 +132,8 @@ namespace mb::internal
 		json_element changesElement{ json.element("changes") };
 		std::string pairName{ json.get<std::string>("product_id") };
 
+		std::vector<order_book_level_update> levels;
+
 		for (auto it = changesElement.begin(); it != changesElement.end(); ++it)
 		{
 			json_element entryElement{ it.value() };
@@ -135,8 +142,13 @@ namespace mb::internal
 				? order_book_side::BID
 				: order_book_side::ASK;
 
-			update_order_book(pairName, timeStamp, create_order_book_entry(side, entryElement, 1));
+			levels.emplace_back(
+				side,
+				parse_order_book_price(pairName, entryElement.get<std::string>(1)),
+				std::stod(entryElement.get<std::string>(2)));
 		}
+
+		update_order_book(std::move(pairName), timeStamp, std::move(levels));
 	}
 
 	void coinbase_websocket_stream::on_message(std::string_view message)
@@ -171,7 +183,7 @@ namespace mb::internal
 		std::string channelName{ get_channel(subscription.channel()) };
 		std::string message{ create_message("subscribe", channelName, subscription.pair_item()) };
 
-		_connection->send_message(message);
+		send_message(message);
 	}
 
 	void coinbase_websocket_stream::send_unsubscribe(const websocket_subscription& subscription)
@@ -185,6 +197,6 @@ namespace mb::internal
 		std::string channelName{ get_channel(subscription.channel()) };
 		std::string message{ create_message("unsubscribe", std::move(channelName), subscription.pair_item()) };
 
-		_connection->send_message(std::move(message));
+		send_message(std::move(message));
 	}
 }
\ No newline at end of file
@@ -25,5 +25,7 @@ namespace mb::internal
 		coinbase_websocket_stream(
 			std::unique_ptr<websocket_connection_factory> connectionFactory,
 			std::unique_ptr<market_api> marketApi);
+
+		~coinbase_websocket_stream() override;
 	};
 }
\ No newline at end of file
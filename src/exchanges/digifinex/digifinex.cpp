@@ -1,8 +1,7 @@
 #include "digifinex.h"
-#include "common/security/hash.h"
-#include "common/security/encoding.h"
 #include "common/exceptions/not_implemented_exception.h"
 #include "common/file/config_file_reader.h"
+#include "common/utils/containerutils.h"
 
 namespace
 {
@@ -38,6 +37,21 @@ namespace
 		throw mb_exception{ "Order type not supported" };
 	}
 
+	std::string create_price_query(const tradable_pair& pair, char pairSeparator)
+	{
+		return url_query_builder{}
+			.add_parameter("symbol", pair.to_string(pairSeparator))
+			.to_string();
+	}
+
+	std::string create_order_book_query(const tradable_pair& pair, int depth, char pairSeparator)
+	{
+		return url_query_builder{}
+			.add_parameter("symbol", pair.to_string(pairSeparator))
+			.add_parameter("limit", std::to_string(depth))
+			.to_string();
+	}
+
 	template<typename GetPrice>
 	double get_amount(const order_request& orderRequest, GetPrice getPrice)
 	{
@@ -62,24 +76,28 @@ namespace mb
 		: 
 		exchange{ exchange_ids::DIGIFINEX, std::move(websocketStream) },
 		_apiKey{ config.api_key() },
-		_apiSecret{ config.api_secret() },
+		_signer{ create_hmac_sha256_signer(config.api_secret()) },
 		_httpService{ std::move(httpService) }
-	{}
+	{
+		_httpService->set_rate_limiter(std::make_shared<rate_limiter>(config.rate_limit()));
+	}
 
-	std::string digifinex_api::compute_api_sign(std::string_view query) const
+	std::string_view digifinex_api::compute_api_sign(std::string_view query) const
 	{
-		std::vector<unsigned char> signData{ hmac_sha256(query, _apiSecret) };
-		return hex_encode(signData);
+		thread_local std::string signature;
+		_signer.sign_hex_into(signature, query);
+
+		return signature;
 	}
 
 	exchange_status digifinex_api::get_status() const
 	{
-		return send_public_request<exchange_status>("/ping", digifinex::read_system_status);
+		return send_cached_public_request<exchange_status>("/ping", internal::STATUS_CACHE_TTL, digifinex::read_system_status);
 	}
 
 	std::vector<tradable_pair> digifinex_api::get_tradable_pairs() const
 	{
-		return send_public_request<std::vector<tradable_pair>>("/spot/symbols", digifinex::read_tradable_pairs);
+		return send_cached_public_request<std::vector<tradable_pair>>("/spot/symbols", internal::TRADABLE_PAIRS_CACHE_TTL, digifinex::read_tradable_pairs);
 	}
 
 	std::vector<ohlcv_data> digifinex_api::get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const
@@ -97,21 +115,26 @@ namespace mb
 
 	double digifinex_api::get_price(const tradable_pair& tradablePair) const
 	{
-		std::string query = url_query_builder{}
-			.add_parameter("symbol", tradablePair.to_string(_pairSeparator))
-			.to_string();
+		return send_public_request<double>("/ticker", digifinex::read_price, create_price_query(tradablePair, _pairSeparator));
+	}
+
+	std::unordered_map<tradable_pair, double> digifinex_api::get_prices(const std::vector<tradable_pair>& pairs) const
+	{
+		std::vector<std::string> queries{ to_vector<std::string>(pairs, [](const tradable_pair& pair) { return create_price_query(pair, _pairSeparator); }) };
 
-		return send_public_request<double>("/ticker", digifinex::read_price, query);
+		return internal::create_pair_result_map(pairs, send_public_requests<double>("/ticker", digifinex::read_price, queries));
 	}
 
 	order_book_state digifinex_api::get_order_book(const tradable_pair& tradablePair, int depth) const
 	{
-		std::string query = url_query_builder{}
-			.add_parameter("symbol", tradablePair.to_string('_'))
-			.add_parameter("limit", std::to_string(depth))
-			.to_string();
+		return send_public_request<order_book_state>("order_book", digifinex::read_order_book, create_order_book_query(tradablePair, depth, _pairSeparator));
+	}
+
+	std::unordered_map<tradable_pair, order_book_state> digifinex_api::get_order_books(const std::vector<tradable_pair>& pairs, int depth) const
+	{
+		std::vector<std::string> queries{ to_vector<std::string>(pairs, [depth](const tradable_pair& pair) { return create_order_book_query(pair, depth, _pairSeparator); }) };
 
-		return send_public_request<order_book_state>("order_book", digifinex::read_order_book, query);
+		return internal::create_pair_result_map(pairs, send_public_requests<order_book_state>("order_book", digifinex::read_order_book, queries));
 	}
 
 	double digifinex_api::get_fee(const tradable_pair& tradablePair) const
@@ -167,7 +190,7 @@ namespace mb
 			false) };
 
 		return std::make_unique<internal::digifinex_websocket_stream>(
-			std::make_unique<websocket_connection_factory>(),
+			std::make_unique<websocket_connection_factory>(ws_compression::NONE, true),
 			std::move(marketApi));
 	}
 
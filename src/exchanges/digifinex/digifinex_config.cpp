@@ -2,21 +2,33 @@
 
 namespace
 {
+	using namespace mb;
+
 	namespace json_property_names
 	{
 		static constexpr std::string_view API_KEY = "apiKey";
 		static constexpr std::string_view API_SECRET = "apiSecret";
 	}
+
+	rate_limit_config default_rate_limit()
+	{
+		return rate_limit_config
+		{
+			10.0,
+			5.0,
+			{}
+		};
+	}
 }
 
 namespace mb
 {
 	digifinex_config::digifinex_config()
-		: _apiKey{}, _apiSecret{}
+		: _apiKey{}, _apiSecret{}, _rateLimit{ default_rate_limit() }
 	{}
 
-	digifinex_config::digifinex_config(std::string apiKey, std::string apiSecret)
-		: _apiKey{ std::move(apiKey) }, _apiSecret{ std::move(apiSecret) }
+	digifinex_config::digifinex_config(std::string apiKey, std::string apiSecret, rate_limit_config rateLimit)
+		: _apiKey{ std::move(apiKey) }, _apiSecret{ std::move(apiSecret) }, _rateLimit{ std::move(rateLimit) }
 	{}
 
 	template<>
@@ -25,7 +37,8 @@ namespace mb
 		return digifinex_config
 		{
 			json.get<std::string>(json_property_names::API_KEY),
-			json.get<std::string>(json_property_names::API_SECRET)
+			json.get<std::string>(json_property_names::API_SECRET),
+			read_rate_limit_config(json, default_rate_limit())
 		};
 	}
 
@@ -34,5 +47,6 @@ namespace mb
 	{
 		writer.add(json_property_names::API_KEY, config.api_key());
 		writer.add(json_property_names::API_SECRET, config.api_secret());
+		write_rate_limit_config(config.rate_limit(), writer);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/json/json.h"
+#include "networking/http/rate_limiter.h"
 
 namespace mb
 {
@@ -9,15 +10,17 @@ namespace mb
 	private:
 		std::string _apiKey;
 		std::string _apiSecret;
+		rate_limit_config _rateLimit;
 
 	public:
 		digifinex_config();
-		digifinex_config(std::string apiKey, std::string apiSecret);
+		digifinex_config(std::string apiKey, std::string apiSecret, rate_limit_config rateLimit);
 
 		static std::string name() noexcept { return "digifinex"; }
 
 		const std::string& api_key() const noexcept { return _apiKey; }
 		const std::string& api_secret() const noexcept { return _apiSecret; }
+		const rate_limit_config& rate_limit() const noexcept { return _rateLimit; }
 	};
 
 	template<>
@@ -55,6 +55,11 @@ namespace mb::internal
 			} }
 	{}
 
+	digifinex_websocket_stream::~digifinex_websocket_stream()
+	{
+		shutdown();
+	}
+
 	void digifinex_websocket_stream::process_trade_message(const json_document& json)
 	{
 		json_element paramsElement{ json.element("params") };
@@ -101,7 +106,7 @@ namespace mb::internal
 		std::string channelName{ get_channel(subscription.channel()) };
 		std::string message{ create_message("subscribe", std::move(channelName), subscription.pair_item()) };
 
-		_connection->send_message(std::move(message));
+		send_message(std::move(message));
 	}
 
 	void digifinex_websocket_stream::send_unsubscribe(const websocket_subscription& subscription)
@@ -115,6 +120,6 @@ namespace mb::internal
 		std::string channelName{ get_channel(subscription.channel()) };
 		std::string message{ create_message("unsubscribe", std::move(channelName), subscription.pair_item()) };
 
-		_connection->send_message(std::move(message));
+		send_message(std::move(message));
 	}
 }
\ No newline at end of file
@@ -21,5 +21,7 @@ namespace mb::internal
 		digifinex_websocket_stream(
 			std::unique_ptr<websocket_connection_factory> connectionFactory,
 			std::unique_ptr<market_api> marketApi);
+
+		~digifinex_websocket_stream() override;
 	};
 }
\ No newline at end of file
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <chrono>
+
 #include "networking/http/http_service.h"
 #include "common/types/result.h"
 
 namespace mb::internal
 {
+	static constexpr std::chrono::minutes STATUS_CACHE_TTL{ 1 };
+	static constexpr std::chrono::hours TRADABLE_PAIRS_CACHE_TTL{ 1 };
+	static constexpr std::chrono::hours FEE_CACHE_TTL{ 1 };
+
 	template<typename Value, typename ResponseReader>
-	Value send_http_request(const http_service& httpService, http_request& request, const ResponseReader& reader)
+	Value read_http_response(const http_response& response, const ResponseReader& reader)
 	{
-		http_response response{ httpService.send(request) };
-
 		if (response.response_code() != HttpResponseCodes::OK)
 		{
 			throw mb_exception{ response.message() };
@@ -25,6 +29,28 @@ namespace mb::internal
 		throw mb_exception{ result.error() };
 	}
 
+	template<typename Value, typename ResponseReader>
+	Value send_http_request(const http_service& httpService, http_request& request, const ResponseReader& reader)
+	{
+		return read_http_response<Value>(httpService.send(request), reader);
+	}
+
+	template<typename Value, typename ResponseReader>
+	std::vector<Value> send_http_requests(const http_service& httpService, const std::vector<http_request>& requests, const ResponseReader& reader)
+	{
+		std::vector<http_response> responses{ httpService.send_batch(requests) };
+
+		std::vector<Value> values;
+		values.reserve(responses.size());
+
+		for (auto& response : responses)
+		{
+			values.emplace_back(read_http_response<Value>(response, reader));
+		}
+
+		return values;
+	}
+
 	template<typename T>
 	std::unordered_map<tradable_pair, T> create_pair_result_map(const std::vector<tradable_pair>& pairs, std::unordered_map<std::string, T> namedResults)
 	{
@@ -33,7 +59,7 @@ namespace mb::internal
 			[](const tradable_pair& pair) { return pair.to_string(); },
 			[](const tradable_pair& pair) { return pair; }) };
 
-		std::unordered_map<tradable_pair, double> result;
+		std::unordered_map<tradable_pair, T> result;
 		result.reserve(namedResults.size());
 
 		for (auto& [name, value] : namedResults)
@@ -43,4 +69,18 @@ namespace mb::internal
 
 		return result;
 	}
+
+	template<typename T>
+	std::unordered_map<tradable_pair, T> create_pair_result_map(const std::vector<tradable_pair>& pairs, std::vector<T> orderedResults)
+	{
+		std::unordered_map<tradable_pair, T> result;
+		result.reserve(pairs.size());
+
+		for (size_t i = 0; i < pairs.size(); ++i)
+		{
+			result.emplace(pairs[i], std::move(orderedResults[i]));
+		}
+
+		return result;
+	}
 }
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <chrono>
 
 #include "kraken.h"
@@ -51,6 +52,14 @@ namespace
 		pairList.pop_back();
 		return pairList;
 	}
+
+	std::string create_order_book_query(const tradable_pair& pair, int depth)
+	{
+		return url_query_builder{}
+			.add_parameter("pair", pair.to_string())
+			.add_parameter("count", std::to_string(depth))
+			.to_string();
+	}
 }
 
 namespace mb
@@ -63,23 +72,34 @@ namespace mb
 		:
 		exchange{ exchange_ids::KRAKEN, std::move(websocketStream) },
 		_publicKey{ config.public_key() },
-		_decodedPrivateKey{ b64_decode(config.private_key()) },
-		_httpService{ std::move(httpService) }
-	{}
+		_signer{ create_hmac_sha512_signer(b64_decode(config.private_key())) },
+		_httpService{ std::move(httpService) },
+		_lastNonce{ 0 }
+	{
+		_httpService->set_rate_limiter(std::make_shared<rate_limiter>(config.rate_limit()));
+	}
 
 	std::string kraken_api::get_nonce() const
 	{
-		return std::to_string(time_since_epoch<std::chrono::milliseconds>());
+		// Follows the clock, but never repeats or goes backwards when two calls land in the same millisecond
+		long long now = time_since_epoch<std::chrono::milliseconds>();
+		long long last = _lastNonce.load();
+		long long next;
+
+		do
+		{
+			next = std::max(now, last + 1);
+		} while (!_lastNonce.compare_exchange_weak(last, next));
+
+		return std::to_string(next);
 	}
 
-	std::string kraken_api::compute_api_sign(std::string_view uriPath, std::string_view urlPostData, std::string_view nonce) const
+	std::string_view kraken_api::compute_api_sign(std::string_view uriPath, std::string_view urlPostData, std::string_view nonce) const
 	{
-		std::vector<unsigned char> nonce_postData = sha256(std::string{ nonce }.append(urlPostData));
+		thread_local std::string signature;
+		_signer.sign_base64_into(signature, uriPath, sha256_digest(nonce, urlPostData));
 
-		std::vector<unsigned char> message{ uriPath.begin(), uriPath.end() };
-		message.insert(message.end(), nonce_postData.begin(), nonce_postData.end());
-
-		return b64_encode(hmac_sha512(message, _decodedPrivateKey));
+		return signature;
 	}
 
 	std::string kraken_api::build_kraken_path(std::string access, std::string method) const
@@ -89,12 +109,12 @@ namespace mb
 
 	exchange_status kraken_api::get_status() const
 	{
-		return send_public_request<exchange_status>("SystemStatus", kraken::read_system_status);
+		return send_cached_public_request<exchange_status>("SystemStatus", internal::STATUS_CACHE_TTL, kraken::read_system_status);
 	}
 
 	std::vector<tradable_pair> kraken_api::get_tradable_pairs() const
 	{
-		return send_public_request<std::vector<tradable_pair>>("AssetPairs", kraken::read_tradable_pairs);
+		return send_cached_public_request<std::vector<tradable_pair>>("AssetPairs", internal::TRADABLE_PAIRS_CACHE_TTL, kraken::read_tradable_pairs);
 	}
 
 	std::vector<ohlcv_data> kraken_api::get_ohlcv(const tradable_pair& tradablePair, ohlcv_interval interval, int count) const
@@ -131,12 +151,14 @@ namespace mb
 
 	order_book_state kraken_api::get_order_book(const tradable_pair& tradablePair, int depth) const
 	{
-		std::string query = url_query_builder{}
-			.add_parameter("pair", tradablePair.to_string())
-			.add_parameter("count", std::to_string(depth))
-			.to_string();
+		return send_public_request<order_book_state>("Depth", kraken::read_order_book, create_order_book_query(tradablePair, depth));
+	}
+
+	std::unordered_map<tradable_pair, order_book_state> kraken_api::get_order_books(const std::vector<tradable_pair>& pairs, int depth) const
+	{
+		std::vector<std::string> queries{ to_vector<std::string>(pairs, [depth](const tradable_pair& pair) { return create_order_book_query(pair, depth); }) };
 
-		return send_public_request<order_book_state>("Depth", kraken::read_order_book, query);
+		return internal::create_pair_result_map(pairs, send_public_requests<order_book_state>("Depth", kraken::read_order_book, queries));
 	}
 
 	double kraken_api::get_fee(const tradable_pair& tradablePair) const
@@ -145,7 +167,10 @@ namespace mb
 			.add_parameter("pair", tradablePair.to_string())
 			.to_string();
 
-		return send_private_request<double>("TradeVolume", kraken::read_fee, query);
+		return _responseCache.get<double>("TradeVolume", query, internal::FEE_CACHE_TTL, [this, &query]()
+		{
+			return send_private_request<double>("TradeVolume", kraken::read_fee, query);
+		});
 	}
 
 	std::unordered_map<std::string,double> kraken_api::get_balances() const
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <string>
@@ -13,7 +15,9 @@
 #include "exchanges/exchange_common.h"
 #include "common/utils/retry.h"
 #include "networking/url.h"
+#include "common/security/hmac_signer.h"
 #include "networking/http/http_service.h"
+#include "networking/http/response_cache.h"
 #include "networking/websocket/websocket_connection.h"
 #include "trading/order_request.h"
 #include "trading/trading_constants.h"
@@ -27,11 +31,15 @@ namespace mb
 		static constexpr std::string_view _baseUrl = "https://api.kraken.com";
 
 		std::string _publicKey;
-		std::vector<unsigned char> _decodedPrivateKey;
+		hmac_signer _signer;
 		std::unique_ptr<http_service> _httpService;
+		mutable response_cache _responseCache;
+		mutable std::atomic<long long> _lastNonce;
+		mutable std::mutex _privateRequestMutex;
 
 		std::string get_nonce() const;
-		std::string compute_api_sign(std::string_view uriPath, std::string_view postData, std::string_view nonce) const;
+		// The signature is only valid until the calling thread signs again
+		std::string_view compute_api_sign(std::string_view uriPath, std::string_view postData, std::string_view nonce) const;
 		std::string build_kraken_path(std::string access, std::string method) const;
 
 		template<typename Value, typename ResponseReader>
@@ -44,9 +52,35 @@ namespace mb
 			return internal::send_http_request<Value>(*_httpService, request, reader);
 		}
 
+		template<typename Value, typename ResponseReader>
+		Value send_cached_public_request(std::string_view method, std::chrono::milliseconds ttl, const ResponseReader& reader, std::string_view query = "") const
+		{
+			return _responseCache.get<Value>(method, query, ttl, [&]() { return send_public_request<Value>(std::string{ method }, reader, query); });
+		}
+
+		template<typename Value, typename ResponseReader>
+		std::vector<Value> send_public_requests(std::string method, const ResponseReader& reader, const std::vector<std::string>& queries) const
+		{
+			std::string path{ build_kraken_path("public", std::move(method)) };
+
+			std::vector<http_request> requests;
+			requests.reserve(queries.size());
+
+			for (auto& query : queries)
+			{
+				requests.emplace_back(http_verb::GET, build_url(_baseUrl, path, query));
+			}
+
+			return internal::send_http_requests<Value>(*_httpService, requests, reader);
+		}
+
 		template<typename Value, typename ResponseReader>
 		Value send_private_request(std::string method, const ResponseReader& reader, std::string_view query = "") const
 		{
+			// Kraken rejects a nonce lower than one it has already seen, so private requests
+			// are sent one at a time to keep them arriving in nonce order
+			std::lock_guard<std::mutex> lock{ _privateRequestMutex };
+
 			std::string nonce{ get_nonce() };
 			std::string postData{ "nonce=" + nonce};
 			
@@ -57,7 +91,7 @@ namespace mb
 			}
 
 			std::string apiPath{ build_kraken_path("private", std::move(method)) };
-			std::string apiSign{ compute_api_sign(apiPath, postData, nonce) };
+			std::string_view apiSign{ compute_api_sign(apiPath, postData, nonce) };
 			std::string url{ build_url(_baseUrl, apiPath) };
 
 			http_request request{ http_verb::POST, std::move(url) };
@@ -83,6 +117,7 @@ namespace mb
 		double get_price(const tradable_pair& tradablePair) const override;
 		std::unordered_map<tradable_pair, double> get_prices(const std::vector<tradable_pair>& pairs) const;
 		order_book_state get_order_book(const tradable_pair& tradablePair, int depth) const override;
+		std::unordered_map<tradable_pair, order_book_state> get_order_books(const std::vector<tradable_pair>& pairs, int depth) const override;
 		double get_fee(const tradable_pair& tradablePair) const override;
 		std::unordered_map<std::string,double> get_balances() const override;
 		std::vector<order_description> get_open_orders() const override;
@@ -4,21 +4,35 @@
 
 namespace
 {
+	using namespace mb;
+
 	namespace json_property_names
 	{
 		static constexpr std::string_view PUBLIC_KEY = "publicKey";
 		static constexpr std::string_view PRIVATE_KEY = "privateKey";
 	}
+
+	rate_limit_config default_rate_limit()
+	{
+		return rate_limit_config
+		{
+			15.0,
+			1.0,
+			{
+				{ "/0/private/ClosedOrders", 2.0 }
+			}
+		};
+	}
 }
 
 namespace mb
 {
 	kraken_config::kraken_config()
-		: _publicKey{}, _privateKey{}
+		: _publicKey{}, _privateKey{}, _rateLimit{ default_rate_limit() }
 	{}
 
-	kraken_config::kraken_config(std::string publicKey, std::string privateKey)
-		: _publicKey{ std::move(publicKey) }, _privateKey{ std::move(privateKey) }
+	kraken_config::kraken_config(std::string publicKey, std::string privateKey, rate_limit_config rateLimit)
+		: _publicKey{ std::move(publicKey) }, _privateKey{ std::move(privateKey) }, _rateLimit{ std::move(rateLimit) }
 	{
 		validate();
 	}
@@ -44,7 +58,7 @@ namespace mb
 		std::string publicKey{ json.get<std::string>(json_property_names::PUBLIC_KEY) };
 		std::string privateKey{ json.get<std::string>(json_property_names::PRIVATE_KEY) };
 
-		return kraken_config{ std::move(publicKey), std::move(privateKey) };
+		return kraken_config{ std::move(publicKey), std::move(privateKey), read_rate_limit_config(json, default_rate_limit()) };
 	}
 
 	template<>
@@ -52,5 +66,6 @@ namespace mb
 	{
 		writer.add(json_property_names::PUBLIC_KEY, config.public_key());
 		writer.add(json_property_names::PRIVATE_KEY, config.private_key());
+		write_rate_limit_config(config.rate_limit(), writer);
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "common/json/json.h"
+#include "networking/http/rate_limiter.h"
 
 namespace mb
 {
@@ -11,17 +12,19 @@ namespace mb
 	private:
 		std::string _publicKey;
 		std::string _privateKey;
+		rate_limit_config _rateLimit;
 
 		void validate();
 
 	public:
 		kraken_config();
-		kraken_config(std::string publicKey, std::string privateKey);
+		kraken_config(std::string publicKey, std::string privateKey, rate_limit_config rateLimit);
 
 		static std::string name() noexcept { return "kraken"; }
 
 		const std::string& public_key() const noexcept { return _publicKey; }
 		const std::string& private_key() const noexcept { return _privateKey; }
+		const rate_limit_config& rate_limit() const noexcept { return _rateLimit; }
 	};
 
 	template<>
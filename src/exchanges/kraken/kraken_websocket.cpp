@@ -64,8 +64,8 @@ namespace
 
 		int depth = std::max<int>(asks.size(), bids.size());
 
-		ask_cache askCache;
-		bid_cache bidCache;
+		std::vector<order_book_entry> askCache;
+		std::vector<order_book_entry> bidCache;
 		std::time_t timeStamp = 0;
 
 		for (int i = 0; i < depth; ++i)
@@ -73,7 +73,7 @@ namespace
 			if (i < asks.size())
 			{
 				json_element askElement{ asks.element(i) };
-				askCache.emplace(create_order_book_entry(order_book_side::ASK, askElement));
+				askCache.push_back(create_order_book_entry(order_book_side::ASK, askElement));
 
 				timeStamp = std::max(timeStamp, get_order_book_update_timestamp(askElement));
 			}
@@ -81,13 +81,13 @@ namespace
 			if (i < bids.size())
 			{
 				json_element bidElement{ bids.element(i) };
-				bidCache.emplace(create_order_book_entry(order_book_side::BID, bidElement));
+				bidCache.push_back(create_order_book_entry(order_book_side::BID, bidElement));
 
 				timeStamp = std::max(timeStamp, get_order_book_update_timestamp(bidElement));
 			}
 		}
 
-		return order_book_cache{ timeStamp, std::move(askCache), std::move(bidCache) };
+		return order_book_cache{ timeStamp, askCache, bidCache };
 	}
 }
 
@@ -104,6 +104,11 @@ namespace mb::internal
 		}
 	{}
 
+	kraken_websocket_stream::~kraken_websocket_stream()
+	{
+		shutdown();
+	}
+
 	void kraken_websocket_stream::process_event_message(const json_document& json)
 	{
 		// TODO
@@ -182,15 +187,22 @@ namespace mb::internal
 		}
 
 		json_element updateElement{ updateObject.element(name) };
+		std::vector<order_book_level_update> levels;
+		std::time_t timeStamp{ 0 };
 
 		for (auto it = updateElement.begin(); it != updateElement.end(); ++it)
 		{
 			json_element entryElement{ it.value() };
-			order_book_entry entry{ create_order_book_entry(side, entryElement) };
-			std::time_t timeStamp{ get_order_book_update_timestamp(entryElement) };
+			levels.emplace_back(
+				side,
+				parse_order_book_price(pairName, entryElement.get<std::string>(0)),
+				std::stod(entryElement.get<std::string>(1)));
 
-			update_order_book(pairName, timeStamp, std::move(entry));
+			// The book takes the time of the last entry, as it did when entries were applied one by one
+			timeStamp = get_order_book_update_timestamp(entryElement);
 		}
+
+		update_order_book(std::move(pairName), timeStamp, std::move(levels));
 	}
 
 	void kraken_websocket_stream::on_message(std::string_view message)
@@ -226,13 +238,13 @@ namespace mb::internal
 	{
 		std::string message{ create_message("subscribe", subscription) };
 
-		_connection->send_message(message);
+		send_message(message);
 	}
 
 	void kraken_websocket_stream::send_unsubscribe(const websocket_subscription& subscription)
 	{
 		std::string message{ create_message("unsubscribe", subscription) };
 
-		_connection->send_message(message);
+		send_message(message);
 	}
 }
\ No newline at end of file
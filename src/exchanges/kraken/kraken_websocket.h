@@ -20,5 +20,7 @@ namespace mb::internal
 
 	public:
 		kraken_websocket_stream(std::unique_ptr<websocket_connection_factory> connectionFactory);
+
+		~kraken_websocket_stream() override;
 	};
 }
\ No newline at end of file
@@ -14,6 +14,11 @@ namespace mb::internal
 		}
 	{}
 
+	template_websocket_stream::~template_websocket_stream()
+	{
+		shutdown();
+	}
+
 	void template_websocket_stream::process_trade_message(const json_document& json)
 	{
 	}
@@ -17,5 +17,7 @@ namespace mb::internal
 	public:
 		template_websocket_stream(
 			std::unique_ptr<websocket_connection_factory> connectionFactory);
+
+		~template_websocket_stream() override;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,388 @@
+#include <algorithm>
+#include <thread>
+
+#include "consolidated_order_book.h"
+#include "common/utils/mathutils.h"
+
+namespace
+{
+	using namespace mb;
+	using namespace mb::internal;
+
+	static constexpr consolidated_order_book_entry EMPTY_ENTRY{ 0.0, 0.0, "" };
+
+	bool is_reset_marker(const order_book_entry& entry)
+	{
+		return entry.price() == 0.0 && entry.volume() == 0.0;
+	}
+
+	template<typename Levels>
+	void set_venue_volume(Levels& levels, double price, std::string_view exchangeId, double volume)
+	{
+		auto levelIt = levels.find(price);
+
+		if (levelIt == levels.end())
+		{
+			if (volume <= 0.0)
+			{
+				return;
+			}
+
+			levelIt = levels.emplace(price, level_venues{}).first;
+		}
+
+		level_venues& venues{ levelIt->second };
+		auto venueIt = std::find_if(venues.begin(), venues.end(), [exchangeId](const venue_volume& venue) { return venue.exchangeId == exchangeId; });
+
+		if (volume > 0.0)
+		{
+			venueIt != venues.end()
+				? void(venueIt->volume = volume)
+				: void(venues.push_back(venue_volume{ exchangeId, volume }));
+		}
+		else if (venueIt != venues.end())
+		{
+			venues.erase(venueIt);
+		}
+
+		if (venues.empty())
+		{
+			levels.erase(levelIt);
+		}
+	}
+
+	template<typename Levels>
+	void remove_venue(Levels& levels, std::string_view exchangeId)
+	{
+		for (auto levelIt = levels.begin(); levelIt != levels.end();)
+		{
+			level_venues& venues{ levelIt->second };
+			venues.erase(std::remove_if(venues.begin(), venues.end(), [exchangeId](const venue_volume& venue) { return venue.exchangeId == exchangeId; }), venues.end());
+
+			levelIt = venues.empty()
+				? levels.erase(levelIt)
+				: std::next(levelIt);
+		}
+	}
+
+	template<typename Levels>
+	std::vector<consolidated_order_book_entry> flatten_levels(const Levels& levels, int depth)
+	{
+		std::vector<consolidated_order_book_entry> entries;
+		entries.reserve(depth);
+
+		int levelCount = 0;
+		for (auto levelIt = levels.begin(); levelIt != levels.end() && levelCount < depth; ++levelIt, ++levelCount)
+		{
+			for (auto& venue : levelIt->second)
+			{
+				entries.emplace_back(levelIt->first, venue.volume, venue.exchangeId);
+			}
+		}
+
+		return entries;
+	}
+
+	template<typename Levels>
+	consolidated_order_book_entry best_entry(const Levels& levels)
+	{
+		if (levels.empty())
+		{
+			return EMPTY_ENTRY;
+		}
+
+		const auto& [price, venues] = *levels.begin();
+
+		double totalVolume = 0.0;
+		const venue_volume* largestVenue = &venues.front();
+
+		for (auto& venue : venues)
+		{
+			totalVolume += venue.volume;
+
+			if (venue.volume > largestVenue->volume)
+			{
+				largestVenue = &venue;
+			}
+		}
+
+		return consolidated_order_book_entry{ price, totalVolume, largestVenue->exchangeId };
+	}
+}
+
+namespace mb
+{
+	namespace internal
+	{
+		bool price_less_than::operator()(double l, double r) const
+		{
+			return double_less_than(l, r);
+		}
+
+		bool price_greater_than::operator()(double l, double r) const
+		{
+			return double_greater_than(l, r);
+		}
+
+		published_entry::published_entry()
+			: _price{ 0.0 }, _volume{ 0.0 }, _exchangeIdData{ nullptr }, _exchangeIdSize{ 0 }
+		{}
+
+		void published_entry::store(const consolidated_order_book_entry& entry) noexcept
+		{
+			_price.store(entry.price(), std::memory_order_relaxed);
+			_volume.store(entry.volume(), std::memory_order_relaxed);
+			_exchangeIdData.store(entry.exchange_id().data(), std::memory_order_relaxed);
+			_exchangeIdSize.store(entry.exchange_id().size(), std::memory_order_relaxed);
+		}
+
+		consolidated_order_book_entry published_entry::load() const noexcept
+		{
+			const char* exchangeIdData = _exchangeIdData.load(std::memory_order_relaxed);
+
+			return consolidated_order_book_entry
+			{
+				_price.load(std::memory_order_relaxed),
+				_volume.load(std::memory_order_relaxed),
+				exchangeIdData ? std::string_view{ exchangeIdData, _exchangeIdSize.load(std::memory_order_relaxed) } : std::string_view{}
+			};
+		}
+
+		consolidated_pair_book::consolidated_pair_book(int publishedDepth)
+			:
+			_mutex{},
+			_asks{},
+			_bids{},
+			_publishedDepth{ publishedDepth },
+			_depthSlots{ std::make_shared<const consolidated_depth>(std::vector<consolidated_order_book_entry>{}, std::vector<consolidated_order_book_entry>{}), nullptr },
+			_currentDepthSlot{ 0 },
+			_depthSlotReaders{ 0, 0 },
+			_bestSequence{ 0 },
+			_bestBid{},
+			_bestAsk{}
+		{}
+
+		void consolidated_pair_book::remove_exchange(std::string_view exchangeId)
+		{
+			remove_venue(_asks, exchangeId);
+			remove_venue(_bids, exchangeId);
+		}
+
+		void consolidated_pair_book::update_level(std::string_view exchangeId, const order_book_entry& entry)
+		{
+			entry.side() == order_book_side::ASK
+				? set_venue_volume(_asks, entry.price(), exchangeId, entry.volume())
+				: set_venue_volume(_bids, entry.price(), exchangeId, entry.volume());
+		}
+
+		void consolidated_pair_book::publish()
+		{
+			std::shared_ptr<const consolidated_depth> depth{ std::make_shared<const consolidated_depth>(
+				flatten_levels(_asks, _publishedDepth),
+				flatten_levels(_bids, _publishedDepth)) };
+
+			// Double buffered: the writer fills the slot readers are not using, then flips to it. A reader copying
+			// the other slot from before the previous flip is only ever mid shared_ptr copy, so the wait is short
+			int nextSlot = 1 - _currentDepthSlot.load(std::memory_order_relaxed);
+
+			while (_depthSlotReaders[nextSlot].load() != 0)
+			{
+				std::this_thread::yield();
+			}
+
+			_depthSlots[nextSlot].swap(depth);
+			_currentDepthSlot.store(nextSlot);
+
+			// Seqlock write: an odd sequence tells readers the best bid/offer is mid-update
+			unsigned sequence = _bestSequence.load(std::memory_order_relaxed);
+			_bestSequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			_bestBid.store(best_entry(_bids));
+			_bestAsk.store(best_entry(_asks));
+
+			_bestSequence.store(sequence + 2, std::memory_order_release);
+		}
+
+		void consolidated_pair_book::update(std::string_view exchangeId, const order_book_entry& entry, bool publishBook)
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+
+			update_level(exchangeId, entry);
+
+			if (publishBook)
+			{
+				publish();
+			}
+		}
+
+		void consolidated_pair_book::reset(std::string_view exchangeId, const order_book_state& orderBook)
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+
+			remove_exchange(exchangeId);
+
+			for (auto& ask : orderBook.asks())
+			{
+				update_level(exchangeId, ask);
+			}
+
+			for (auto& bid : orderBook.bids())
+			{
+				update_level(exchangeId, bid);
+			}
+
+			publish();
+		}
+
+		std::shared_ptr<const consolidated_depth> consolidated_pair_book::depth() const
+		{
+			while (true)
+			{
+				int slot = _currentDepthSlot.load();
+				_depthSlotReaders[slot].fetch_add(1);
+
+				// Registered before checking the slot is still current, so the writer cannot refill it under this copy
+				if (_currentDepthSlot.load() == slot)
+				{
+					std::shared_ptr<const consolidated_depth> depth{ _depthSlots[slot] };
+					_depthSlotReaders[slot].fetch_sub(1);
+
+					return depth;
+				}
+
+				_depthSlotReaders[slot].fetch_sub(1);
+			}
+		}
+
+		best_bid_offer consolidated_pair_book::best() const noexcept
+		{
+			while (true)
+			{
+				unsigned sequence = _bestSequence.load(std::memory_order_acquire);
+
+				if (sequence % 2 != 0)
+				{
+					continue;
+				}
+
+				consolidated_order_book_entry bid{ _bestBid.load() };
+				consolidated_order_book_entry ask{ _bestAsk.load() };
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				if (_bestSequence.load(std::memory_order_relaxed) == sequence)
+				{
+					return best_bid_offer{ bid, ask };
+				}
+			}
+		}
+
+		consolidated_book_map::consolidated_book_map(std::unordered_map<std::string, std::string> assetAliases, const std::vector<tradable_pair>& pairs, int publishedDepth)
+			: _assetAliases{ std::move(assetAliases) }, _books{}, _exchangeIdMutex{}, _exchangeIds{}
+		{
+			for (auto& pair : pairs)
+			{
+				_books.emplace(normalise(pair), std::make_unique<consolidated_pair_book>(publishedDepth));
+			}
+		}
+
+		std::string_view consolidated_book_map::intern_exchange_id(std::string_view exchangeId)
+		{
+			std::lock_guard<std::mutex> lock{ _exchangeIdMutex };
+			return *_exchangeIds.emplace(exchangeId).first;
+		}
+
+		tradable_pair consolidated_book_map::normalise(const tradable_pair& pair) const
+		{
+			auto alias = [this](const std::string& asset)
+			{
+				auto it = _assetAliases.find(asset);
+				return it != _assetAliases.end()
+					? it->second
+					: asset;
+			};
+
+			return tradable_pair{ alias(pair.asset()), alias(pair.price_unit()) };
+		}
+
+		consolidated_pair_book* consolidated_book_map::find(const tradable_pair& pair) const
+		{
+			auto it = _books.find(normalise(pair));
+			return it != _books.end()
+				? it->second.get()
+				: nullptr;
+		}
+	}
+
+	std::unordered_map<std::string, std::string> default_asset_aliases()
+	{
+		return std::unordered_map<std::string, std::string>
+		{
+			{ "XBT", "BTC" },
+			{ "XXBT", "BTC" },
+			{ "XDG", "DOGE" },
+			{ "ZUSD", "USD" },
+			{ "ZEUR", "EUR" },
+			{ "ZGBP", "GBP" }
+		};
+	}
+
+	consolidated_order_book::consolidated_order_book(
+		std::vector<tradable_pair> pairs,
+		int publishedDepth,
+		std::unordered_map<std::string, std::string> assetAliases)
+		: _books{ std::make_shared<internal::consolidated_book_map>(std::move(assetAliases), pairs, publishedDepth) }
+	{}
+
+	const internal::consolidated_pair_book& consolidated_order_book::get_book(const tradable_pair& pair) const
+	{
+		internal::consolidated_pair_book* book{ _books->find(pair) };
+
+		if (!book)
+		{
+			throw mb_exception{ fmt::format("Pair {} is not part of the consolidated order book", pair.to_string('/')) };
+		}
+
+		return *book;
+	}
+
+	void consolidated_order_book::add_stream(std::string_view exchangeId, websocket_stream& stream)
+	{
+		// The handler shares ownership of the books so streams outliving this object never touch freed memory. The books
+		// own the exchange id too, since the caller's view may not outlive the stream and venues keep views of it.
+		stream.add_order_book_update_handler([books = _books, exchangeId = _books->intern_exchange_id(exchangeId), &stream](order_book_update_message message)
+		{
+			internal::consolidated_pair_book* book{ books->find(message.pair()) };
+
+			if (!book)
+			{
+				return;
+			}
+
+			is_reset_marker(message.entry())
+				? book->reset(exchangeId, stream.get_order_book(message.pair()))
+				: book->update(exchangeId, message.entry(), message.end_of_batch());
+		});
+	}
+
+	void consolidated_order_book::add_exchange(exchange& exchange)
+	{
+		add_stream(exchange.id(), *exchange.get_websocket_stream());
+	}
+
+	tradable_pair consolidated_order_book::normalise(const tradable_pair& pair) const
+	{
+		return _books->normalise(pair);
+	}
+
+	std::shared_ptr<const consolidated_depth> consolidated_order_book::get_depth(const tradable_pair& pair) const
+	{
+		return get_book(pair).depth();
+	}
+
+	best_bid_offer consolidated_order_book::get_best_bid_offer(const tradable_pair& pair) const
+	{
+		return get_book(pair).best();
+	}
+}
\ No newline at end of file
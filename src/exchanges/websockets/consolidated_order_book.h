@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "websocket_stream.h"
+#include "exchanges/exchange.h"
+#include "trading/order_book.h"
+#include "trading/tradable_pair.h"
+
+namespace mb
+{
+	class consolidated_order_book_entry
+	{
+	private:
+		double _price;
+		double _volume;
+		std::string_view _exchangeId;
+
+	public:
+		constexpr consolidated_order_book_entry(double price, double volume, std::string_view exchangeId)
+			: _price{ price }, _volume{ volume }, _exchangeId{ exchangeId }
+		{}
+
+		constexpr double price() const noexcept { return _price; }
+		constexpr double volume() const noexcept { return _volume; }
+		constexpr std::string_view exchange_id() const noexcept { return _exchangeId; }
+	};
+
+	class consolidated_depth
+	{
+	private:
+		std::vector<consolidated_order_book_entry> _asks;
+		std::vector<consolidated_order_book_entry> _bids;
+
+	public:
+		consolidated_depth(std::vector<consolidated_order_book_entry> asks, std::vector<consolidated_order_book_entry> bids)
+			: _asks{ std::move(asks) }, _bids{ std::move(bids) }
+		{}
+
+		const std::vector<consolidated_order_book_entry>& asks() const noexcept { return _asks; }
+		const std::vector<consolidated_order_book_entry>& bids() const noexcept { return _bids; }
+	};
+
+	class best_bid_offer
+	{
+	private:
+		consolidated_order_book_entry _bid;
+		consolidated_order_book_entry _ask;
+
+	public:
+		constexpr best_bid_offer(consolidated_order_book_entry bid, consolidated_order_book_entry ask)
+			: _bid{ std::move(bid) }, _ask{ std::move(ask) }
+		{}
+
+		constexpr const consolidated_order_book_entry& bid() const noexcept { return _bid; }
+		constexpr const consolidated_order_book_entry& ask() const noexcept { return _ask; }
+
+		constexpr bool has_bid() const noexcept { return _bid.volume() > 0.0; }
+		constexpr bool has_ask() const noexcept { return _ask.volume() > 0.0; }
+	};
+
+	namespace internal
+	{
+		struct price_less_than
+		{
+			bool operator()(double l, double r) const;
+		};
+
+		struct price_greater_than
+		{
+			bool operator()(double l, double r) const;
+		};
+
+		struct venue_volume
+		{
+			std::string_view exchangeId;
+			double volume;
+		};
+
+		using level_venues = std::vector<venue_volume>;
+
+		class published_entry
+		{
+		private:
+			std::atomic<double> _price;
+			std::atomic<double> _volume;
+			std::atomic<const char*> _exchangeIdData;
+			std::atomic<size_t> _exchangeIdSize;
+
+		public:
+			published_entry();
+
+			void store(const consolidated_order_book_entry& entry) noexcept;
+			consolidated_order_book_entry load() const noexcept;
+		};
+
+		class consolidated_pair_book
+		{
+		private:
+			std::mutex _mutex;
+			std::map<double, level_venues, price_less_than> _asks;
+			std::map<double, level_venues, price_greater_than> _bids;
+			int _publishedDepth;
+
+			std::shared_ptr<const consolidated_depth> _depthSlots[2];
+			std::atomic<int> _currentDepthSlot;
+			mutable std::atomic<int> _depthSlotReaders[2];
+			std::atomic<unsigned> _bestSequence;
+			published_entry _bestBid;
+			published_entry _bestAsk;
+
+			void remove_exchange(std::string_view exchangeId);
+			void update_level(std::string_view exchangeId, const order_book_entry& entry);
+			void publish();
+
+		public:
+			explicit consolidated_pair_book(int publishedDepth);
+
+			void update(std::string_view exchangeId, const order_book_entry& entry, bool publishBook = true);
+			void reset(std::string_view exchangeId, const order_book_state& orderBook);
+
+			std::shared_ptr<const consolidated_depth> depth() const;
+			best_bid_offer best() const noexcept;
+		};
+
+		class consolidated_book_map
+		{
+		private:
+			std::unordered_map<std::string, std::string> _assetAliases;
+			std::unordered_map<tradable_pair, std::unique_ptr<consolidated_pair_book>> _books;
+			std::mutex _exchangeIdMutex;
+			std::unordered_set<std::string> _exchangeIds;
+
+		public:
+			consolidated_book_map(std::unordered_map<std::string, std::string> assetAliases, const std::vector<tradable_pair>& pairs, int publishedDepth);
+
+			// Returns a view of an owned copy of the id, which stays valid for the lifetime of the map
+			std::string_view intern_exchange_id(std::string_view exchangeId);
+			tradable_pair normalise(const tradable_pair& pair) const;
+			consolidated_pair_book* find(const tradable_pair& pair) const;
+		};
+	}
+
+	std::unordered_map<std::string, std::string> default_asset_aliases();
+
+	class consolidated_order_book
+	{
+	private:
+		std::shared_ptr<internal::consolidated_book_map> _books;
+
+		const internal::consolidated_pair_book& get_book(const tradable_pair& pair) const;
+
+	public:
+		consolidated_order_book(
+			std::vector<tradable_pair> pairs,
+			int publishedDepth = 20,
+			std::unordered_map<std::string, std::string> assetAliases = default_asset_aliases());
+
+		void add_stream(std::string_view exchangeId, websocket_stream& stream);
+		void add_exchange(exchange& exchange);
+
+		tradable_pair normalise(const tradable_pair& pair) const;
+		std::shared_ptr<const consolidated_depth> get_depth(const tradable_pair& pair) const;
+		best_bid_offer get_best_bid_offer(const tradable_pair& pair) const;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
+#include <algorithm>
+
 #include "exchange_websocket_stream.h"
 #include "logging/logger.h"
+#include "networking/websocket/websocket_error.h"
 #include "common/utils/containerutils.h"
 
 #include "common/exceptions/not_implemented_exception.h"
@@ -25,11 +28,26 @@ namespace mb
 		_id{ id },
 		_url{ std::move(url) },
 		_pairSeparator{ pairSeparator },
-		_connectionFactory{ std::move(connectionFactory) }
+		_connectionFactory{ std::move(connectionFactory) },
+		_closeRequested{ true },
+		_supervisor{ [this]() { reconnect(); }, [this](const std::string& pairName) { resync_order_book(pairName); } }
 	{
 		initialise_connection_factory();
 	}
 
+	exchange_websocket_stream::~exchange_websocket_stream()
+	{
+		shutdown();
+	}
+
+	void exchange_websocket_stream::shutdown()
+	{
+		// Reconnects and resyncs call back into the derived stream, so they have to
+		// finish before its members are destroyed
+		_closeRequested = true;
+		_supervisor.stop();
+	}
+
 	void exchange_websocket_stream::initialise_connection_factory()
 	{
 		_connectionFactory->set_on_open([this]() { on_open(); });
@@ -37,8 +55,36 @@ namespace mb
 		_connectionFactory->set_on_message([this](std::string_view message) { on_message(message); });
 	}
 
+	std::shared_ptr<websocket_connection> exchange_websocket_stream::connection() const
+	{
+		std::lock_guard<std::mutex> lock{ _connectionMutex };
+		return _connection;
+	}
+
+	std::shared_ptr<websocket_connection> exchange_websocket_stream::replace_connection(std::shared_ptr<websocket_connection> connection)
+	{
+		// The previous connection is handed back so it is closed and destroyed outside of the lock
+		std::lock_guard<std::mutex> lock{ _connectionMutex };
+		_connection.swap(connection);
+
+		return connection;
+	}
+
+	void exchange_websocket_stream::send_message(std::string message)
+	{
+		std::shared_ptr<websocket_connection> current{ connection() };
+		if (!current)
+		{
+			throw websocket_error{ "Cannot send a message before the stream is connected" };
+		}
+
+		current->send_message(std::move(message));
+	}
+
 	void exchange_websocket_stream::clear_subscriptions()
 	{
+		// The sequencer is always locked before the order books, as a resync holds it while it rebuilds a book
+		auto lockedSequencer = _orderBookSequencer.unique_lock();
 		auto lockedTrades = _trades.unique_lock();
 		auto lockedOhlcv = _ohlcv.unique_lock();
 		auto lockedOrderBooks = _orderBooks.unique_lock();
@@ -46,6 +92,68 @@ namespace mb
 		lockedTrades->clear();
 		lockedOhlcv->clear();
 		lockedOrderBooks->clear();
+		lockedSequencer->clear();
+
+		_activeSubscriptions.unique_lock()->clear();
+		_priceScales.unique_lock()->clear();
+	}
+
+	void exchange_websocket_stream::add_active_subscription(const websocket_subscription& subscription)
+	{
+		auto lockedSubscriptions = _activeSubscriptions.unique_lock();
+
+		for (auto& pair : subscription.pair_item())
+		{
+			lockedSubscriptions->emplace(subscription.channel(), pair, subscription.get_parameter());
+		}
+	}
+
+	void exchange_websocket_stream::remove_active_subscription(const websocket_subscription& subscription)
+	{
+		auto lockedSubscriptions = _activeSubscriptions.unique_lock();
+
+		for (auto& pair : subscription.pair_item())
+		{
+			lockedSubscriptions->erase(unique_websocket_subscription{ subscription.channel(), pair, subscription.get_parameter() });
+		}
+	}
+
+	void exchange_websocket_stream::load_price_scale(const tradable_pair& pair, const std::string& pairName)
+	{
+		if (contains(*_priceScales.shared_lock(), pairName))
+		{
+			return;
+		}
+
+		// Looked up outside the lock, as exchanges may need a request to find the tick size
+		int scale = DEFAULT_PRICE_SCALE;
+		try
+		{
+			scale = get_price_scale(pair);
+		}
+		catch (const std::exception& e)
+		{
+			logger::instance().warning("Could not get {0} price scale for exchange '{1}', using {2}: {3}", pairName, _id, scale, e.what());
+		}
+
+		_priceScales.unique_lock()->try_emplace(pairName, scale);
+	}
+
+	tradable_pair exchange_websocket_stream::find_pair(const std::string& pairName) const
+	{
+		// Returned by value so the reader slot is released before handlers run. A handler that subscribes
+		// would otherwise wait on its own read to write the pair map
+		return _pairs.shared_lock()->at(pairName);
+	}
+
+	int exchange_websocket_stream::price_scale(const std::string& pairName) const
+	{
+		auto lockedScales = _priceScales.shared_lock();
+		auto it = lockedScales->find(pairName);
+
+		return it != lockedScales->end()
+			? it->second
+			: DEFAULT_PRICE_SCALE;
 	}
 
 	void exchange_websocket_stream::on_open()
@@ -56,36 +164,112 @@ namespace mb
 	void exchange_websocket_stream::on_close()
 	{
 		logger::instance().info("Websocket stream closed for exchange '{}'", _id);
+
+		if (!_closeRequested)
+		{
+			_supervisor.request_reconnect();
+		}
+	}
+
+	void exchange_websocket_stream::reconnect()
+	{
+		if (_closeRequested)
+		{
+			return;
+		}
+
+		logger::instance().info("Reconnecting websocket stream for exchange '{}'", _id);
+
+		replace_connection(_connectionFactory->create_connection(_url.data()));
+
+		// Sequence numbers restart with the new connection, so every sequenced
+		// book resynchronises from a fresh snapshot on its next update.
+		// Cached books stay readable until their snapshot arrives
+		_orderBookSequencer.unique_lock()->clear();
+
+		resubscribe();
+	}
+
+	void exchange_websocket_stream::resubscribe()
+	{
+		// Pairs are regrouped by channel so each channel is replayed in a single message
+		std::vector<std::pair<unique_websocket_subscription, std::vector<tradable_pair>>> groups;
+
+		{
+			auto lockedSubscriptions = _activeSubscriptions.shared_lock();
+
+			for (auto& subscription : *lockedSubscriptions)
+			{
+				auto it = std::find_if(groups.begin(), groups.end(), [&subscription](const auto& group)
+				{
+					return group.first.channel() == subscription.channel() && group.first.get_parameter() == subscription.get_parameter();
+				});
+
+				if (it == groups.end())
+				{
+					it = groups.insert(groups.end(), std::make_pair(subscription, std::vector<tradable_pair>{}));
+				}
+
+				it->second.push_back(subscription.pair_item());
+			}
+		}
+
+		for (auto& [subscription, pairs] : groups)
+		{
+			send_subscribe(websocket_subscription{ subscription.channel(), std::move(pairs), subscription.get_parameter() });
+		}
 	}
 
 	void exchange_websocket_stream::reset()
 	{
-		if (_connection)
+		if (connection())
 		{
 			disconnect();
 		}
 
-		_connection = _connectionFactory->create_connection(_url.data());
+		replace_connection(_connectionFactory->create_connection(_url.data()));
+		_closeRequested = false;
 	}
 
 	void exchange_websocket_stream::disconnect()
 	{
-		_connection->close();
+		_closeRequested = true;
+		_supervisor.cancel();
+
+		std::shared_ptr<websocket_connection> current{ connection() };
+		if (current)
+		{
+			current->close();
+		}
+
 		clear_subscriptions();
 	}
 
 	ws_connection_status exchange_websocket_stream::connection_status() const
 	{
-		if (!_connection)
+		std::shared_ptr<websocket_connection> current{ connection() };
+		if (!current)
 		{
 			return ws_connection_status::CLOSED;
 		}
 
-		return _connection->connection_status();
+		return current->connection_status();
 	}
 
 	void exchange_websocket_stream::subscribe(const websocket_subscription& subscription)
 	{
+		bool hasNewPairs = false;
+		{
+			auto lockedPairs = _pairs.shared_lock();
+
+			for (auto& pair : subscription.pair_item())
+			{
+				hasNewPairs = hasNewPairs || lockedPairs->find(pair.to_string(_pairSeparator)) == lockedPairs->end();
+			}
+		}
+
+		// Every write copies the pair map, so resubscribing to known pairs skips it
+		if (hasNewPairs)
 		{
 			auto lockedPairs = _pairs.unique_lock();
 
@@ -95,11 +279,13 @@ namespace mb
 			}
 		}
 
+		add_active_subscription(subscription);
 		send_subscribe(subscription);
 	}
 
 	void exchange_websocket_stream::unsubscribe(const websocket_subscription& subscription)
 	{
+		remove_active_subscription(subscription);
 		send_unsubscribe(subscription);
 	}
 
@@ -121,8 +307,9 @@ namespace mb
 		}
 		case websocket_channel::ORDER_BOOK:
 		{
-			auto lockedOrderBooks = _orderBooks.unique_lock();
-			lockedOrderBooks->erase(subscription.pair_item());
+			auto lockedSequencer = _orderBookSequencer.unique_lock();
+			lockedSequencer->remove(subscription.pair_item());
+			_orderBooks.unique_lock()->erase(subscription.pair_item());
 			break;
 		}
 		default:
@@ -139,7 +326,7 @@ namespace mb
 		
 		if (has_trade_update_handler())
 		{
-			fire_trade_update(trade_update_message{ _pairs.shared_lock()->at(pairName), std::move(trade)});
+			fire_trade_update(trade_update_message{ find_pair(pairName), std::move(trade)});
 		}
 	}
 
@@ -152,7 +339,7 @@ namespace mb
 
 		if (has_ohlcv_update_handler())
 		{
-			fire_ohlcv_update(ohlcv_update_message{ _pairs.shared_lock()->at(pairName), interval, std::move(ohlcvData) });
+			fire_ohlcv_update(ohlcv_update_message{ find_pair(pairName), interval, std::move(ohlcvData) });
 		}
 	}
 
@@ -165,27 +352,139 @@ namespace mb
 
 		if (has_order_book_update_handler())
 		{
-			fire_order_book_update(order_book_update_message{ _pairs.shared_lock()->at(pairName), order_book_entry{ 0, 0, order_book_side::ASK } });
+			fire_order_book_update(order_book_update_message{ find_pair(pairName), order_book_entry{ 0, 0, order_book_side::ASK } });
 		}
 	}
 
+	order_book_cache& exchange_websocket_stream::find_or_create_order_book(std::unordered_map<std::string, order_book_cache>& orderBooks, const std::string& pairName) const
+	{
+		auto cacheIt = orderBooks.find(pairName);
+
+		if (cacheIt == orderBooks.end())
+		{
+			cacheIt = orderBooks.emplace(pairName, order_book_cache{ 0, {}, {}, price_scale(pairName) }).first;
+		}
+
+		return cacheIt->second;
+	}
+
 	void exchange_websocket_stream::update_order_book(std::string pairName, std::time_t timeStamp, order_book_entry entry)
 	{
 		{
 			auto lockedOrderBooks = _orderBooks.unique_lock();
+			find_or_create_order_book(*lockedOrderBooks, pairName).update_cache(timeStamp, entry);
+		}
+		
+		if (has_order_book_update_handler())
+		{
+			fire_order_book_update(order_book_update_message{ find_pair(pairName), std::move(entry) });
+		}
+	}
+
+	void exchange_websocket_stream::update_order_book(std::string pairName, std::time_t timeStamp, const order_book_level_update& level)
+	{
+		{
+			auto lockedOrderBooks = _orderBooks.unique_lock();
+			find_or_create_order_book(*lockedOrderBooks, pairName).update_cache(timeStamp, level.side(), level.price(), level.volume());
+		}
 
-			if (!contains(*lockedOrderBooks, pairName))
+		if (has_order_book_update_handler())
+		{
+			fire_order_book_update(order_book_update_message{ find_pair(pairName), order_book_entry{ level.price().to_double(), level.volume(), level.side() } });
+		}
+	}
+
+	void exchange_websocket_stream::update_order_book(std::string pairName, std::time_t timeStamp, std::vector<order_book_level_update> levels)
+	{
+		if (!levels.empty())
+		{
+			apply_order_book_update(pairName, order_book_update_batch{ timeStamp, 0, 0, std::move(levels) });
+		}
+	}
+
+	decimal exchange_websocket_stream::parse_order_book_price(const std::string& pairName, std::string_view price) const
+	{
+		return parse_decimal(price, fitting_scale(price, price_scale(pairName)));
+	}
+
+	void exchange_websocket_stream::update_order_book(std::string pairName, order_book_update_batch update)
+	{
+		auto lockedSequencer = _orderBookSequencer.unique_lock();
+
+		switch (lockedSequencer->process(pairName, update))
+		{
+		case sequence_result::APPLY:
+			apply_order_book_update(pairName, update);
+			break;
+		case sequence_result::SNAPSHOT_REQUIRED:
+			_supervisor.request_resync(std::move(pairName));
+			break;
+		default:
+			break;
+		}
+	}
+
+	void exchange_websocket_stream::apply_order_book_update(const std::string& pairName, const order_book_update_batch& update)
+	{
+		const std::vector<order_book_level_update>& levels{ update.levels() };
+
+		{
+			auto lockedOrderBooks = _orderBooks.unique_lock();
+			order_book_cache& cache{ find_or_create_order_book(*lockedOrderBooks, pairName) };
+
+			for (auto& level : levels)
 			{
-				lockedOrderBooks->insert_or_assign(pairName, order_book_cache{ 0, {}, {} });
+				cache.update_cache(update.time_stamp(), level.side(), level.price(), level.volume());
 			}
-
-			auto cacheIt = lockedOrderBooks->find(pairName);
-			cacheIt->second.update_cache(timeStamp, entry);
 		}
-		
+
 		if (has_order_book_update_handler())
 		{
-			fire_order_book_update(order_book_update_message{ _pairs.shared_lock()->at(pairName), std::move(entry) });
+			tradable_pair pair{ find_pair(pairName) };
+
+			// Handlers that rebuild derived books can wait for the last level instead of rebuilding after each one
+			for (size_t i = 0; i < levels.size(); ++i)
+			{
+				fire_order_book_update(order_book_update_message{ pair, order_book_entry{ levels[i].price().to_double(), levels[i].volume(), levels[i].side() }, i + 1 == levels.size() });
+			}
+		}
+	}
+
+	sequenced_order_book exchange_websocket_stream::fetch_order_book_snapshot(const tradable_pair& pair)
+	{
+		throw not_implemented_exception{ "exchange_websocket_stream::fetch_order_book_snapshot" };
+	}
+
+	int exchange_websocket_stream::get_price_scale(const tradable_pair& pair)
+	{
+		return DEFAULT_PRICE_SCALE;
+	}
+
+	void exchange_websocket_stream::resync_order_book(const std::string& pairName)
+	{
+		tradable_pair pair{ find_pair(pairName) };
+
+		logger::instance().info("Resynchronising {0} order book for exchange '{1}'", pairName, _id);
+
+		// Loaded here rather than on subscribe, as the lookup may block on a request. Updates parsed before
+		// the scale is known are rescaled when they are applied to the book
+		load_price_scale(pair, pairName);
+
+		sequenced_order_book snapshot{ fetch_order_book_snapshot(pair) };
+
+		// Holding the sequencer lock keeps live updates from landing between the snapshot and the buffered updates
+		auto lockedSequencer = _orderBookSequencer.unique_lock();
+
+		initialise_order_book(pairName, from_snapshot(snapshot.state(), price_scale(pairName)));
+
+		for (auto& update : lockedSequencer->synchronise(pairName, snapshot.sequence()))
+		{
+			apply_order_book_update(pairName, update);
+		}
+
+		if (!lockedSequencer->is_synchronised(pairName))
+		{
+			_supervisor.request_resync(pairName);
 		}
 	}
 
@@ -233,6 +532,17 @@ namespace mb
 		return order_book_state{ 0, {}, {} };
 	}
 
+	void exchange_websocket_stream::walk_order_book(const tradable_pair& pair, order_book_side side, const order_book_visitor& visitor) const
+	{
+		auto lockedOrderBooks = _orderBooks.shared_lock();
+		auto it = lockedOrderBooks->find(pair.to_string(_pairSeparator));
+
+		if (it != lockedOrderBooks->end())
+		{
+			it->second.walk(side, visitor);
+		}
+	}
+
 	trade_update exchange_websocket_stream::get_last_trade(const tradable_pair& pair) const
 	{
 		auto lockedTrades = _trades.shared_lock();
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "websocket_stream.h"
+#include "websocket_supervisor.h"
 #include "order_book_cache.h"
+#include "order_book_sequencer.h"
 #include "common/types/concurrent_wrapper.h"
+#include "common/types/read_mostly_wrapper.h"
 
 #include "common/exceptions/not_implemented_exception.h"
 
@@ -22,26 +28,53 @@ namespace mb
 		concurrent_wrapper<std::unordered_map<std::string, trade_update>> _trades;
 		concurrent_wrapper<std::unordered_map<std::string, ohlcv_data>> _ohlcv;
 		concurrent_wrapper<std::unordered_map<std::string, order_book_cache>> _orderBooks;
+		concurrent_wrapper<std::unordered_set<unique_websocket_subscription>> _activeSubscriptions;
+		concurrent_wrapper<order_book_sequencer> _orderBookSequencer;
+		concurrent_wrapper<std::unordered_map<std::string, int>> _priceScales;
+		std::atomic<bool> _closeRequested;
+		std::shared_ptr<websocket_connection> _connection;
+		mutable std::mutex _connectionMutex;
+		websocket_supervisor _supervisor;
 
 		void initialise_connection_factory();
+		std::shared_ptr<websocket_connection> connection() const;
+		std::shared_ptr<websocket_connection> replace_connection(std::shared_ptr<websocket_connection> connection);
 		void clear_subscriptions();
+		void add_active_subscription(const websocket_subscription& subscription);
+		void remove_active_subscription(const websocket_subscription& subscription);
+		void load_price_scale(const tradable_pair& pair, const std::string& pairName);
+		tradable_pair find_pair(const std::string& pairName) const;
+		int price_scale(const std::string& pairName) const;
+		order_book_cache& find_or_create_order_book(std::unordered_map<std::string, order_book_cache>& orderBooks, const std::string& pairName) const;
 
 		void on_open();
 		void on_close();
+		void reconnect();
+		void resubscribe();
+		void resync_order_book(const std::string& pairName);
+		void apply_order_book_update(const std::string& pairName, const order_book_update_batch& update);
 
 		virtual void on_message(std::string_view message) = 0;
 		virtual void send_subscribe(const websocket_subscription& subscription) = 0;
 		virtual void send_unsubscribe(const websocket_subscription& subscription) = 0;
 
 	protected:
-		concurrent_wrapper<std::unordered_map<std::string, tradable_pair>> _pairs;
-		std::unique_ptr<websocket_connection> _connection;
+		read_mostly_wrapper<std::unordered_map<std::string, tradable_pair>> _pairs;
 
+		void shutdown();
+		void send_message(std::string message);
 		void set_unsubscribed(const named_subscription& subscription);
 		void update_trade(std::string pairName, trade_update trade);
 		void update_ohlcv(std::string pairName, ohlcv_interval interval, ohlcv_data ohlcvData);
 		void initialise_order_book(std::string pairName, order_book_cache cache);
 		void update_order_book(std::string pairName, std::time_t timeStamp, order_book_entry entry);
+		void update_order_book(std::string pairName, std::time_t timeStamp, const order_book_level_update& level);
+		void update_order_book(std::string pairName, std::time_t timeStamp, std::vector<order_book_level_update> levels);
+		void update_order_book(std::string pairName, order_book_update_batch update);
+		decimal parse_order_book_price(const std::string& pairName, std::string_view price) const;
+
+		virtual sequenced_order_book fetch_order_book_snapshot(const tradable_pair& pair);
+		virtual int get_price_scale(const tradable_pair& pair);
 
 	public:
 		exchange_websocket_stream(
@@ -50,7 +83,7 @@ namespace mb
 			char pairSeparator,
 			std::unique_ptr<websocket_connection_factory> connectionFactory);
 
-		virtual ~exchange_websocket_stream() = default;
+		virtual ~exchange_websocket_stream();
 
 		std::string_view id() const noexcept { return _id; }
 
@@ -58,11 +91,15 @@ namespace mb
 		void disconnect() override;
 		ws_connection_status connection_status() const override;
 
+		size_t reconnect_count() const noexcept { return _supervisor.reconnect_count(); }
+		size_t order_book_gap_count() const { return _orderBookSequencer.shared_lock()->gap_count(); }
+
 		void subscribe(const websocket_subscription& subscription) override;
 		void unsubscribe(const websocket_subscription& subscription) override;
 		subscription_status get_subscription_status(const unique_websocket_subscription& subscription) const override;
 
 		order_book_state get_order_book(const tradable_pair& pair, int depth = 0) const override;
+		void walk_order_book(const tradable_pair& pair, order_book_side side, const order_book_visitor& visitor) const override;
 		trade_update get_last_trade(const tradable_pair& pair) const override;
 		ohlcv_data get_last_candle(const tradable_pair& pair, ohlcv_interval interval) const override;
 	};
@@ -73,4 +110,4 @@ namespace mb
 		return std::make_unique<Implementation>(
 			std::make_unique<websocket_connection_factory>());
 	}
-}
+}
\ No newline at end of file
@@ -1,19 +1,81 @@
+#include <future>
+
 #include "ohlcv_subscription_service.h"
+#include "common/types/task_executor.h"
 #include "common/utils/containerutils.h"
 
+namespace
+{
+	using namespace mb;
+
+	ohlcv_data get_latest_ohlcv(const market_api& marketApi, const tradable_pair& pair, ohlcv_interval interval)
+	{
+		std::vector<ohlcv_data> ohlcvData{ marketApi.get_ohlcv(pair, interval, 1) };
+		return ohlcvData.empty() ? ohlcv_data{} : ohlcvData.front();
+	}
+}
+
 namespace mb
 {
 	ohlcv_subscription_service::ohlcv_subscription_service(std::unique_ptr<market_api> marketApi, update_ohlcv_function updateOhlcv, char pairSeparator)
 		: 
+		_pairIds{},
+		_pairNames{},
+		_candles{},
 		_marketApi{ std::move(marketApi) },
 		_updateOhlcv{ std::move(updateOhlcv) },
-		_pairSeparator{ pairSeparator },
-		_subscriptions{}
+		_pairSeparator{ pairSeparator }
 	{}
 
+	size_t ohlcv_subscription_service::intern_pair(std::string pairName)
+	{
+		auto it = _pairIds.find(pairName);
+
+		if (it != _pairIds.end())
+		{
+			return it->second;
+		}
+
+		size_t pairId = _candles.size();
+
+		_pairIds.emplace(pairName, pairId);
+		_pairNames.emplace_back(std::move(pairName));
+		_candles.emplace_back();
+
+		return pairId;
+	}
+
+	std::vector<ohlcv_data> ohlcv_subscription_service::fetch_seed_candles(const std::vector<tradable_pair>& pairs, ohlcv_interval interval) const
+	{
+		if (pairs.size() == 1)
+		{
+			return { get_latest_ohlcv(*_marketApi, pairs.front(), interval) };
+		}
+
+		std::vector<std::future<ohlcv_data>> futures;
+		futures.reserve(pairs.size());
+
+		for (auto& pair : pairs)
+		{
+			futures.emplace_back(task_executor::instance().submit([this, &pair, interval]() { return get_latest_ohlcv(*_marketApi, pair, interval); }));
+		}
+
+		std::vector<ohlcv_data> seedCandles;
+		seedCandles.reserve(pairs.size());
+
+		for (auto& future : futures)
+		{
+			seedCandles.emplace_back(future.get());
+		}
+
+		return seedCandles;
+	}
+
 	bool ohlcv_subscription_service::is_subscribed(std::string_view pairName) const
 	{
-		return contains(_subscriptions, pairName.data());
+		auto it = _pairIds.find(std::string{ pairName });
+
+		return it != _pairIds.end() && !_candles[it->second].empty();
 	}
 
 	void ohlcv_subscription_service::add_subscription(const websocket_subscription& subscription)
@@ -21,50 +83,50 @@ namespace mb
 		ohlcv_interval ohlcvInterval{ subscription.get_ohlcv_interval() };
 		int interval{ to_seconds(ohlcvInterval) };
 
-		for (auto& pair : subscription.pair_item())
-		{
-			std::vector<ohlcv_data> ohlcvData{ _marketApi->get_ohlcv(pair, ohlcvInterval, 1) };
-			ohlcv_data latestOhlcv{ ohlcvData.empty() ? ohlcv_data{} : ohlcvData.front() };
+		const std::vector<tradable_pair>& pairs{ subscription.pair_item() };
+		std::vector<ohlcv_data> seedCandles{ fetch_seed_candles(pairs, ohlcvInterval) };
 
-			std::string pairName{ pair.to_string(_pairSeparator) };
+		for (size_t i = 0; i < pairs.size(); ++i)
+		{
+			std::string pairName{ pairs[i].to_string(_pairSeparator) };
+			size_t pairId{ intern_pair(pairName) };
 
-			_subscriptions[pairName].emplace(ohlcvInterval, ohlcv_from_trades{ latestOhlcv, interval });
-			_updateOhlcv(std::move(pairName), ohlcvInterval, std::move(latestOhlcv));
+			_candles[pairId].add_interval(interval, seedCandles[i]);
+			_updateOhlcv(std::move(pairName), ohlcvInterval, std::move(seedCandles[i]));
 		}
 	}
 
 	void ohlcv_subscription_service::remove_subscription(const websocket_subscription& subscription)
 	{
-		ohlcv_interval interval{ subscription.get_ohlcv_interval() };
+		int interval{ to_seconds(subscription.get_ohlcv_interval()) };
 
 		for (auto& pair : subscription.pair_item())
 		{
-			std::string pairName{ pair.to_string(_pairSeparator) };
-			
-			_subscriptions[pairName].erase(interval);
-			
-			if (_subscriptions[pairName].empty())
+			auto it = _pairIds.find(pair.to_string(_pairSeparator));
+
+			if (it != _pairIds.end())
 			{
-				_subscriptions.erase(pairName);
+				_candles[it->second].remove_interval(interval);
 			}
 		}
 	}
 
 	void ohlcv_subscription_service::update_ohlcv(std::string_view pairName, std::time_t time, double price, double volume)
 	{
-		auto it = _subscriptions.find(pairName.data());
+		auto it = _pairIds.find(std::string{ pairName });
 
-		if (it == _subscriptions.end())
+		if (it == _pairIds.end() || _candles[it->second].empty())
 		{
 			throw mb_exception{ fmt::format("OHLCV is not subscribed for pair {}", pairName) };
 		}
 
-		std::unordered_map<ohlcv_interval, ohlcv_from_trades>& ohlcvFromTrades{ it->second };
+		size_t pairId{ it->second };
+		multi_interval_candle& candle{ _candles[pairId] };
 
-		for (auto& [interval, oft] : ohlcvFromTrades)
+		candle.add_trade(time, price, volume);
+		candle.visit(time, [this, pairId](int interval, ohlcv_data ohlcv)
 		{
-			oft.add_trade(time, price, volume);
-			_updateOhlcv(std::string{ pairName }, interval, oft.get_ohlcv(time));
-		}
+			_updateOhlcv(_pairNames[pairId], from_seconds(interval), std::move(ohlcv));
+		});
 	}
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include <functional>
 
 #include "exchanges/exchange.h"
-#include "trading/ohlcv_from_trades.h"
+#include "trading/multi_interval_candle.h"
 
 namespace mb
 {
@@ -13,11 +13,16 @@ namespace mb
 	private:
 		using update_ohlcv_function = std::function<void(std::string, ohlcv_interval, ohlcv_data)>;
 
-		std::unordered_map<std::string,std::unordered_map<ohlcv_interval, ohlcv_from_trades>> _subscriptions;
+		std::unordered_map<std::string, size_t> _pairIds;
+		std::vector<std::string> _pairNames;
+		std::vector<multi_interval_candle> _candles;
 		std::unique_ptr<market_api> _marketApi;
 		update_ohlcv_function _updateOhlcv;
 		char _pairSeparator;
 
+		size_t intern_pair(std::string pairName);
+		std::vector<ohlcv_data> fetch_seed_candles(const std::vector<tradable_pair>& pairs, ohlcv_interval interval) const;
+
 	public:
 		ohlcv_subscription_service(std::unique_ptr<market_api> marketApi, update_ohlcv_function updateOhlcv, char pairSeparator);
 
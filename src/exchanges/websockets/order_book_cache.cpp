@@ -1,54 +1,138 @@
 #include "order_book_cache.h"
 #include "common/utils/containerutils.h"
-#include "common/utils/mathutils.h"
+#include "logging/logger.h"
 
 namespace
 {
 	using namespace mb;
 
-	template<typename Cache>
-	void update_cache(Cache& cache, order_book_entry entry)
+	template<typename Levels>
+	void walk_levels(const Levels& levels, const order_book_visitor& visitor)
 	{
-		auto it = cache.find(entry);
-
-		if (it != cache.end())
+		for (auto& [key, entry] : levels)
 		{
-			cache.erase(it);
+			if (!visitor(entry))
+			{
+				return;
+			}
 		}
+	}
 
+	template<typename Levels>
+	void update_level(Levels& levels, std::int64_t key, order_book_entry entry)
+	{
 		if (entry.volume() > 0.0)
 		{
-			cache.insert(std::move(entry));
+			levels.insert_or_assign(key, std::move(entry));
+		}
+		else
+		{
+			levels.erase(key);
+		}
+	}
+
+	template<typename Levels>
+	void add_levels(Levels& levels, const std::vector<order_book_entry>& entries, int priceScale)
+	{
+		for (auto& entry : entries)
+		{
+			update_level(levels, decimal::from_double(entry.price(), priceScale).mantissa(), entry);
+		}
+	}
+
+	template<typename Levels>
+	Levels rescale_levels(const Levels& levels, int fromScale, int toScale)
+	{
+		Levels rescaled;
+
+		for (auto& [key, entry] : levels)
+		{
+			rescaled.insert_or_assign(decimal{ key, fromScale }.rescale(toScale).mantissa(), entry);
+		}
+
+		return rescaled;
+	}
+
+	template<typename Levels>
+	std::vector<order_book_entry> copy_levels(const Levels& levels, int depth)
+	{
+		std::vector<order_book_entry> entries;
+		entries.reserve(std::min(static_cast<int>(levels.size()), depth));
+
+		for (auto it = levels.begin(); it != levels.end() && static_cast<int>(entries.size()) < depth; ++it)
+		{
+			entries.push_back(it->second);
 		}
+
+		return entries;
 	}
 }
 
 namespace mb
 {
-	namespace internal
+	order_book_cache::order_book_cache(std::time_t timeStamp, const std::vector<order_book_entry>& asks, const std::vector<order_book_entry>& bids, int priceScale)
+		: _lastUpdate{ timeStamp }, _priceScale{ priceScale }, _asks{}, _bids{}
 	{
-		bool entry_less_than::operator()(const order_book_entry& l, const order_book_entry& r) const
+		// Validates the scale up front rather than on the first update
+		power_of_ten(priceScale);
+
+		// Fitting every price while the levels are still empty keys the whole book without rescaling it
+		for (auto& entry : asks)
+		{
+			fit_price_scale(entry.price());
+		}
+
+		for (auto& entry : bids)
 		{
-			return double_less_than(l.price(), r.price());
+			fit_price_scale(entry.price());
 		}
 
-		bool entry_greater_than::operator()(const order_book_entry& l, const order_book_entry& r) const
+		add_levels(_asks, asks, _priceScale);
+		add_levels(_bids, bids, _priceScale);
+	}
+
+	void order_book_cache::fit_price_scale(double price)
+	{
+		int scale = fitting_scale(price, _priceScale);
+		if (scale == _priceScale)
 		{
-			return double_greater_than(l.price(), r.price());
+			return;
 		}
+
+		// A price too large for the tick size coarsens the whole book rather than failing the stream
+		logger::instance().warning("Order book price {0} does not fit at scale {1}, reducing scale to {2}", price, _priceScale, scale);
+
+		_asks = rescale_levels(_asks, _priceScale, scale);
+		_bids = rescale_levels(_bids, _priceScale, scale);
+		_priceScale = scale;
 	}
 
-	order_book_cache::order_book_cache(std::time_t timeStamp, ask_cache asks, bid_cache bids)
-		: _lastUpdate{ timeStamp }, _asks{ std::move(asks) }, _bids{std::move(bids)}
-	{}
+	std::int64_t order_book_cache::price_key(double price)
+	{
+		fit_price_scale(price);
+		return decimal::from_double(price, _priceScale).mantissa();
+	}
 
 	void order_book_cache::update_cache(std::time_t timeStamp, order_book_entry entry)
 	{
 		_lastUpdate = timeStamp;
+		std::int64_t key = price_key(entry.price());
 
 		entry.side() == order_book_side::ASK
-			? ::update_cache(_asks, std::move(entry))
-			: ::update_cache(_bids, std::move(entry));
+			? update_level(_asks, key, std::move(entry))
+			: update_level(_bids, key, std::move(entry));
+	}
+
+	void order_book_cache::update_cache(std::time_t timeStamp, order_book_side side, decimal price, double volume)
+	{
+		_lastUpdate = timeStamp;
+		fit_price_scale(price.to_double());
+		decimal scaledPrice{ price.rescale(_priceScale) };
+		order_book_entry entry{ scaledPrice.to_double(), volume, side };
+
+		side == order_book_side::ASK
+			? update_level(_asks, scaledPrice.mantissa(), std::move(entry))
+			: update_level(_bids, scaledPrice.mantissa(), std::move(entry));
 	}
 
 	order_book_state order_book_cache::snapshot(int depth) const
@@ -58,27 +142,23 @@ namespace mb
 			depth = std::max(_asks.size(), _bids.size());
 		}
 
-		int askDepth = std::min(static_cast<int>(_asks.size()), depth);
-		std::vector<order_book_entry> asks{ _asks.begin(), std::next(_asks.begin(), askDepth) };
-
-		int bidDepth = std::min(static_cast<int>(_bids.size()), depth);
-		std::vector<order_book_entry> bids{ _bids.begin(), std::next(_bids.begin(), bidDepth) };
-
 		return order_book_state
 		{
 			_lastUpdate,
-			std::move(asks),
-			std::move(bids)
+			copy_levels(_asks, depth),
+			copy_levels(_bids, depth)
 		};
 	}
 
-	order_book_cache from_snapshot(const order_book_state& snapshot)
+	void order_book_cache::walk(order_book_side side, const order_book_visitor& visitor) const
 	{
-		return order_book_cache
-		{
-			snapshot.time_stamp(),
-			ask_cache{ snapshot.asks().begin(), snapshot.asks().end() },
-			bid_cache{ snapshot.bids().begin(), snapshot.bids().end() }
-		};
+		side == order_book_side::ASK
+			? walk_levels(_asks, visitor)
+			: walk_levels(_bids, visitor);
+	}
+
+	order_book_cache from_snapshot(const order_book_state& snapshot, int priceScale)
+	{
+		return order_book_cache{ snapshot.time_stamp(), snapshot.asks(), snapshot.bids(), priceScale };
 	}
 }
\ No newline at end of file
@@ -1,43 +1,43 @@
 
 #pragma once
 
+#include <map>
 #include <mutex>
-#include <set>
+#include <vector>
 
+#include "trading/decimal.h"
 #include "trading/order_book.h"
 #include "common/utils/stringutils.h"
 
 namespace mb
 {
-	namespace internal
-	{
-		struct entry_less_than
-		{
-			bool operator()(const order_book_entry& l, const order_book_entry& r) const;
-		};
-
-		struct entry_greater_than
-		{
-			bool operator()(const order_book_entry& l, const order_book_entry& r) const;
-		};
-	}
-	
-	using ask_cache = std::set<order_book_entry, internal::entry_less_than>;
-	using bid_cache = std::set<order_book_entry, internal::entry_greater_than>;
+	// Levels are keyed by price in ticks of 10^-scale, so lookups are exact integer comparisons
+	using ask_levels = std::map<std::int64_t, order_book_entry>;
+	using bid_levels = std::map<std::int64_t, order_book_entry, std::greater<std::int64_t>>;
+
+	constexpr int DEFAULT_PRICE_SCALE = 10;
 
 	class order_book_cache
 	{
 	private:
 		std::time_t _lastUpdate;
-		ask_cache _asks;
-		bid_cache _bids;
+		int _priceScale;
+		ask_levels _asks;
+		bid_levels _bids;
+
+		void fit_price_scale(double price);
+		std::int64_t price_key(double price);
 
 	public:
-		order_book_cache(std::time_t timeStamp, ask_cache asks, bid_cache bids);
+		order_book_cache(std::time_t timeStamp, const std::vector<order_book_entry>& asks, const std::vector<order_book_entry>& bids, int priceScale = DEFAULT_PRICE_SCALE);
+
+		int price_scale() const noexcept { return _priceScale; }
 
 		void update_cache(std::time_t timeStamp, order_book_entry entry);
+		void update_cache(std::time_t timeStamp, order_book_side side, decimal price, double volume);
 		order_book_state snapshot(int depth = 0) const;
+		void walk(order_book_side side, const order_book_visitor& visitor) const;
 	};
 
-	order_book_cache from_snapshot(const order_book_state& snapshot);
+	order_book_cache from_snapshot(const order_book_state& snapshot, int priceScale = DEFAULT_PRICE_SCALE);
 }
\ No newline at end of file
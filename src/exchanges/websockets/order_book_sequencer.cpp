@@ -0,0 +1,108 @@
+#include "order_book_sequencer.h"
+
+namespace mb
+{
+	order_book_sequencer::order_book_sequencer(size_t maxPendingUpdates)
+		: _books{}, _maxPendingUpdates{ maxPendingUpdates }, _gapCount{ 0 }
+	{}
+
+	void order_book_sequencer::buffer(book_sequence& book, order_book_update_batch update, size_t maxPendingUpdates)
+	{
+		// Only the newest updates can follow the snapshot that is on its way
+		if (book.pendingUpdates.size() >= maxPendingUpdates)
+		{
+			book.pendingUpdates.erase(book.pendingUpdates.begin());
+		}
+
+		book.pendingUpdates.emplace_back(std::move(update));
+	}
+
+	sequence_result order_book_sequencer::process(const std::string& pairName, order_book_update_batch& update)
+	{
+		auto [it, inserted] = _books.try_emplace(pairName);
+		book_sequence& book{ it->second };
+
+		if (!book.synchronised)
+		{
+			buffer(book, std::move(update), _maxPendingUpdates);
+
+			return inserted
+				? sequence_result::SNAPSHOT_REQUIRED
+				: sequence_result::BUFFERED;
+		}
+
+		if (update.last_sequence() <= book.lastSequence)
+		{
+			return sequence_result::STALE;
+		}
+
+		if (update.first_sequence() > book.lastSequence + 1)
+		{
+			++_gapCount;
+			book.synchronised = false;
+			buffer(book, std::move(update), _maxPendingUpdates);
+
+			return sequence_result::SNAPSHOT_REQUIRED;
+		}
+
+		book.lastSequence = update.last_sequence();
+		return sequence_result::APPLY;
+	}
+
+	std::vector<order_book_update_batch> order_book_sequencer::synchronise(const std::string& pairName, long long snapshotSequence)
+	{
+		book_sequence& book{ _books[pairName] };
+
+		book.lastSequence = snapshotSequence;
+		book.synchronised = true;
+
+		std::vector<order_book_update_batch> pendingUpdates{ std::move(book.pendingUpdates) };
+		book.pendingUpdates.clear();
+
+		std::vector<order_book_update_batch> updates;
+		updates.reserve(pendingUpdates.size());
+
+		for (auto& update : pendingUpdates)
+		{
+			if (!book.synchronised)
+			{
+				book.pendingUpdates.emplace_back(std::move(update));
+				continue;
+			}
+
+			if (update.last_sequence() <= book.lastSequence)
+			{
+				continue;
+			}
+
+			if (update.first_sequence() > book.lastSequence + 1)
+			{
+				++_gapCount;
+				book.synchronised = false;
+				book.pendingUpdates.emplace_back(std::move(update));
+				continue;
+			}
+
+			book.lastSequence = update.last_sequence();
+			updates.emplace_back(std::move(update));
+		}
+
+		return updates;
+	}
+
+	bool order_book_sequencer::is_synchronised(const std::string& pairName) const
+	{
+		auto it = _books.find(pairName);
+		return it != _books.end() && it->second.synchronised;
+	}
+
+	void order_book_sequencer::remove(const std::string& pairName)
+	{
+		_books.erase(pairName);
+	}
+
+	void order_book_sequencer::clear()
+	{
+		_books.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trading/decimal.h"
+#include "trading/order_book.h"
+
+namespace mb
+{
+	// A change to one price level, with the price kept exactly as the exchange quoted it
+	class order_book_level_update
+	{
+	private:
+		order_book_side _side;
+		decimal _price;
+		double _volume;
+
+	public:
+		order_book_level_update(order_book_side side, decimal price, double volume)
+			: _side{ side }, _price{ price }, _volume{ volume }
+		{}
+
+		order_book_side side() const noexcept { return _side; }
+		const decimal& price() const noexcept { return _price; }
+		double volume() const noexcept { return _volume; }
+	};
+
+	class order_book_update_batch
+	{
+	private:
+		std::time_t _timeStamp;
+		long long _firstSequence;
+		long long _lastSequence;
+		std::vector<order_book_level_update> _levels;
+
+	public:
+		order_book_update_batch(std::time_t timeStamp, long long firstSequence, long long lastSequence, std::vector<order_book_level_update> levels)
+			:
+			_timeStamp{ timeStamp },
+			_firstSequence{ firstSequence },
+			_lastSequence{ lastSequence },
+			_levels{ std::move(levels) }
+		{}
+
+		std::time_t time_stamp() const noexcept { return _timeStamp; }
+		long long first_sequence() const noexcept { return _firstSequence; }
+		long long last_sequence() const noexcept { return _lastSequence; }
+		const std::vector<order_book_level_update>& levels() const noexcept { return _levels; }
+	};
+
+	class sequenced_order_book
+	{
+	private:
+		order_book_state _state;
+		long long _sequence;
+
+	public:
+		sequenced_order_book(order_book_state state, long long sequence)
+			: _state{ std::move(state) }, _sequence{ sequence }
+		{}
+
+		const order_book_state& state() const noexcept { return _state; }
+		long long sequence() const noexcept { return _sequence; }
+	};
+
+	enum class sequence_result
+	{
+		APPLY,
+		STALE,
+		BUFFERED,
+		SNAPSHOT_REQUIRED
+	};
+
+	class order_book_sequencer
+	{
+	private:
+		struct book_sequence
+		{
+			long long lastSequence = 0;
+			bool synchronised = false;
+			std::vector<order_book_update_batch> pendingUpdates;
+		};
+
+		std::unordered_map<std::string, book_sequence> _books;
+		size_t _maxPendingUpdates;
+		size_t _gapCount;
+
+		static void buffer(book_sequence& book, order_book_update_batch update, size_t maxPendingUpdates);
+
+	public:
+		explicit order_book_sequencer(size_t maxPendingUpdates = 1000);
+
+		sequence_result process(const std::string& pairName, order_book_update_batch& update);
+		std::vector<order_book_update_batch> synchronise(const std::string& pairName, long long snapshotSequence);
+
+		bool is_synchronised(const std::string& pairName) const;
+		void remove(const std::string& pairName);
+		void clear();
+
+		size_t gap_count() const noexcept { return _gapCount; }
+	};
+}
\ No newline at end of file
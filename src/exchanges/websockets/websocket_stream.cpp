@@ -2,10 +2,14 @@
 
 namespace
 {
+	using namespace mb;
+
 	template<typename Handler, typename Message>
-	void fire_handlers(std::vector<Handler>& handlers, Message message)
+	void fire_handlers(const read_mostly_wrapper<std::vector<Handler>>& handlers, Message message)
 	{
-		for (auto& handler : handlers)
+		auto lockedHandlers = handlers.shared_lock();
+
+		for (auto& handler : *lockedHandlers)
 		{
 			handler(message);
 		}
@@ -16,32 +20,46 @@ namespace mb
 {
 	void websocket_stream::add_trade_update_handler(trade_update_handler handler)
 	{
-		_tradeUpdateHandlers.emplace_back(std::move(handler));
+		_tradeUpdateHandlers.unique_lock()->emplace_back(std::move(handler));
 	}
 
 	void websocket_stream::add_ohlcv_update_handler(ohlcv_update_handler handler)
 	{
-		_ohlcvUpdateHandlers.emplace_back(std::move(handler));
+		_ohlcvUpdateHandlers.unique_lock()->emplace_back(std::move(handler));
 	}
 
 	void websocket_stream::add_order_book_update_handler(order_book_update_handler handler)
 	{
-		_orderBookUpdateHandlers.emplace_back(std::move(handler));
+		_orderBookUpdateHandlers.unique_lock()->emplace_back(std::move(handler));
+	}
+
+	void websocket_stream::walk_order_book(const tradable_pair& pair, order_book_side side, const order_book_visitor& visitor) const
+	{
+		order_book_state orderBook{ get_order_book(pair) };
+		const std::vector<order_book_entry>& entries{ side == order_book_side::ASK ? orderBook.asks() : orderBook.bids() };
+
+		for (auto& entry : entries)
+		{
+			if (!visitor(entry))
+			{
+				return;
+			}
+		}
 	}
 
 	bool websocket_stream::has_trade_update_handler()
 	{
-		return !_tradeUpdateHandlers.empty();
+		return !_tradeUpdateHandlers.shared_lock()->empty();
 	}
 
 	bool websocket_stream::has_ohlcv_update_handler()
 	{
-		return !_ohlcvUpdateHandlers.empty();
+		return !_ohlcvUpdateHandlers.shared_lock()->empty();
 	}
 
 	bool websocket_stream::has_order_book_update_handler()
 	{
-		return !_orderBookUpdateHandlers.empty();
+		return !_orderBookUpdateHandlers.shared_lock()->empty();
 	}
 
 	void websocket_stream::fire_trade_update(trade_update_message message)
@@ -7,7 +7,7 @@
 #include "trading/order_book.h"
 #include "trading/ohlcv_data.h"
 #include "trading/trade_update.h"
-#include "common/types/set_queue.h"
+#include "common/types/read_mostly_wrapper.h"
 
 namespace mb
 {
@@ -29,6 +29,7 @@ namespace mb
 		virtual subscription_status get_subscription_status(const unique_websocket_subscription& subscription) const = 0;
 
 		virtual order_book_state get_order_book(const tradable_pair& pair, int depth = 0) const = 0;
+		virtual void walk_order_book(const tradable_pair& pair, order_book_side side, const order_book_visitor& visitor) const;
 		virtual trade_update get_last_trade(const tradable_pair& pair) const = 0;
 		virtual ohlcv_data get_last_candle(const tradable_pair& pair, ohlcv_interval interval) const = 0;
 
@@ -46,8 +47,10 @@ namespace mb
 		void fire_order_book_update(order_book_update_message message);
 
 	private:
-		std::vector<trade_update_handler> _tradeUpdateHandlers;
-		std::vector<ohlcv_update_handler> _ohlcvUpdateHandlers;
-		std::vector<order_book_update_handler> _orderBookUpdateHandlers;
+		// Handlers can be added while updates are being fired from the connection's thread, so the lists are
+		// shared. A handler must not add another handler to the stream that is firing it
+		read_mostly_wrapper<std::vector<trade_update_handler>> _tradeUpdateHandlers;
+		read_mostly_wrapper<std::vector<ohlcv_update_handler>> _ohlcvUpdateHandlers;
+		read_mostly_wrapper<std::vector<order_book_update_handler>> _orderBookUpdateHandlers;
 	};
 }
\ No newline at end of file
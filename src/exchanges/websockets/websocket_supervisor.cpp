@@ -0,0 +1,186 @@
+#include <algorithm>
+
+#include "websocket_supervisor.h"
+#include "common/utils/retry.h"
+#include "logging/logger.h"
+
+namespace mb
+{
+	websocket_supervisor::websocket_supervisor(
+		reconnect_function reconnect,
+		resync_function resync,
+		std::chrono::milliseconds baseDelay,
+		std::chrono::milliseconds maxDelay)
+		:
+		_reconnect{ std::move(reconnect) },
+		_resync{ std::move(resync) },
+		_baseDelay{ baseDelay },
+		_maxDelay{ maxDelay },
+		_stopping{ false },
+		_reconnectPending{ false },
+		_reconnectAttempt{ 0 },
+		_randomEngine{ std::random_device{}() },
+		_reconnectCount{ 0 }
+	{}
+
+	websocket_supervisor::~websocket_supervisor()
+	{
+		stop();
+	}
+
+	void websocket_supervisor::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+			_stopping = true;
+		}
+
+		_condition.notify_all();
+
+		if (!_thread.joinable())
+		{
+			return;
+		}
+
+		// A callback that tears down its own stream cannot wait for itself, the thread exits once it returns
+		_thread.get_id() == std::this_thread::get_id()
+			? _thread.detach()
+			: _thread.join();
+	}
+
+	void websocket_supervisor::ensure_started()
+	{
+		// The thread is only needed once something has gone wrong, so idle streams never start one
+		if (!_thread.joinable())
+		{
+			_thread = std::thread{ &websocket_supervisor::run, this };
+		}
+	}
+
+	void websocket_supervisor::request_reconnect()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+
+			if (_stopping)
+			{
+				return;
+			}
+
+			_reconnectPending = true;
+			ensure_started();
+		}
+
+		_condition.notify_all();
+	}
+
+	void websocket_supervisor::request_resync(std::string pairName)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+
+			if (_stopping || std::find(_resyncQueue.begin(), _resyncQueue.end(), pairName) != _resyncQueue.end())
+			{
+				return;
+			}
+
+			_resyncQueue.emplace_back(std::move(pairName));
+			ensure_started();
+		}
+
+		_condition.notify_all();
+	}
+
+	void websocket_supervisor::cancel()
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+
+		_reconnectPending = false;
+		_reconnectAttempt = 0;
+		_resyncQueue.clear();
+		_resyncAttempts.clear();
+	}
+
+	bool websocket_supervisor::wait_for_backoff(std::unique_lock<std::mutex>& lock, int attempt)
+	{
+		std::chrono::milliseconds delay{ jittered_backoff(_baseDelay, _maxDelay, attempt, _randomEngine) };
+		return !_condition.wait_for(lock, delay, [this]() { return _stopping; });
+	}
+
+	void websocket_supervisor::run()
+	{
+		logger& log{ logger::instance() };
+		std::unique_lock<std::mutex> lock{ _mutex };
+
+		while (true)
+		{
+			_condition.wait(lock, [this]() { return _stopping || _reconnectPending || !_resyncQueue.empty(); });
+
+			if (_stopping)
+			{
+				return;
+			}
+
+			if (_reconnectPending)
+			{
+				if (!wait_for_backoff(lock, _reconnectAttempt))
+				{
+					return;
+				}
+
+				if (!_reconnectPending)
+				{
+					continue;
+				}
+
+				_reconnectPending = false;
+				lock.unlock();
+
+				try
+				{
+					_reconnect();
+					++_reconnectCount;
+
+					lock.lock();
+					_reconnectAttempt = 0;
+				}
+				catch (const std::exception& e)
+				{
+					log.warning("Websocket reconnect failed: {}", e.what());
+
+					lock.lock();
+					_reconnectPending = true;
+					++_reconnectAttempt;
+				}
+
+				continue;
+			}
+
+			std::string pairName{ std::move(_resyncQueue.front()) };
+			_resyncQueue.pop_front();
+			lock.unlock();
+
+			try
+			{
+				_resync(pairName);
+
+				lock.lock();
+				_resyncAttempts.erase(pairName);
+			}
+			catch (const std::exception& e)
+			{
+				log.warning("Order book resync failed for {0}: {1}", pairName, e.what());
+
+				lock.lock();
+				int attempt = _resyncAttempts[pairName]++;
+
+				if (!wait_for_backoff(lock, attempt))
+				{
+					return;
+				}
+
+				_resyncQueue.emplace_back(std::move(pairName));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace mb
+{
+	class websocket_supervisor
+	{
+	private:
+		using reconnect_function = std::function<void()>;
+		using resync_function = std::function<void(const std::string&)>;
+
+		reconnect_function _reconnect;
+		resync_function _resync;
+		std::chrono::milliseconds _baseDelay;
+		std::chrono::milliseconds _maxDelay;
+
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::thread _thread;
+		bool _stopping;
+		bool _reconnectPending;
+		int _reconnectAttempt;
+		std::deque<std::string> _resyncQueue;
+		std::unordered_map<std::string, int> _resyncAttempts;
+		std::mt19937 _randomEngine;
+		std::atomic<size_t> _reconnectCount;
+
+		void ensure_started();
+		void run();
+		bool wait_for_backoff(std::unique_lock<std::mutex>& lock, int attempt);
+
+	public:
+		websocket_supervisor(
+			reconnect_function reconnect,
+			resync_function resync,
+			std::chrono::milliseconds baseDelay = std::chrono::milliseconds{ 500 },
+			std::chrono::milliseconds maxDelay = std::chrono::milliseconds{ 30000 });
+
+		~websocket_supervisor();
+
+		websocket_supervisor(const websocket_supervisor&) = delete;
+		websocket_supervisor& operator=(const websocket_supervisor&) = delete;
+
+		void request_reconnect();
+		void request_resync(std::string pairName);
+		void cancel();
+		void stop();
+
+		size_t reconnect_count() const noexcept { return _reconnectCount; }
+	};
+}
\ No newline at end of file
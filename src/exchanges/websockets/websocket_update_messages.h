@@ -45,13 +45,17 @@ namespace mb
 	private:
 		tradable_pair _pair;
 		order_book_entry _entry;
+		bool _endOfBatch;
 
 	public:
-		order_book_update_message(tradable_pair pair, order_book_entry entry)
-			: _pair{ std::move(pair) }, _entry{ std::move(entry) }
+		order_book_update_message(tradable_pair pair, order_book_entry entry, bool endOfBatch = true)
+			: _pair{ std::move(pair) }, _entry{ std::move(entry) }, _endOfBatch{ endOfBatch }
 		{}
 
 		const tradable_pair& pair() const noexcept { return _pair; }
 		const order_book_entry& entry() const noexcept { return _entry; }
+
+		// False while more levels of the same exchange message are still to come
+		bool end_of_batch() const noexcept { return _endOfBatch; }
 	};
 }
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+#include "http_client_pool.h"
+#include "http_error.h"
+
+namespace mb::internal
+{
+	struct multi_handle_registry
+	{
+		std::mutex mutex;
+		std::unordered_map<std::thread::id, CURLM*> handles;
+
+		void release(std::thread::id owner)
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+
+			auto it = handles.find(owner);
+			if (it != handles.end())
+			{
+				curl_multi_cleanup(it->second);
+				handles.erase(it);
+			}
+		}
+
+		void release_all()
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+
+			for (auto& [owner, multiHandle] : handles)
+			{
+				curl_multi_cleanup(multiHandle);
+			}
+
+			handles.clear();
+		}
+	};
+}
+
+namespace
+{
+	using namespace mb;
+
+	// Releases a thread's multi handles when it exits, for the pools that are still alive
+	class thread_multi_handles
+	{
+	private:
+		std::vector<std::weak_ptr<internal::multi_handle_registry>> _registries;
+
+	public:
+		~thread_multi_handles()
+		{
+			for (auto& registry : _registries)
+			{
+				if (auto liveRegistry = registry.lock())
+				{
+					liveRegistry->release(std::this_thread::get_id());
+				}
+			}
+		}
+
+		void add(std::weak_ptr<internal::multi_handle_registry> registry)
+		{
+			_registries.erase(
+				std::remove_if(_registries.begin(), _registries.end(), [](const auto& r) { return r.expired(); }),
+				_registries.end());
+
+			_registries.push_back(std::move(registry));
+		}
+	};
+
+	thread_multi_handles& current_thread_multi_handles()
+	{
+		thread_local thread_multi_handles multiHandles;
+		return multiHandles;
+	}
+
+	void initialise_curl()
+	{
+		static std::once_flag initFlag;
+		std::call_once(initFlag, []() { curl_global_init(CURL_GLOBAL_ALL); });
+	}
+
+	template<typename... Args>
+	void set_share_option(CURLSH* handle, CURLSHoption option, Args&&... args)
+	{
+		CURLSHcode result = curl_share_setopt(handle, option, std::forward<Args>(args)...);
+
+		if (result != CURLSHcode::CURLSHE_OK)
+		{
+			throw http_error{ curl_share_strerror(result) };
+		}
+	}
+}
+
+namespace mb
+{
+	pooled_http_client::pooled_http_client(http_client_pool& pool, CURL* handle)
+		: _pool{ &pool }, _handle{ handle }
+	{}
+
+	pooled_http_client::~pooled_http_client()
+	{
+		if (_handle)
+		{
+			_pool->release(_handle);
+		}
+	}
+
+	pooled_http_client::pooled_http_client(pooled_http_client&& other) noexcept
+		: _pool{ other._pool }, _handle{ other._handle }
+	{
+		other._handle = nullptr;
+	}
+
+	pooled_http_client& pooled_http_client::operator=(pooled_http_client&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (_handle)
+			{
+				_pool->release(_handle);
+			}
+
+			_pool = other._pool;
+			_handle = other._handle;
+			other._handle = nullptr;
+		}
+
+		return *this;
+	}
+
+	http_client_metrics::http_client_metrics(size_t requestCount, size_t reusedConnectionCount, size_t clientCount, double totalLatency)
+		:
+		_requestCount{ requestCount },
+		_reusedConnectionCount{ reusedConnectionCount },
+		_clientCount{ clientCount },
+		_totalLatency{ totalLatency }
+	{}
+
+	double http_client_metrics::connection_reuse_rate() const noexcept
+	{
+		return _requestCount == 0
+			? 0.0
+			: static_cast<double>(_reusedConnectionCount) / _requestCount;
+	}
+
+	double http_client_metrics::average_latency() const noexcept
+	{
+		return _requestCount == 0
+			? 0.0
+			: _totalLatency / _requestCount;
+	}
+
+	http_client_pool::http_client_pool(size_t maxIdleCount)
+		:
+		_shareHandle{ nullptr },
+		_maxIdleCount{ maxIdleCount },
+		_multiHandles{ std::make_shared<internal::multi_handle_registry>() },
+		_requestCount{ 0 },
+		_reusedConnectionCount{ 0 },
+		_clientCount{ 0 },
+		_totalLatencyMicroseconds{ 0 }
+	{
+		initialise_curl();
+
+		_shareHandle = curl_share_init();
+
+		if (!_shareHandle)
+		{
+			throw http_error{ "Could not create HTTP client pool" };
+		}
+
+		try
+		{
+			set_share_option(_shareHandle, CURLSHOPT_LOCKFUNC, lock_share);
+			set_share_option(_shareHandle, CURLSHOPT_UNLOCKFUNC, unlock_share);
+			set_share_option(_shareHandle, CURLSHOPT_USERDATA, this);
+			set_share_option(_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+			set_share_option(_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+		}
+		catch (...)
+		{
+			curl_share_cleanup(_shareHandle);
+			throw;
+		}
+	}
+
+	http_client_pool::~http_client_pool()
+	{
+		for (auto& [handle, owner] : _idleHandles)
+		{
+			curl_easy_cleanup(handle);
+		}
+
+		// Threads that exit later find their handles already gone. Cleaned up before the share handle they use
+		_multiHandles->release_all();
+
+		curl_share_cleanup(_shareHandle);
+	}
+
+	void http_client_pool::lock_share(CURL*, curl_lock_data data, curl_lock_access, void* pool)
+	{
+		static_cast<http_client_pool*>(pool)->_shareLocks[data].lock();
+	}
+
+	void http_client_pool::unlock_share(CURL*, curl_lock_data data, void* pool)
+	{
+		static_cast<http_client_pool*>(pool)->_shareLocks[data].unlock();
+	}
+
+	CURL* http_client_pool::create_handle()
+	{
+		CURL* handle = curl_easy_init();
+
+		if (!handle)
+		{
+			throw http_error{ "Could not create HTTP client" };
+		}
+
+		curl_easy_setopt(handle, CURLOPT_SHARE, _shareHandle);
+		curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+		curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+
+		++_clientCount;
+
+		return handle;
+	}
+
+	void http_client_pool::release(CURL* handle)
+	{
+		CURL* evicted = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock{ _idleMutex };
+			_idleHandles.push_back(idle_handle{ handle, std::this_thread::get_id() });
+
+			if (_idleHandles.size() > _maxIdleCount)
+			{
+				evicted = _idleHandles.front().handle;
+				_idleHandles.erase(_idleHandles.begin());
+			}
+		}
+
+		// Closing the connections can block, so it is done outside the lock
+		if (evicted)
+		{
+			curl_easy_cleanup(evicted);
+		}
+	}
+
+	pooled_http_client http_client_pool::checkout()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _idleMutex };
+
+			if (!_idleHandles.empty())
+			{
+				// Prefer the client this thread released last, since its connections are still open
+				auto ownHandle = std::find_if(_idleHandles.rbegin(), _idleHandles.rend(), [](const idle_handle& idle)
+				{
+					return idle.owner == std::this_thread::get_id();
+				});
+
+				auto reused = ownHandle == _idleHandles.rend()
+					? std::prev(_idleHandles.end())
+					: std::prev(ownHandle.base());
+
+				CURL* handle = reused->handle;
+				_idleHandles.erase(reused);
+
+				return pooled_http_client{ *this, handle };
+			}
+		}
+
+		return pooled_http_client{ *this, create_handle() };
+	}
+
+	CURLM* http_client_pool::multi_handle()
+	{
+		std::lock_guard<std::mutex> lock{ _multiHandles->mutex };
+
+		CURLM*& multiHandle = _multiHandles->handles[std::this_thread::get_id()];
+
+		if (!multiHandle)
+		{
+			multiHandle = curl_multi_init();
+
+			if (!multiHandle)
+			{
+				_multiHandles->handles.erase(std::this_thread::get_id());
+				throw http_error{ "Could not create HTTP batch" };
+			}
+
+			current_thread_multi_handles().add(_multiHandles);
+		}
+
+		return multiHandle;
+	}
+
+	void http_client_pool::record_transfer(CURL* handle)
+	{
+		long connectCount = 0;
+		double totalTime = 0.0;
+
+		curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connectCount);
+		curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME, &totalTime);
+
+		++_requestCount;
+		_totalLatencyMicroseconds += static_cast<long long>(totalTime * 1000000);
+
+		if (connectCount == 0)
+		{
+			++_reusedConnectionCount;
+		}
+	}
+
+	size_t http_client_pool::idle_count() const
+	{
+		std::lock_guard<std::mutex> lock{ _idleMutex };
+		return _idleHandles.size();
+	}
+
+	size_t http_client_pool::multi_handle_count() const
+	{
+		std::lock_guard<std::mutex> lock{ _multiHandles->mutex };
+		return _multiHandles->handles.size();
+	}
+
+	http_client_metrics http_client_pool::metrics() const
+	{
+		return http_client_metrics
+		{
+			_requestCount,
+			_reusedConnectionCount,
+			_clientCount,
+			_totalLatencyMicroseconds / 1000000.0
+		};
+	}
+}
\ No newline at end of file
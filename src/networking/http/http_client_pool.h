@@ -0,0 +1,113 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mb
+{
+	namespace internal
+	{
+		struct multi_handle_registry;
+	}
+
+	constexpr size_t DEFAULT_MAX_IDLE_CLIENTS = 16;
+
+	class http_client_pool;
+
+	class pooled_http_client
+	{
+	private:
+		http_client_pool* _pool;
+		CURL* _handle;
+
+	public:
+		pooled_http_client(http_client_pool& pool, CURL* handle);
+		~pooled_http_client();
+
+		pooled_http_client(const pooled_http_client&) = delete;
+		pooled_http_client& operator=(const pooled_http_client&) = delete;
+
+		pooled_http_client(pooled_http_client&& other) noexcept;
+		pooled_http_client& operator=(pooled_http_client&& other) noexcept;
+
+		CURL* handle() const noexcept { return _handle; }
+	};
+
+	class http_client_metrics
+	{
+	private:
+		size_t _requestCount;
+		size_t _reusedConnectionCount;
+		size_t _clientCount;
+		double _totalLatency;
+
+	public:
+		http_client_metrics(size_t requestCount, size_t reusedConnectionCount, size_t clientCount, double totalLatency);
+
+		size_t request_count() const noexcept { return _requestCount; }
+		size_t reused_connection_count() const noexcept { return _reusedConnectionCount; }
+		size_t client_count() const noexcept { return _clientCount; }
+		double total_latency() const noexcept { return _totalLatency; }
+
+		double connection_reuse_rate() const noexcept;
+		double average_latency() const noexcept;
+	};
+
+	/*
+	* Clients share DNS and TLS session caches. Connections cannot be shared between threads, so each easy handle keeps
+	* its own and a thread is given back the client it last released. Batches run on one multi handle per thread, which
+	* outlives the batch so its connections are reused by the next one, and is released when the thread exits.
+	* At most maxIdleCount clients are kept idle, the least recently released being closed first.
+	*/
+	class http_client_pool
+	{
+	private:
+		struct idle_handle
+		{
+			CURL* handle;
+			std::thread::id owner;
+		};
+
+		CURLSH* _shareHandle;
+		std::array<std::mutex, CURL_LOCK_DATA_LAST> _shareLocks;
+
+		size_t _maxIdleCount;
+		mutable std::mutex _idleMutex;
+		std::vector<idle_handle> _idleHandles;
+
+		std::shared_ptr<internal::multi_handle_registry> _multiHandles;
+
+		std::atomic<size_t> _requestCount;
+		std::atomic<size_t> _reusedConnectionCount;
+		std::atomic<size_t> _clientCount;
+		std::atomic<long long> _totalLatencyMicroseconds;
+
+		static void lock_share(CURL* handle, curl_lock_data data, curl_lock_access access, void* pool);
+		static void unlock_share(CURL* handle, curl_lock_data data, void* pool);
+
+		CURL* create_handle();
+		void release(CURL* handle);
+
+		friend class pooled_http_client;
+
+	public:
+		explicit http_client_pool(size_t maxIdleCount = DEFAULT_MAX_IDLE_CLIENTS);
+		~http_client_pool();
+
+		http_client_pool(const http_client_pool&) = delete;
+		http_client_pool& operator=(const http_client_pool&) = delete;
+
+		pooled_http_client checkout();
+		CURLM* multi_handle();
+		void record_transfer(CURL* handle);
+
+		size_t idle_count() const;
+		size_t multi_handle_count() const;
+		http_client_metrics metrics() const;
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <stdexcept>
 
 namespace mb
 {
@@ -51,4 +52,4 @@ namespace mb
 
 		throw std::invalid_argument("HTTP verb not recognized");
 	}
-}
+}
\ No newline at end of file
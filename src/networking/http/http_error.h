@@ -4,11 +4,23 @@
 
 namespace mb
 {
+	enum class http_error_type
+	{
+		FATAL,
+		CONNECTION_FAILED,
+		TRANSFER_FAILED
+	};
+
 	class http_error : public mb_exception
 	{
+	private:
+		http_error_type _type;
+
 	public:
-		http_error(std::string message)
-			: mb_exception{ "HTTP Error: " + std::move(message)}
+		http_error(std::string message, http_error_type type = http_error_type::FATAL)
+			: mb_exception{ "HTTP Error: " + std::move(message)}, _type{ type }
 		{}
+
+		http_error_type type() const noexcept { return _type; }
 	};
-}
+}
\ No newline at end of file
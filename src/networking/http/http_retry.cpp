@@ -0,0 +1,53 @@
+#include "http_retry.h"
+
+namespace
+{
+	namespace retryable_response_codes
+	{
+		static constexpr int REQUEST_TIMEOUT = 408;
+		static constexpr int TOO_MANY_REQUESTS = 429;
+		static constexpr int INTERNAL_SERVER_ERROR = 500;
+		static constexpr int BAD_GATEWAY = 502;
+		static constexpr int SERVICE_UNAVAILABLE = 503;
+		static constexpr int GATEWAY_TIMEOUT = 504;
+	}
+}
+
+namespace mb
+{
+	bool is_idempotent(http_verb verb) noexcept
+	{
+		return verb == http_verb::GET;
+	}
+
+	bool is_retryable(const http_error& error, http_verb verb) noexcept
+	{
+		switch (error.type())
+		{
+		case http_error_type::CONNECTION_FAILED:
+			return true;
+		case http_error_type::TRANSFER_FAILED:
+			// The exchange may already have acted on a request that failed mid-transfer
+			return is_idempotent(verb);
+		default:
+			return false;
+		}
+	}
+
+	bool is_retryable(int responseCode, http_verb verb) noexcept
+	{
+		switch (responseCode)
+		{
+		case retryable_response_codes::TOO_MANY_REQUESTS:
+			return true;
+		case retryable_response_codes::REQUEST_TIMEOUT:
+		case retryable_response_codes::INTERNAL_SERVER_ERROR:
+		case retryable_response_codes::BAD_GATEWAY:
+		case retryable_response_codes::SERVICE_UNAVAILABLE:
+		case retryable_response_codes::GATEWAY_TIMEOUT:
+			return is_idempotent(verb);
+		default:
+			return false;
+		}
+	}
+}
\ No newline at end of file
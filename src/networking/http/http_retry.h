@@ -0,0 +1,11 @@
+#pragma once
+
+#include "http_constants.h"
+#include "http_error.h"
+
+namespace mb
+{
+	bool is_idempotent(http_verb verb) noexcept;
+	bool is_retryable(const http_error& error, http_verb verb) noexcept;
+	bool is_retryable(int responseCode, http_verb verb) noexcept;
+}
\ No newline at end of file
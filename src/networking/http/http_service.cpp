@@ -1,28 +1,36 @@
 #include <stdexcept>
-#include <mutex>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <thread>
 
 #include "http_service.h"
 #include "http_constants.h"
 #include "http_error.h"
+#include "http_retry.h"
+#include "logging/logger.h"
+#include "networking/url.h"
 
 namespace
 {
 	using namespace mb;
 
-	CURL* create_easy_handle()
-	{
-		static bool hasGlobalInit = false;
-		static std::mutex mutex;
+	static constexpr int BATCH_WAIT_TIMEOUT = 1000;
 
-		std::lock_guard<std::mutex>lock{ mutex };
+	using send_clock = std::chrono::steady_clock;
 
-		if (!hasGlobalInit)
+	// Waits at most until the next transfer is due to start, so a throttled transfer starts on time without sleeping
+	int batch_wait_timeout(send_clock::time_point now, std::optional<send_clock::time_point> nextStart)
+	{
+		if (!nextStart)
 		{
-			curl_global_init(CURL_GLOBAL_ALL);
-			hasGlobalInit = true;
+			return BATCH_WAIT_TIMEOUT;
 		}
 
-		return curl_easy_init();
+		auto untilStart{ std::chrono::duration_cast<std::chrono::milliseconds>(*nextStart - now).count() + 1 };
+		return static_cast<int>(std::clamp<long long>(untilStart, 0, BATCH_WAIT_TIMEOUT));
 	}
 
 	size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata)
@@ -34,11 +42,42 @@ namespace
 		return realSize;
 	}
 
+	http_error_type get_error_type(CURLcode result)
+	{
+		switch (result)
+		{
+		case CURLcode::CURLE_COULDNT_RESOLVE_PROXY:
+		case CURLcode::CURLE_COULDNT_RESOLVE_HOST:
+		case CURLcode::CURLE_COULDNT_CONNECT:
+		case CURLcode::CURLE_SSL_CONNECT_ERROR:
+			return http_error_type::CONNECTION_FAILED;
+		case CURLcode::CURLE_OPERATION_TIMEDOUT:
+		case CURLcode::CURLE_PARTIAL_FILE:
+		case CURLcode::CURLE_SEND_ERROR:
+		case CURLcode::CURLE_RECV_ERROR:
+		case CURLcode::CURLE_GOT_NOTHING:
+		case CURLcode::CURLE_HTTP2:
+		case CURLcode::CURLE_HTTP2_STREAM:
+			return http_error_type::TRANSFER_FAILED;
+		default:
+			return http_error_type::FATAL;
+		}
+	}
+
 	void throw_if_error(CURLcode result)
 	{
 		if (result != CURLcode::CURLE_OK)
 		{
 			std::string error = curl_easy_strerror(result);
+			throw http_error{ std::move(error), get_error_type(result) };
+		}
+	}
+
+	void throw_if_error(CURLMcode result)
+	{
+		if (result != CURLMcode::CURLM_OK)
+		{
+			std::string error = curl_multi_strerror(result);
 			throw http_error{ std::move(error) };
 		}
 	}
@@ -59,75 +98,442 @@ namespace
 
 		return chunk;
 	}
+
+	curl_slist* prepare_request(CURL* handle, const http_request& request, int timeout, std::string& readBuffer)
+	{
+		set_option(handle, CURLOPT_WRITEFUNCTION, write_callback);
+		set_option(handle, CURLOPT_TIMEOUT_MS, timeout);
+		set_option(handle, CURLOPT_URL, request.url().c_str());
+		set_option(handle, CURLOPT_CUSTOMREQUEST, to_string(request.verb()).data());
+		set_option(handle, CURLOPT_WRITEDATA, &readBuffer);
+		set_option(handle, CURLOPT_POSTFIELDS, request.content().c_str());
+
+		curl_slist* chunk = append_headers(NULL, request.headers());
+		set_option(handle, CURLOPT_HTTPHEADER, chunk);
+
+		return chunk;
+	}
+
+	http_response read_response(CURL* handle, std::string readBuffer)
+	{
+		long responseCode;
+		curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &responseCode);
+
+		return http_response{ static_cast<int>(responseCode), std::move(readBuffer) };
+	}
+
+	class batch_transfer
+	{
+	private:
+		pooled_http_client _client;
+		curl_slist* _headers;
+		std::string _readBuffer;
+
+	public:
+		batch_transfer(pooled_http_client client, const http_request& request, int timeout)
+			: _client{ std::move(client) }, _headers{ nullptr }
+		{
+			_headers = prepare_request(_client.handle(), request, timeout, _readBuffer);
+		}
+
+		~batch_transfer()
+		{
+			curl_slist_free_all(_headers);
+		}
+
+		batch_transfer(const batch_transfer&) = delete;
+		batch_transfer& operator=(const batch_transfer&) = delete;
+
+		CURL* handle() const noexcept { return _client.handle(); }
+
+		http_response to_response()
+		{
+			return read_response(_client.handle(), std::move(_readBuffer));
+		}
+	};
+
+	// Borrows the calling thread's multi handle from the pool and removes only the transfers it added
+	class multi_transfer
+	{
+	private:
+		CURLM* _multiHandle;
+		std::vector<CURL*> _activeHandles;
+
+	public:
+		explicit multi_transfer(CURLM* multiHandle)
+			: _multiHandle{ multiHandle }
+		{}
+
+		~multi_transfer()
+		{
+			for (CURL* handle : _activeHandles)
+			{
+				curl_multi_remove_handle(_multiHandle, handle);
+			}
+		}
+
+		multi_transfer(const multi_transfer&) = delete;
+		multi_transfer& operator=(const multi_transfer&) = delete;
+
+		void add(CURL* handle)
+		{
+			throw_if_error(curl_multi_add_handle(_multiHandle, handle));
+			_activeHandles.push_back(handle);
+		}
+
+		void remove(CURL* handle)
+		{
+			curl_multi_remove_handle(_multiHandle, handle);
+			_activeHandles.erase(std::find(_activeHandles.begin(), _activeHandles.end(), handle));
+		}
+
+		void perform()
+		{
+			int runningHandles;
+			throw_if_error(curl_multi_perform(_multiHandle, &runningHandles));
+		}
+
+		void wait(int timeout)
+		{
+			throw_if_error(curl_multi_wait(_multiHandle, nullptr, 0, timeout, nullptr));
+		}
+
+		template<typename OnComplete>
+		void read_completed(OnComplete onComplete)
+		{
+			int queuedMessages;
+			while (CURLMsg* message = curl_multi_info_read(_multiHandle, &queuedMessages))
+			{
+				if (message->msg != CURLMSG_DONE)
+				{
+					continue;
+				}
+
+				CURL* handle = message->easy_handle;
+				CURLcode result = message->data.result;
+
+				remove(handle);
+				onComplete(handle, result);
+			}
+		}
+	};
 }
 
 namespace mb
 {
 	http_service::http_service()
-		: _easyHandle{ create_easy_handle() }
+		: _clientPool{ std::make_shared<http_client_pool>() }, _retryPolicy{ std::make_shared<retry_policy>(_retryPolicyConfig) }
+	{}
+
+	void http_service::throttle(const http_request& request) const
 	{
-		if (!_easyHandle)
+		if (_rateLimiter)
 		{
-			throw http_error{ "Could not create HTTP service" };
+			_rateLimiter->acquire(get_url_path(request.url()));
 		}
+	}
 
-		set_option(_easyHandle, CURLOPT_WRITEFUNCTION, write_callback);
-		set_option(_easyHandle, CURLOPT_TIMEOUT_MS, _timeout);
+	std::chrono::steady_clock::time_point http_service::reserve_send_time(const http_request& request, std::chrono::steady_clock::time_point now) const
+	{
+		return _rateLimiter
+			? now + _rateLimiter->reserve(get_url_path(request.url()))
+			: now;
 	}
 
-	http_service::~http_service()
+	http_response http_service::send(const http_request& request) const
 	{
-		curl_easy_cleanup(_easyHandle);
+		_retryPolicy->record_request();
+		return send_with_retries(request, 0);
 	}
 
-	http_service::http_service(const http_service& other)
-		: _easyHandle{ other._easyHandle }
+	http_response http_service::send_with_retries(const http_request& request, int firstAttempt) const
 	{
+		bool hedged = _retryPolicy->hedging_enabled() && is_idempotent(request.verb());
+
+		for (int attempt = firstAttempt;; ++attempt)
+		{
+			try
+			{
+				http_response response{ hedged ? send_hedged(request) : send_once(request) };
+
+				if (!is_retryable(response.response_code(), request.verb()) || !_retryPolicy->try_acquire_retry(attempt))
+				{
+					return response;
+				}
+
+				logger::instance().warning("Request to {0} returned {1}, retrying", get_url_path(request.url()), response.response_code());
+			}
+			catch (const http_error& error)
+			{
+				if (!is_retryable(error, request.verb()) || !_retryPolicy->try_acquire_retry(attempt))
+				{
+					throw;
+				}
+
+				logger::instance().warning("Request to {0} failed, retrying: {1}", get_url_path(request.url()), error.what());
+			}
+
+			std::this_thread::sleep_for(_retryPolicy->backoff_delay(attempt));
+		}
 	}
 
-	http_service::http_service(http_service&& other) noexcept
-		: _easyHandle{ other._easyHandle }
+	http_response http_service::send_once(const http_request& request) const
 	{
-		other._easyHandle = nullptr;
+		throttle(request);
+
+		std::string readBuffer;
+		pooled_http_client client{ _clientPool->checkout() };
+
+		curl_slist* chunk = prepare_request(client.handle(), request, _timeout, readBuffer);
+
+		CURLcode result = curl_easy_perform(client.handle());
+
+		curl_slist_free_all(chunk);
+
+		throw_if_error(result);
+
+		_clientPool->record_transfer(client.handle());
+
+		return read_response(client.handle(), std::move(readBuffer));
 	}
 
-	http_service& http_service::operator=(const http_service& other)
+	http_response http_service::send_hedged(const http_request& request) const
 	{
-		_easyHandle = other._easyHandle;
+		std::vector<std::unique_ptr<batch_transfer>> transfers;
+		multi_transfer multiTransfer{ _clientPool->multi_handle() };
+
+		auto start_transfer = [&]()
+		{
+			auto& transfer{ transfers.emplace_back(std::make_unique<batch_transfer>(_clientPool->checkout(), request, _timeout)) };
+			multiTransfer.add(transfer->handle());
+		};
+
+		throttle(request);
+		start_transfer();
+
+		// A duplicate request is only sent if the original is slow and the retry budget allows it,
+		// so hedging never sends more requests than retrying would
+		auto hedgeTime{ send_clock::now() + _retryPolicy->config().hedge_delay() };
+		bool canHedge = true;
+		std::optional<send_clock::time_point> hedgeStart;
+
+		std::optional<http_response> response;
+		size_t failedTransfers = 0;
+		CURLcode lastError = CURLcode::CURLE_OK;
+
+		while (!response)
+		{
+			multiTransfer.perform();
+			multiTransfer.read_completed([&](CURL* handle, CURLcode result)
+			{
+				if (response)
+				{
+					return;
+				}
+
+				if (result != CURLcode::CURLE_OK)
+				{
+					++failedTransfers;
+					lastError = result;
+					return;
+				}
+
+				_clientPool->record_transfer(handle);
+
+				auto it = std::find_if(transfers.begin(), transfers.end(), [handle](const auto& transfer) { return transfer->handle() == handle; });
+				response = (*it)->to_response();
+			});
 
-		return *this;
+			if (response)
+			{
+				break;
+			}
+
+			if (failedTransfers == transfers.size())
+			{
+				throw_if_error(lastError);
+			}
+
+			auto now{ send_clock::now() };
+
+			if (canHedge && now >= hedgeTime)
+			{
+				canHedge = false;
+
+				if (_retryPolicy->try_acquire_retry(0))
+				{
+					hedgeStart = reserve_send_time(request, now);
+				}
+			}
+
+			if (hedgeStart && now >= *hedgeStart)
+			{
+				hedgeStart.reset();
+				start_transfer();
+				continue;
+			}
+
+			multiTransfer.wait(batch_wait_timeout(now, canHedge ? hedgeTime : hedgeStart));
+		}
+
+		return std::move(*response);
 	}
 
-	http_service& http_service::operator=(http_service&& other) noexcept
+	void http_service::retry_failed_transfers(
+		const std::vector<http_request>& requests,
+		std::vector<std::optional<http_response>>& responses,
+		const std::vector<std::pair<size_t, CURLcode>>& failedTransfers) const
 	{
-		_easyHandle = other._easyHandle;
+		std::vector<size_t> retryIndices;
+
+		for (auto& [index, result] : failedTransfers)
+		{
+			http_error error{ curl_easy_strerror(result), get_error_type(result) };
+
+			if (!is_retryable(error, requests[index].verb()) || !_retryPolicy->try_acquire_retry(0))
+			{
+				throw error;
+			}
 
-		other._easyHandle = nullptr;
+			retryIndices.push_back(index);
+		}
+
+		for (size_t i = 0; i < responses.size(); ++i)
+		{
+			if (responses[i] && is_retryable(responses[i]->response_code(), requests[i].verb()) && _retryPolicy->try_acquire_retry(0))
+			{
+				retryIndices.push_back(i);
+			}
+		}
+
+		if (retryIndices.empty())
+		{
+			return;
+		}
 
-		return *this;
+		std::this_thread::sleep_for(_retryPolicy->backoff_delay(0));
+
+		for (size_t index : retryIndices)
+		{
+			responses[index] = send_with_retries(requests[index], 1);
+		}
 	}
 
-	http_response http_service::send(const http_request& request) const
+	std::vector<http_response> http_service::send_batch(const std::vector<http_request>& requests) const
 	{
-		std::string readBuffer;
+		std::vector<http_response> responses;
+		responses.reserve(requests.size());
 
-		set_option(_easyHandle, CURLOPT_URL, request.url().c_str());
-		set_option(_easyHandle, CURLOPT_CUSTOMREQUEST, to_string(request.verb()).data());
-		set_option(_easyHandle, CURLOPT_WRITEDATA, &readBuffer);
-		set_option(_easyHandle, CURLOPT_POSTFIELDS, request.content().c_str());
+		for (size_t i = 0; i < requests.size(); ++i)
+		{
+			_retryPolicy->record_request();
+		}
 
-		curl_slist* chunk = append_headers(NULL, request.headers());
-		set_option(_easyHandle, CURLOPT_HTTPHEADER, chunk);
+		if (requests.size() <= 1 || _maxConcurrentRequests <= 1)
+		{
+			for (auto& request : requests)
+			{
+				responses.emplace_back(send_with_retries(request, 0));
+			}
 
-		CURLcode result = curl_easy_perform(_easyHandle);
+			return responses;
+		}
 
-		curl_slist_free_all(chunk);
+		std::vector<std::optional<http_response>> completedResponses(requests.size());
+		std::unordered_map<CURL*, std::pair<size_t, std::unique_ptr<batch_transfer>>> activeTransfers;
 
-		throw_if_error(result);
+		multi_transfer multiTransfer{ _clientPool->multi_handle() };
+		size_t nextTransfer = 0;
+		size_t completedTransfers = 0;
+		std::vector<std::pair<size_t, CURLcode>> failedTransfers;
 
-		long responseCode;
-		curl_easy_getinfo(_easyHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+		// Transfers take a concurrency slot when their rate limit tokens are reserved and are added once they are due.
+		// Reservations are made in order, so the queue is sorted by start time.
+		std::deque<std::pair<send_clock::time_point, size_t>> scheduledTransfers;
+
+		auto schedule_next_transfer = [&](send_clock::time_point now)
+		{
+			if (nextTransfer < requests.size())
+			{
+				scheduledTransfers.emplace_back(reserve_send_time(requests[nextTransfer], now), nextTransfer);
+				++nextTransfer;
+			}
+		};
+
+		auto start_due_transfers = [&](send_clock::time_point now)
+		{
+			while (!scheduledTransfers.empty() && scheduledTransfers.front().first <= now)
+			{
+				size_t index = scheduledTransfers.front().second;
+				scheduledTransfers.pop_front();
+
+				auto transfer{ std::make_unique<batch_transfer>(_clientPool->checkout(), requests[index], _timeout) };
+				CURL* handle = transfer->handle();
 
-		return http_response{ static_cast<int>(responseCode), readBuffer };
+				activeTransfers.emplace(handle, std::make_pair(index, std::move(transfer)));
+				multiTransfer.add(handle);
+			}
+		};
+
+		auto now{ send_clock::now() };
+		for (int i = 0; i < _maxConcurrentRequests; ++i)
+		{
+			schedule_next_transfer(now);
+		}
+
+		while (completedTransfers < requests.size())
+		{
+			start_due_transfers(send_clock::now());
+			multiTransfer.perform();
+			multiTransfer.read_completed([&](CURL* handle, CURLcode result)
+			{
+				++completedTransfers;
+
+				auto it = activeTransfers.find(handle);
+
+				if (result == CURLcode::CURLE_OK)
+				{
+					_clientPool->record_transfer(handle);
+					completedResponses[it->second.first] = it->second.second->to_response();
+				}
+				else
+				{
+					failedTransfers.emplace_back(it->second.first, result);
+				}
+
+				activeTransfers.erase(it);
+				schedule_next_transfer(send_clock::now());
+			});
+
+			if (completedTransfers < requests.size())
+			{
+				now = send_clock::now();
+				std::optional<send_clock::time_point> nextStart;
+
+				if (!scheduledTransfers.empty())
+				{
+					nextStart = scheduledTransfers.front().first;
+				}
+
+				// curl_multi_wait returns at once when no transfer is in flight, and then there is nothing to stall
+				if (activeTransfers.empty() && nextStart)
+				{
+					std::this_thread::sleep_until(*nextStart);
+				}
+				else
+				{
+					multiTransfer.wait(batch_wait_timeout(now, nextStart));
+				}
+			}
+		}
+
+		retry_failed_transfers(requests, completedResponses, failedTransfers);
+
+		for (auto& response : completedResponses)
+		{
+			responses.emplace_back(std::move(*response));
+		}
+
+		return responses;
 	}
-}
+}
\ No newline at end of file
@@ -1,37 +1,76 @@
 #pragma once
 
 #include <curl/curl.h>
+#include <chrono>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <utility>
 
 #include "http_response.h"
 #include "http_request.h"
+#include "http_client_pool.h"
+#include "rate_limiter.h"
+#include "common/utils/retry.h"
 
 namespace mb
 {
 	class http_service
 	{
 	private:
-		CURL* _easyHandle;
+		std::shared_ptr<http_client_pool> _clientPool;
+		std::shared_ptr<rate_limiter> _rateLimiter;
+		std::shared_ptr<retry_policy> _retryPolicy;
+
+		void throttle(const http_request& request) const;
+		std::chrono::steady_clock::time_point reserve_send_time(const http_request& request, std::chrono::steady_clock::time_point now) const;
+		http_response send_with_retries(const http_request& request, int firstAttempt) const;
+		http_response send_once(const http_request& request) const;
+		http_response send_hedged(const http_request& request) const;
+		void retry_failed_transfers(
+			const std::vector<http_request>& requests,
+			std::vector<std::optional<http_response>>& responses,
+			const std::vector<std::pair<size_t, CURLcode>>& failedTransfers) const;
+
 		inline static int _timeout;
+		inline static int _maxConcurrentRequests = 8;
+		inline static retry_policy_config _retryPolicyConfig;
 
 	public:
 		http_service();
-		virtual ~http_service();
+		virtual ~http_service() = default;
 
 		inline static void set_timeout(int timeout) noexcept
 		{
 			_timeout = timeout;
 		}
 
-		http_service(const http_service& other);
-		http_service(http_service&& other) noexcept;
+		inline static void set_max_concurrent_requests(int maxConcurrentRequests) noexcept
+		{
+			_maxConcurrentRequests = maxConcurrentRequests;
+		}
+
+		inline static void set_retry_policy_config(retry_policy_config retryPolicyConfig) noexcept
+		{
+			_retryPolicyConfig = std::move(retryPolicyConfig);
+		}
+
+		http_service(const http_service& other) = default;
+		http_service(http_service&& other) noexcept = default;
+
+		http_service& operator=(const http_service& other) = default;
+		http_service& operator=(http_service&& other) noexcept = default;
+
+		http_client_metrics metrics() const { return _clientPool->metrics(); }
+
+		void set_rate_limiter(std::shared_ptr<rate_limiter> rateLimiter) noexcept { _rateLimiter = std::move(rateLimiter); }
+		const std::shared_ptr<rate_limiter>& get_rate_limiter() const noexcept { return _rateLimiter; }
 
-		http_service& operator=(const http_service& other);
-		http_service& operator=(http_service&& other) noexcept;
+		void set_retry_policy(std::shared_ptr<retry_policy> retryPolicy) noexcept { _retryPolicy = std::move(retryPolicy); }
+		const std::shared_ptr<retry_policy>& get_retry_policy() const noexcept { return _retryPolicy; }
 
 		virtual http_response send(const http_request& request) const;
+		virtual std::vector<http_response> send_batch(const std::vector<http_request>& requests) const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "rate_limiter.h"
+
+namespace
+{
+	static constexpr double DEFAULT_ENDPOINT_WEIGHT = 1.0;
+
+	namespace json_property_names
+	{
+		static constexpr std::string_view CAPACITY = "rateLimitCapacity";
+		static constexpr std::string_view REFILL_RATE = "rateLimitRefillRate";
+		static constexpr std::string_view ENDPOINT_WEIGHTS = "endpointWeights";
+	}
+}
+
+namespace mb
+{
+	rate_limit_config::rate_limit_config()
+		: rate_limit_config{ 0.0, 0.0, {} }
+	{}
+
+	rate_limit_config::rate_limit_config(double capacity, double refillRate, std::unordered_map<std::string, double> endpointWeights)
+		: _capacity{ capacity }, _refillRate{ refillRate }, _endpointWeights{ std::move(endpointWeights) }
+	{}
+
+	double rate_limit_config::endpoint_weight(std::string_view endpoint) const
+	{
+		auto it = _endpointWeights.find(std::string{ endpoint });
+		return it != _endpointWeights.end()
+			? it->second
+			: DEFAULT_ENDPOINT_WEIGHT;
+	}
+
+	rate_limit_config read_rate_limit_config(const json_document& json, rate_limit_config defaultConfig)
+	{
+		return rate_limit_config
+		{
+			json.get_or_default<double>(json_property_names::CAPACITY, defaultConfig.capacity()),
+			json.get_or_default<double>(json_property_names::REFILL_RATE, defaultConfig.refill_rate()),
+			json.get_or_default<std::unordered_map<std::string, double>>(json_property_names::ENDPOINT_WEIGHTS, defaultConfig.endpoint_weights())
+		};
+	}
+
+	void write_rate_limit_config(const rate_limit_config& config, json_writer& writer)
+	{
+		writer.add(json_property_names::CAPACITY, config.capacity());
+		writer.add(json_property_names::REFILL_RATE, config.refill_rate());
+		writer.add(json_property_names::ENDPOINT_WEIGHTS, config.endpoint_weights());
+	}
+
+	rate_limiter::rate_limiter(rate_limit_config config)
+		:
+		_config{ std::move(config) },
+		_tokens{ _config.capacity() },
+		_lastRefill{ clock::now() },
+		_throttledCount{ 0 },
+		_throttledMicroseconds{ 0 }
+	{}
+
+	std::chrono::microseconds rate_limiter::reserve(double weight)
+	{
+		if (!_config.enabled())
+		{
+			return std::chrono::microseconds::zero();
+		}
+
+		std::lock_guard<std::mutex> lock{ _mutex };
+
+		clock::time_point now{ clock::now() };
+		double elapsedSeconds = std::chrono::duration<double>(now - _lastRefill).count();
+
+		_tokens = std::min(_config.capacity(), _tokens + elapsedSeconds * _config.refill_rate());
+		_lastRefill = now;
+		_tokens -= weight;
+
+		if (_tokens >= 0.0)
+		{
+			return std::chrono::microseconds::zero();
+		}
+
+		std::chrono::microseconds delay{ static_cast<long long>(std::ceil(-_tokens / _config.refill_rate() * 1000000)) };
+
+		++_throttledCount;
+		_throttledMicroseconds += delay.count();
+
+		return delay;
+	}
+
+	std::chrono::microseconds rate_limiter::reserve(std::string_view endpoint)
+	{
+		return reserve(_config.endpoint_weight(endpoint));
+	}
+
+	void rate_limiter::acquire(double weight)
+	{
+		std::chrono::microseconds delay{ reserve(weight) };
+
+		if (delay > std::chrono::microseconds::zero())
+		{
+			std::this_thread::sleep_for(delay);
+		}
+	}
+
+	void rate_limiter::acquire(std::string_view endpoint)
+	{
+		acquire(_config.endpoint_weight(endpoint));
+	}
+}
\ No newline at end of file
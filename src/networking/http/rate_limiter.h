@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "common/json/json.h"
+
+namespace mb
+{
+	class rate_limit_config
+	{
+	private:
+		double _capacity;
+		double _refillRate;
+		std::unordered_map<std::string, double> _endpointWeights;
+
+	public:
+		rate_limit_config();
+		rate_limit_config(double capacity, double refillRate, std::unordered_map<std::string, double> endpointWeights);
+
+		double capacity() const noexcept { return _capacity; }
+		double refill_rate() const noexcept { return _refillRate; }
+		const std::unordered_map<std::string, double>& endpoint_weights() const noexcept { return _endpointWeights; }
+
+		bool enabled() const noexcept { return _capacity > 0.0 && _refillRate > 0.0; }
+		double endpoint_weight(std::string_view endpoint) const;
+	};
+
+	rate_limit_config read_rate_limit_config(const json_document& json, rate_limit_config defaultConfig);
+	void write_rate_limit_config(const rate_limit_config& config, json_writer& writer);
+
+	class rate_limiter
+	{
+	private:
+		using clock = std::chrono::steady_clock;
+
+		rate_limit_config _config;
+		std::mutex _mutex;
+		double _tokens;
+		clock::time_point _lastRefill;
+		std::atomic<size_t> _throttledCount;
+		std::atomic<long long> _throttledMicroseconds;
+
+	public:
+		explicit rate_limiter(rate_limit_config config);
+
+		const rate_limit_config& config() const noexcept { return _config; }
+
+		// Takes the tokens now and returns how long the caller must wait before sending, without blocking
+		std::chrono::microseconds reserve(double weight);
+		std::chrono::microseconds reserve(std::string_view endpoint);
+		void acquire(double weight);
+		void acquire(std::string_view endpoint);
+
+		size_t throttled_count() const noexcept { return _throttledCount; }
+		std::chrono::microseconds throttled_time() const noexcept { return std::chrono::microseconds{ _throttledMicroseconds }; }
+	};
+}
\ No newline at end of file
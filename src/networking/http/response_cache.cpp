@@ -0,0 +1,97 @@
+#include "response_cache.h"
+
+namespace mb
+{
+	response_cache::response_cache()
+		: _hitCount{ 0 }, _missCount{ 0 }
+	{}
+
+	std::string response_cache::create_key(std::string_view endpoint, std::string_view query)
+	{
+		std::string key{ endpoint };
+		key.push_back('?');
+		key.append(query);
+
+		return key;
+	}
+
+	void response_cache::clear()
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+		_entries.clear();
+	}
+
+	size_t response_cache::hit_count() const
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+		return _hitCount;
+	}
+
+	size_t response_cache::miss_count() const
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+		return _missCount;
+	}
+
+	response_cache::cache_lookup response_cache::acquire(const std::string& key)
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+
+		auto it = _entries.find(key);
+
+		if (it != _entries.end() && clock::now() < it->second.expiry)
+		{
+			++_hitCount;
+			return cache_lookup{ it->second.value, nullptr };
+		}
+
+		++_missCount;
+
+		auto pendingFetch{ std::make_shared<std::promise<std::any>>() };
+		std::shared_future<std::any> value{ pendingFetch->get_future().share() };
+
+		_entries[key] = cache_entry{ value, clock::time_point::max(), pendingFetch.get() };
+
+		return cache_lookup{ std::move(value), std::move(pendingFetch) };
+	}
+
+	void response_cache::complete(const std::string& key, std::chrono::milliseconds ttl, std::promise<std::any>& pendingFetch, std::any value)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+
+			auto it = _entries.find(key);
+
+			if (it != _entries.end() && it->second.pendingFetch == &pendingFetch)
+			{
+				if (ttl > std::chrono::milliseconds::zero())
+				{
+					it->second.expiry = clock::now() + ttl;
+					it->second.pendingFetch = nullptr;
+				}
+				else
+				{
+					_entries.erase(it);
+				}
+			}
+		}
+
+		pendingFetch.set_value(std::move(value));
+	}
+
+	void response_cache::fail(const std::string& key, std::promise<std::any>& pendingFetch, std::exception_ptr error)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+
+			auto it = _entries.find(key);
+
+			if (it != _entries.end() && it->second.pendingFetch == &pendingFetch)
+			{
+				_entries.erase(it);
+			}
+		}
+
+		pendingFetch.set_exception(std::move(error));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <any>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mb
+{
+	class response_cache
+	{
+	private:
+		using clock = std::chrono::steady_clock;
+
+		struct cache_entry
+		{
+			std::shared_future<std::any> value;
+			clock::time_point expiry;
+			const std::promise<std::any>* pendingFetch;
+		};
+
+		struct cache_lookup
+		{
+			std::shared_future<std::any> value;
+			std::shared_ptr<std::promise<std::any>> pendingFetch;
+		};
+
+		mutable std::mutex _mutex;
+		std::unordered_map<std::string, cache_entry> _entries;
+		size_t _hitCount;
+		size_t _missCount;
+
+		static std::string create_key(std::string_view endpoint, std::string_view query);
+
+		cache_lookup acquire(const std::string& key);
+		void complete(const std::string& key, std::chrono::milliseconds ttl, std::promise<std::any>& pendingFetch, std::any value);
+		void fail(const std::string& key, std::promise<std::any>& pendingFetch, std::exception_ptr error);
+
+	public:
+		response_cache();
+
+		void clear();
+
+		size_t hit_count() const;
+		size_t miss_count() const;
+
+		template<typename Value, typename Fetch>
+		Value get(std::string_view endpoint, std::string_view query, std::chrono::milliseconds ttl, Fetch fetch)
+		{
+			std::string key{ create_key(endpoint, query) };
+			cache_lookup lookup{ acquire(key) };
+
+			if (lookup.pendingFetch)
+			{
+				try
+				{
+					complete(key, ttl, *lookup.pendingFetch, std::any{ fetch() });
+				}
+				catch (...)
+				{
+					fail(key, *lookup.pendingFetch, std::current_exception());
+					throw;
+				}
+			}
+
+			return std::any_cast<const Value&>(lookup.value.get());
+		}
+	};
+}
\ No newline at end of file
@@ -56,4 +56,18 @@ namespace mb
 
 		return url;
 	}
+
+	std::string_view get_url_path(std::string_view url)
+	{
+		size_t schemeEnd = url.find("://");
+		size_t pathStart = url.find('/', schemeEnd == std::string_view::npos ? 0 : schemeEnd + 3);
+
+		if (pathStart == std::string_view::npos)
+		{
+			return "/";
+		}
+
+		size_t queryStart = url.find('?', pathStart);
+		return url.substr(pathStart, queryStart == std::string_view::npos ? std::string_view::npos : queryStart - pathStart);
+	}
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ namespace mb
 	void append_query(std::string& url, std::string_view query);
 	void append_path(std::string& url, std::string_view path);
 	std::string build_url(std::string_view baseUrl, std::string_view path, std::string_view _query = "");
+	std::string_view get_url_path(std::string_view url);
 
 	template<typename PathComponents>
 	std::string build_url_path(const PathComponents& pathComponents)
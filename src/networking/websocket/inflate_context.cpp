@@ -0,0 +1,92 @@
+#include <fmt/format.h>
+
+#include "inflate_context.h"
+#include "websocket_error.h"
+
+namespace
+{
+	static constexpr int HEADER_WINDOW_BITS = 15 + 32;
+	static constexpr int RAW_WINDOW_BITS = -15;
+	static constexpr size_t MIN_BUFFER_SIZE = 16384;
+
+	int get_window_bits(std::string_view payload)
+	{
+		if (payload.size() < 2)
+		{
+			return RAW_WINDOW_BITS;
+		}
+
+		unsigned char first = static_cast<unsigned char>(payload[0]);
+		unsigned char second = static_cast<unsigned char>(payload[1]);
+
+		bool isGzip = first == 0x1f && second == 0x8b;
+		bool isZlib = (first & 0x0f) == Z_DEFLATED && ((first << 8) | second) % 31 == 0;
+
+		return isGzip || isZlib
+			? HEADER_WINDOW_BITS
+			: RAW_WINDOW_BITS;
+	}
+}
+
+namespace mb
+{
+	inflate_context::inflate_context()
+		: _stream{}, _buffer(MIN_BUFFER_SIZE, '\0')
+	{
+		if (inflateInit2(&_stream, HEADER_WINDOW_BITS) != Z_OK)
+		{
+			throw websocket_error{ "Initialising inflate context" };
+		}
+	}
+
+	inflate_context::~inflate_context()
+	{
+		inflateEnd(&_stream);
+	}
+
+	std::string_view inflate_context::inflate(std::string_view payload)
+	{
+		if (inflateReset2(&_stream, get_window_bits(payload)) != Z_OK)
+		{
+			throw websocket_error{ "Resetting inflate context" };
+		}
+
+		_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(payload.data()));
+		_stream.avail_in = static_cast<uInt>(payload.size());
+
+		size_t produced = 0;
+
+		while (true)
+		{
+			if (produced == _buffer.size())
+			{
+				_buffer.resize(_buffer.size() * 2);
+			}
+
+			_stream.next_out = reinterpret_cast<Bytef*>(_buffer.data() + produced);
+			_stream.avail_out = static_cast<uInt>(_buffer.size() - produced);
+
+			int result = ::inflate(&_stream, Z_SYNC_FLUSH);
+			produced = _buffer.size() - _stream.avail_out;
+
+			if (result == Z_STREAM_END)
+			{
+				break;
+			}
+
+			// Without output space a buffer error only means the buffer has to grow. With space left the input
+			// ran out before the end of the stream, and the partial message must not reach the parser
+			if (result == Z_BUF_ERROR && _stream.avail_out > 0)
+			{
+				throw websocket_error{ "Inflating message: payload ends before the end of the compressed stream" };
+			}
+
+			if (result != Z_OK && result != Z_BUF_ERROR)
+			{
+				throw websocket_error{ fmt::format("Inflating message: {}", _stream.msg ? _stream.msg : "unknown error") };
+			}
+		}
+
+		return std::string_view{ _buffer.data(), produced };
+	}
+}
\ No newline at end of file
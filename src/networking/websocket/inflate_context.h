@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <zlib.h>
+
+namespace mb
+{
+	class inflate_context
+	{
+	private:
+		z_stream _stream;
+		std::string _buffer;
+
+	public:
+		inflate_context();
+		~inflate_context();
+
+		inflate_context(const inflate_context&) = delete;
+		inflate_context(inflate_context&&) = delete;
+		inflate_context& operator=(const inflate_context&) = delete;
+		inflate_context& operator=(inflate_context&&) = delete;
+
+		std::string_view inflate(std::string_view payload);
+	};
+}
\ No newline at end of file
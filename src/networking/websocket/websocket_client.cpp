@@ -27,18 +27,87 @@ namespace
 
         return context;
     }
+
+    template<typename Client>
+    void initialise_endpoint(Client& endpoint, websocketpp::lib::asio::io_service& ioService)
+    {
+        endpoint.clear_access_channels(websocketpp::log::alevel::all);
+        endpoint.clear_error_channels(websocketpp::log::elevel::all);
+        endpoint.init_asio(&ioService);
+        endpoint.start_perpetual();
+        endpoint.set_tls_init_handler(bind(&on_tls_init));
+    }
+
+    template<typename Client>
+    void close_endpoint_connection(Client& endpoint, websocketpp::connection_hdl connectionHandle)
+    {
+        std::error_code errorCode;
+        auto connectionPtr = endpoint.get_con_from_hdl(connectionHandle, errorCode);
+        if (!connectionPtr)
+        {
+            return;
+        }
+
+        connectionPtr->close(websocketpp::close::status::normal, "", errorCode);
+
+        if (errorCode)
+        {
+            throw websocket_error{ fmt::format("Closing connection: {}", errorCode.message()) };
+        }
+
+        volatile bool closing = true;
+        while (closing)
+        {
+            closing = connectionPtr->get_state() == websocketpp::session::state::closing;
+        }
+    }
+
+    template<typename Client>
+    ws_connection_status get_endpoint_connection_status(Client& endpoint, websocketpp::connection_hdl connectionHandle)
+    {
+        std::error_code errorCode;
+        auto connectionPtr = endpoint.get_con_from_hdl(connectionHandle, errorCode);
+        
+        if (!connectionPtr || errorCode)
+        {
+            return ws_connection_status::CLOSED;
+        }
+
+        using namespace websocketpp::session;
+        state::value state = connectionPtr->get_state();
+
+        switch (state)
+        {
+        case state::closed:
+            return ws_connection_status::CLOSED;
+        case state::open:
+            return ws_connection_status::OPEN;
+        default:
+            throw std::logic_error{ "Websocket connection is in intermediary state" };
+        }
+    }
+
+    template<typename Client>
+    void send_endpoint_message(Client& endpoint, websocketpp::connection_hdl connectionHandle, std::string_view message)
+    {
+        std::error_code errorCode;
+
+        endpoint.send(connectionHandle, message.data(), message.size(), websocketpp::frame::opcode::text, errorCode);
+
+        if (errorCode)
+        {
+            throw websocket_error{ fmt::format("Sending message: {}", errorCode.message()) };
+        }
+    }
 }
 
 namespace mb
 {
     websocket_client::websocket_client()
-        :_client{}, _thread{}
+        :_ioService{}, _client{}, _deflateClient{}, _thread{}
     {
-        _client.clear_access_channels(websocketpp::log::alevel::all);
-        _client.clear_error_channels(websocketpp::log::elevel::all);
-        _client.init_asio();
-        _client.start_perpetual();
-        _client.set_tls_init_handler(bind(&on_tls_init));
+        initialise_endpoint(_client, _ioService);
+        initialise_endpoint(_deflateClient, _ioService);
         
         _thread = std::make_unique<std::thread>(&client::run, &_client);
     }
@@ -46,6 +115,7 @@ namespace mb
     websocket_client::~websocket_client()
     {
         _client.stop_perpetual();
+        _deflateClient.stop_perpetual();
         _thread->join();
     }
 
@@ -55,11 +125,12 @@ namespace mb
         return client;
     }
 
-    void websocket_client::connect(client::connection_ptr connectionPtr)
+    template<typename Client>
+    void websocket_client::connect(Client& endpoint, typename Client::connection_ptr connectionPtr)
     {
         try
         {
-            _client.connect(connectionPtr);
+            endpoint.connect(connectionPtr);
 
             volatile bool connecting = true;
             while (connecting)
@@ -79,72 +150,48 @@ namespace mb
         }
     }
 
+    template void websocket_client::connect<client>(client& endpoint, client::connection_ptr connectionPtr);
+    template void websocket_client::connect<deflate_client>(deflate_client& endpoint, deflate_client::connection_ptr connectionPtr);
+
     void websocket_client::set_open_handshake_timeout(int timeout)
     {
         _client.set_open_handshake_timeout(timeout);
+        _deflateClient.set_open_handshake_timeout(timeout);
     }
 
-    void websocket_client::close_connection(websocketpp::connection_hdl connectionHandle)
+    void websocket_client::close_connection(websocketpp::connection_hdl connectionHandle, ws_compression compression)
     {
         if (connectionHandle.expired())
         {
             return;
         }
 
-        std::error_code errorCode;
-        auto connectionPtr = _client.get_con_from_hdl(connectionHandle, errorCode);
-        if (!connectionPtr)
+        if (compression == ws_compression::PERMESSAGE_DEFLATE)
         {
-            return;
+            close_endpoint_connection(_deflateClient, connectionHandle);
         }
-
-        connectionPtr->close(websocketpp::close::status::normal, "", errorCode);
-
-        if (errorCode)
-        {
-            throw websocket_error{ fmt::format("Closing connection: {}", errorCode.message()) };
-        }
-
-        volatile bool closing = true;
-        while (closing)
+        else
         {
-            closing = connectionPtr->get_state() == websocketpp::session::state::closing;
+            close_endpoint_connection(_client, connectionHandle);
         }
     }
 
-    ws_connection_status websocket_client::get_connection_status(websocketpp::connection_hdl connectionHandle)
+    ws_connection_status websocket_client::get_connection_status(websocketpp::connection_hdl connectionHandle, ws_compression compression)
     {
-        std::error_code errorCode;
-        auto connectionPtr = _client.get_con_from_hdl(connectionHandle, errorCode);
-        
-        if (!connectionPtr || errorCode)
-        {
-            return ws_connection_status::CLOSED;
-        }
-
-        using namespace websocketpp::session;
-        state::value state = connectionPtr->get_state();
-
-        switch (state)
-        {
-        case state::closed:
-            return ws_connection_status::CLOSED;
-        case state::open:
-            return ws_connection_status::OPEN;
-        default:
-            throw std::logic_error{ "Websocket connection is in intermediary state" };
-        }
+        return compression == ws_compression::PERMESSAGE_DEFLATE
+            ? get_endpoint_connection_status(_deflateClient, connectionHandle)
+            : get_endpoint_connection_status(_client, connectionHandle);
     }
 
-    void websocket_client::send_message(websocketpp::connection_hdl connectionHandle, std::string_view message)
+    void websocket_client::send_message(websocketpp::connection_hdl connectionHandle, ws_compression compression, std::string_view message)
     {
-        std::error_code errorCode;
-
-        _client.send(connectionHandle, message.data(), websocketpp::frame::opcode::text, errorCode);
-
-        if (errorCode)
+        if (compression == ws_compression::PERMESSAGE_DEFLATE)
         {
-            throw websocket_error{ fmt::format("Sending message: {}", errorCode.message()) };
+            send_endpoint_message(_deflateClient, connectionHandle, message);
+        }
+        else
+        {
+            send_endpoint_message(_client, connectionHandle, message);
         }
     }
-}
+}
\ No newline at end of file
@@ -4,45 +4,48 @@
 
 #include <websocketpp/config/asio_client.hpp>
 #include <websocketpp/client.hpp>
+#include <websocketpp/extensions/permessage_deflate/enabled.hpp>
 #include "websocket_error.h"
 #include "websocket_constants.h"
 
 namespace mb
 {
+	struct deflate_tls_client_config : public websocketpp::config::asio_tls_client
+	{
+		typedef deflate_tls_client_config type;
+
+		struct permessage_deflate_config {};
+
+		typedef websocketpp::extensions::permessage_deflate::enabled<permessage_deflate_config> permessage_deflate_type;
+	};
+
 	typedef websocketpp::client<websocketpp::config::asio_tls_client> client;
+	typedef websocketpp::client<deflate_tls_client_config> deflate_client;
 	typedef websocketpp::lib::asio::ssl::context ssl_context;
 
 	class websocket_client
 	{
 	private:
+		websocketpp::lib::asio::io_service _ioService;
 		client _client;
+		deflate_client _deflateClient;
 		std::unique_ptr<std::thread> _thread;
 
 		websocket_client();
 
-		void connect(client::connection_ptr connectionPtr);
-
-	public:
-		~websocket_client();
-
-		websocket_client(const websocket_client&) = delete;
-		websocket_client(websocket_client&&) noexcept = delete;
-		websocket_client& operator=(const websocket_client&) = delete;
-		websocket_client& operator=(websocket_client&&) noexcept = delete;
-
-		static websocket_client& instance();
-
-		void set_open_handshake_timeout(int timeout);
+		template<typename Client>
+		void connect(Client& endpoint, typename Client::connection_ptr connectionPtr);
 
-		template<typename OnOpen, typename OnClose,	typename OnMessage>
-		websocketpp::connection_hdl create_connection(
+		template<typename Client, typename OnOpen, typename OnClose, typename OnMessage>
+		websocketpp::connection_hdl create_endpoint_connection(
+			Client& endpoint,
 			std::string_view url,
 			OnOpen onOpen,
 			OnClose onClose,
 			OnMessage onMessage)
 		{
 			std::error_code errorCode;
-			auto connectionPtr = _client.get_connection(url.data(), errorCode);
+			auto connectionPtr = endpoint.get_connection(url.data(), errorCode);
 
 			if (errorCode)
 			{
@@ -62,18 +65,43 @@ namespace mb
 				});
 
 			connectionPtr->set_message_handler(
-				[onMessage](websocketpp::connection_hdl, client::message_ptr message)
+				[onMessage](websocketpp::connection_hdl, typename Client::message_ptr message)
 				{
-					onMessage(message->get_payload());
+					onMessage(message->get_payload(), message->get_opcode() == websocketpp::frame::opcode::binary);
 				});
 
-			connect(connectionPtr);
+			connect(endpoint, connectionPtr);
 
 			return connectionPtr->get_handle();
 		}
+
+	public:
+		~websocket_client();
+
+		websocket_client(const websocket_client&) = delete;
+		websocket_client(websocket_client&&) noexcept = delete;
+		websocket_client& operator=(const websocket_client&) = delete;
+		websocket_client& operator=(websocket_client&&) noexcept = delete;
+
+		static websocket_client& instance();
+
+		void set_open_handshake_timeout(int timeout);
+
+		template<typename OnOpen, typename OnClose,	typename OnMessage>
+		websocketpp::connection_hdl create_connection(
+			std::string_view url,
+			ws_compression compression,
+			OnOpen onOpen,
+			OnClose onClose,
+			OnMessage onMessage)
+		{
+			return compression == ws_compression::PERMESSAGE_DEFLATE
+				? create_endpoint_connection(_deflateClient, url, std::move(onOpen), std::move(onClose), std::move(onMessage))
+				: create_endpoint_connection(_client, url, std::move(onOpen), std::move(onClose), std::move(onMessage));
+		}
 				
-		void close_connection(websocketpp::connection_hdl connectionHandle);
-		ws_connection_status get_connection_status(websocketpp::connection_hdl connectionHandle);
-		void send_message(websocketpp::connection_hdl connectionHandle, std::string_view message);
+		void close_connection(websocketpp::connection_hdl connectionHandle, ws_compression compression);
+		ws_connection_status get_connection_status(websocketpp::connection_hdl connectionHandle, ws_compression compression);
+		void send_message(websocketpp::connection_hdl connectionHandle, ws_compression compression, std::string_view message);
 	};
 }
\ No newline at end of file
@@ -1,31 +1,54 @@
 #include "websocket_connection.h"
+#include "inflate_context.h"
+#include "logging/logger.h"
 
 namespace mb
 {
-    websocket_connection::websocket_connection(websocketpp::connection_hdl connectionHandle)
+    websocket_connection::websocket_connection(websocketpp::connection_hdl connectionHandle, ws_compression compression)
         : 
         _client{ websocket_client::instance() }, 
-        _connectionHandle{ connectionHandle }
+        _connectionHandle{ connectionHandle },
+        _compression{ compression }
     {}
 
     void websocket_connection::close()
     {
-        _client.close_connection(_connectionHandle);
+        _client.close_connection(_connectionHandle, _compression);
     }
 
     void websocket_connection::send_message(std::string message)
     {
-        _client.send_message(_connectionHandle, message);
+        _client.send_message(_connectionHandle, _compression, message);
     }
 
     ws_connection_status websocket_connection::connection_status() const
     {
-        return _client.get_connection_status(_connectionHandle);
+        return _client.get_connection_status(_connectionHandle, _compression);
     }
 
     std::unique_ptr<websocket_connection> websocket_connection_factory::create_connection(std::string url) const
     {
-        auto handle =  websocket_client::instance().create_connection(url, _onOpen, _onClose, _onMessage);
-        return std::make_unique<websocket_connection>(handle);
+        std::shared_ptr<inflate_context> inflater{ _inflateBinaryFrames ? std::make_shared<inflate_context>() : nullptr };
+
+        auto onMessage = [onMessage = _onMessage, inflater](std::string_view payload, bool binary)
+        {
+            if (!binary || !inflater)
+            {
+                onMessage(payload);
+                return;
+            }
+
+            try
+            {
+                onMessage(inflater->inflate(payload));
+            }
+            catch (const websocket_error& e)
+            {
+                logger::instance().error(e.what());
+            }
+        };
+
+        auto handle = websocket_client::instance().create_connection(url, _compression, _onOpen, _onClose, std::move(onMessage));
+        return std::make_unique<websocket_connection>(handle, _compression);
     }
 }
\ No newline at end of file
@@ -13,9 +13,10 @@ namespace mb
     private:
         websocket_client& _client;
         websocketpp::connection_hdl _connectionHandle;
+        ws_compression _compression;
 
     public:
-        websocket_connection(websocketpp::connection_hdl connectionHandle);
+        websocket_connection(websocketpp::connection_hdl connectionHandle, ws_compression compression = ws_compression::NONE);
 
         virtual ~websocket_connection()
         {
@@ -43,14 +44,23 @@ namespace mb
         on_open _onOpen;
         on_close _onClose;
         on_message _onMessage;
+        ws_compression _compression;
+        bool _inflateBinaryFrames;
 
     public:
+        websocket_connection_factory(ws_compression compression = ws_compression::NONE, bool inflateBinaryFrames = false)
+            : _compression{ compression }, _inflateBinaryFrames{ inflateBinaryFrames }
+        {}
+
         virtual ~websocket_connection_factory() = default;
 
         void set_on_open(on_open onOpen) noexcept { _onOpen = std::move(onOpen); }
         void set_on_close(on_close onClose) noexcept { _onClose = std::move(onClose); }
         void set_on_message(on_message onMessage) noexcept { _onMessage = std::move(onMessage); }
 
+        ws_compression compression() const noexcept { return _compression; }
+        bool inflate_binary_frames() const noexcept { return _inflateBinaryFrames; }
+
         virtual std::unique_ptr<websocket_connection> create_connection(std::string url) const;
     };
 }
\ No newline at end of file
@@ -7,4 +7,10 @@ namespace mb
         CLOSED,
         OPEN
     };
+
+    enum class ws_compression
+    {
+        NONE,
+        PERMESSAGE_DEFLATE
+    };
 }
\ No newline at end of file
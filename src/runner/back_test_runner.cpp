@@ -0,0 +1,28 @@
+#include "back_test_runner.h"
+
+namespace mb::internal
+{
+	std::optional<back_test_checkpoint> load_checkpoint_if_enabled(const back_testing_config& config)
+	{
+		if (!config.resume_from_checkpoint())
+		{
+			return std::nullopt;
+		}
+
+		if (!std::filesystem::exists(config.checkpoint_file()))
+		{
+			logger::instance().warning("No back test checkpoint found at {}. Starting from the beginning", config.checkpoint_file());
+			return std::nullopt;
+		}
+
+		try
+		{
+			return load_back_test_checkpoint(config.checkpoint_file());
+		}
+		catch (const std::exception& e)
+		{
+			logger::instance().error("Error occurred loading back test checkpoint: {}. Starting from the beginning", e.what());
+			return std::nullopt;
+		}
+	}
+}
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <optional>
+#include <type_traits>
+
 #include "runner_implementation.h"
 #include "testing/back_testing/back_test_market_api.h"
 #include "testing/back_testing/back_testing_config.h"
 #include "testing/back_testing/data_loading/data_factory.h"
+#include "testing/back_testing/back_test_checkpoint.h"
 #include "testing/paper_trading/paper_trade_api.h"
 #include "testing/reporting/back_test_report.h"
 #include "testing/reporting/test_logger.h"
@@ -14,18 +18,99 @@
 
 namespace mb::internal
 {
+	template<typename Strategy, typename = void>
+	struct has_checkpoint_state : std::false_type {};
+
+	template<typename Strategy>
+	struct has_checkpoint_state<Strategy, std::void_t<
+		decltype(std::declval<const Strategy&>().save_state()),
+		decltype(std::declval<Strategy&>().load_state(std::declval<std::string_view>()))>>
+		: std::true_type {};
+
 	template<typename Strategy>
 	class back_test_runner : public runner_implementation<Strategy>
 	{
 	private:
 		back_testing_config _config;
+		std::optional<back_test_checkpoint> _checkpoint;
 		std::shared_ptr<back_testing_data> _backTestingData;
 		std::shared_ptr<backtest_websocket_stream> _websocketStream;
 		std::shared_ptr<paper_trade_api> _paperTradeApi;
 
+		test_logger create_or_restore_test_logger()
+		{
+			if (!_checkpoint)
+			{
+				return mb::create_test_logger({ _paperTradeApi }, _config.binary_trade_journal());
+			}
+
+			binary_reader loggerReader{ _checkpoint->test_logger_state() };
+			return restore_test_logger({ _paperTradeApi }, loggerReader);
+		}
+
+		int restore_checkpoint(Strategy& strategy)
+		{
+			if (!_checkpoint)
+			{
+				return 0;
+			}
+
+			binary_reader tradeApiReader{ _checkpoint->trade_api_state() };
+			_paperTradeApi->load_state(tradeApiReader);
+			_backTestingData->seek(_checkpoint->data_time());
+
+			if constexpr (has_checkpoint_state<Strategy>::value)
+			{
+				strategy.load_state(_checkpoint->strategy_state());
+			}
+
+			logger::instance().info("Resumed back test from time step {}", _checkpoint->time_step());
+			return _checkpoint->time_step();
+		}
+
+		void save_checkpoint(int timeStep, test_logger& testLogger, const Strategy& strategy)
+		{
+			binary_writer tradeApiWriter;
+			_paperTradeApi->save_state(tradeApiWriter);
+
+			binary_writer loggerWriter;
+			testLogger.save_state(loggerWriter);
+
+			std::string strategyState;
+			if constexpr (has_checkpoint_state<Strategy>::value)
+			{
+				strategyState = strategy.save_state();
+			}
+
+			try
+			{
+				save_back_test_checkpoint(_config.checkpoint_file(), back_test_checkpoint
+					{
+						_backTestingData->start_time(),
+						_backTestingData->end_time(),
+						_backTestingData->step_size(),
+						timeStep,
+						_backTestingData->data_time(),
+						tradeApiWriter.data(),
+						loggerWriter.data(),
+						std::move(strategyState)
+					});
+			}
+			catch (const std::exception& e)
+			{
+				logger::instance().error("Error occurred saving back test checkpoint: {}", e.what());
+			}
+		}
+
+		bool should_save_checkpoint(int completedSteps, int timeSteps) const noexcept
+		{
+			int interval{ _config.checkpoint_interval() };
+			return interval > 0 && completedSteps < timeSteps && completedSteps % interval == 0;
+		}
+
 	public:
-		back_test_runner(back_testing_config config)
-			: _config{ std::move(config) }
+		back_test_runner(back_testing_config config, std::optional<back_test_checkpoint> checkpoint = std::nullopt)
+			: _config{ std::move(config) }, _checkpoint{ std::move(checkpoint) }
 		{}
 
 		std::vector<std::shared_ptr<exchange>> create_exchanges(const runner_config& runnerConfig) override
@@ -53,11 +138,17 @@ namespace mb::internal
 
 		void run(Strategy& strategy) override
 		{
-			test_logger testLogger{ mb::create_test_logger({ _paperTradeApi }) };
+			if (_checkpoint && !_checkpoint->is_compatible(_backTestingData->start_time(), _backTestingData->end_time(), _backTestingData->step_size()))
+			{
+				logger::instance().warning("Back test checkpoint does not match the configured test range and will be ignored");
+				_checkpoint.reset();
+			}
+
+			test_logger testLogger{ create_or_restore_test_logger() };
 			int timeSteps{ _backTestingData->time_steps() };
 			int lastLoggedPercentage = -1;
 
-			for (int i = 0; i < timeSteps; ++i)
+			for (int i = restore_checkpoint(strategy); i < timeSteps; ++i)
 			{
 				int percentageComplete = calculate_percentage_proportion(1, timeSteps, i + 1);
 				
@@ -80,6 +171,17 @@ namespace mb::internal
 				}
 
 				_backTestingData->increment();
+
+				if (should_save_checkpoint(i + 1, timeSteps))
+				{
+					save_checkpoint(i + 1, testLogger, strategy);
+				}
+			}
+
+			if (_config.checkpoint_interval() > 0)
+			{
+				std::error_code errorCode;
+				std::filesystem::remove(_config.checkpoint_file(), errorCode);
 			}
 
 			logger::instance().info("Back test complete. Generating report...");
@@ -89,10 +191,14 @@ namespace mb::internal
 		}
 	};
 
+	std::optional<back_test_checkpoint> load_checkpoint_if_enabled(const back_testing_config& config);
+
 	template<typename Strategy>
 	std::unique_ptr<back_test_runner<Strategy>> create_back_test_runner()
 	{
 		back_testing_config config{ load_or_create_config<back_testing_config>() };
-		return std::make_unique<back_test_runner<Strategy>>(std::move(config));
+		std::optional<back_test_checkpoint> checkpoint{ load_checkpoint_if_enabled(config) };
+
+		return std::make_unique<back_test_runner<Strategy>>(std::move(config), std::move(checkpoint));
 	}
 }
\ No newline at end of file
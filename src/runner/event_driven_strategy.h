@@ -0,0 +1,77 @@
+#pragma once
+
+#include <type_traits>
+#include <unordered_set>
+
+#include "market_data_signal.h"
+#include "exchanges/exchange.h"
+#include "common/exceptions/mb_exception.h"
+#include "logging/logger.h"
+
+namespace mb::internal
+{
+	/*
+	* A strategy runs event driven in live modes when it declares the market data it cares about with
+	* market_data_interests() and handles changes with on_market_data(changedPairs), instead of being polled
+	* through run_iteration().
+	*/
+	template<typename Strategy, typename = void>
+	struct is_event_driven : std::false_type {};
+
+	template<typename Strategy>
+	struct is_event_driven<Strategy, std::void_t<
+		decltype(std::declval<const Strategy&>().market_data_interests()),
+		decltype(std::declval<Strategy&>().on_market_data(std::declval<const std::unordered_set<tradable_pair>&>()))>>
+		: std::true_type {};
+
+	template<typename Strategy, typename Exchange>
+	void watch_strategy_interests(const std::vector<std::shared_ptr<Exchange>>& exchanges, market_data_signal& signal, const Strategy& strategy)
+	{
+		std::vector<unique_websocket_subscription> interests{ strategy.market_data_interests() };
+
+		for (auto& exchange : exchanges)
+		{
+			watch_market_data(*exchange->get_websocket_stream(), signal, interests);
+		}
+
+		// The strategy subscribed while initialising, before anything was watching, so its first wake up
+		// covers every pair it is interested in rather than waiting for the next update
+		for (auto& interest : interests)
+		{
+			signal.notify(interest.pair_item());
+		}
+	}
+
+	// A positive run interval caps how long the strategy can sit idle, waking it with no changed pairs
+	inline std::unordered_set<tradable_pair> wait_for_market_data(market_data_signal& signal, int runInterval)
+	{
+		return runInterval > 0
+			? signal.wait_for(std::chrono::milliseconds(runInterval))
+			: signal.wait();
+	}
+
+	// Runs the strategy each time its market data changes until the signal is stopped
+	template<typename Strategy, typename AfterIteration>
+	void run_on_market_data(Strategy& strategy, market_data_signal& signal, int runInterval, const AfterIteration& afterIteration)
+	{
+		while (!signal.stopped())
+		{
+			std::unordered_set<tradable_pair> changedPairs{ wait_for_market_data(signal, runInterval) };
+
+			if (signal.stopped())
+			{
+				break;
+			}
+
+			try
+			{
+				strategy.on_market_data(changedPairs);
+				afterIteration();
+			}
+			catch (const mb_exception& e)
+			{
+				logger::instance().error(e.what());
+			}
+		}
+	}
+}
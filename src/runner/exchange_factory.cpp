@@ -84,6 +84,8 @@ namespace mb::internal
 	std::vector<std::shared_ptr<exchange>> create_exchange_apis(const runner_config& runnerConfig)
 	{
 		http_service::set_timeout(runnerConfig.http_timeout());
+		http_service::set_max_concurrent_requests(runnerConfig.http_max_concurrent_requests());
+		http_service::set_retry_policy_config(runnerConfig.http_retry_policy());
 		websocket_client::instance().set_open_handshake_timeout(runnerConfig.websocket_timeout());
 
 		logger::instance().info("Creating exchange APIs...");
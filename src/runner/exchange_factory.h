@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "runner_config.h"
@@ -9,5 +10,7 @@
 
 namespace mb::internal
 {
+	using exchange_api_factory = std::function<std::vector<std::shared_ptr<exchange>>(const runner_config&)>;
+
 	std::vector<std::shared_ptr<exchange>> create_exchange_apis(const runner_config& runnerConfig);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "runner_implementation.h"
 #include "exchange_factory.h"
+#include "event_driven_strategy.h"
 #include "logging/logger.h"
 
 namespace mb::internal
@@ -10,17 +11,18 @@ namespace mb::internal
 	class live_runner : public runner_implementation<Strategy>
 	{
 	private:
+		exchange_api_factory _createExchanges;
+		std::vector<std::shared_ptr<exchange>> _exchanges;
+		market_data_signal _marketDataSignal;
 		int _runInterval;
 
-	public:
-		std::vector<std::shared_ptr<exchange>> create_exchanges(const runner_config& runnerConfig) override
+		void run_event_driven(Strategy& strategy)
 		{
-			_runInterval = runnerConfig.run_interval();
-
-			return create_exchange_apis(runnerConfig);
+			watch_strategy_interests(_exchanges, _marketDataSignal, strategy);
+			run_on_market_data(strategy, _marketDataSignal, _runInterval, []() {});
 		}
 
-		void run(Strategy& strategy) override
+		void run_polling(Strategy& strategy)
 		{
 			while (true)
 			{
@@ -39,6 +41,37 @@ namespace mb::internal
 				}
 			}
 		}
+
+	public:
+		explicit live_runner(exchange_api_factory createExchanges = create_exchange_apis)
+			: _createExchanges{ std::move(createExchanges) }, _exchanges{}, _marketDataSignal{}, _runInterval{ 0 }
+		{}
+
+		std::vector<std::shared_ptr<exchange>> create_exchanges(const runner_config& runnerConfig) override
+		{
+			_runInterval = runnerConfig.run_interval();
+			_exchanges = _createExchanges(runnerConfig);
+
+			return _exchanges;
+		}
+
+		void run(Strategy& strategy) override
+		{
+			if constexpr (is_event_driven<Strategy>::value)
+			{
+				run_event_driven(strategy);
+			}
+			else
+			{
+				run_polling(strategy);
+			}
+		}
+
+		// Ends an event driven run, polling strategies run until the process exits
+		void stop()
+		{
+			_marketDataSignal.stop();
+		}
 	};
 
 	template<typename Strategy>
@@ -4,6 +4,7 @@
 
 #include "runner_implementation.h"
 #include "exchange_factory.h"
+#include "event_driven_strategy.h"
 #include "testing/reporting/test_report.h"
 #include "testing/reporting/test_logger.h"
 #include "logging/logger.h"
@@ -18,16 +19,49 @@ namespace mb::internal
 	class live_test_runner : public runner_implementation<Strategy>
 	{
 	private:
+		exchange_api_factory _createExchanges;
 		std::vector<std::shared_ptr<live_test_exchange>> _liveTestExchanges;
 		std::atomic_bool _run;
+		market_data_signal _marketDataSignal;
 		int _runInterval;
 
+		void run_event_driven(Strategy& strategy, test_logger& testLogger)
+		{
+			watch_strategy_interests(_liveTestExchanges, _marketDataSignal, strategy);
+			run_on_market_data(strategy, _marketDataSignal, _runInterval, [&testLogger]() { testLogger.flush_trades(); });
+		}
+
+		void run_polling(Strategy& strategy, test_logger& testLogger)
+		{
+			while (_run)
+			{
+				try
+				{
+					strategy.run_iteration();
+					testLogger.flush_trades();
+				}
+				catch (const mb_exception& e)
+				{
+					logger::instance().error(e.what());
+				}
+
+				if (_runInterval > 0)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(_runInterval));
+				}
+			}
+		}
+
 	public:
+		explicit live_test_runner(exchange_api_factory createExchanges = create_exchange_apis)
+			: _createExchanges{ std::move(createExchanges) }, _liveTestExchanges{}, _run{ false }, _marketDataSignal{}, _runInterval{ 0 }
+		{}
+
 		std::vector<std::shared_ptr<exchange>> create_exchanges(const runner_config& runnerConfig) override
 		{
 			_runInterval = runnerConfig.run_interval();
 
-			std::vector<std::shared_ptr<exchange>> exchangeApis{ create_exchange_apis(runnerConfig) };
+			std::vector<std::shared_ptr<exchange>> exchangeApis{ _createExchanges(runnerConfig) };
 			_liveTestExchanges.reserve(exchangeApis.size());
 
 			paper_trading_config paperTradingConfig{ load_or_create_config<paper_trading_config>() };
@@ -56,24 +90,19 @@ namespace mb::internal
 			test_logger testLogger{ create_test_logger(_liveTestExchanges) };
 			_run = true;
 
-			std::thread stopThread{ check_for_stop, std::ref(_run) };
-
-			while (_run)
+			std::thread stopThread{ [this]()
 			{
-				try
-				{
-					strategy.run_iteration();
-					testLogger.flush_trades();
-				}
-				catch (const mb_exception& e)
-				{
-					logger::instance().error(e.what());
-				}
+				check_for_stop(_run);
+				stop();
+			} };
 
-				if (_runInterval > 0)
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(_runInterval));
-				}
+			if constexpr (is_event_driven<Strategy>::value)
+			{
+				run_event_driven(strategy, testLogger);
+			}
+			else
+			{
+				run_polling(strategy, testLogger);
 			}
 
 			stopThread.join();
@@ -84,6 +113,12 @@ namespace mb::internal
 			test_report report{ testLogger.generate_test_report(0, strategy.get_test_results()) };
 			testLogger.log_test_report(report);
 		}
+
+		void stop()
+		{
+			_run = false;
+			_marketDataSignal.stop();
+		}
 	};
 
 	template<typename Strategy>
@@ -0,0 +1,109 @@
+#include <memory>
+
+#include "market_data_signal.h"
+
+namespace mb
+{
+	market_data_signal::market_data_signal()
+		: _changedPairs{}, _stopped{ false }, _mutex{}, _condition{}
+	{}
+
+	std::unordered_set<tradable_pair> market_data_signal::take_changed_pairs()
+	{
+		std::unordered_set<tradable_pair> changedPairs;
+		changedPairs.swap(_changedPairs);
+
+		return changedPairs;
+	}
+
+	void market_data_signal::notify(const tradable_pair& pair)
+	{
+		bool wake = false;
+
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+
+			if (_stopped)
+			{
+				return;
+			}
+
+			// Only the first change since the last wait needs to wake the waiter, the rest are picked up with it
+			wake = _changedPairs.empty();
+			_changedPairs.insert(pair);
+		}
+
+		if (wake)
+		{
+			_condition.notify_one();
+		}
+	}
+
+	void market_data_signal::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ _mutex };
+			_stopped = true;
+		}
+
+		_condition.notify_all();
+	}
+
+	bool market_data_signal::stopped() const
+	{
+		std::lock_guard<std::mutex> lock{ _mutex };
+		return _stopped;
+	}
+
+	std::unordered_set<tradable_pair> market_data_signal::wait()
+	{
+		std::unique_lock<std::mutex> lock{ _mutex };
+		_condition.wait(lock, [this]() { return _stopped || !_changedPairs.empty(); });
+
+		return take_changed_pairs();
+	}
+
+	std::unordered_set<tradable_pair> market_data_signal::wait_for(std::chrono::milliseconds timeout)
+	{
+		std::unique_lock<std::mutex> lock{ _mutex };
+		_condition.wait_for(lock, timeout, [this]() { return _stopped || !_changedPairs.empty(); });
+
+		return take_changed_pairs();
+	}
+
+	void watch_market_data(websocket_stream& stream, market_data_signal& signal, std::vector<unique_websocket_subscription> interests)
+	{
+		auto interestSet = std::make_shared<const std::unordered_set<unique_websocket_subscription>>(
+			std::make_move_iterator(interests.begin()),
+			std::make_move_iterator(interests.end()));
+
+		auto is_interesting = [interestSet](const unique_websocket_subscription& subscription)
+		{
+			return interestSet->find(subscription) != interestSet->end();
+		};
+
+		stream.add_trade_update_handler([&signal, is_interesting](trade_update_message message)
+		{
+			if (is_interesting(unique_websocket_subscription::create_trade_sub(message.pair())))
+			{
+				signal.notify(message.pair());
+			}
+		});
+
+		stream.add_ohlcv_update_handler([&signal, is_interesting](ohlcv_update_message message)
+		{
+			if (is_interesting(unique_websocket_subscription::create_ohlcv_sub(message.pair(), message.interval())))
+			{
+				signal.notify(message.pair());
+			}
+		});
+
+		stream.add_order_book_update_handler([&signal, is_interesting](order_book_update_message message)
+		{
+			if (is_interesting(unique_websocket_subscription::create_order_book_sub(message.pair())))
+			{
+				signal.notify(message.pair());
+			}
+		});
+	}
+}
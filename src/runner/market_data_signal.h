@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "trading/tradable_pair.h"
+#include "exchanges/websockets/websocket_stream.h"
+#include "exchanges/websockets/websocket_subscription.h"
+
+namespace mb
+{
+	/*
+	* Wakes a waiting thread when market data changes. Notifications for the same pair are coalesced until the
+	* waiter collects them, so a burst of updates costs one wake up and a waiter that is idle uses no CPU.
+	*/
+	class market_data_signal
+	{
+	private:
+		std::unordered_set<tradable_pair> _changedPairs;
+		bool _stopped;
+		mutable std::mutex _mutex;
+		std::condition_variable _condition;
+
+		std::unordered_set<tradable_pair> take_changed_pairs();
+
+	public:
+		market_data_signal();
+
+		void notify(const tradable_pair& pair);
+		void stop();
+		bool stopped() const;
+
+		// Blocks until a pair changes or the signal is stopped, and returns every pair changed since the last wait
+		std::unordered_set<tradable_pair> wait();
+
+		// As wait, but gives up after the timeout and returns whatever has changed, which may be nothing
+		std::unordered_set<tradable_pair> wait_for(std::chrono::milliseconds timeout);
+	};
+
+	void watch_market_data(websocket_stream& stream, market_data_signal& signal, std::vector<unique_websocket_subscription> interests);
+}
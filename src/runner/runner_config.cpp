@@ -8,6 +8,7 @@ namespace
 
 	static constexpr int DEFAULT_WEBSOCKET_TIMEOUT = 5000;
 	static constexpr int DEFAULT_HTTP_TIMEOUT = 5000;
+	static constexpr int DEFAULT_HTTP_MAX_CONCURRENT_REQUESTS = 8;
 
 	namespace json_property_names
 	{
@@ -17,6 +18,12 @@ namespace
 		static constexpr std::string_view HTTP_TIMEOUT = "httpTimeout";
 		static constexpr std::string_view RUN_INTERVAL = "runInterval";
 		static constexpr std::string_view SYNC_TIME = "syncTime";
+		static constexpr std::string_view HTTP_MAX_CONCURRENT_REQUESTS = "httpMaxConcurrentRequests";
+		static constexpr std::string_view HTTP_MAX_RETRIES = "httpMaxRetries";
+		static constexpr std::string_view HTTP_RETRY_BASE_DELAY = "httpRetryBaseDelay";
+		static constexpr std::string_view HTTP_RETRY_MAX_DELAY = "httpRetryMaxDelay";
+		static constexpr std::string_view HTTP_RETRY_BUDGET_RATIO = "httpRetryBudgetRatio";
+		static constexpr std::string_view HTTP_HEDGE_DELAY = "httpHedgeDelay";
 	}
 
 	namespace run_mode_strings
@@ -26,6 +33,20 @@ namespace
 		static constexpr std::string_view BACK_TEST = "back_test";
 		static constexpr std::string_view UNKNOWN = "unknown";
 	}
+
+	retry_policy_config read_retry_policy_config(const json_document& json)
+	{
+		retry_policy_config defaultConfig;
+
+		return retry_policy_config
+		{
+			json.get_or_default<int>(json_property_names::HTTP_MAX_RETRIES, defaultConfig.max_retries()),
+			std::chrono::milliseconds{ json.get_or_default<int>(json_property_names::HTTP_RETRY_BASE_DELAY, static_cast<int>(defaultConfig.base_delay().count())) },
+			std::chrono::milliseconds{ json.get_or_default<int>(json_property_names::HTTP_RETRY_MAX_DELAY, static_cast<int>(defaultConfig.max_delay().count())) },
+			json.get_or_default<double>(json_property_names::HTTP_RETRY_BUDGET_RATIO, defaultConfig.budget_ratio()),
+			std::chrono::milliseconds{ json.get_or_default<int>(json_property_names::HTTP_HEDGE_DELAY, static_cast<int>(defaultConfig.hedge_delay().count())) }
+		};
+	}
 }
 
 namespace mb
@@ -64,7 +85,7 @@ namespace mb
 	}
 
 	runner_config::runner_config()
-		: runner_config{ {}, run_mode::LIVETEST, DEFAULT_WEBSOCKET_TIMEOUT, DEFAULT_HTTP_TIMEOUT, 0, false }
+		: runner_config{ {}, run_mode::LIVETEST, DEFAULT_WEBSOCKET_TIMEOUT, DEFAULT_HTTP_TIMEOUT, 0, false, DEFAULT_HTTP_MAX_CONCURRENT_REQUESTS, retry_policy_config{} }
 	{}
 
 	runner_config::runner_config(
@@ -73,14 +94,18 @@ namespace mb
 		int websocketTimeout,
 		int httpTimeout,
 		int runInterval,
-		bool syncTime)
+		bool syncTime,
+		int httpMaxConcurrentRequests,
+		retry_policy_config httpRetryPolicy)
 		:
 		_exchangeIds{ std::move(exchangeIds) },
 		_runMode{ runMode },
 		_websocketTimeout{ websocketTimeout },
 		_httpTimeout{ httpTimeout },
 		_runInterval{ runInterval },
-		_syncTime{ syncTime }
+		_syncTime{ syncTime },
+		_httpMaxConcurrentRequests{ httpMaxConcurrentRequests },
+		_httpRetryPolicy{ std::move(httpRetryPolicy) }
 	{
 		validate();
 	}
@@ -104,6 +129,12 @@ namespace mb
 			_runInterval = 0;
 			log.warning("Run interval cannot be less than zero");
 		}
+
+		if (_httpMaxConcurrentRequests < 1)
+		{
+			_httpMaxConcurrentRequests = 1;
+			log.warning("HTTP max concurrent requests cannot be less than one");
+		}
 	}
 
 	template<>
@@ -116,7 +147,9 @@ namespace mb
 			json.get<int>(json_property_names::WEBSOCKET_TIMEOUT),
 			json.get<int>(json_property_names::HTTP_TIMEOUT),
 			json.get<int>(json_property_names::RUN_INTERVAL),
-			json.get<bool>(json_property_names::SYNC_TIME)
+			json.get<bool>(json_property_names::SYNC_TIME),
+			json.get_or_default<int>(json_property_names::HTTP_MAX_CONCURRENT_REQUESTS, DEFAULT_HTTP_MAX_CONCURRENT_REQUESTS),
+			read_retry_policy_config(json)
 		};
 	}
 
@@ -129,5 +162,11 @@ namespace mb
 		writer.add(json_property_names::HTTP_TIMEOUT, config.http_timeout());
 		writer.add(json_property_names::RUN_INTERVAL, config.run_interval());
 		writer.add(json_property_names::SYNC_TIME, config.sync_time());
+		writer.add(json_property_names::HTTP_MAX_CONCURRENT_REQUESTS, config.http_max_concurrent_requests());
+		writer.add(json_property_names::HTTP_MAX_RETRIES, config.http_retry_policy().max_retries());
+		writer.add(json_property_names::HTTP_RETRY_BASE_DELAY, static_cast<int>(config.http_retry_policy().base_delay().count()));
+		writer.add(json_property_names::HTTP_RETRY_MAX_DELAY, static_cast<int>(config.http_retry_policy().max_delay().count()));
+		writer.add(json_property_names::HTTP_RETRY_BUDGET_RATIO, config.http_retry_policy().budget_ratio());
+		writer.add(json_property_names::HTTP_HEDGE_DELAY, static_cast<int>(config.http_retry_policy().hedge_delay().count()));
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "common/json/json.h"
+#include "common/utils/retry.h"
 
 namespace mb
 {
@@ -23,6 +24,8 @@ namespace mb
 		int _httpTimeout;
 		int _runInterval;
 		bool _syncTime;
+		int _httpMaxConcurrentRequests;
+		retry_policy_config _httpRetryPolicy;
 
 		void validate();
 
@@ -35,7 +38,9 @@ namespace mb
 			int websocketTimeout,
 			int httpTimeout,
 			int runInterval,
-			bool syncTime);
+			bool syncTime,
+			int httpMaxConcurrentRequests,
+			retry_policy_config httpRetryPolicy);
 			
 		static std::string name() noexcept { return "runner"; }
 		
@@ -43,6 +48,8 @@ namespace mb
 		constexpr run_mode runmode() const noexcept { return _runMode; }
 		constexpr int websocket_timeout() const noexcept { return _websocketTimeout; }
 		constexpr int http_timeout() const noexcept { return _httpTimeout; }
+		constexpr int http_max_concurrent_requests() const noexcept { return _httpMaxConcurrentRequests; }
+		constexpr const retry_policy_config& http_retry_policy() const noexcept { return _httpRetryPolicy; }
 		constexpr int run_interval() const noexcept { return _runInterval; }
 		constexpr bool sync_time() const noexcept { return _syncTime; }
 	};
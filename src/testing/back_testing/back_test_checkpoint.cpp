@@ -0,0 +1,93 @@
+#include "back_test_checkpoint.h"
+#include "common/file/binary_stream.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace
+{
+	static constexpr std::uint32_t CHECKPOINT_MAGIC = 0x4B43424D;
+	static constexpr std::uint32_t CHECKPOINT_VERSION = 6;
+}
+
+namespace mb
+{
+	back_test_checkpoint::back_test_checkpoint(
+		std::time_t startTime,
+		std::time_t endTime,
+		int stepSize,
+		int timeStep,
+		std::time_t dataTime,
+		std::string tradeApiState,
+		std::string testLoggerState,
+		std::string strategyState)
+		:
+		_startTime{ startTime },
+		_endTime{ endTime },
+		_stepSize{ stepSize },
+		_timeStep{ timeStep },
+		_dataTime{ dataTime },
+		_tradeApiState{ std::move(tradeApiState) },
+		_testLoggerState{ std::move(testLoggerState) },
+		_strategyState{ std::move(strategyState) }
+	{}
+
+	bool back_test_checkpoint::is_compatible(std::time_t startTime, std::time_t endTime, int stepSize) const noexcept
+	{
+		return _startTime == startTime && _endTime == endTime && _stepSize == stepSize;
+	}
+
+	void save_back_test_checkpoint(const std::filesystem::path& path, const back_test_checkpoint& checkpoint)
+	{
+		binary_writer writer;
+
+		writer
+			.write(CHECKPOINT_MAGIC)
+			.write(CHECKPOINT_VERSION)
+			.write(checkpoint.start_time())
+			.write(checkpoint.end_time())
+			.write(checkpoint.step_size())
+			.write(checkpoint.time_step())
+			.write(checkpoint.data_time())
+			.write_string(checkpoint.trade_api_state())
+			.write_string(checkpoint.test_logger_state())
+			.write_string(checkpoint.strategy_state());
+
+		write_binary_file(path, writer.data());
+	}
+
+	back_test_checkpoint load_back_test_checkpoint(const std::filesystem::path& path)
+	{
+		std::string data{ read_binary_file(path) };
+		binary_reader reader{ data };
+
+		if (reader.read<std::uint32_t>() != CHECKPOINT_MAGIC)
+		{
+			throw mb_exception{ "File is not a back test checkpoint" };
+		}
+
+		if (reader.read<std::uint32_t>() != CHECKPOINT_VERSION)
+		{
+			throw mb_exception{ "Back test checkpoint version is not supported" };
+		}
+
+		std::time_t startTime{ reader.read<std::time_t>() };
+		std::time_t endTime{ reader.read<std::time_t>() };
+		int stepSize{ reader.read<int>() };
+		int timeStep{ reader.read<int>() };
+		std::time_t dataTime{ reader.read<std::time_t>() };
+		std::string tradeApiState{ reader.read_string() };
+		std::string testLoggerState{ reader.read_string() };
+		std::string strategyState{ reader.read_string() };
+
+		return back_test_checkpoint
+		{
+			startTime,
+			endTime,
+			stepSize,
+			timeStep,
+			dataTime,
+			std::move(tradeApiState),
+			std::move(testLoggerState),
+			std::move(strategyState)
+		};
+	}
+}
\ No newline at end of file
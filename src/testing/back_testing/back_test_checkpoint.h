@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <filesystem>
+
+#include <ctime>
+
+namespace mb
+{
+	class back_test_checkpoint
+	{
+	private:
+		std::time_t _startTime;
+		std::time_t _endTime;
+		int _stepSize;
+		int _timeStep;
+		std::time_t _dataTime;
+		std::string _tradeApiState;
+		std::string _testLoggerState;
+		std::string _strategyState;
+
+	public:
+		back_test_checkpoint(
+			std::time_t startTime,
+			std::time_t endTime,
+			int stepSize,
+			int timeStep,
+			std::time_t dataTime,
+			std::string tradeApiState,
+			std::string testLoggerState,
+			std::string strategyState);
+
+		std::time_t start_time() const noexcept { return _startTime; }
+		std::time_t end_time() const noexcept { return _endTime; }
+		int step_size() const noexcept { return _stepSize; }
+		int time_step() const noexcept { return _timeStep; }
+		std::time_t data_time() const noexcept { return _dataTime; }
+		const std::string& trade_api_state() const noexcept { return _tradeApiState; }
+		const std::string& test_logger_state() const noexcept { return _testLoggerState; }
+		const std::string& strategy_state() const noexcept { return _strategyState; }
+
+		bool is_compatible(std::time_t startTime, std::time_t endTime, int stepSize) const noexcept;
+	};
+
+	void save_back_test_checkpoint(const std::filesystem::path& path, const back_test_checkpoint& checkpoint);
+	back_test_checkpoint load_back_test_checkpoint(const std::filesystem::path& path);
+}
\ No newline at end of file
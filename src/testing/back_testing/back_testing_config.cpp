@@ -9,6 +9,10 @@ namespace
 		static constexpr std::string_view STEP_SIZE = "stepSize";
 		static constexpr std::string_view DATA_DIRECTORY = "dataDirectory";
 		static constexpr std::string_view DYNAMIC_LOAD = "dynamicDataLoad";
+		static constexpr std::string_view CHECKPOINT_INTERVAL = "checkpointInterval";
+		static constexpr std::string_view CHECKPOINT_FILE = "checkpointFile";
+		static constexpr std::string_view RESUME_FROM_CHECKPOINT = "resumeFromCheckpoint";
+		static constexpr std::string_view BINARY_TRADE_JOURNAL = "binaryTradeJournal";
 	}
 }
 
@@ -20,7 +24,11 @@ namespace mb
 		_endTime{ 0 },
 		_stepSize{ 60 },
 		_dataDirectory{ "back_test_data" },
-		_dynamicLoad{ false }
+		_dynamicLoad{ false },
+		_checkpointInterval{ 0 },
+		_checkpointFile{ DEFAULT_CHECKPOINT_FILE },
+		_resumeFromCheckpoint{ false },
+		_binaryTradeJournal{ false }
 	{}
 
 	back_testing_config::back_testing_config(
@@ -28,13 +36,21 @@ namespace mb
 		std::time_t endTime,
 		int stepSize,
 		std::string dataDirectory,
-		bool dynamicLoad)
+		bool dynamicLoad,
+		int checkpointInterval,
+		std::string checkpointFile,
+		bool resumeFromCheckpoint,
+		bool binaryTradeJournal)
 		:
 		_startTime{ startTime },
 		_endTime{ endTime },
 		_stepSize{ stepSize },
 		_dataDirectory{ std::move(dataDirectory) },
-		_dynamicLoad{ dynamicLoad }
+		_dynamicLoad{ dynamicLoad },
+		_checkpointInterval{ checkpointInterval },
+		_checkpointFile{ std::move(checkpointFile) },
+		_resumeFromCheckpoint{ resumeFromCheckpoint },
+		_binaryTradeJournal{ binaryTradeJournal }
 	{
 		validate();
 	}
@@ -53,6 +69,7 @@ namespace mb
 		}
 
 		assert_throw(_stepSize > 0, "Step size must be greater than zero");
+		assert_throw(_checkpointInterval >= 0, "Checkpoint interval cannot be less than zero");
 	}
 
 	template<>
@@ -64,7 +81,11 @@ namespace mb
 			json.get<std::time_t>(json_property_names::END_TIME),
 			json.get<int>(json_property_names::STEP_SIZE),
 			json.get<std::string>(json_property_names::DATA_DIRECTORY),
-			json.get<bool>(json_property_names::DYNAMIC_LOAD)
+			json.get<bool>(json_property_names::DYNAMIC_LOAD),
+			json.get_or_default<int>(json_property_names::CHECKPOINT_INTERVAL, 0),
+			json.get_or_default<std::string>(json_property_names::CHECKPOINT_FILE, std::string{ back_testing_config::DEFAULT_CHECKPOINT_FILE }),
+			json.get_or_default<bool>(json_property_names::RESUME_FROM_CHECKPOINT, false),
+			json.get_or_default<bool>(json_property_names::BINARY_TRADE_JOURNAL, false)
 		};
 	}
 
@@ -76,5 +97,9 @@ namespace mb
 		writer.add(json_property_names::STEP_SIZE, config.step_size());
 		writer.add(json_property_names::DATA_DIRECTORY, config.data_directory());
 		writer.add(json_property_names::DYNAMIC_LOAD, config.dynamic_load());
+		writer.add(json_property_names::CHECKPOINT_INTERVAL, config.checkpoint_interval());
+		writer.add(json_property_names::CHECKPOINT_FILE, config.checkpoint_file());
+		writer.add(json_property_names::RESUME_FROM_CHECKPOINT, config.resume_from_checkpoint());
+		writer.add(json_property_names::BINARY_TRADE_JOURNAL, config.binary_trade_journal());
 	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "common/json/json.h"
 #include "common/utils/generalutils.h"
@@ -16,10 +17,16 @@ namespace mb
 		int _stepSize;
 		std::string _dataDirectory;
 		bool _dynamicLoad;
+		int _checkpointInterval;
+		std::string _checkpointFile;
+		bool _resumeFromCheckpoint;
+		bool _binaryTradeJournal;
 
 		void validate();
 
 	public:
+		static constexpr std::string_view DEFAULT_CHECKPOINT_FILE = "back_test_checkpoint.bin";
+
 		back_testing_config();
 
 		back_testing_config(
@@ -27,7 +34,11 @@ namespace mb
 			std::time_t endTime,
 			int stepSize,
 			std::string dataDirectory,
-			bool dynamicLoad);
+			bool dynamicLoad,
+			int checkpointInterval = 0,
+			std::string checkpointFile = std::string{ DEFAULT_CHECKPOINT_FILE },
+			bool resumeFromCheckpoint = false,
+			bool binaryTradeJournal = false);
 
 		static std::string name() noexcept { return "back_testing"; }
 
@@ -36,6 +47,10 @@ namespace mb
 		int step_size() const noexcept { return _stepSize; }
 		const std::string& data_directory() const noexcept { return _dataDirectory; }
 		bool dynamic_load() const noexcept { return _dynamicLoad; }
+		int checkpoint_interval() const noexcept { return _checkpointInterval; }
+		const std::string& checkpoint_file() const noexcept { return _checkpointFile; }
+		bool resume_from_checkpoint() const noexcept { return _resumeFromCheckpoint; }
+		bool binary_trade_journal() const noexcept { return _binaryTradeJournal; }
 	};
 
 	template<>
@@ -43,4 +58,4 @@ namespace mb
 
 	template<>
 	void to_json<back_testing_config>(const back_testing_config& config, json_writer& writer);
-}
+}
\ No newline at end of file
@@ -8,52 +8,32 @@ namespace
 {
 	using namespace mb;
 
-	template<typename StartIt, typename EndIt>
-	ohlcv_data merge_ohlcv(StartIt start, EndIt end, std::time_t targetTime)
+	std::optional<size_t> get_index(const ohlcv_series& data, const tradable_pair& pair, std::time_t time, index_cache& cache)
 	{
-		double open = start->open();
-		double high = start->high();
-		double low = start->low();
-		double close = start->close();
-		double volume = start->volume();
+		const aligned_vector<std::time_t>& timeStamps{ data.time_stamps() };
 
-		for (auto it = std::next(start); it < end; ++it)
-		{
-			const ohlcv_data& data = *it;
-
-			high = std::max(high, data.high());
-			low = std::min(low, data.low());
-			close = data.close();
-			volume += data.volume();
-		}
-
-		return ohlcv_data{ targetTime, open, high, low, close, volume };
-	}
-
-	std::optional<data_iterator> get_iterator(const std::vector<ohlcv_data>& data, const tradable_pair& pair, std::time_t time, iterator_cache& cache)
-	{
-		if (data.empty() || time < data.front().time_stamp())
+		if (timeStamps.empty() || time < timeStamps.front())
 		{
 			return std::nullopt;
 		}
 
-		if (time > data.back().time_stamp())
+		if (time > timeStamps.back())
 		{
-			return std::prev(data.end());
+			return timeStamps.size() - 1;
 		}
 
 		auto cacheIt = cache.find(pair);
-		auto it = cacheIt == cache.end()
-			? data.begin()
+		size_t index = cacheIt == cache.end()
+			? 0
 			: cacheIt->second;
 
-		for (it; it != data.end(); ++it)
+		for (; index < timeStamps.size(); ++index)
 		{
-			std::time_t timeStamp = it->time_stamp();
+			std::time_t timeStamp = timeStamps[index];
 
 			if (timeStamp > time)
 			{
-				--it;
+				--index;
 				break;
 			}
 
@@ -63,8 +43,8 @@ namespace
 			}
 		}
 
-		cache[pair] = it;
-		return it;
+		cache[pair] = index;
+		return index;
 	}
 }
 
@@ -80,17 +60,22 @@ namespace mb
 		std::unique_ptr<back_testing_data_source> dataSource)
 		: 
 		_tradablePairs{ std::move(tradablePairs) }, 
-		_data{ std::move(data) }, 
+		_data{}, 
 		_startTime{ startTime },
 		_endTime{ endTime },
 		_stepSize{ step_size },
 		_timeSteps{ size },
 		_dataSource{ std::move(dataSource) },
 		_dataTime{ _startTime }, 
-		_iteratorCache{}
-	{}
+		_indexCache{}
+	{
+		for (auto& [pair, pairData] : data)
+		{
+			_data.emplace(pair, ohlcv_series{ pairData });
+		}
+	}
 
-	const std::vector<ohlcv_data>& back_testing_data::get_or_load_data(const tradable_pair& pair)
+	const ohlcv_series& back_testing_data::get_or_load_data(const tradable_pair& pair)
 	{
 		auto it = _data.find(pair);
 		if (it != _data.end())
@@ -100,11 +85,10 @@ namespace mb
 
 		if (_dataSource)
 		{
-			std::vector<ohlcv_data> data{ _dataSource->load_data(pair, _stepSize) };
-			return _data[pair] = std::move(data);
+			return _data[pair] = ohlcv_series{ _dataSource->load_data(pair, _stepSize) };
 		}
 
-		return _data[pair] = {};
+		return _data[pair];
 	}
 
 	void back_testing_data::increment()
@@ -112,48 +96,54 @@ namespace mb
 		_dataTime += _stepSize;
 	}
 
+	void back_testing_data::seek(std::time_t dataTime)
+	{
+		_dataTime = dataTime;
+		_indexCache.clear();
+	}
+
 	std::vector<ohlcv_data> back_testing_data::get_ohlcv(const tradable_pair& pair, int interval, int count)
 	{
-		const std::vector<ohlcv_data>& pairData{ get_or_load_data(pair) };
+		const ohlcv_series& pairData{ get_or_load_data(pair) };
 
 		if (pairData.empty())
 		{
 			return {};
 		}
 
-		std::optional<data_iterator> optionalIterator = get_iterator(pairData, pair, _dataTime, _iteratorCache);
-		std::time_t startTime = pairData.begin()->time_stamp();
+		const aligned_vector<std::time_t>& timeStamps{ pairData.time_stamps() };
+		std::optional<size_t> optionalIndex = get_index(pairData, pair, _dataTime, _indexCache);
+		std::time_t startTime = timeStamps.front();
 
-		if (!optionalIterator.has_value() ||
-			*optionalIterator == pairData.begin() && _dataTime == startTime)
+		if (!optionalIndex.has_value() ||
+			*optionalIndex == 0 && _dataTime == startTime)
 		{
 			return {};
 		}
 
 		std::time_t targetTime = _dataTime;
-		data_iterator end = *optionalIterator;
+		size_t end = *optionalIndex;
 		std::vector<ohlcv_data> data;
 		data.reserve(count);
 
 		for (int i = 0; i < count; ++i)
 		{
 			targetTime = std::max(targetTime - interval, startTime);
-			data_iterator start = end;
+			size_t start = end;
 
-			if (targetTime + interval > end->time_stamp())
+			if (targetTime + interval > timeStamps[end])
 			{
 				++end;
 			}
 
-			while (start->time_stamp() > targetTime && start != pairData.begin())
+			while (timeStamps[start] > targetTime && start != 0)
 			{
 				start--;
 			}
 
-			ohlcv_data mergedOhlcv{ merge_ohlcv(start, end, targetTime) };
-			data.emplace_back(std::move(mergedOhlcv));
+			data.emplace_back(pairData.merge(start, end, targetTime));
 
-			if (targetTime == startTime && start == pairData.begin())
+			if (targetTime == startTime && start == 0)
 			{
 				break;
 			}
@@ -166,18 +156,18 @@ namespace mb
 
 	trade_update back_testing_data::get_trade(const tradable_pair& pair)
 	{
-		const std::vector<ohlcv_data>& pairData{ get_or_load_data(pair) };
+		const ohlcv_series& pairData{ get_or_load_data(pair) };
 
-		std::optional<data_iterator> iterator = get_iterator(pairData, pair, _dataTime, _iteratorCache);
+		std::optional<size_t> index = get_index(pairData, pair, _dataTime, _indexCache);
 
-		if (!iterator.has_value())
+		if (!index.has_value())
 		{
 			return trade_update{0,0,0};
 		}
 
-		const ohlcv_data& ohlcvData = *iterator.value();
+		ohlcv_data ohlcvData{ pairData[index.value()] };
 		double price;
-		if (std::next(iterator.value()) == pairData.end() && _dataTime > ohlcvData.time_stamp())
+		if (index.value() + 1 == pairData.size() && _dataTime > ohlcvData.time_stamp())
 		{
 			price = ohlcvData.close();
 		}
@@ -191,15 +181,15 @@ namespace mb
 
 	order_book_state back_testing_data::get_order_book(const tradable_pair& pair, int depth)
 	{
-		const std::vector<ohlcv_data>& pairData{ get_or_load_data(pair) };
-		std::optional<data_iterator> iterator = get_iterator(pairData, pair, _dataTime, _iteratorCache);
+		const ohlcv_series& pairData{ get_or_load_data(pair) };
+		std::optional<size_t> index = get_index(pairData, pair, _dataTime, _indexCache);
 
-		if (!iterator.has_value())
+		if (!index.has_value())
 		{
 			return order_book_state{ 0, {},{} };
 		}
 
-		const ohlcv_data& ohlcvData = *iterator.value();
+		ohlcv_data ohlcvData{ pairData[index.value()] };
 		return order_book_state
 		{
 			ohlcvData.time_stamp(),
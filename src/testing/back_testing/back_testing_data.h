@@ -6,19 +6,19 @@
 #include "data_loading/back_testing_data_source.h"
 #include "trading/tradable_pair.h"
 #include "trading/ohlcv_data.h"
+#include "trading/ohlcv_series.h"
 #include "trading/order_book.h"
 #include "trading/trade_update.h"
 
 namespace mb
 {
-	using data_iterator = std::vector<ohlcv_data>::const_iterator;
-	using iterator_cache = std::unordered_map<tradable_pair, data_iterator>;
+	using index_cache = std::unordered_map<tradable_pair, size_t>;
 
 	class back_testing_data
 	{
 	private:
 		std::vector<tradable_pair> _tradablePairs;
-		std::unordered_map<tradable_pair, std::vector<ohlcv_data>> _data;
+		std::unordered_map<tradable_pair, ohlcv_series> _data;
 		std::time_t _startTime;
 		std::time_t _endTime;
 		int _stepSize;
@@ -27,9 +27,9 @@ namespace mb
 		std::unique_ptr<back_testing_data_source> _dataSource;
 
 		std::time_t _dataTime;
-		iterator_cache _iteratorCache;
+		index_cache _indexCache;
 
-		const std::vector<ohlcv_data>& get_or_load_data(const tradable_pair& pair);
+		const ohlcv_series& get_or_load_data(const tradable_pair& pair);
 
 	public:
 		back_testing_data(
@@ -49,6 +49,7 @@ namespace mb
 		const std::vector<tradable_pair>& tradable_pairs() const noexcept { return _tradablePairs; }
 
 		void increment();
+		void seek(std::time_t dataTime);
 		std::vector<ohlcv_data> get_ohlcv(const tradable_pair& pair, int interval, int count);
 		trade_update get_trade(const tradable_pair& pair);
 		order_book_state get_order_book(const tradable_pair& pair, int depth = 0);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_set>
+
 #include "back_testing_data.h"
 #include "exchanges/websockets/websocket_stream.h"
 
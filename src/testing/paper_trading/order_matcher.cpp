@@ -0,0 +1,173 @@
+#include <algorithm>
+
+#include "order_matcher.h"
+
+namespace
+{
+	using namespace mb;
+
+	double calculate_trailing_trigger(trade_action action, double extreme, double delta)
+	{
+		return action == trade_action::BUY
+			? extreme * (1 + delta)
+			: extreme * (1 - delta);
+	}
+
+	template<typename Container>
+	bool erase_value(Container& container, paper_order_id value)
+	{
+		auto it = std::find(container.begin(), container.end(), value);
+		if (it == container.end())
+		{
+			return false;
+		}
+
+		container.erase(it);
+		return true;
+	}
+}
+
+namespace mb
+{
+	void order_matcher::add(paper_order_id orderId, const paper_order& order, double referencePrice)
+	{
+		bool isBuy = order.action == trade_action::BUY;
+
+		switch (order.type)
+		{
+		case order_type::MARKET:
+		{
+			_marketOrders.emplace_back(orderId);
+			_orders.emplace(orderId, resting_order{ nullptr, {}, nullptr, {}, order.action, 0.0 });
+			break;
+		}
+		case order_type::LIMIT:
+		{
+			price_index& index{ isBuy ? _buyLimits : _sellLimits };
+			auto it = index.emplace(order.assetPrice, orderId);
+			_orders.emplace(orderId, resting_order{ &index, it, nullptr, {}, order.action, 0.0 });
+			break;
+		}
+		case order_type::STOP_LOSS:
+		{
+			price_index& index{ isBuy ? _buyStops : _sellStops };
+			auto it = index.emplace(order.stopPrice, orderId);
+			_orders.emplace(orderId, resting_order{ &index, it, nullptr, {}, order.action, 0.0 });
+			break;
+		}
+		case order_type::TRAILING_STOP_LOSS:
+		{
+			if (referencePrice == 0.0)
+			{
+				_pendingTrailingOrders.emplace_back(orderId);
+				_orders.emplace(orderId, resting_order{ nullptr, {}, nullptr, {}, order.action, order.trailingDelta });
+			}
+			else
+			{
+				add_trailing_stop(orderId, order.action, order.trailingDelta, referencePrice);
+			}
+
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	void order_matcher::add_trailing_stop(paper_order_id orderId, trade_action action, double delta, double extreme)
+	{
+		bool isBuy = action == trade_action::BUY;
+
+		price_index& triggerIndex{ isBuy ? _buyTrailingTriggers : _sellTrailingTriggers };
+		price_index& extremeIndex{ isBuy ? _buyTrailingMinimums : _sellTrailingMaximums };
+
+		auto triggerIt = triggerIndex.emplace(calculate_trailing_trigger(action, extreme, delta), orderId);
+		auto extremeIt = extremeIndex.emplace(extreme, orderId);
+
+		_orders.insert_or_assign(orderId, resting_order{ &triggerIndex, triggerIt, &extremeIndex, extremeIt, action, delta });
+	}
+
+	void order_matcher::initialise_pending_trailing_stops(double price)
+	{
+		for (auto& orderId : _pendingTrailingOrders)
+		{
+			const resting_order& order{ _orders.at(orderId) };
+			add_trailing_stop(orderId, order.action, order.delta, price);
+		}
+
+		_pendingTrailingOrders.clear();
+	}
+
+	void order_matcher::update_trailing_extremes(double price)
+	{
+		for (auto it = _buyTrailingMinimums.upper_bound(price); it != _buyTrailingMinimums.end();)
+		{
+			_updatedExtremes.emplace_back(_buyTrailingMinimums.extract(it++));
+		}
+
+		for (auto it = _sellTrailingMaximums.begin(); it != _sellTrailingMaximums.end() && it->first < price;)
+		{
+			_updatedExtremes.emplace_back(_sellTrailingMaximums.extract(it++));
+		}
+
+		for (auto& node : _updatedExtremes)
+		{
+			resting_order& order{ _orders.at(node.mapped()) };
+
+			auto triggerNode = order.index->extract(order.it);
+			triggerNode.key() = calculate_trailing_trigger(order.action, price, order.delta);
+			order.it = order.index->insert(std::move(triggerNode));
+
+			node.key() = price;
+			order.extremeIt = order.extremeIndex->insert(std::move(node));
+		}
+
+		_updatedExtremes.clear();
+	}
+
+	void order_matcher::convert_to_market(resting_order& order, paper_order_id orderId)
+	{
+		order = resting_order{ nullptr, {}, nullptr, {}, order.action, 0.0 };
+		_marketOrders.emplace_back(orderId);
+	}
+
+	bool order_matcher::remove(paper_order_id orderId)
+	{
+		auto orderIt = _orders.find(orderId);
+		if (orderIt == _orders.end())
+		{
+			return false;
+		}
+
+		const resting_order& order{ orderIt->second };
+
+		if (order.index)
+		{
+			order.index->erase(order.it);
+		}
+
+		if (order.extremeIndex)
+		{
+			order.extremeIndex->erase(order.extremeIt);
+		}
+
+		if (!order.index && !erase_value(_marketOrders, orderId))
+		{
+			erase_value(_pendingTrailingOrders, orderId);
+		}
+
+		_orders.erase(orderIt);
+		return true;
+	}
+
+	double order_matcher::trailing_extreme(paper_order_id orderId) const
+	{
+		auto orderIt = _orders.find(orderId);
+		if (orderIt == _orders.end() || !orderIt->second.extremeIndex)
+		{
+			return 0.0;
+		}
+
+		return orderIt->second.extremeIt->first;
+	}
+}
\ No newline at end of file
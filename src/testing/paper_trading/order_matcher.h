@@ -0,0 +1,124 @@
+#pragma once
+
+#include <map>
+#include <vector>
+#include <unordered_map>
+
+#include "paper_order.h"
+
+namespace mb
+{
+	class order_matcher
+	{
+	private:
+		using price_index = std::multimap<double, paper_order_id>;
+
+		struct resting_order
+		{
+			price_index* index;
+			price_index::iterator it;
+			price_index* extremeIndex;
+			price_index::iterator extremeIt;
+			trade_action action;
+			double delta;
+		};
+
+		price_index _buyLimits;
+		price_index _sellLimits;
+		price_index _buyStops;
+		price_index _sellStops;
+		price_index _buyTrailingTriggers;
+		price_index _sellTrailingTriggers;
+		price_index _buyTrailingMinimums;
+		price_index _sellTrailingMaximums;
+		std::vector<paper_order_id> _marketOrders;
+		std::vector<paper_order_id> _pendingTrailingOrders;
+		std::vector<price_index::node_type> _updatedExtremes;
+		std::unordered_map<paper_order_id, resting_order> _orders;
+
+		void add_trailing_stop(paper_order_id orderId, trade_action action, double delta, double extreme);
+		void update_trailing_extremes(double price);
+		void initialise_pending_trailing_stops(double price);
+		void convert_to_market(resting_order& order, paper_order_id orderId);
+
+		template<typename OnFill>
+		void fill_market_orders(double price, OnFill& onFill)
+		{
+			for (auto i = _marketOrders.size(); i-- > 0;)
+			{
+				if (onFill(_marketOrders[i], price))
+				{
+					_orders.erase(_marketOrders[i]);
+					_marketOrders.erase(_marketOrders.begin() + i);
+				}
+			}
+		}
+
+		template<typename OnFill>
+		void fill_limit_range(price_index& index, price_index::iterator begin, price_index::iterator end, OnFill& onFill)
+		{
+			auto it = begin;
+			while (it != end)
+			{
+				paper_order_id orderId{ it->second };
+				if (!onFill(orderId, it->first))
+				{
+					++it;
+					continue;
+				}
+
+				_orders.erase(orderId);
+				it = index.erase(it);
+			}
+		}
+
+		template<typename OnFill>
+		void fill_stop_range(price_index& index, price_index::iterator begin, price_index::iterator end, double price, bool atTriggerPrice, OnFill& onFill)
+		{
+			auto it = begin;
+			while (it != end)
+			{
+				auto orderIt = _orders.find(it->second);
+				bool filled = onFill(orderIt->first, atTriggerPrice ? it->first : price);
+
+				it = index.erase(it);
+
+				if (orderIt->second.extremeIndex)
+				{
+					orderIt->second.extremeIndex->erase(orderIt->second.extremeIt);
+				}
+
+				if (filled)
+				{
+					_orders.erase(orderIt);
+				}
+				else
+				{
+					convert_to_market(orderIt->second, orderIt->first);
+				}
+			}
+		}
+
+		public:
+		void add(paper_order_id orderId, const paper_order& order, double referencePrice);
+		bool remove(paper_order_id orderId);
+		double trailing_extreme(paper_order_id orderId) const;
+
+		template<typename OnFill>
+		void match(double price, OnFill onFill)
+		{
+			fill_market_orders(price, onFill);
+
+			fill_limit_range(_buyLimits, _buyLimits.lower_bound(price), _buyLimits.end(), onFill);
+			fill_limit_range(_sellLimits, _sellLimits.begin(), _sellLimits.upper_bound(price), onFill);
+			fill_stop_range(_buyStops, _buyStops.begin(), _buyStops.upper_bound(price), price, true, onFill);
+			fill_stop_range(_sellStops, _sellStops.lower_bound(price), _sellStops.end(), price, true, onFill);
+
+			initialise_pending_trailing_stops(price);
+			update_trailing_extremes(price);
+
+			fill_stop_range(_buyTrailingTriggers, _buyTrailingTriggers.begin(), _buyTrailingTriggers.upper_bound(price), price, false, onFill);
+			fill_stop_range(_sellTrailingTriggers, _sellTrailingTriggers.lower_bound(price), _sellTrailingTriggers.end(), price, false, onFill);
+		}
+	};
+}
\ No newline at end of file
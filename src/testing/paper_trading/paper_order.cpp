@@ -0,0 +1,22 @@
+#include "paper_order.h"
+
+namespace mb
+{
+	paper_order to_paper_order(const order_request& request, std::uint32_t pairIndex)
+	{
+		double volume{ request.get(order_request_parameter::VOLUME) };
+
+		return paper_order
+		{
+			request.order_type(),
+			request.action(),
+			pairIndex,
+			request.get(order_request_parameter::ASSET_PRICE),
+			request.get(order_request_parameter::STOP_PRICE),
+			volume,
+			request.get(order_request_parameter::TRAILING_DELTA),
+			volume,
+			0.0
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+#include "trading/order_request.h"
+
+namespace mb
+{
+	using paper_order_id = std::uint64_t;
+
+	struct paper_order
+	{
+		order_type type;
+		trade_action action;
+		std::uint32_t pairIndex;
+		double assetPrice;
+		double stopPrice;
+		double volume;
+		double trailingDelta;
+		double remainingVolume;
+		double queueAhead;
+	};
+
+	struct closed_order_record
+	{
+		std::time_t time;
+		paper_order_id orderId;
+		std::uint32_t pairIndex;
+		order_type type;
+		trade_action action;
+		double price;
+		double volume;
+	};
+
+	paper_order to_paper_order(const order_request& request, std::uint32_t pairIndex);
+}
\ No newline at end of file
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <charconv>
+#include <optional>
 #include <fmt/format.h>
 
 #include "paper_trade_api.h"
@@ -13,55 +16,43 @@ namespace
 	static constexpr int VolumePrecision = 10;
 	static double VolumeModifier = std::pow(10, VolumePrecision);
 
-	bool should_close_limit_order(const order_request& request, double currentPrice)
-	{
-		double orderPrice{ request.get(order_request_parameter::ASSET_PRICE) };
-
-		return 
-			(request.action() == trade_action::BUY && currentPrice <= orderPrice) ||
-			(request.action() == trade_action::SELL && currentPrice >= orderPrice);
-	}
-
-	bool should_close_stop_loss_order(const order_request& request, double currentPrice)
+	volume_t to_integer_volume(double volume)
 	{
-		double orderPrice{ request.get(order_request_parameter::STOP_PRICE) };
-
-		return
-			(request.action() == trade_action::BUY && currentPrice >= orderPrice) ||
-			(request.action() == trade_action::SELL && currentPrice <= orderPrice);
+		return static_cast<volume_t>(volume * VolumeModifier);
 	}
 
-	bool should_close_trailing_stop_loss_order(const order_request& request, double currentPrice, double& maxOrMin)
+	std::optional<paper_order_id> parse_order_id(std::string_view orderId)
 	{
-		double delta{ request.get(order_request_parameter::TRAILING_DELTA) };
+		paper_order_id value;
+		auto [end, error] = std::from_chars(orderId.data(), orderId.data() + orderId.size(), value);
 
-		if (request.action() == trade_action::BUY)
-		{
-			maxOrMin = std::min(maxOrMin, currentPrice);
-			return currentPrice >= maxOrMin * (1 + delta);
-		}
-		else
+		if (error != std::errc{} || end != orderId.data() + orderId.size())
 		{
-			maxOrMin = std::max(maxOrMin, currentPrice);
-			return currentPrice <= maxOrMin * (1 - delta);
+			return std::nullopt;
 		}
+
+		return value;
 	}
 
-	order_description to_order_description(std::string orderId, double fillPrice, std::time_t time, const order_request& request)
+	template<typename PendingAction>
+	void write_pending_actions(binary_writer& writer, const std::deque<PendingAction>& actions)
 	{
-		return order_description{
-			time,
-			std::move(orderId),
-			request.order_type(),
-			request.pair().to_string(),
-			request.action(),
-			fillPrice,
-			request.get(order_request_parameter::VOLUME) };
+		writer.write<std::uint32_t>(actions.size());
+		for (auto& action : actions)
+		{
+			writer.write(action);
+		}
 	}
 
-	volume_t to_integer_volume(double volume)
+	template<typename PendingAction>
+	void read_pending_actions(binary_reader& reader, std::deque<PendingAction>& actions)
 	{
-		return static_cast<volume_t>(volume * VolumeModifier);
+		actions.clear();
+		std::uint32_t actionCount{ reader.read<std::uint32_t>() };
+		for (std::uint32_t i = 0; i < actionCount; ++i)
+		{
+			actions.emplace_back(reader.read<PendingAction>());
+		}
 	}
 
 	std::unordered_map<std::string, volume_t> create_initialised_balances(const std::unordered_map<std::string, double>& initialBalances)
@@ -85,13 +76,50 @@ namespace mb
 		_getTime{ std::move(getTime) },
 		_exchangeId{ exchangeId },
 		_fee{ config.fee() },
+		_fillModel{ config.fillmodel() },
+		_orderBookDepth{ config.order_book_depth() },
+		_queuePosition{ config.queue_position() },
+		_orderEntryLatency{ config.order_entry_latency() },
+		_cancelLatency{ config.cancel_latency() },
 		_balances{ create_initialised_balances(config.balances()) },
-		_nextOrderNumber{ 1 },
 		_tradingMutex{}
 	{
 		_websocketStream->add_trade_update_handler([this](trade_update_message message) { trade_update_handler(std::move(message)); });
 	}
 
+	std::uint32_t paper_trade_api::intern_pair(const tradable_pair& pair)
+	{
+		auto it = _pairIndices.find(pair);
+		if (it != _pairIndices.end())
+		{
+			return it->second;
+		}
+
+		std::uint32_t pairIndex = static_cast<std::uint32_t>(_pairs.size());
+		_pairs.emplace_back(pair);
+		_orderMatchers.emplace_back();
+		_pairIndices.emplace(pair, pairIndex);
+
+		return pairIndex;
+	}
+
+	void paper_trade_api::ensure_subscriptions(const tradable_pair& pair)
+	{
+		if (_websocketStream->get_subscription_status(unique_websocket_subscription::create_trade_sub(pair)) == subscription_status::UNSUBSCRIBED)
+		{
+			_websocketStream->subscribe(websocket_subscription::create_trade_sub({ pair }));
+		}
+
+		// Queue position is read from the book under either fill model
+		bool needsOrderBook = _fillModel == fill_model::ORDER_BOOK || _queuePosition;
+
+		if (needsOrderBook &&
+			_websocketStream->get_subscription_status(unique_websocket_subscription::create_order_book_sub(pair)) == subscription_status::UNSUBSCRIBED)
+		{
+			_websocketStream->subscribe(websocket_subscription::create_order_book_sub({ pair }));
+		}
+	}
+
 	bool paper_trade_api::has_sufficient_funds(const std::string& asset, volume_t amount) const
 	{
 		auto balanceIt = _balances.find(asset);
@@ -103,99 +131,183 @@ namespace mb
 		return balanceIt->second >= amount;
 	}
 
-	bool paper_trade_api::try_fill_order(std::string_view orderId)
+	paper_trade_api::order_fill paper_trade_api::fill_from_order_book(const paper_order& order, double volume, double limitPrice) const
 	{
-		order_request& request{ _openOrders.at(orderId.data()) };
-		double price{ _websocketStream->get_last_trade(request.pair()).price() };
+		bool isBuy = order.action == trade_action::BUY;
+		int levels = 0;
+		double filledVolume = 0.0;
+		double filledCost = 0.0;
 
-		if (price == 0.0)
+		_websocketStream->walk_order_book(_pairs[order.pairIndex], isBuy ? order_book_side::ASK : order_book_side::BID, [&](const order_book_entry& entry)
 		{
-			return false;
-		}
+			if (limitPrice != 0.0 && (isBuy ? entry.price() > limitPrice : entry.price() < limitPrice))
+			{
+				return false;
+			}
 
-		double fillPrice;
-		bool fill = false;
+			double levelVolume = std::min(entry.volume(), volume - filledVolume);
+			filledVolume += levelVolume;
+			filledCost += levelVolume * entry.price();
 
-		switch (request.order_type())
-		{
-		case order_type::MARKET:
+			return filledVolume < volume && (_orderBookDepth == 0 || ++levels < _orderBookDepth);
+		});
+
+		if (filledVolume == 0.0)
 		{
-			fillPrice = price;
-			fill = true;
-			break;
+			return order_fill{ 0.0, 0.0 };
 		}
-		case order_type::LIMIT:
+
+		return order_fill{ filledVolume, filledCost / filledVolume };
+	}
+
+	double paper_trade_api::get_queue_ahead(const paper_order& order) const
+	{
+		bool isBuy = order.action == trade_action::BUY;
+		double queueAhead = 0.0;
+
+		_websocketStream->walk_order_book(_pairs[order.pairIndex], isBuy ? order_book_side::BID : order_book_side::ASK, [&](const order_book_entry& entry)
 		{
-			fill = should_close_limit_order(request, price);
-			if (fill)
+			if (double_equal(entry.price(), order.assetPrice))
 			{
-				fillPrice = request.get(order_request_parameter::ASSET_PRICE);
+				queueAhead = entry.volume();
+				return false;
 			}
 
-			break;
-		}
-		case order_type::STOP_LOSS:
+			return isBuy ? entry.price() > order.assetPrice : entry.price() < order.assetPrice;
+		});
+
+		return queueAhead;
+	}
+
+	void paper_trade_api::process_pending_actions(std::time_t time)
+	{
+		while (!_pendingEntries.empty() && _pendingEntries.front().time <= time)
 		{
-			fill = should_close_stop_loss_order(request, price);
-			if (fill)
+			paper_order_id orderId{ _pendingEntries.front().orderId };
+			_pendingEntries.pop_front();
+
+			paper_order* order{ _openOrders.find(orderId) };
+			if (order)
 			{
-				fillPrice = request.get(order_request_parameter::STOP_PRICE);
+				activate_order(orderId, *order);
 			}
+		}
+
+		while (!_pendingCancels.empty() && _pendingCancels.front().time <= time)
+		{
+			paper_order_id orderId{ _pendingCancels.front().orderId };
+			_pendingCancels.pop_front();
 
-			break;
+			remove_order(orderId);
+		}
+	}
+
+	void paper_trade_api::activate_order(paper_order_id orderId, paper_order& order)
+	{
+		trade_update lastTrade{ _websocketStream->get_last_trade(_pairs[order.pairIndex]) };
+		order_matcher& matcher{ _orderMatchers[order.pairIndex] };
+		matcher.add(orderId, order, lastTrade.price());
+
+		if (_queuePosition && order.type == order_type::LIMIT)
+		{
+			order.queueAhead = get_queue_ahead(order);
 		}
-		case order_type::TRAILING_STOP_LOSS:
+
+		if (_fillModel == fill_model::ORDER_BOOK && order.type == order_type::LIMIT)
 		{
-			if (_trailingOrderLimits.find(orderId.data()) == _trailingOrderLimits.end())
+			order_fill fill{ fill_from_order_book(order, order.remainingVolume, order.assetPrice) };
+			if (fill.volume > 0.0 && execute_order(orderId, order, fill.price, fill.volume))
 			{
-				_trailingOrderLimits.emplace(orderId.data(), price);
+				matcher.remove(orderId);
 			}
+		}
+		else
+		{
+			match_orders(matcher, trade_update{ lastTrade.time_stamp(), lastTrade.price(), 0.0 });
+		}
+	}
+
+	void paper_trade_api::remove_order(paper_order_id orderId)
+	{
+		const paper_order* order{ _openOrders.find(orderId) };
+		if (!order)
+		{
+			return;
+		}
+
+		_orderMatchers[order->pairIndex].remove(orderId);
+		_openOrders.erase(orderId);
+	}
 
-			fill = should_close_trailing_stop_loss_order(request, price, _trailingOrderLimits[orderId.data()]);
-			if (fill)
+	void paper_trade_api::match_orders(order_matcher& matcher, const trade_update& trade)
+	{
+		if (trade.price() == 0.0)
+		{
+			return;
+		}
+
+		double levelFilledVolume = 0.0;
+		matcher.match(trade.price(), [this, &trade, &levelFilledVolume](paper_order_id orderId, double triggerPrice)
+		{
+			return fill_order(orderId, triggerPrice, trade, levelFilledVolume);
+		});
+	}
+
+	bool paper_trade_api::fill_order(paper_order_id orderId, double triggerPrice, const trade_update& trade, double& levelFilledVolume)
+	{
+		paper_order& order{ *_openOrders.find(orderId) };
+
+		if (_queuePosition && order.type == order_type::LIMIT && double_equal(triggerPrice, trade.price()))
+		{
+			double excessVolume = trade.volume() - order.queueAhead - levelFilledVolume;
+			order.queueAhead = std::max(0.0, order.queueAhead - trade.volume());
+
+			if (excessVolume <= 0.0)
 			{
-				fillPrice = price;
-				_trailingOrderLimits.erase(orderId.data());
+				return false;
 			}
 
-			break;
+			double volume = std::min(order.remainingVolume, excessVolume);
+			levelFilledVolume += volume;
+
+			return execute_order(orderId, order, triggerPrice, volume);
 		}
-		default:
+
+		if (_fillModel == fill_model::LAST_TRADE || order.type == order_type::LIMIT)
 		{
-			fill = false;
-			break;
-		}
+			return execute_order(orderId, order, triggerPrice, order.remainingVolume);
 		}
 
-		if (fill)
+		order_fill fill{ fill_from_order_book(order, order.remainingVolume, 0.0) };
+		if (fill.volume == 0.0)
 		{
-			execute_order(orderId.data(), request, fillPrice);
+			return false;
 		}
 
-		return fill;
+		return execute_order(orderId, order, fill.price, fill.volume);
 	}
 
-	void paper_trade_api::execute_order(std::string_view orderId, order_request& request, double fillPrice)
+	bool paper_trade_api::execute_order(paper_order_id orderId, paper_order& order, double fillPrice, double volume)
 	{
-		double volume{ request.get(order_request_parameter::VOLUME) };
+		const tradable_pair& pair{ _pairs[order.pairIndex] };
 		double cost = calculate_cost(fillPrice, volume);
 		double fee = cost * _fee * 0.01;
-		std::string gainedAsset;
-		std::string soldAsset;
+		const std::string* gainedAsset;
+		const std::string* soldAsset;
 		double gainValue;
 		double soldValue;
 
-		if (request.action() == trade_action::BUY)
+		if (order.action == trade_action::BUY)
 		{
-			gainedAsset = request.pair().asset();
-			soldAsset = request.pair().price_unit();
+			gainedAsset = &pair.asset();
+			soldAsset = &pair.price_unit();
 			gainValue = volume;
 			soldValue =	cost + fee;
 		}
 		else
 		{
-			gainedAsset = request.pair().price_unit();
-			soldAsset = request.pair().asset();
+			gainedAsset = &pair.price_unit();
+			soldAsset = &pair.asset();
 			gainValue = cost - fee;
 			soldValue = volume;
 		}
@@ -203,38 +315,48 @@ namespace mb
 		volume_t gainVolume{ to_integer_volume(gainValue) };
 		volume_t soldVolume{ to_integer_volume(soldValue) };
 
-		if (!has_sufficient_funds(soldAsset, soldVolume))
+		if (!has_sufficient_funds(*soldAsset, soldVolume))
+		{
+			throw mb_exception{ fmt::format("Insufficient funds ({0})", *soldAsset) };
+		}
+
+		_balances[*gainedAsset] += gainVolume;
+		_balances[*soldAsset] -= soldVolume;
+
+		_closedOrders.emplace_back(closed_order_record{ _getTime(), orderId, order.pairIndex, order.type, order.action, fillPrice, volume });
+
+		order.remainingVolume -= volume;
+		if (to_integer_volume(order.remainingVolume) > 0)
 		{
-			throw mb_exception{ fmt::format("Insufficient funds ({0})", soldAsset) };
+			return false;
 		}
 
-		_balances[gainedAsset] += gainVolume;
-		_balances[soldAsset] -= soldVolume;
+		_openOrders.erase(orderId);
+		return true;
+	}
 
-		_closedOrders.emplace_back(to_order_description(orderId.data(), fillPrice, _getTime(), std::move(request)));
-		_openOrders.erase(orderId.data());
+	order_description paper_trade_api::to_order_description(const closed_order_record& record) const
+	{
+		return order_description{
+			record.time,
+			std::to_string(record.orderId),
+			record.type,
+			_pairs[record.pairIndex].to_string(),
+			record.action,
+			record.price,
+			record.volume };
 	}
 
 	void paper_trade_api::trade_update_handler(trade_update_message message)
 	{
 		std::lock_guard lock{ _tradingMutex };
 
-		std::vector<std::string>& orderIds{ _openOrdersByPair[message.pair()] };
-		size_t orderCount = orderIds.size();
-		int index = 0;
-		
-		for (int i = 0; i < orderCount; ++i)
-		{
-			auto it = orderIds.begin() + index;
+		process_pending_actions(_getTime());
 
-			if (!contains(_openOrders, *it) || try_fill_order(*it))
-			{
-				orderIds.erase(it);
-			}
-			else
-			{
-				++index;
-			}
+		auto pairIt = _pairIndices.find(message.pair());
+		if (pairIt != _pairIndices.end())
+		{
+			match_orders(_orderMatchers[pairIt->second], message.trade());
 		}
 	}
 
@@ -259,10 +381,11 @@ namespace mb
 		std::vector<order_description> orders;
 		orders.reserve(_openOrders.size());
 
-		for (auto& [orderId, trade] : _openOrders)
+		std::time_t time{ _getTime() };
+		_openOrders.for_each([this, &orders, time](paper_order_id orderId, const paper_order& order)
 		{
-			orders.emplace_back(to_order_description(orderId, trade.get(order_request_parameter::ASSET_PRICE), _getTime(), trade));
-		}
+			orders.emplace_back(to_order_description(closed_order_record{ time, orderId, order.pairIndex, order.type, order.action, order.assetPrice, order.remainingVolume }));
+		});
 
 		return orders;
 	}
@@ -270,38 +393,97 @@ namespace mb
 	std::vector<order_description> paper_trade_api::get_closed_orders() const
 	{
 		std::lock_guard lock{ _tradingMutex };
-		return _closedOrders;
+
+		std::vector<order_description> orders;
+		orders.reserve(_closedOrders.size());
+
+		for (auto& record : _closedOrders)
+		{
+			orders.emplace_back(to_order_description(record));
+		}
+
+		return orders;
 	}
 
-	std::string paper_trade_api::add_order(const order_request& request)
+	std::vector<order_description> paper_trade_api::get_closed_orders_since(std::size_t index) const
+	{
+		std::lock_guard lock{ _tradingMutex };
+
+		std::vector<order_description> orders;
+		if (index >= _closedOrders.size())
+		{
+			return orders;
+		}
+
+		orders.reserve(_closedOrders.size() - index);
+		for (auto it = _closedOrders.begin() + index; it != _closedOrders.end(); ++it)
+		{
+			orders.emplace_back(to_order_description(*it));
+		}
+
+		return orders;
+	}
+
+	std::size_t paper_trade_api::closed_order_count() const
 	{
 		std::lock_guard lock{ _tradingMutex };
+		return _closedOrders.size();
+	}
+
+	paper_order_id paper_trade_api::place_order(const order_request& request)
+	{
+		std::uint32_t pairIndex{ intern_pair(request.pair()) };
+		paper_order_id orderId{ _openOrders.insert(to_paper_order(request, pairIndex)) };
+
+		ensure_subscriptions(request.pair());
 
-		std::string orderId{ std::to_string(_nextOrderNumber++) };
-		_openOrders.emplace(orderId, request);
-		_openOrdersByPair[request.pair()].emplace_back(orderId);
-		
-		if (_websocketStream->get_subscription_status(unique_websocket_subscription::create_trade_sub(request.pair())) == subscription_status::UNSUBSCRIBED)
+		if (_orderEntryLatency > 0)
+		{
+			_pendingEntries.emplace_back(pending_action{ orderId, _getTime() + _orderEntryLatency });
+		}
+		else
 		{
-			_websocketStream->subscribe(websocket_subscription::create_trade_sub({ request.pair() }));
+			activate_order(orderId, *_openOrders.find(orderId));
 		}
 
-		try_fill_order(orderId);
-		
 		return orderId;
 	}
 
+	std::string paper_trade_api::add_order(const order_request& request)
+	{
+		std::lock_guard lock{ _tradingMutex };
+		return std::to_string(place_order(request));
+	}
+
 	order_confirmation paper_trade_api::add_order_confirm(const order_request& request)
 	{
-		std::string orderId{ add_order(request) };
+		std::lock_guard lock{ _tradingMutex };
+
+		auto closedOrderCount = _closedOrders.size();
+		paper_order_id orderId{ place_order(request) };
+
+		double filledVolume = 0.0;
+		double filledCost = 0.0;
+		for (auto it = _closedOrders.begin() + closedOrderCount; it != _closedOrders.end(); ++it)
+		{
+			if (it->orderId == orderId)
+			{
+				filledVolume += it->volume;
+				filledCost += it->volume * it->price;
+			}
+		}
+
+		order_status status{ _openOrders.contains(orderId)
+			? (filledVolume > 0.0 ? order_status::PARTIALLY_FILLED : order_status::OPEN)
+			: order_status::CLOSED };
 
 		return order_confirmation
 		{
-			std::move(orderId),
-			order_status::CLOSED,
+			std::to_string(orderId),
+			status,
 			request.get(order_request_parameter::VOLUME),
-			request.get(order_request_parameter::VOLUME),
-			_websocketStream->get_last_trade(request.pair()).price()
+			filledVolume,
+			filledVolume > 0.0 ? filledCost / filledVolume : _websocketStream->get_last_trade(request.pair()).price()
 		};
 	}
 
@@ -309,25 +491,129 @@ namespace mb
 	{
 		std::lock_guard lock{ _tradingMutex };
 
-		auto it = _openOrders.find(orderId.data());
-
-		if (it == _openOrders.end())
+		std::optional<paper_order_id> id{ parse_order_id(orderId) };
+		if (!id || !_openOrders.contains(*id))
 		{
 			throw mb_exception{ fmt::format("Could not find order with id = {}", orderId) };
 		}
 
-		_openOrders.erase(it);
+		if (_cancelLatency > 0)
+		{
+			_pendingCancels.emplace_back(pending_action{ *id, _getTime() + _cancelLatency });
+		}
+		else
+		{
+			remove_order(*id);
+		}
 	}
 
 	order_status paper_trade_api::get_order_status(std::string_view orderId) const
 	{
 		std::lock_guard lock{ _tradingMutex };
 
-		if (contains(_openOrders, orderId.data()))
+		std::optional<paper_order_id> id{ parse_order_id(orderId) };
+		const paper_order* order{ id ? _openOrders.find(*id) : nullptr };
+
+		if (order)
 		{
-			return order_status::OPEN;
+			return order->remainingVolume < order->volume
+				? order_status::PARTIALLY_FILLED
+				: order_status::OPEN;
 		}
 
 		return order_status::CLOSED;
 	}
+
+	void paper_trade_api::save_state(binary_writer& writer) const
+	{
+		std::lock_guard lock{ _tradingMutex };
+
+		writer.write<std::uint32_t>(_balances.size());
+		for (auto& [asset, balance] : _balances)
+		{
+			writer.write_string(asset);
+			writer.write(balance);
+		}
+
+		writer.write<std::uint32_t>(_pairs.size());
+		for (auto& pair : _pairs)
+		{
+			writer.write_string(pair.asset());
+			writer.write_string(pair.price_unit());
+		}
+
+		write_pending_actions(writer, _pendingEntries);
+		write_pending_actions(writer, _pendingCancels);
+
+		_openOrders.save(writer, [this](binary_writer& writer, paper_order_id orderId, const paper_order& order)
+		{
+			writer.write(order);
+			writer.write(_orderMatchers[order.pairIndex].trailing_extreme(orderId));
+		});
+
+		writer.write<std::uint32_t>(_closedOrders.size());
+		for (auto& closedOrder : _closedOrders)
+		{
+			writer.write(closedOrder);
+		}
+	}
+
+	void paper_trade_api::load_state(binary_reader& reader)
+	{
+		std::lock_guard lock{ _tradingMutex };
+
+		_balances.clear();
+		std::uint32_t balanceCount{ reader.read<std::uint32_t>() };
+		for (std::uint32_t i = 0; i < balanceCount; ++i)
+		{
+			std::string asset{ reader.read_string() };
+			_balances.insert_or_assign(std::move(asset), reader.read<volume_t>());
+		}
+
+		_pairs.clear();
+		_pairIndices.clear();
+		_orderMatchers.clear();
+		std::uint32_t pairCount{ reader.read<std::uint32_t>() };
+		for (std::uint32_t i = 0; i < pairCount; ++i)
+		{
+			std::string asset{ reader.read_string() };
+			tradable_pair pair{ std::move(asset), reader.read_string() };
+
+			ensure_subscriptions(pair);
+			intern_pair(pair);
+		}
+
+		read_pending_actions(reader, _pendingEntries);
+		read_pending_actions(reader, _pendingCancels);
+
+		_openOrders.load(reader, [this](binary_reader& reader, paper_order_id orderId)
+		{
+			paper_order order{ reader.read<paper_order>() };
+			double trailingExtreme{ reader.read<double>() };
+
+			bool isPending = std::any_of(_pendingEntries.begin(), _pendingEntries.end(),
+				[orderId](const pending_action& entry) { return entry.orderId == orderId; });
+
+			if (!isPending)
+			{
+				paper_order restingOrder{ order };
+				if (order.type != order_type::LIMIT && order.remainingVolume < order.volume)
+				{
+					restingOrder.type = order_type::MARKET;
+				}
+
+				_orderMatchers[order.pairIndex].add(orderId, restingOrder, trailingExtreme);
+			}
+
+			return order;
+		});
+
+		_closedOrders.clear();
+		std::uint32_t closedOrderCount{ reader.read<std::uint32_t>() };
+		_closedOrders.reserve(closedOrderCount);
+		for (std::uint32_t i = 0; i < closedOrderCount; ++i)
+		{
+			_closedOrders.emplace_back(reader.read<closed_order_record>());
+		}
+	}
 }
\ No newline at end of file
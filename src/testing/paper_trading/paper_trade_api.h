@@ -1,9 +1,12 @@
 #pragma once
 
 #include <unordered_map>
+#include <deque>
 #include <string>
 
 #include "paper_trading_config.h"
+#include "paper_order.h"
+#include "order_matcher.h"
 #include "exchanges/exchange.h"
 #include "common/file/config_file_reader.h"
 #include "trading/trading_constants.h"
@@ -12,6 +15,8 @@
 #include "trading/order_description.h"
 #include "common/utils/timeutils.h"
 #include "common/types/concurrent_wrapper.h"
+#include "common/types/slot_map.h"
+#include "common/file/binary_stream.h"
 
 namespace mb
 {
@@ -22,21 +27,50 @@ namespace mb
 	private:
 		using get_time_function = std::function<std::time_t()>;
 
+		struct order_fill
+		{
+			double volume;
+			double price;
+		};
+
+		struct pending_action
+		{
+			paper_order_id orderId;
+			std::time_t time;
+		};
+
 		std::shared_ptr<websocket_stream> _websocketStream;
 		get_time_function _getTime;
 		std::string_view _exchangeId;
 		double _fee;
-		std::unordered_map<std::string, double> _trailingOrderLimits;
+		fill_model _fillModel;
+		int _orderBookDepth;
+		bool _queuePosition;
+		int _orderEntryLatency;
+		int _cancelLatency;
 		std::unordered_map<std::string, volume_t> _balances;
-		std::unordered_map<std::string, order_request> _openOrders;
-		std::unordered_map<tradable_pair, std::vector<std::string>> _openOrdersByPair;
-		std::vector<order_description> _closedOrders;
-		int _nextOrderNumber;
+		std::vector<tradable_pair> _pairs;
+		std::unordered_map<tradable_pair, std::uint32_t> _pairIndices;
+		std::vector<order_matcher> _orderMatchers;
+		slot_map<paper_order> _openOrders;
+		std::vector<closed_order_record> _closedOrders;
+		std::deque<pending_action> _pendingEntries;
+		std::deque<pending_action> _pendingCancels;
 		mutable std::mutex _tradingMutex;
 
+		std::uint32_t intern_pair(const tradable_pair& pair);
+		void ensure_subscriptions(const tradable_pair& pair);
 		bool has_sufficient_funds(const std::string& asset, volume_t amount) const;
-		bool try_fill_order(std::string_view orderId);
-		void execute_order(std::string_view orderId, order_request& request, double fillPrice);
+		order_fill fill_from_order_book(const paper_order& order, double volume, double limitPrice) const;
+		double get_queue_ahead(const paper_order& order) const;
+		void process_pending_actions(std::time_t time);
+		void activate_order(paper_order_id orderId, paper_order& order);
+		void remove_order(paper_order_id orderId);
+		void match_orders(order_matcher& matcher, const trade_update& trade);
+		bool fill_order(paper_order_id orderId, double triggerPrice, const trade_update& trade, double& levelFilledVolume);
+		bool execute_order(paper_order_id orderId, paper_order& order, double fillPrice, double volume);
+		paper_order_id place_order(const order_request& request);
+		order_description to_order_description(const closed_order_record& record) const;
 		void trade_update_handler(trade_update_message message);
 
 	public:
@@ -57,6 +91,11 @@ namespace mb
 		void cancel_order(std::string_view orderId) override;
 
 		order_status get_order_status(std::string_view orderId) const;
+		std::vector<order_description> get_closed_orders_since(std::size_t index) const;
+		std::size_t closed_order_count() const;
+
+		void save_state(binary_writer& writer) const;
+		void load_state(binary_reader& reader);
 	};
 
 	template<typename GetTime>
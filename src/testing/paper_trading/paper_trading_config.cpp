@@ -1,31 +1,118 @@
+#include <fmt/format.h>
+
 #include "paper_trading_config.h"
+#include "common/exceptions/mb_exception.h"
 
 namespace
 {
+	using namespace mb;
+
 	namespace json_property_names
 	{
 		static constexpr std::string_view FEE = "fee";
 		static constexpr std::string_view BALANCES = "balances";
+		static constexpr std::string_view FILL_MODEL = "fillModel";
+		static constexpr std::string_view ORDER_BOOK_DEPTH = "orderBookDepth";
+		static constexpr std::string_view QUEUE_POSITION = "queuePosition";
+		static constexpr std::string_view ORDER_ENTRY_LATENCY = "orderEntryLatency";
+		static constexpr std::string_view CANCEL_LATENCY = "cancelLatency";
+	}
+
+	namespace fill_model_strings
+	{
+		static constexpr std::string_view LAST_TRADE = "last_trade";
+		static constexpr std::string_view ORDER_BOOK = "order_book";
+		static constexpr std::string_view UNKNOWN = "unknown";
 	}
 }
 
 namespace mb
 {
+	std::string_view to_string(fill_model fillModel)
+	{
+		switch (fillModel)
+		{
+		case fill_model::LAST_TRADE:
+			return fill_model_strings::LAST_TRADE;
+		case fill_model::ORDER_BOOK:
+			return fill_model_strings::ORDER_BOOK;
+		default:
+			return fill_model_strings::UNKNOWN;
+		}
+	}
+
+	fill_model fill_model_from_string(std::string_view fillModel)
+	{
+		if (fillModel == fill_model_strings::LAST_TRADE)
+		{
+			return fill_model::LAST_TRADE;
+		}
+		else if (fillModel == fill_model_strings::ORDER_BOOK)
+		{
+			return fill_model::ORDER_BOOK;
+		}
+
+		return fill_model::UNKNOWN;
+	}
+
 	paper_trading_config::paper_trading_config()
-		: _fee{}, _balances{}
+		: paper_trading_config{ 0.0, {} }
 	{}
 
 	paper_trading_config::paper_trading_config(double fee, std::unordered_map<std::string,double> balances)
-		: _fee{ fee }, _balances{ std::move(balances) }
+		: paper_trading_config{ fee, std::move(balances), fill_model::LAST_TRADE, 0, false, 0, 0 }
 	{}
 
+	paper_trading_config::paper_trading_config(
+		double fee,
+		std::unordered_map<std::string,double> balances,
+		fill_model fillModel,
+		int orderBookDepth,
+		bool queuePosition,
+		int orderEntryLatency,
+		int cancelLatency)
+		:
+		_fee{ fee },
+		_balances{ std::move(balances) },
+		_fillModel{ fillModel },
+		_orderBookDepth{ orderBookDepth },
+		_queuePosition{ queuePosition },
+		_orderEntryLatency{ orderEntryLatency },
+		_cancelLatency{ cancelLatency }
+	{
+		validate();
+	}
+
+	void paper_trading_config::validate()
+	{
+		if (_fillModel == fill_model::UNKNOWN)
+		{
+			throw mb_exception{ fmt::format("Fill model not recognized. Options are: {0}, {1}", fill_model_strings::LAST_TRADE, fill_model_strings::ORDER_BOOK) };
+		}
+
+		if (_orderBookDepth < 0)
+		{
+			throw mb_exception{ "Order book depth cannot be less than zero" };
+		}
+
+		if (_orderEntryLatency < 0 || _cancelLatency < 0)
+		{
+			throw mb_exception{ "Order latency cannot be less than zero" };
+		}
+	}
+
 	template<>
 	paper_trading_config from_json<paper_trading_config>(const json_document& json)
 	{
 		double fee{ json.get<double>(json_property_names::FEE) };
 		std::unordered_map<std::string,double> balances{ json.get<std::unordered_map<std::string,double>>(json_property_names::BALANCES) };
+		fill_model fillModel{ fill_model_from_string(json.get_or_default<std::string>(json_property_names::FILL_MODEL, std::string{ fill_model_strings::LAST_TRADE })) };
+		int orderBookDepth{ json.get_or_default<int>(json_property_names::ORDER_BOOK_DEPTH, 0) };
+		bool queuePosition{ json.get_or_default<bool>(json_property_names::QUEUE_POSITION, false) };
+		int orderEntryLatency{ json.get_or_default<int>(json_property_names::ORDER_ENTRY_LATENCY, 0) };
+		int cancelLatency{ json.get_or_default<int>(json_property_names::CANCEL_LATENCY, 0) };
 
-		return paper_trading_config{ std::move(fee), std::move(balances) };
+		return paper_trading_config{ std::move(fee), std::move(balances), fillModel, orderBookDepth, queuePosition, orderEntryLatency, cancelLatency };
 	}
 
 	template<>
@@ -33,5 +120,10 @@ namespace mb
 	{
 		writer.add(json_property_names::FEE, config.fee());
 		writer.add(json_property_names::BALANCES, config.balances());
+		writer.add(json_property_names::FILL_MODEL, to_string(config.fillmodel()));
+		writer.add(json_property_names::ORDER_BOOK_DEPTH, config.order_book_depth());
+		writer.add(json_property_names::QUEUE_POSITION, config.queue_position());
+		writer.add(json_property_names::ORDER_ENTRY_LATENCY, config.order_entry_latency());
+		writer.add(json_property_names::CANCEL_LATENCY, config.cancel_latency());
 	}
 }
\ No newline at end of file
@@ -5,20 +5,48 @@
 
 namespace mb
 {
+	enum class fill_model
+	{
+		LAST_TRADE, ORDER_BOOK, UNKNOWN
+	};
+
+	std::string_view to_string(fill_model fillModel);
+	fill_model fill_model_from_string(std::string_view fillModel);
+
 	class paper_trading_config
 	{
 	private:
 		double _fee;
 		std::unordered_map<std::string,double> _balances;
+		fill_model _fillModel;
+		int _orderBookDepth;
+		bool _queuePosition;
+		int _orderEntryLatency;
+		int _cancelLatency;
+
+		void validate();
 
 	public:
 		paper_trading_config();
 		paper_trading_config(double fee, std::unordered_map<std::string,double> balances);
+		paper_trading_config(
+			double fee,
+			std::unordered_map<std::string,double> balances,
+			fill_model fillModel,
+			int orderBookDepth,
+			bool queuePosition,
+			int orderEntryLatency,
+			int cancelLatency);
 		
 		static std::string name() noexcept { return "paper_trading"; }
 
 		double fee() const noexcept { return _fee; }
 		const std::unordered_map<std::string,double>& balances() const noexcept { return _balances; }
+		fill_model fillmodel() const noexcept { return _fillModel; }
+		int order_book_depth() const noexcept { return _orderBookDepth; }
+		bool queue_position() const noexcept { return _queuePosition; }
+		int order_entry_latency() const noexcept { return _orderEntryLatency; }
+		int cancel_latency() const noexcept { return _cancelLatency; }
 	};
 
 	template<>
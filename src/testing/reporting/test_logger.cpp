@@ -4,11 +4,15 @@
 #include "common/utils/mathutils.h"
 #include "common/utils/containerutils.h"
 #include "logging/logger.h"
+#include "common/exceptions/mb_exception.h"
 
 namespace
 {
 	using namespace mb;
 
+	static constexpr std::string_view TRADES_FILENAME = "trades.csv";
+	static constexpr std::string_view BINARY_TRADES_FILENAME = "trades.bin";
+
 	std::filesystem::path get_output_path()
 	{
 		std::time_t time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -21,20 +25,22 @@ namespace
 		return path;
 	}
 
-	file_handler create_trades_file(std::filesystem::path path)
+	std::unique_ptr<trade_journal> create_trade_journal(const std::filesystem::path& path, bool binaryJournal)
 	{
-		static constexpr std::string_view TRADES_FILENAME = "trades.csv";
-
 		std::vector<std::string> tradesCsvHeaders
 		{
 			"Time Stamp", "Order ID", "Market", "Action", "Price", "Volume"
 		};
 
-		file_handler tradeFileHandler{ file_handler::write(path / TRADES_FILENAME) };
+		write_to_file(path / TRADES_FILENAME, csv_row{ tradesCsvHeaders }.to_string() + "\n");
 
-		tradeFileHandler.stream() << csv_row{ tradesCsvHeaders }.to_string() << std::endl;
+		std::optional<std::filesystem::path> binaryPath;
+		if (binaryJournal)
+		{
+			binaryPath = path / BINARY_TRADES_FILENAME;
+		}
 
-		return tradeFileHandler;
+		return std::make_unique<trade_journal>(path / TRADES_FILENAME, std::move(binaryPath));
 	}
 
 	void create_report_file(std::string_view report, const std::filesystem::path& path)
@@ -120,36 +126,69 @@ namespace mb
 		: _tradeApi{ tradeApi }, _initialBalances{ _tradeApi->get_balances() }, _closedOrderIndex{ 0 }
 	{}
 
+	test_logger_exchange_data::test_logger_exchange_data(
+		std::shared_ptr<paper_trade_api> tradeApi,
+		std::unordered_map<std::string,double> initialBalances,
+		int closedOrderIndex)
+		: _tradeApi{ tradeApi }, _initialBalances{ std::move(initialBalances) }, _closedOrderIndex{ closedOrderIndex }
+	{}
+
+	test_logger::test_logger(
+		std::vector<test_logger_exchange_data> exchangeData,
+		std::filesystem::path outputDirectory,
+		std::unique_ptr<trade_journal> tradeJournal)
+		: test_logger{ std::move(exchangeData), std::move(outputDirectory), std::move(tradeJournal), now_t() }
+	{}
+
 	test_logger::test_logger(
 		std::vector<test_logger_exchange_data> exchangeData,
 		std::filesystem::path outputDirectory,
-		file_handler tradeFileHandler)
+		std::unique_ptr<trade_journal> tradeJournal,
+		std::time_t startTime)
 		: 
 		_exchangeData{ std::move(exchangeData) },
 		_outputDirectory{ std::move(outputDirectory) },
-		_tradeFileHandler{ std::move(tradeFileHandler) },
-		_startTime{ now_t() }
+		_tradeJournal{ std::move(tradeJournal) },
+		_startTime{ startTime }
 	{}
 
 	void test_logger::flush_trades()
 	{
 		for (auto& exchange : _exchangeData)
 		{
-			std::vector<order_description> closedOrders{ exchange.trade_api()->get_closed_orders() };
+			std::vector<order_description> newOrders{ exchange.trade_api()->get_closed_orders_since(exchange.closed_order_index()) };
 
-			if (closedOrders.empty())
+			if (newOrders.empty())
 			{
 				continue;
 			}
 
-			int nextTrade = exchange.closed_order_index();
+			exchange.set_closed_order_index(exchange.closed_order_index() + static_cast<int>(newOrders.size()));
+			_tradeJournal->append(std::move(newOrders));
+		}
+	}
+
+	void test_logger::save_state(binary_writer& writer)
+	{
+		_tradeJournal->flush();
+
+		writer.write_string(_outputDirectory.string());
+		writer.write(_startTime);
+		writer.write<std::uintmax_t>(std::filesystem::file_size(_tradeJournal->csv_path()));
+		writer.write(_tradeJournal->binary_path().has_value());
+		writer.write<std::uintmax_t>(_tradeJournal->binary_path() ? std::filesystem::file_size(*_tradeJournal->binary_path()) : 0);
 
-			for (; nextTrade < closedOrders.size(); ++nextTrade)
+		writer.write<std::uint32_t>(_exchangeData.size());
+		for (auto& exchange : _exchangeData)
+		{
+			writer.write(exchange.closed_order_index());
+			writer.write<std::uint32_t>(exchange.initial_balances().size());
+
+			for (auto& [asset, balance] : exchange.initial_balances())
 			{
-				_tradeFileHandler.stream() << to_csv_row<order_description>(closedOrders[nextTrade]).to_string() << std::endl;
+				writer.write_string(asset);
+				writer.write(balance);
 			}
-
-			exchange.set_closed_order_index(nextTrade);
 		}
 	}
 
@@ -164,7 +203,7 @@ namespace mb
 		}
 
 		int numberOfTrades = std::accumulate(_exchangeData.begin(), _exchangeData.end(), 0,
-			[](int i, const test_logger_exchange_data& data) { return data.trade_api()->get_closed_orders().size(); });
+			[](int i, const test_logger_exchange_data& data) { return i + static_cast<int>(data.trade_api()->closed_order_count()); });
 
 		return test_report
 		{
@@ -186,14 +225,14 @@ namespace mb
 		logger::instance().info("\n" + reportString);
 	}
 
-	test_logger create_test_logger(std::vector<std::shared_ptr<paper_trade_api>> tradeApis)
+	test_logger create_test_logger(std::vector<std::shared_ptr<paper_trade_api>> tradeApis, bool binaryJournal)
 	{
 		std::filesystem::path path{ get_output_path() };
 		std::filesystem::create_directories(path);
 
 		logger::instance().info("Test results will be written to {}", path.string());
 
-		file_handler tradeFileHandler{ create_trades_file(path) };
+		std::unique_ptr<trade_journal> tradeJournal{ create_trade_journal(path, binaryJournal) };
 
 		std::vector<test_logger_exchange_data> exchangeData;
 		exchangeData.reserve(tradeApis.size());
@@ -203,6 +242,59 @@ namespace mb
 			exchangeData.emplace_back(tradeApi);
 		}
 
-		return test_logger{ std::move(exchangeData), std::move(path), std::move(tradeFileHandler) };
+		return test_logger{ std::move(exchangeData), std::move(path), std::move(tradeJournal) };
+	}
+
+	test_logger restore_test_logger(std::vector<std::shared_ptr<paper_trade_api>> tradeApis, binary_reader& reader)
+	{
+		std::filesystem::path path{ reader.read_string() };
+		std::time_t startTime{ reader.read<std::time_t>() };
+		std::uintmax_t tradesFileSize{ reader.read<std::uintmax_t>() };
+		bool binaryJournal{ reader.read<bool>() };
+		std::uintmax_t binaryTradesFileSize{ reader.read<std::uintmax_t>() };
+		std::uint32_t exchangeCount{ reader.read<std::uint32_t>() };
+
+		if (exchangeCount != tradeApis.size())
+		{
+			throw mb_exception{ "Checkpoint exchange count does not match the current test" };
+		}
+
+		logger::instance().info("Resuming test results in {}", path.string());
+
+		std::filesystem::path tradesPath{ path / TRADES_FILENAME };
+		std::filesystem::resize_file(tradesPath, tradesFileSize);
+
+		std::optional<std::filesystem::path> binaryTradesPath;
+		if (binaryJournal)
+		{
+			binaryTradesPath = path / BINARY_TRADES_FILENAME;
+			std::filesystem::resize_file(*binaryTradesPath, binaryTradesFileSize);
+		}
+
+		std::vector<test_logger_exchange_data> exchangeData;
+		exchangeData.reserve(exchangeCount);
+
+		for (auto tradeApi : tradeApis)
+		{
+			int closedOrderIndex{ reader.read<int>() };
+			std::uint32_t balanceCount{ reader.read<std::uint32_t>() };
+
+			std::unordered_map<std::string,double> initialBalances;
+			initialBalances.reserve(balanceCount);
+
+			for (std::uint32_t i = 0; i < balanceCount; ++i)
+			{
+				std::string asset{ reader.read_string() };
+				initialBalances.emplace(std::move(asset), reader.read<double>());
+			}
+
+			exchangeData.emplace_back(std::move(tradeApi), std::move(initialBalances), closedOrderIndex);
+		}
+
+		return test_logger{
+			std::move(exchangeData),
+			std::move(path),
+			std::make_unique<trade_journal>(std::move(tradesPath), std::move(binaryTradesPath)),
+			startTime };
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "test_report.h"
+#include "trade_journal.h"
 #include "testing/paper_trading/paper_trade_api.h"
 #include "common/file/file.h"
 
@@ -18,6 +19,11 @@ namespace mb
 	public:
 		test_logger_exchange_data(std::shared_ptr<paper_trade_api> tradeApi);
 
+		test_logger_exchange_data(
+			std::shared_ptr<paper_trade_api> tradeApi,
+			std::unordered_map<std::string,double> initialBalances,
+			int closedOrderIndex);
+
 		std::shared_ptr<paper_trade_api> trade_api() const noexcept { return _tradeApi; }
 		const std::unordered_map<std::string,double>& initial_balances() const noexcept { return _initialBalances; }
 		int closed_order_index() const noexcept { return _closedOrderIndex; }
@@ -30,20 +36,28 @@ namespace mb
 	private:
 		std::vector<test_logger_exchange_data> _exchangeData;
 		std::filesystem::path _outputDirectory;
-		file_handler _tradeFileHandler;
+		std::unique_ptr<trade_journal> _tradeJournal;
 		std::time_t _startTime;
 
 	public:
 		test_logger(
 			std::vector<test_logger_exchange_data> exchangeData,
 			std::filesystem::path outputDirectory,
-			file_handler tradeFileHandler);
+			std::unique_ptr<trade_journal> tradeJournal);
+
+		test_logger(
+			std::vector<test_logger_exchange_data> exchangeData,
+			std::filesystem::path outputDirectory,
+			std::unique_ptr<trade_journal> tradeJournal,
+			std::time_t startTime);
 
 		void flush_trades();
+		void save_state(binary_writer& writer);
 
 		test_report generate_test_report(std::time_t dataTimeRange = 0, report_result_list additionalResults = {}) const;
 		void log_test_report(const test_report& report) const;
 	};
 
-	test_logger create_test_logger(std::vector<std::shared_ptr<paper_trade_api>> tradeApis);
+	test_logger create_test_logger(std::vector<std::shared_ptr<paper_trade_api>> tradeApis, bool binaryJournal = false);
+	test_logger restore_test_logger(std::vector<std::shared_ptr<paper_trade_api>> tradeApis, binary_reader& reader);
 }
\ No newline at end of file
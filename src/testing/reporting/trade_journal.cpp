@@ -0,0 +1,238 @@
+#include <fmt/format.h>
+
+#include "trade_journal.h"
+#include "common/file/binary_stream.h"
+#include "common/exceptions/mb_exception.h"
+#include "logging/logger.h"
+
+namespace
+{
+	using namespace mb;
+
+	void write_journal_record(binary_writer& writer, const order_description& order)
+	{
+		writer.write(order.time_stamp());
+		writer.write_string(order.order_id());
+		writer.write(order.ordertype());
+		writer.write_string(order.pair_name());
+		writer.write(order.action());
+		writer.write(order.price());
+		writer.write(order.volume());
+	}
+
+	order_description read_journal_record(binary_reader& reader)
+	{
+		std::time_t timeStamp{ reader.read<std::time_t>() };
+		std::string orderId{ reader.read_string() };
+		order_type orderType{ reader.read<order_type>() };
+		std::string pairName{ reader.read_string() };
+		trade_action action{ reader.read<trade_action>() };
+		double price{ reader.read<double>() };
+		double volume{ reader.read<double>() };
+
+		return order_description{ timeStamp, std::move(orderId), orderType, std::move(pairName), action, price, volume };
+	}
+
+	void throw_if_not_open(const std::ofstream& stream, const std::filesystem::path& path)
+	{
+		if (!stream.is_open())
+		{
+			throw mb_exception{ fmt::format("Could not open trade journal {}", path.string()) };
+		}
+	}
+}
+
+namespace mb
+{
+	trade_journal::trade_journal(std::filesystem::path csvPath, std::optional<std::filesystem::path> binaryPath)
+		:
+		_csvPath{ std::move(csvPath) },
+		_binaryPath{ std::move(binaryPath) },
+		_csvStream{ _csvPath, std::ios::app },
+		_binaryStream{},
+		_pendingOrders{},
+		_queuedBatches{ 0 },
+		_writtenBatches{ 0 },
+		_flushRequested{ false },
+		_stop{ false },
+		_mutex{},
+		_ordersQueued{},
+		_ordersWritten{},
+		_writerThread{}
+	{
+		throw_if_not_open(_csvStream, _csvPath);
+
+		if (_binaryPath)
+		{
+			_binaryStream.open(*_binaryPath, std::ios::app | std::ios::binary);
+			throw_if_not_open(_binaryStream, *_binaryPath);
+		}
+
+		_writerThread = std::thread{ &trade_journal::run_writer, this };
+	}
+
+	trade_journal::~trade_journal()
+	{
+		{
+			std::lock_guard lock{ _mutex };
+			_stop = true;
+		}
+
+		_ordersQueued.notify_one();
+		_writerThread.join();
+	}
+
+	void trade_journal::append(std::vector<order_description> orders)
+	{
+		if (orders.empty())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard lock{ _mutex };
+
+			if (_pendingOrders.empty())
+			{
+				_pendingOrders = std::move(orders);
+			}
+			else
+			{
+				_pendingOrders.insert(_pendingOrders.end(), std::make_move_iterator(orders.begin()), std::make_move_iterator(orders.end()));
+			}
+
+			++_queuedBatches;
+		}
+
+		_ordersQueued.notify_one();
+	}
+
+	void trade_journal::flush()
+	{
+		std::unique_lock lock{ _mutex };
+		std::uint64_t queuedBatches{ _queuedBatches };
+
+		if (_writtenBatches >= queuedBatches)
+		{
+			return;
+		}
+
+		_flushRequested = true;
+		_ordersQueued.notify_one();
+		_ordersWritten.wait(lock, [this, queuedBatches]() { return _writtenBatches >= queuedBatches; });
+	}
+
+	void trade_journal::run_writer()
+	{
+		using clock = std::chrono::steady_clock;
+
+		std::vector<order_description> orders;
+		std::string csvBuffer;
+		binary_writer binaryBuffer;
+		std::uint64_t bufferedBatches{ 0 };
+		std::optional<clock::time_point> flushDeadline;
+
+		while (true)
+		{
+			bool flushNow;
+			bool stopping;
+
+			{
+				std::unique_lock lock{ _mutex };
+				auto woken = [this]() { return _stop || _flushRequested || !_pendingOrders.empty(); };
+
+				if (flushDeadline)
+				{
+					_ordersQueued.wait_until(lock, *flushDeadline, woken);
+				}
+				else
+				{
+					_ordersQueued.wait(lock, woken);
+				}
+
+				orders.swap(_pendingOrders);
+				bufferedBatches = _queuedBatches;
+				flushNow = _stop || _flushRequested;
+				stopping = _stop;
+				_flushRequested = false;
+			}
+
+			try
+			{
+				for (auto& order : orders)
+				{
+					csvBuffer.append(to_csv_row(order).to_string());
+					csvBuffer.push_back('\n');
+
+					if (_binaryPath)
+					{
+						write_journal_record(binaryBuffer, order);
+					}
+				}
+
+				if (!flushDeadline && !orders.empty())
+				{
+					flushDeadline = clock::now() + FLUSH_INTERVAL;
+				}
+
+				bool bufferFull = csvBuffer.size() + binaryBuffer.data().size() >= FLUSH_SIZE;
+				bool deadlinePassed = flushDeadline && clock::now() >= *flushDeadline;
+
+				if (flushNow || bufferFull || deadlinePassed)
+				{
+					_csvStream.write(csvBuffer.data(), csvBuffer.size());
+					_csvStream.flush();
+
+					if (_binaryPath)
+					{
+						_binaryStream.write(binaryBuffer.data().data(), binaryBuffer.data().size());
+						_binaryStream.flush();
+					}
+
+					csvBuffer.clear();
+					binaryBuffer.clear();
+					flushDeadline.reset();
+				}
+			}
+			catch (const std::exception& e)
+			{
+				logger::instance().error("An error occurred whilst writing the trade journal: {}", e.what());
+
+				csvBuffer.clear();
+				binaryBuffer.clear();
+				flushDeadline.reset();
+			}
+
+			orders.clear();
+
+			if (!flushDeadline)
+			{
+				{
+					std::lock_guard lock{ _mutex };
+					_writtenBatches = bufferedBatches;
+				}
+
+				_ordersWritten.notify_all();
+			}
+
+			if (stopping)
+			{
+				return;
+			}
+		}
+	}
+
+	std::vector<order_description> read_binary_trade_journal(const std::filesystem::path& path)
+	{
+		std::string content{ read_binary_file(path) };
+		binary_reader reader{ content };
+
+		std::vector<order_description> orders;
+		while (!reader.at_end())
+		{
+			orders.emplace_back(read_journal_record(reader));
+		}
+
+		return orders;
+	}
+}
\ No newline at end of file
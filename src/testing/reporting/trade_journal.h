@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "trading/order_description.h"
+
+namespace mb
+{
+	/*
+	* Writes orders on a background thread. Records are buffered and only written to disk once the buffer passes
+	* FLUSH_SIZE, once the oldest record has waited FLUSH_INTERVAL, on flush() or on destruction.
+	*/
+	class trade_journal
+	{
+	private:
+		static constexpr std::size_t FLUSH_SIZE = 64 * 1024;
+		static constexpr std::chrono::milliseconds FLUSH_INTERVAL{ 1000 };
+
+		std::filesystem::path _csvPath;
+		std::optional<std::filesystem::path> _binaryPath;
+		std::ofstream _csvStream;
+		std::ofstream _binaryStream;
+		std::vector<order_description> _pendingOrders;
+		std::uint64_t _queuedBatches;
+		std::uint64_t _writtenBatches;
+		bool _flushRequested;
+		bool _stop;
+		std::mutex _mutex;
+		std::condition_variable _ordersQueued;
+		std::condition_variable _ordersWritten;
+		std::thread _writerThread;
+
+		void run_writer();
+
+	public:
+		trade_journal(std::filesystem::path csvPath, std::optional<std::filesystem::path> binaryPath);
+		~trade_journal();
+
+		trade_journal(const trade_journal&) = delete;
+		trade_journal& operator=(const trade_journal&) = delete;
+
+		const std::filesystem::path& csv_path() const noexcept { return _csvPath; }
+		const std::optional<std::filesystem::path>& binary_path() const noexcept { return _binaryPath; }
+
+		void append(std::vector<order_description> orders);
+		void flush();
+	};
+
+	std::vector<order_description> read_binary_trade_journal(const std::filesystem::path& path);
+}
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <fmt/format.h>
+
+#include "decimal.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace
+{
+	using namespace mb;
+
+	constexpr std::array<std::int64_t, MAX_DECIMAL_SCALE + 1> POWERS_OF_TEN
+	{
+		1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+		10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+		1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+	};
+
+	constexpr std::int64_t MAX_MANTISSA = std::numeric_limits<std::int64_t>::max();
+
+	int validate_scale(int scale)
+	{
+		if (scale < 0 || scale > MAX_DECIMAL_SCALE)
+		{
+			throw mb_exception{ fmt::format("Decimal scale must be between 0 and {}, got {}", MAX_DECIMAL_SCALE, scale) };
+		}
+
+		return scale;
+	}
+
+	std::int64_t checked_multiply(std::int64_t value, std::int64_t factor)
+	{
+		if (value > MAX_MANTISSA / factor || value < -MAX_MANTISSA / factor)
+		{
+			throw mb_exception{ fmt::format("Decimal overflow scaling {} by {}", value, factor) };
+		}
+
+		return value * factor;
+	}
+
+	std::int64_t checked_add(std::int64_t l, std::int64_t r)
+	{
+		if ((r > 0 && l > MAX_MANTISSA - r) || (r < 0 && l < -MAX_MANTISSA - r))
+		{
+			throw mb_exception{ fmt::format("Decimal overflow adding {} and {}", l, r) };
+		}
+
+		return l + r;
+	}
+
+	std::int64_t round_divide(std::int64_t value, std::int64_t divisor) noexcept
+	{
+		// Rounds half away from zero, matching how prices are quoted
+		std::int64_t quotient = value / divisor;
+		std::int64_t remainder = value % divisor;
+
+		if (2 * (remainder < 0 ? -remainder : remainder) >= divisor)
+		{
+			quotient += value < 0 ? -1 : 1;
+		}
+
+		return quotient;
+	}
+
+	std::pair<decimal, decimal> align(const decimal& l, const decimal& r)
+	{
+		return l.scale() == r.scale()
+			? std::pair<decimal, decimal>{ l, r }
+			: l.scale() > r.scale()
+				? std::pair<decimal, decimal>{ l, r.rescale(l.scale()) }
+				: std::pair<decimal, decimal>{ l.rescale(r.scale()), r };
+	}
+
+	bool is_digit(char c) noexcept
+	{
+		return c >= '0' && c <= '9';
+	}
+}
+
+namespace mb
+{
+	decimal::decimal(std::int64_t mantissa, int scale)
+		: _mantissa{ mantissa }, _scale{ validate_scale(scale) }
+	{}
+
+	decimal decimal::from_double(double value, int scale)
+	{
+		double scaled = value * static_cast<double>(power_of_ten(scale));
+
+		if (!std::isfinite(scaled) || std::abs(scaled) >= MAX_DECIMAL_MAGNITUDE)
+		{
+			throw mb_exception{ fmt::format("Cannot represent {} as a decimal with scale {}", value, scale) };
+		}
+
+		return decimal{ std::llround(scaled), scale };
+	}
+
+	double decimal::to_double() const noexcept
+	{
+		// Both operands are exact for any realistic price, so the division is correctly rounded
+		return static_cast<double>(_mantissa) / static_cast<double>(POWERS_OF_TEN[_scale]);
+	}
+
+	decimal decimal::rescale(int scale) const
+	{
+		validate_scale(scale);
+
+		if (scale == _scale)
+		{
+			return *this;
+		}
+
+		return scale > _scale
+			? decimal{ checked_multiply(_mantissa, POWERS_OF_TEN[scale - _scale]), scale }
+			: decimal{ round_divide(_mantissa, POWERS_OF_TEN[_scale - scale]), scale };
+	}
+
+	decimal decimal::normalise() const noexcept
+	{
+		decimal result{ *this };
+
+		while (result._scale > 0 && result._mantissa % 10 == 0)
+		{
+			result._mantissa /= 10;
+			--result._scale;
+		}
+
+		return result;
+	}
+
+	decimal decimal::operator-() const
+	{
+		return decimal{ -_mantissa, _scale };
+	}
+
+	decimal decimal::operator+(const decimal& other) const
+	{
+		auto [l, r] = align(*this, other);
+		return decimal{ checked_add(l._mantissa, r._mantissa), l._scale };
+	}
+
+	decimal decimal::operator-(const decimal& other) const
+	{
+		return *this + -other;
+	}
+
+	bool decimal::operator==(const decimal& other) const
+	{
+		if (_scale == other._scale)
+		{
+			return _mantissa == other._mantissa;
+		}
+
+		auto [l, r] = align(*this, other);
+		return l._mantissa == r._mantissa;
+	}
+
+	bool decimal::operator<(const decimal& other) const
+	{
+		if (_scale == other._scale)
+		{
+			return _mantissa < other._mantissa;
+		}
+
+		auto [l, r] = align(*this, other);
+		return l._mantissa < r._mantissa;
+	}
+
+	std::int64_t power_of_ten(int exponent)
+	{
+		return POWERS_OF_TEN[validate_scale(exponent)];
+	}
+
+	decimal parse_decimal(std::string_view text, int scale)
+	{
+		validate_scale(scale);
+
+		size_t i = 0;
+		bool negative = false;
+
+		if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+		{
+			negative = text[i] == '-';
+			++i;
+		}
+
+		std::int64_t mantissa = 0;
+		int fractionDigits = 0;
+		bool hasDigits = false;
+		bool pastPoint = false;
+		bool roundUp = false;
+
+		for (; i < text.size(); ++i)
+		{
+			char c = text[i];
+
+			if (c == '.' && !pastPoint)
+			{
+				pastPoint = true;
+				continue;
+			}
+
+			if (!is_digit(c))
+			{
+				throw mb_exception{ fmt::format("Cannot parse '{}' as a decimal", text) };
+			}
+
+			hasDigits = true;
+
+			if (pastPoint && fractionDigits >= scale)
+			{
+				// Only the first digit past the scale decides the rounding, the rest are just validated
+				roundUp = roundUp || (fractionDigits == scale && c >= '5');
+				++fractionDigits;
+				continue;
+			}
+
+			mantissa = checked_add(checked_multiply(mantissa, 10), c - '0');
+
+			if (pastPoint)
+			{
+				++fractionDigits;
+			}
+		}
+
+		if (!hasDigits)
+		{
+			throw mb_exception{ fmt::format("Cannot parse '{}' as a decimal", text) };
+		}
+
+		if (fractionDigits < scale)
+		{
+			mantissa = checked_multiply(mantissa, POWERS_OF_TEN[scale - fractionDigits]);
+		}
+
+		if (roundUp)
+		{
+			mantissa = checked_add(mantissa, 1);
+		}
+
+		return decimal{ negative ? -mantissa : mantissa, scale };
+	}
+
+	int fitting_scale(double value, int maxScale)
+	{
+		int scale = validate_scale(maxScale);
+		double magnitude = std::abs(value);
+
+		while (scale > 0 && magnitude * static_cast<double>(POWERS_OF_TEN[scale]) >= MAX_DECIMAL_MAGNITUDE)
+		{
+			--scale;
+		}
+
+		return scale;
+	}
+
+	int fitting_scale(std::string_view text, int maxScale)
+	{
+		validate_scale(maxScale);
+
+		size_t start = text.find_first_not_of("+-0");
+		size_t end = text.find('.', start == std::string_view::npos ? text.size() : start);
+
+		// Any number with fewer than 19 integer digits fits at the scale that leaves it 18 digits in total
+		int integerDigits = start == std::string_view::npos || start >= end
+			? 0
+			: static_cast<int>((end == std::string_view::npos ? text.size() : end) - start);
+
+		return std::max(0, std::min(maxScale, MAX_DECIMAL_SCALE - integerDigits));
+	}
+
+	int decimal_scale(std::string_view step)
+	{
+		size_t point = step.find('.');
+		if (point == std::string_view::npos)
+		{
+			return 0;
+		}
+
+		size_t last = step.find_last_not_of('0');
+		return last <= point
+			? 0
+			: validate_scale(static_cast<int>(last - point));
+	}
+
+	std::string to_string(const decimal& value)
+	{
+		std::int64_t mantissa = value.mantissa();
+		std::string digits{ std::to_string(mantissa < 0 ? -mantissa : mantissa) };
+		int scale = value.scale();
+
+		if (scale > 0)
+		{
+			if (digits.size() <= static_cast<size_t>(scale))
+			{
+				digits.insert(0, scale + 1 - digits.size(), '0');
+			}
+
+			digits.insert(digits.size() - scale, 1, '.');
+		}
+
+		return mantissa < 0
+			? "-" + digits
+			: digits;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace mb
+{
+	constexpr int MAX_DECIMAL_SCALE = 18;
+
+	// Scaled values at or above this no longer fit in the mantissa
+	constexpr double MAX_DECIMAL_MAGNITUDE = 9.2e18;
+
+	/*
+	* A fixed point number, mantissa * 10^-scale. Values with the same scale compare and hash as plain
+	* integers, so prices quantised to a pair's tick size can key order book levels exactly.
+	*/
+	class decimal
+	{
+	private:
+		std::int64_t _mantissa;
+		int _scale;
+
+	public:
+		constexpr decimal()
+			: _mantissa{ 0 }, _scale{ 0 }
+		{}
+
+		decimal(std::int64_t mantissa, int scale);
+
+		static decimal from_double(double value, int scale);
+
+		constexpr std::int64_t mantissa() const noexcept { return _mantissa; }
+		constexpr int scale() const noexcept { return _scale; }
+
+		double to_double() const noexcept;
+		decimal rescale(int scale) const;
+		decimal normalise() const noexcept;
+
+		decimal operator-() const;
+		decimal operator+(const decimal& other) const;
+		decimal operator-(const decimal& other) const;
+
+		bool operator==(const decimal& other) const;
+		bool operator!=(const decimal& other) const { return !(*this == other); }
+		bool operator<(const decimal& other) const;
+		bool operator>(const decimal& other) const { return other < *this; }
+		bool operator<=(const decimal& other) const { return !(other < *this); }
+		bool operator>=(const decimal& other) const { return !(*this < other); }
+	};
+
+	std::int64_t power_of_ten(int exponent);
+
+	decimal parse_decimal(std::string_view text, int scale);
+
+	// The largest scale, up to maxScale, at which the value still fits in a mantissa
+	int fitting_scale(double value, int maxScale);
+	int fitting_scale(std::string_view text, int maxScale);
+
+	int decimal_scale(std::string_view step);
+	std::string to_string(const decimal& value);
+}
+
+namespace std
+{
+	template<>
+	struct hash<mb::decimal>
+	{
+		std::size_t operator()(const mb::decimal& value) const noexcept
+		{
+			mb::decimal normalised{ value.normalise() };
+			return std::hash<std::int64_t>()(normalised.mantissa()) ^ (static_cast<std::size_t>(normalised.scale()) << 1);
+		}
+	};
+}
\ No newline at end of file
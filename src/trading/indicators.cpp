@@ -0,0 +1,677 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <fmt/format.h>
+
+#include "indicators.h"
+#include "common/exceptions/mb_exception.h"
+#include "common/utils/simdutils.h"
+
+namespace
+{
+	using namespace mb;
+
+	constexpr double NOT_READY = std::numeric_limits<double>::quiet_NaN();
+
+	int validate_period(int period)
+	{
+		if (period <= 0)
+		{
+			throw mb_exception{ fmt::format("Indicator period must be positive, got {}", period) };
+		}
+
+		return period;
+	}
+
+	double wilder_smooth(double average, double value, int period) noexcept
+	{
+		return (average * (period - 1) + value) / period;
+	}
+
+	double calculate_rsi_value(double averageGain, double averageLoss) noexcept
+	{
+		if (averageLoss == 0.0)
+		{
+			return averageGain == 0.0 ? 50.0 : 100.0;
+		}
+
+		return 100.0 - 100.0 / (1.0 + averageGain / averageLoss);
+	}
+
+	double calculate_true_range(double high, double low, double previousClose) noexcept
+	{
+		double range = high - low;
+		if (std::isnan(previousClose))
+		{
+			return range;
+		}
+
+		return std::max(range, std::max(std::abs(high - previousClose), std::abs(low - previousClose)));
+	}
+
+	/*
+	* The element-wise kernels run two SSE2 lanes, as the ohlcv_series kernels do, and fall back to scalar code for the
+	* tail and other targets. Each lane performs the same operations as the scalar code, so results are identical.
+	* Running totals and the EMA, Wilder and rolling variance updates depend on the previous value and stay scalar.
+	*/
+	void shift_kernel(const double* values, double shift, double* shifted, size_t count) noexcept
+	{
+		size_t i = 0;
+
+#ifdef MB_SSE2
+		__m128d shifts = _mm_set1_pd(shift);
+
+		for (; i + 2 <= count; i += 2)
+		{
+			_mm_storeu_pd(shifted + i, _mm_sub_pd(_mm_loadu_pd(values + i), shifts));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			shifted[i] = values[i] - shift;
+		}
+	}
+
+	// Writes shift + (sums[i + window] - sums[i]) / period for each window
+	void window_mean_kernel(const double* sums, size_t window, double shift, double period, double* means, size_t count) noexcept
+	{
+		size_t i = 0;
+
+#ifdef MB_SSE2
+		__m128d shifts = _mm_set1_pd(shift);
+		__m128d periods = _mm_set1_pd(period);
+
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128d windowSums = _mm_sub_pd(_mm_loadu_pd(sums + i + window), _mm_loadu_pd(sums + i));
+			_mm_storeu_pd(means + i, _mm_add_pd(shifts, _mm_div_pd(windowSums, periods)));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			means[i] = shift + (sums[i + window] - sums[i]) / period;
+		}
+	}
+
+	void price_change_kernel(const double* prices, double* gains, double* losses, size_t count) noexcept
+	{
+		size_t i = 0;
+
+#ifdef MB_SSE2
+		__m128d zeros = _mm_setzero_pd();
+
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128d changes = _mm_sub_pd(_mm_loadu_pd(prices + i + 1), _mm_loadu_pd(prices + i));
+			_mm_storeu_pd(gains + i, _mm_max_pd(changes, zeros));
+			_mm_storeu_pd(losses + i, _mm_max_pd(_mm_sub_pd(zeros, changes), zeros));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			double change = prices[i + 1] - prices[i];
+			gains[i] = std::max(change, 0.0);
+			losses[i] = std::max(-change, 0.0);
+		}
+	}
+
+	// Writes the true range of each candle after the first, which has no previous close
+	void true_range_kernel(const double* highs, const double* lows, const double* closes, double* trueRanges, size_t count) noexcept
+	{
+		size_t i = 1;
+
+#ifdef MB_SSE2
+		__m128d signBits = _mm_set1_pd(-0.0);
+
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128d highs2 = _mm_loadu_pd(highs + i);
+			__m128d lows2 = _mm_loadu_pd(lows + i);
+			__m128d previousCloses = _mm_loadu_pd(closes + i - 1);
+
+			__m128d range = _mm_sub_pd(highs2, lows2);
+			__m128d highGap = _mm_andnot_pd(signBits, _mm_sub_pd(highs2, previousCloses));
+			__m128d lowGap = _mm_andnot_pd(signBits, _mm_sub_pd(lows2, previousCloses));
+
+			_mm_storeu_pd(trueRanges + i, _mm_max_pd(range, _mm_max_pd(highGap, lowGap)));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			double range = highs[i] - lows[i];
+			double highGap = std::abs(highs[i] - closes[i - 1]);
+			double lowGap = std::abs(lows[i] - closes[i - 1]);
+			trueRanges[i] = std::max(range, std::max(highGap, lowGap));
+		}
+	}
+
+	void band_kernel(const double* middle, const double* squaredDeviations, double width, double period, double* lower, double* upper, size_t count) noexcept
+	{
+		size_t i = 0;
+
+#ifdef MB_SSE2
+		__m128d zeros = _mm_setzero_pd();
+		__m128d widths = _mm_set1_pd(width);
+		__m128d periods = _mm_set1_pd(period);
+
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128d variances = _mm_div_pd(_mm_max_pd(_mm_loadu_pd(squaredDeviations + i), zeros), periods);
+			__m128d offsets = _mm_mul_pd(widths, _mm_sqrt_pd(variances));
+			__m128d means = _mm_loadu_pd(middle + i);
+
+			_mm_storeu_pd(lower + i, _mm_sub_pd(means, offsets));
+			_mm_storeu_pd(upper + i, _mm_add_pd(means, offsets));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			double offset = width * std::sqrt(std::max(squaredDeviations[i], 0.0) / period);
+			lower[i] = middle[i] - offset;
+			upper[i] = middle[i] + offset;
+		}
+	}
+
+	/*
+	* Window sums are taken from a running total of prices shifted by the first price, which keeps the
+	* magnitude of the total low for long series.
+	*/
+	std::vector<double> shifted_prefix_sums(const std::vector<double>& prices, double shift)
+	{
+		std::vector<double> sums(prices.size() + 1);
+		std::vector<double> shifted(prices.size());
+
+		shift_kernel(prices.data(), shift, shifted.data(), prices.size());
+
+		double sum = 0.0;
+		sums[0] = 0.0;
+		for (size_t i = 0; i < shifted.size(); ++i)
+		{
+			sum += shifted[i];
+			sums[i + 1] = sum;
+		}
+
+		return sums;
+	}
+
+	void check_columns(size_t expected, size_t actual)
+	{
+		if (expected != actual)
+		{
+			throw mb_exception{ fmt::format("Indicator columns have different lengths: {} and {}", expected, actual) };
+		}
+	}
+}
+
+namespace mb
+{
+	namespace internal
+	{
+		rolling_window::rolling_window(int period)
+			: _values(validate_period(period)), _next{ 0 }, _size{ 0 }
+		{}
+
+		void rolling_window::push(double value) noexcept
+		{
+			_values[_next] = value;
+			_next = _next + 1 == _values.size() ? 0 : _next + 1;
+			_size = std::min(_size + 1, _values.size());
+		}
+
+		void rolling_window::clear() noexcept
+		{
+			_next = 0;
+			_size = 0;
+		}
+	}
+
+	simple_moving_average::simple_moving_average(int period)
+		: _period{ validate_period(period) }, _window{ period }, _sum{}
+	{}
+
+	double simple_moving_average::value() const noexcept
+	{
+		return ready() ? _sum.value() / _period : NOT_READY;
+	}
+
+	double simple_moving_average::peek(double price) const noexcept
+	{
+		if (_window.size() + 1 < static_cast<size_t>(_period))
+		{
+			return NOT_READY;
+		}
+
+		compensated_sum sum{ _sum };
+		if (_window.full())
+		{
+			sum.add(-_window.oldest());
+		}
+
+		sum.add(price);
+		return sum.value() / _period;
+	}
+
+	void simple_moving_average::update(double price) noexcept
+	{
+		if (_window.full())
+		{
+			_sum.add(-_window.oldest());
+		}
+
+		_sum.add(price);
+		_window.push(price);
+	}
+
+	void simple_moving_average::reset() noexcept
+	{
+		_window.clear();
+		_sum.clear();
+	}
+
+	exponential_moving_average::exponential_moving_average(int period)
+		:
+		_period{ validate_period(period) },
+		_alpha{ 2.0 / (period + 1) },
+		_count{ 0 },
+		_seedSum{ 0.0 },
+		_value{ 0.0 }
+	{}
+
+	double exponential_moving_average::value() const noexcept
+	{
+		return ready() ? _value : NOT_READY;
+	}
+
+	double exponential_moving_average::peek(double price) const noexcept
+	{
+		if (ready())
+		{
+			return _value + _alpha * (price - _value);
+		}
+
+		return _count + 1 == _period
+			? (_seedSum + price) / _period
+			: NOT_READY;
+	}
+
+	void exponential_moving_average::update(double price) noexcept
+	{
+		_value = peek(price);
+
+		if (!ready())
+		{
+			_seedSum += price;
+			++_count;
+		}
+	}
+
+	void exponential_moving_average::reset() noexcept
+	{
+		_count = 0;
+		_seedSum = 0.0;
+		_value = 0.0;
+	}
+
+	relative_strength_index::relative_strength_index(int period)
+		:
+		_period{ validate_period(period) },
+		_count{ 0 },
+		_previous{ NOT_READY },
+		_gainSum{ 0.0 },
+		_lossSum{ 0.0 },
+		_averageGain{ 0.0 },
+		_averageLoss{ 0.0 }
+	{}
+
+	double relative_strength_index::value() const noexcept
+	{
+		return ready() ? calculate_rsi_value(_averageGain, _averageLoss) : NOT_READY;
+	}
+
+	double relative_strength_index::peek(double price) const noexcept
+	{
+		if (std::isnan(_previous) || _count + 1 < _period)
+		{
+			return NOT_READY;
+		}
+
+		double change = price - _previous;
+		double gain = std::max(change, 0.0);
+		double loss = std::max(-change, 0.0);
+
+		if (ready())
+		{
+			return calculate_rsi_value(wilder_smooth(_averageGain, gain, _period), wilder_smooth(_averageLoss, loss, _period));
+		}
+
+		return calculate_rsi_value((_gainSum + gain) / _period, (_lossSum + loss) / _period);
+	}
+
+	void relative_strength_index::update(double price) noexcept
+	{
+		if (!std::isnan(_previous))
+		{
+			double change = price - _previous;
+			double gain = std::max(change, 0.0);
+			double loss = std::max(-change, 0.0);
+
+			if (ready())
+			{
+				_averageGain = wilder_smooth(_averageGain, gain, _period);
+				_averageLoss = wilder_smooth(_averageLoss, loss, _period);
+			}
+			else
+			{
+				_gainSum += gain;
+				_lossSum += loss;
+
+				if (++_count == _period)
+				{
+					_averageGain = _gainSum / _period;
+					_averageLoss = _lossSum / _period;
+				}
+			}
+		}
+
+		_previous = price;
+	}
+
+	void relative_strength_index::reset() noexcept
+	{
+		_count = 0;
+		_previous = NOT_READY;
+		_gainSum = 0.0;
+		_lossSum = 0.0;
+		_averageGain = 0.0;
+		_averageLoss = 0.0;
+	}
+
+	average_true_range::average_true_range(int period)
+		:
+		_period{ validate_period(period) },
+		_count{ 0 },
+		_previousClose{ NOT_READY },
+		_seedSum{ 0.0 },
+		_value{ 0.0 }
+	{}
+
+	double average_true_range::true_range(const ohlcv_data& candle) const noexcept
+	{
+		return calculate_true_range(candle.high(), candle.low(), _previousClose);
+	}
+
+	double average_true_range::value() const noexcept
+	{
+		return ready() ? _value : NOT_READY;
+	}
+
+	double average_true_range::peek(const ohlcv_data& candle) const noexcept
+	{
+		if (ready())
+		{
+			return wilder_smooth(_value, true_range(candle), _period);
+		}
+
+		return _count + 1 == _period
+			? (_seedSum + true_range(candle)) / _period
+			: NOT_READY;
+	}
+
+	void average_true_range::update(const ohlcv_data& candle) noexcept
+	{
+		_value = peek(candle);
+
+		if (!ready())
+		{
+			_seedSum += true_range(candle);
+			++_count;
+		}
+
+		_previousClose = candle.close();
+	}
+
+	void average_true_range::reset() noexcept
+	{
+		_count = 0;
+		_previousClose = NOT_READY;
+		_seedSum = 0.0;
+		_value = 0.0;
+	}
+
+	bollinger_bands::bollinger_bands(int period, double width)
+		:
+		_period{ validate_period(period) },
+		_width{ width },
+		_window{ period },
+		_mean{ 0.0 },
+		_squaredDeviations{ 0.0 }
+	{}
+
+	std::pair<double, double> bollinger_bands::next_moments(double price) const noexcept
+	{
+		// Welford's update, replacing the oldest price once the window is full
+		if (_window.full())
+		{
+			double oldest = _window.oldest();
+			double mean = _mean + (price - oldest) / _period;
+			double squaredDeviations = _squaredDeviations + (price - oldest) * (price - mean + oldest - _mean);
+
+			return { mean, squaredDeviations };
+		}
+
+		double delta = price - _mean;
+		double mean = _mean + delta / (_window.size() + 1);
+
+		return { mean, _squaredDeviations + delta * (price - mean) };
+	}
+
+	bollinger_band_values bollinger_bands::create_bands(double mean, double squaredDeviations) const noexcept
+	{
+		double offset = _width * std::sqrt(std::max(squaredDeviations, 0.0) / _period);
+		return bollinger_band_values{ mean - offset, mean, mean + offset };
+	}
+
+	bollinger_band_values bollinger_bands::value() const noexcept
+	{
+		return ready()
+			? create_bands(_mean, _squaredDeviations)
+			: bollinger_band_values{ NOT_READY, NOT_READY, NOT_READY };
+	}
+
+	bollinger_band_values bollinger_bands::peek(double price) const noexcept
+	{
+		if (!_window.full() && _window.size() + 1 < static_cast<size_t>(_period))
+		{
+			return bollinger_band_values{ NOT_READY, NOT_READY, NOT_READY };
+		}
+
+		auto [mean, squaredDeviations] = next_moments(price);
+		return create_bands(mean, squaredDeviations);
+	}
+
+	void bollinger_bands::update(double price) noexcept
+	{
+		std::tie(_mean, _squaredDeviations) = next_moments(price);
+		_window.push(price);
+	}
+
+	void bollinger_bands::reset() noexcept
+	{
+		_window.clear();
+		_mean = 0.0;
+		_squaredDeviations = 0.0;
+	}
+
+	std::vector<double> calculate_sma(const std::vector<double>& prices, int period)
+	{
+		validate_period(period);
+
+		std::vector<double> result(prices.size(), NOT_READY);
+		size_t window = static_cast<size_t>(period);
+		if (prices.size() < window)
+		{
+			return result;
+		}
+
+		double shift = prices.front();
+		std::vector<double> sums{ shifted_prefix_sums(prices, shift) };
+
+		window_mean_kernel(sums.data(), window, shift, period, result.data() + window - 1, prices.size() + 1 - window);
+
+		return result;
+	}
+
+	std::vector<double> calculate_ema(const std::vector<double>& prices, int period)
+	{
+		validate_period(period);
+
+		std::vector<double> result(prices.size(), NOT_READY);
+		size_t window = static_cast<size_t>(period);
+		if (prices.size() < window)
+		{
+			return result;
+		}
+
+		double seedSum = 0.0;
+		for (size_t i = 0; i < window; ++i)
+		{
+			seedSum += prices[i];
+		}
+
+		double alpha = 2.0 / (period + 1);
+		double value = seedSum / period;
+		result[window - 1] = value;
+
+		for (size_t i = window; i < prices.size(); ++i)
+		{
+			value += alpha * (prices[i] - value);
+			result[i] = value;
+		}
+
+		return result;
+	}
+
+	std::vector<double> calculate_rsi(const std::vector<double>& prices, int period)
+	{
+		validate_period(period);
+
+		std::vector<double> result(prices.size(), NOT_READY);
+		size_t window = static_cast<size_t>(period);
+		if (prices.size() <= window)
+		{
+			return result;
+		}
+
+		size_t changeCount = prices.size() - 1;
+		std::vector<double> gains(changeCount);
+		std::vector<double> losses(changeCount);
+
+		price_change_kernel(prices.data(), gains.data(), losses.data(), changeCount);
+
+		double gainSum = 0.0;
+		double lossSum = 0.0;
+		for (size_t i = 0; i < window; ++i)
+		{
+			gainSum += gains[i];
+			lossSum += losses[i];
+		}
+
+		double averageGain = gainSum / period;
+		double averageLoss = lossSum / period;
+		result[window] = calculate_rsi_value(averageGain, averageLoss);
+
+		for (size_t i = window; i < changeCount; ++i)
+		{
+			averageGain = wilder_smooth(averageGain, gains[i], period);
+			averageLoss = wilder_smooth(averageLoss, losses[i], period);
+			result[i + 1] = calculate_rsi_value(averageGain, averageLoss);
+		}
+
+		return result;
+	}
+
+	std::vector<double> calculate_atr(const std::vector<double>& highs, const std::vector<double>& lows, const std::vector<double>& closes, int period)
+	{
+		validate_period(period);
+		check_columns(closes.size(), highs.size());
+		check_columns(closes.size(), lows.size());
+
+		std::vector<double> result(closes.size(), NOT_READY);
+		size_t window = static_cast<size_t>(period);
+		if (closes.size() < window)
+		{
+			return result;
+		}
+
+		std::vector<double> trueRanges(closes.size());
+		trueRanges[0] = highs[0] - lows[0];
+		true_range_kernel(highs.data(), lows.data(), closes.data(), trueRanges.data(), closes.size());
+
+		double seedSum = 0.0;
+		for (size_t i = 0; i < window; ++i)
+		{
+			seedSum += trueRanges[i];
+		}
+
+		double value = seedSum / period;
+		result[window - 1] = value;
+
+		for (size_t i = window; i < closes.size(); ++i)
+		{
+			value = wilder_smooth(value, trueRanges[i], period);
+			result[i] = value;
+		}
+
+		return result;
+	}
+
+	bollinger_band_series calculate_bollinger_bands(const std::vector<double>& prices, int period, double width)
+	{
+		std::vector<double> middle{ calculate_sma(prices, period) };
+		std::vector<double> lower(prices.size(), NOT_READY);
+		std::vector<double> upper(prices.size(), NOT_READY);
+
+		size_t window = static_cast<size_t>(period);
+		if (prices.size() < window)
+		{
+			return bollinger_band_series{ std::move(lower), std::move(middle), std::move(upper) };
+		}
+
+		// Rolls the sum of squared deviations with the same Welford update as bollinger_bands, rather than raw
+		// squared sums, which lose too much precision at typical price levels. Each price is visited once.
+		std::vector<double> squaredDeviations(prices.size());
+		double mean = 0.0;
+		double deviations = 0.0;
+
+		for (size_t i = 0; i < prices.size(); ++i)
+		{
+			double price = prices[i];
+
+			if (i < window)
+			{
+				double delta = price - mean;
+				mean += delta / (i + 1);
+				deviations += delta * (price - mean);
+			}
+			else
+			{
+				double oldest = prices[i - window];
+				double nextMean = mean + (price - oldest) / period;
+				deviations += (price - oldest) * (price - nextMean + oldest - mean);
+				mean = nextMean;
+			}
+
+			squaredDeviations[i] = deviations;
+		}
+
+		size_t first = window - 1;
+		band_kernel(middle.data() + first, squaredDeviations.data() + first, width, period, lower.data() + first, upper.data() + first, prices.size() - first);
+
+		return bollinger_band_series{ std::move(lower), std::move(middle), std::move(upper) };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "ohlcv_data.h"
+#include "common/utils/mathutils.h"
+
+namespace mb
+{
+	namespace internal
+	{
+		class rolling_window
+		{
+		private:
+			std::vector<double> _values;
+			size_t _next;
+			size_t _size;
+
+		public:
+			explicit rolling_window(int period);
+
+			size_t size() const noexcept { return _size; }
+			bool full() const noexcept { return _size == _values.size(); }
+			double oldest() const noexcept { return _values[_next]; }
+
+			void push(double value) noexcept;
+			void clear() noexcept;
+		};
+	}
+
+	class simple_moving_average
+	{
+	private:
+		int _period;
+		internal::rolling_window _window;
+		compensated_sum _sum;
+
+	public:
+		explicit simple_moving_average(int period);
+
+		int period() const noexcept { return _period; }
+		bool ready() const noexcept { return _window.full(); }
+		double value() const noexcept;
+		double peek(double price) const noexcept;
+		double peek(const ohlcv_data& candle) const noexcept { return peek(candle.close()); }
+
+		void update(double price) noexcept;
+		void update(const ohlcv_data& candle) noexcept { update(candle.close()); }
+		void reset() noexcept;
+	};
+
+	class exponential_moving_average
+	{
+	private:
+		int _period;
+		double _alpha;
+		int _count;
+		double _seedSum;
+		double _value;
+
+	public:
+		explicit exponential_moving_average(int period);
+
+		int period() const noexcept { return _period; }
+		bool ready() const noexcept { return _count == _period; }
+		double value() const noexcept;
+		double peek(double price) const noexcept;
+		double peek(const ohlcv_data& candle) const noexcept { return peek(candle.close()); }
+
+		void update(double price) noexcept;
+		void update(const ohlcv_data& candle) noexcept { update(candle.close()); }
+		void reset() noexcept;
+	};
+
+	class relative_strength_index
+	{
+	private:
+		int _period;
+		int _count;
+		double _previous;
+		double _gainSum;
+		double _lossSum;
+		double _averageGain;
+		double _averageLoss;
+
+	public:
+		explicit relative_strength_index(int period);
+
+		int period() const noexcept { return _period; }
+		bool ready() const noexcept { return _count == _period; }
+		double value() const noexcept;
+		double peek(double price) const noexcept;
+		double peek(const ohlcv_data& candle) const noexcept { return peek(candle.close()); }
+
+		void update(double price) noexcept;
+		void update(const ohlcv_data& candle) noexcept { update(candle.close()); }
+		void reset() noexcept;
+	};
+
+	class average_true_range
+	{
+	private:
+		int _period;
+		int _count;
+		double _previousClose;
+		double _seedSum;
+		double _value;
+
+		double true_range(const ohlcv_data& candle) const noexcept;
+
+	public:
+		explicit average_true_range(int period);
+
+		int period() const noexcept { return _period; }
+		bool ready() const noexcept { return _count == _period; }
+		double value() const noexcept;
+		double peek(const ohlcv_data& candle) const noexcept;
+
+		void update(const ohlcv_data& candle) noexcept;
+		void reset() noexcept;
+	};
+
+	class bollinger_band_values
+	{
+	private:
+		double _lower;
+		double _middle;
+		double _upper;
+
+	public:
+		constexpr bollinger_band_values(double lower, double middle, double upper)
+			: _lower{ lower }, _middle{ middle }, _upper{ upper }
+		{}
+
+		constexpr double lower() const noexcept { return _lower; }
+		constexpr double middle() const noexcept { return _middle; }
+		constexpr double upper() const noexcept { return _upper; }
+	};
+
+	class bollinger_bands
+	{
+	private:
+		int _period;
+		double _width;
+		internal::rolling_window _window;
+		double _mean;
+		double _squaredDeviations;
+
+		std::pair<double, double> next_moments(double price) const noexcept;
+		bollinger_band_values create_bands(double mean, double squaredDeviations) const noexcept;
+
+	public:
+		bollinger_bands(int period, double width = 2.0);
+
+		int period() const noexcept { return _period; }
+		bool ready() const noexcept { return _window.full(); }
+		bollinger_band_values value() const noexcept;
+		bollinger_band_values peek(double price) const noexcept;
+		bollinger_band_values peek(const ohlcv_data& candle) const noexcept { return peek(candle.close()); }
+
+		void update(double price) noexcept;
+		void update(const ohlcv_data& candle) noexcept { update(candle.close()); }
+		void reset() noexcept;
+	};
+
+	/*
+	* Feeds a stream of live candles into an indicator. Candle updates repeat the same time stamp
+	* until the interval closes, so a candle is only committed once a later one arrives and value()
+	* reflects the still forming candle without disturbing the indicator state.
+	*/
+	template<typename Indicator>
+	class ohlcv_indicator
+	{
+	private:
+		Indicator _indicator;
+		ohlcv_data _pending;
+
+	public:
+		template<typename... Args>
+		explicit ohlcv_indicator(Args&&... args)
+			: _indicator{ std::forward<Args>(args)... }, _pending{}
+		{}
+
+		const Indicator& indicator() const noexcept { return _indicator; }
+
+		auto value() const noexcept
+		{
+			return _pending.time_stamp() == -1
+				? _indicator.value()
+				: _indicator.peek(_pending);
+		}
+
+		void update(const ohlcv_data& candle) noexcept
+		{
+			if (candle.time_stamp() < _pending.time_stamp())
+			{
+				return;
+			}
+
+			if (_pending.time_stamp() != -1 && candle.time_stamp() != _pending.time_stamp())
+			{
+				_indicator.update(_pending);
+			}
+
+			_pending = candle;
+		}
+
+		void reset() noexcept
+		{
+			_indicator.reset();
+			_pending = ohlcv_data{};
+		}
+	};
+
+	class bollinger_band_series
+	{
+	private:
+		std::vector<double> _lower;
+		std::vector<double> _middle;
+		std::vector<double> _upper;
+
+	public:
+		bollinger_band_series(std::vector<double> lower, std::vector<double> middle, std::vector<double> upper)
+			: _lower{ std::move(lower) }, _middle{ std::move(middle) }, _upper{ std::move(upper) }
+		{}
+
+		const std::vector<double>& lower() const noexcept { return _lower; }
+		const std::vector<double>& middle() const noexcept { return _middle; }
+		const std::vector<double>& upper() const noexcept { return _upper; }
+	};
+
+	// Batch versions over columns, e.g. for back testing. Values before an indicator is ready are NaN.
+	std::vector<double> calculate_sma(const std::vector<double>& prices, int period);
+	std::vector<double> calculate_ema(const std::vector<double>& prices, int period);
+	std::vector<double> calculate_rsi(const std::vector<double>& prices, int period);
+	std::vector<double> calculate_atr(const std::vector<double>& highs, const std::vector<double>& lows, const std::vector<double>& closes, int period);
+	bollinger_band_series calculate_bollinger_bands(const std::vector<double>& prices, int period, double width = 2.0);
+}
\ No newline at end of file
@@ -7,32 +7,83 @@ namespace mb
 		:
 		_interval{ interval },
 		_offset{ offset },
+		_trades{},
 		_startTime{ 0 },
-		_trades{}
+		_firstIndex{ 0 },
+		_includedEnd{ 0 },
+		_maxPrices{},
+		_minPrices{},
+		_volume{},
+		_quoteVolume{}
 	{}
 
-	std::vector<trade_update> moving_candle::get_offset_trades(std::time_t currentTime) const
+	void moving_candle::include_trade(size_t index)
 	{
-		if (_offset == 0)
+		const trade_update& trade{ trade_at(index) };
+
+		while (!_maxPrices.empty() && trade_at(_maxPrices.back()).price() <= trade.price())
 		{
-			return std::vector<trade_update>{ _trades.begin(), _trades.end() };
+			_maxPrices.pop_back();
 		}
 
-		std::vector<trade_update> trades;
-		
-		for (auto& trade : _trades)
+		while (!_minPrices.empty() && trade_at(_minPrices.back()).price() >= trade.price())
 		{
-			if (trade.time_stamp() <= _startTime + _interval - _offset)
-			{
-				trades.push_back(trade);
-			}
-			else
-			{
-				break;
-			}
+			_minPrices.pop_back();
 		}
 
-		return trades;
+		_maxPrices.push_back(index);
+		_minPrices.push_back(index);
+
+		_volume.add(trade.volume());
+		_quoteVolume.add(calculate_cost(trade.price(), trade.volume()));
+	}
+
+	void moving_candle::include_trades()
+	{
+		// With an offset the candle only covers trades up to its (lagged) close time, later trades wait to be included
+		size_t tradeEnd = _firstIndex + _trades.size();
+		std::time_t closeTime = _startTime + _interval - _offset;
+
+		while (_includedEnd < tradeEnd && (_offset == 0 || trade_at(_includedEnd).time_stamp() <= closeTime))
+		{
+			include_trade(_includedEnd++);
+		}
+	}
+
+	void moving_candle::clear_front_volume()
+	{
+		const trade_update& front{ _trades.front() };
+
+		if (_firstIndex < _includedEnd)
+		{
+			_volume.add(-front.volume());
+			_quoteVolume.add(-calculate_cost(front.price(), front.volume()));
+		}
+	}
+
+	void moving_candle::remove_front_trade()
+	{
+		clear_front_volume();
+
+		if (!_maxPrices.empty() && _maxPrices.front() == _firstIndex)
+		{
+			_maxPrices.pop_front();
+		}
+
+		if (!_minPrices.empty() && _minPrices.front() == _firstIndex)
+		{
+			_minPrices.pop_front();
+		}
+
+		_trades.pop_front();
+		++_firstIndex;
+		_includedEnd = std::max(_includedEnd, _firstIndex);
+
+		if (!has_included_trades())
+		{
+			_volume.clear();
+			_quoteVolume.clear();
+		}
 	}
 
 	void moving_candle::update_values(std::time_t currentTime)
@@ -42,16 +93,23 @@ namespace mb
 			_startTime = currentTime - _interval - _offset;
 		}
 
+		if (_trades.empty())
+		{
+			return;
+		}
+
+		include_trades();
+
 		while (_trades.size() > 1 && _trades[1].time_stamp() <= _startTime)
 		{
-			_trades.pop_front();
+			remove_front_trade();
 		}
 
 		if (_trades.front().time_stamp() < _startTime)
 		{
-			trade_update fillTrade{ _startTime, _trades.front().price(), 0.0 };
-			_trades.pop_front();
-			_trades.push_front(std::move(fillTrade));
+			// The fill trade keeps the price (so the max/min deques stay valid) but carries no volume
+			clear_front_volume();
+			_trades.front() = trade_update{ _startTime, _trades.front().price(), 0.0 };
 		}
 	}
 
@@ -70,47 +128,35 @@ namespace mb
 	{
 		update_values(time);
 
-		if (_trades.empty())
+		if (!has_included_trades())
 		{
 			return ohlcv_data{};
 		}
 
-		std::vector<trade_update> offsetTrades{ get_offset_trades(time) };
-
-		double open{ offsetTrades.front().price() };
-		double close{ offsetTrades.back().price() };
-		double high{ open };
-		double low{ open };
-		double volume = 0.0;
-
-		for (auto& trade : offsetTrades)
-		{
-			high = std::max(high, trade.price());
-			low = std::min(low, trade.price());
-			volume += trade.volume();
-		}
+		double open{ _trades.front().price() };
+		double close{ trade_at(_includedEnd - 1).price() };
+		double high{ trade_at(_maxPrices.front()).price() };
+		double low{ trade_at(_minPrices.front()).price() };
 
-		return ohlcv_data{ _startTime - _offset, open, high, low, close, volume };
+		return ohlcv_data{ _startTime - _offset, open, high, low, close, _volume.value() };
 	}
 
 	double moving_candle::get_quote_volume(std::time_t time)
 	{
 		update_values(time);
 
-		double quoteVolume{ 0.0 };
-		std::vector<trade_update> offsetTrades{ get_offset_trades(time) };
-
-		for (auto& trade : offsetTrades)
-		{
-			quoteVolume += calculate_cost(trade.price(), trade.volume());
-		}
-
-		return quoteVolume;
+		return _quoteVolume.value();
 	}
 
 	void moving_candle::reset()
 	{
 		_trades.clear();
 		_startTime = 0;
+		_firstIndex = 0;
+		_includedEnd = 0;
+		_maxPrices.clear();
+		_minPrices.clear();
+		_volume.clear();
+		_quoteVolume.clear();
 	}
 }
\ No newline at end of file
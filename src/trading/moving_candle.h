@@ -4,6 +4,7 @@
 
 #include "trade_update.h"
 #include "ohlcv_data.h"
+#include "common/utils/mathutils.h"
 
 namespace mb
 {
@@ -15,8 +16,21 @@ namespace mb
 		std::deque<trade_update> _trades;
 		std::time_t _startTime;
 
+		size_t _firstIndex;
+		size_t _includedEnd;
+		std::deque<size_t> _maxPrices;
+		std::deque<size_t> _minPrices;
+		compensated_sum _volume;
+		compensated_sum _quoteVolume;
+
+		const trade_update& trade_at(size_t index) const { return _trades[index - _firstIndex]; }
+		bool has_included_trades() const noexcept { return _includedEnd > _firstIndex; }
+
+		void include_trades();
+		void include_trade(size_t index);
+		void remove_front_trade();
+		void clear_front_volume();
 		void update_values(std::time_t currentTime);
-		std::vector<trade_update> get_offset_trades(std::time_t currentTime) const;
 
 	public:
 		moving_candle(int interval, int offset = 0);
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <fmt/format.h>
+
+#include "multi_interval_candle.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace mb
+{
+	namespace internal
+	{
+		trade_bucket::trade_bucket()
+			:
+			_startTime{ 0 },
+			_hasTrades{ false },
+			_high{ 0.0 },
+			_low{ 0.0 },
+			_volume{ 0.0 },
+			_hasStartPrice{ false },
+			_startPrice{ 0.0 },
+			_lastTime{ 0 },
+			_lastPrice{ 0.0 }
+		{}
+
+		void trade_bucket::reset(std::time_t startTime)
+		{
+			*this = trade_bucket{};
+			_startTime = startTime;
+		}
+
+		void trade_bucket::add_trade(std::time_t time, double price, double volume)
+		{
+			if (!_hasTrades)
+			{
+				_hasTrades = true;
+				_high = price;
+				_low = price;
+				_lastTime = time;
+				_lastPrice = price;
+			}
+
+			if (time == _startTime)
+			{
+				_hasStartPrice = true;
+				_startPrice = price;
+			}
+
+			_high = std::max(_high, price);
+			_low = std::min(_low, price);
+			_volume += volume;
+
+			if (time > _lastTime)
+			{
+				_lastTime = time;
+				_lastPrice = price;
+			}
+		}
+
+		candle_level::candle_level(int interval, const ohlcv_data& startOhlcv)
+			:
+			_interval{ interval },
+			_startTime{ startOhlcv.time_stamp() },
+			_open{ startOhlcv.open() },
+			_high{ startOhlcv.high() },
+			_low{ startOhlcv.low() },
+			_close{ startOhlcv.close() },
+			_volume{ startOhlcv.volume() },
+			_lastTime{ _startTime }
+		{}
+
+		void candle_level::roll(std::time_t currentTime)
+		{
+			if (currentTime < _startTime + _interval)
+			{
+				return;
+			}
+
+			_startTime += ((currentTime - _startTime) / _interval) * _interval;
+			_open = _close;
+			_high = _close;
+			_low = _close;
+			_volume = 0.0;
+		}
+
+		void candle_level::merge(const trade_bucket& bucket)
+		{
+			if (!bucket.has_trades())
+			{
+				return;
+			}
+
+			if (bucket.has_start_price() && bucket.start_time() == _startTime)
+			{
+				_open = bucket.start_price();
+			}
+
+			_high = std::max(_high, bucket.high());
+			_low = std::min(_low, bucket.low());
+			_volume += bucket.volume();
+
+			// Matches adding the trades one by one: close only moves for a trade later than any seen before
+			if (bucket.last_time() > _lastTime)
+			{
+				_close = bucket.last_price();
+				_lastTime = bucket.last_time();
+			}
+		}
+
+		void candle_level::add_trade(std::time_t time, double price, double volume)
+		{
+			roll(time);
+
+			if (time < _startTime)
+			{
+				return;
+			}
+
+			if (time == _startTime)
+			{
+				_open = price;
+			}
+
+			_high = std::max(_high, price);
+			_low = std::min(_low, price);
+			_volume += volume;
+
+			if (time > _lastTime)
+			{
+				_close = price;
+				_lastTime = time;
+			}
+		}
+
+		ohlcv_data candle_level::to_ohlcv() const
+		{
+			return ohlcv_data{ _startTime, _open, _high, _low, _close, _volume };
+		}
+	}
+
+	multi_interval_candle::multi_interval_candle()
+		: _levels{}, _bucket{}
+	{}
+
+	bool multi_interval_candle::has_interval(int interval) const
+	{
+		return std::any_of(_levels.begin(), _levels.end(), [interval](const internal::candle_level& level) { return level.interval() == interval; });
+	}
+
+	void multi_interval_candle::fold_bucket()
+	{
+		if (!_bucket.has_trades())
+		{
+			return;
+		}
+
+		for (auto& level : _levels)
+		{
+			level.roll(_bucket.start_time());
+			level.merge(_bucket);
+		}
+
+		_bucket.reset(_bucket.start_time());
+	}
+
+	void multi_interval_candle::advance(std::time_t currentTime)
+	{
+		if (_levels.empty())
+		{
+			return;
+		}
+
+		internal::candle_level& finest{ _levels.front() };
+
+		if (currentTime >= _bucket.start_time() + finest.interval())
+		{
+			fold_bucket();
+
+			finest.roll(currentTime);
+			_bucket.reset(finest.start_time());
+		}
+	}
+
+	void multi_interval_candle::add_interval(int interval, const ohlcv_data& startOhlcv)
+	{
+		if (has_interval(interval))
+		{
+			return;
+		}
+
+		fold_bucket();
+
+		auto it = std::find_if(_levels.begin(), _levels.end(), [interval](const internal::candle_level& level) { return level.interval() > interval; });
+		_levels.emplace(it, interval, startOhlcv);
+
+		_bucket.reset(_levels.front().start_time());
+	}
+
+	void multi_interval_candle::remove_interval(int interval)
+	{
+		fold_bucket();
+
+		_levels.erase(std::remove_if(_levels.begin(), _levels.end(), [interval](const internal::candle_level& level) { return level.interval() == interval; }), _levels.end());
+
+		if (!_levels.empty())
+		{
+			_bucket.reset(_levels.front().start_time());
+		}
+	}
+
+	void multi_interval_candle::add_trade(std::time_t time, double price, double volume)
+	{
+		if (_levels.empty())
+		{
+			return;
+		}
+
+		// A trade older than the open bucket has missed the finest candle, but a coarser candle may still contain it
+		if (time < _bucket.start_time())
+		{
+			for (auto& level : _levels)
+			{
+				level.add_trade(time, price, volume);
+			}
+
+			return;
+		}
+
+		advance(time);
+		_bucket.add_trade(time, price, volume);
+	}
+
+	ohlcv_data multi_interval_candle::get_ohlcv(int interval, std::time_t currentTime)
+	{
+		auto it = std::find_if(_levels.begin(), _levels.end(), [interval](const internal::candle_level& level) { return level.interval() == interval; });
+
+		if (it == _levels.end())
+		{
+			throw mb_exception{ fmt::format("Candle interval {} is not tracked", interval) };
+		}
+
+		advance(currentTime);
+		it->roll(currentTime);
+
+		internal::candle_level current{ *it };
+		current.merge(_bucket);
+
+		return current.to_ohlcv();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+
+#include "ohlcv_data.h"
+
+namespace mb
+{
+	namespace internal
+	{
+		class trade_bucket
+		{
+		private:
+			std::time_t _startTime;
+			bool _hasTrades;
+			double _high;
+			double _low;
+			double _volume;
+			bool _hasStartPrice;
+			double _startPrice;
+			std::time_t _lastTime;
+			double _lastPrice;
+
+		public:
+			trade_bucket();
+
+			std::time_t start_time() const noexcept { return _startTime; }
+			bool has_trades() const noexcept { return _hasTrades; }
+			double high() const noexcept { return _high; }
+			double low() const noexcept { return _low; }
+			double volume() const noexcept { return _volume; }
+			bool has_start_price() const noexcept { return _hasStartPrice; }
+			double start_price() const noexcept { return _startPrice; }
+			std::time_t last_time() const noexcept { return _lastTime; }
+			double last_price() const noexcept { return _lastPrice; }
+
+			void reset(std::time_t startTime);
+			void add_trade(std::time_t time, double price, double volume);
+		};
+
+		class candle_level
+		{
+		private:
+			int _interval;
+			std::time_t _startTime;
+			double _open;
+			double _high;
+			double _low;
+			double _close;
+			double _volume;
+			std::time_t _lastTime;
+
+		public:
+			candle_level(int interval, const ohlcv_data& startOhlcv);
+
+			int interval() const noexcept { return _interval; }
+			std::time_t start_time() const noexcept { return _startTime; }
+
+			void roll(std::time_t currentTime);
+			void merge(const trade_bucket& bucket);
+			void add_trade(std::time_t time, double price, double volume);
+
+			ohlcv_data to_ohlcv() const;
+		};
+	}
+
+	class multi_interval_candle
+	{
+	private:
+		std::vector<internal::candle_level> _levels;
+		internal::trade_bucket _bucket;
+
+		void fold_bucket();
+		void advance(std::time_t currentTime);
+
+	public:
+		multi_interval_candle();
+
+		bool empty() const noexcept { return _levels.empty(); }
+		bool has_interval(int interval) const;
+
+		void add_interval(int interval, const ohlcv_data& startOhlcv);
+		void remove_interval(int interval);
+
+		void add_trade(std::time_t time, double price, double volume);
+		ohlcv_data get_ohlcv(int interval, std::time_t currentTime);
+
+		template<typename Visitor>
+		void visit(std::time_t currentTime, const Visitor& visitor)
+		{
+			advance(currentTime);
+
+			for (auto& level : _levels)
+			{
+				level.roll(currentTime);
+
+				internal::candle_level current{ level };
+				current.merge(_bucket);
+
+				visitor(level.interval(), current.to_ohlcv());
+			}
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <fmt/format.h>
+
+#include "ohlcv_series.h"
+#include "common/exceptions/mb_exception.h"
+#include "common/utils/simdutils.h"
+
+namespace
+{
+	/*
+	* The kernels run two SSE2 accumulators of two lanes each, which every x64 target supports
+	* without extra compiler flags, and fall back to scalar code for the tail and other targets.
+	*/
+	double max_kernel(const double* values, size_t count) noexcept
+	{
+		double result = values[0];
+		size_t i = 0;
+
+#ifdef MB_SSE2
+		if (count >= 4)
+		{
+			__m128d first = _mm_loadu_pd(values);
+			__m128d second = _mm_loadu_pd(values + 2);
+
+			for (i = 4; i + 4 <= count; i += 4)
+			{
+				first = _mm_max_pd(first, _mm_loadu_pd(values + i));
+				second = _mm_max_pd(second, _mm_loadu_pd(values + i + 2));
+			}
+
+			first = _mm_max_pd(first, second);
+			result = std::max(_mm_cvtsd_f64(first), _mm_cvtsd_f64(_mm_unpackhi_pd(first, first)));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			result = std::max(result, values[i]);
+		}
+
+		return result;
+	}
+
+	double min_kernel(const double* values, size_t count) noexcept
+	{
+		double result = values[0];
+		size_t i = 0;
+
+#ifdef MB_SSE2
+		if (count >= 4)
+		{
+			__m128d first = _mm_loadu_pd(values);
+			__m128d second = _mm_loadu_pd(values + 2);
+
+			for (i = 4; i + 4 <= count; i += 4)
+			{
+				first = _mm_min_pd(first, _mm_loadu_pd(values + i));
+				second = _mm_min_pd(second, _mm_loadu_pd(values + i + 2));
+			}
+
+			first = _mm_min_pd(first, second);
+			result = std::min(_mm_cvtsd_f64(first), _mm_cvtsd_f64(_mm_unpackhi_pd(first, first)));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			result = std::min(result, values[i]);
+		}
+
+		return result;
+	}
+
+	double sum_kernel(const double* values, size_t count) noexcept
+	{
+		double result = 0.0;
+		size_t i = 0;
+
+#ifdef MB_SSE2
+		__m128d first = _mm_setzero_pd();
+		__m128d second = _mm_setzero_pd();
+
+		for (; i + 4 <= count; i += 4)
+		{
+			first = _mm_add_pd(first, _mm_loadu_pd(values + i));
+			second = _mm_add_pd(second, _mm_loadu_pd(values + i + 2));
+		}
+
+		first = _mm_add_pd(first, second);
+		result = _mm_cvtsd_f64(first) + _mm_cvtsd_f64(_mm_unpackhi_pd(first, first));
+#endif
+
+		for (; i < count; ++i)
+		{
+			result += values[i];
+		}
+
+		return result;
+	}
+
+	double typical_turnover_kernel(const double* highs, const double* lows, const double* closes, const double* volumes, size_t count) noexcept
+	{
+		double result = 0.0;
+		size_t i = 0;
+
+#ifdef MB_SSE2
+		__m128d sum = _mm_setzero_pd();
+
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128d price = _mm_add_pd(_mm_add_pd(_mm_loadu_pd(highs + i), _mm_loadu_pd(lows + i)), _mm_loadu_pd(closes + i));
+			sum = _mm_add_pd(sum, _mm_mul_pd(price, _mm_loadu_pd(volumes + i)));
+		}
+
+		result = _mm_cvtsd_f64(sum) + _mm_cvtsd_f64(_mm_unpackhi_pd(sum, sum));
+#endif
+
+		for (; i < count; ++i)
+		{
+			result += (highs[i] + lows[i] + closes[i]) * volumes[i];
+		}
+
+		return result / 3.0;
+	}
+
+	std::time_t interval_start(std::time_t timeStamp, int interval) noexcept
+	{
+		std::time_t remainder = timeStamp % interval;
+		return remainder < 0
+			? timeStamp - remainder - interval
+			: timeStamp - remainder;
+	}
+}
+
+namespace mb
+{
+	ohlcv_series::ohlcv_series()
+		: _timeStamps{}, _opens{}, _highs{}, _lows{}, _closes{}, _volumes{}
+	{}
+
+	ohlcv_series::ohlcv_series(const std::vector<ohlcv_data>& data)
+		: ohlcv_series{}
+	{
+		reserve(data.size());
+
+		for (auto& candle : data)
+		{
+			push_back(candle);
+		}
+	}
+
+	ohlcv_data ohlcv_series::operator[](size_t index) const noexcept
+	{
+		return ohlcv_data{ _timeStamps[index], _opens[index], _highs[index], _lows[index], _closes[index], _volumes[index] };
+	}
+
+	void ohlcv_series::reserve(size_t count)
+	{
+		_timeStamps.reserve(count);
+		_opens.reserve(count);
+		_highs.reserve(count);
+		_lows.reserve(count);
+		_closes.reserve(count);
+		_volumes.reserve(count);
+	}
+
+	void ohlcv_series::push_back(const ohlcv_data& data)
+	{
+		_timeStamps.push_back(data.time_stamp());
+		_opens.push_back(data.open());
+		_highs.push_back(data.high());
+		_lows.push_back(data.low());
+		_closes.push_back(data.close());
+		_volumes.push_back(data.volume());
+	}
+
+	void ohlcv_series::clear() noexcept
+	{
+		_timeStamps.clear();
+		_opens.clear();
+		_highs.clear();
+		_lows.clear();
+		_closes.clear();
+		_volumes.clear();
+	}
+
+	double ohlcv_series::max_high(size_t first, size_t last) const noexcept
+	{
+		return max_kernel(_highs.data() + first, last - first);
+	}
+
+	double ohlcv_series::min_low(size_t first, size_t last) const noexcept
+	{
+		return min_kernel(_lows.data() + first, last - first);
+	}
+
+	double ohlcv_series::sum_volume(size_t first, size_t last) const noexcept
+	{
+		return sum_kernel(_volumes.data() + first, last - first);
+	}
+
+	double ohlcv_series::vwap(size_t first, size_t last) const noexcept
+	{
+		double volume = sum_volume(first, last);
+		if (volume == 0.0)
+		{
+			return _closes[last - 1];
+		}
+
+		size_t count = last - first;
+		return typical_turnover_kernel(_highs.data() + first, _lows.data() + first, _closes.data() + first, _volumes.data() + first, count) / volume;
+	}
+
+	ohlcv_data ohlcv_series::merge(size_t first, size_t last, std::time_t timeStamp) const noexcept
+	{
+		return ohlcv_data
+		{
+			timeStamp,
+			_opens[first],
+			max_high(first, last),
+			min_low(first, last),
+			_closes[last - 1],
+			sum_volume(first, last)
+		};
+	}
+
+	ohlcv_series ohlcv_series::resample(int interval) const
+	{
+		if (interval <= 0)
+		{
+			throw mb_exception{ fmt::format("Cannot resample candles to an interval of {}", interval) };
+		}
+
+		ohlcv_series result;
+		size_t first = 0;
+
+		while (first < size())
+		{
+			std::time_t start = interval_start(_timeStamps[first], interval);
+			std::time_t end = start + interval;
+			size_t last = first + 1;
+
+			while (last < size() && _timeStamps[last] < end)
+			{
+				++last;
+			}
+
+			result.push_back(merge(first, last, start));
+			first = last;
+		}
+
+		return result;
+	}
+
+	std::vector<ohlcv_data> ohlcv_series::to_vector() const
+	{
+		std::vector<ohlcv_data> data;
+		data.reserve(size());
+
+		for (size_t i = 0; i < size(); ++i)
+		{
+			data.emplace_back((*this)[i]);
+		}
+
+		return data;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <new>
+#include <vector>
+
+#include "ohlcv_data.h"
+
+namespace mb
+{
+	namespace internal
+	{
+		constexpr size_t SERIES_ALIGNMENT = 64;
+
+		template<typename T>
+		class aligned_allocator
+		{
+		public:
+			using value_type = T;
+
+			constexpr aligned_allocator() noexcept = default;
+
+			template<typename U>
+			constexpr aligned_allocator(const aligned_allocator<U>&) noexcept
+			{}
+
+			T* allocate(size_t count)
+			{
+				return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ SERIES_ALIGNMENT }));
+			}
+
+			void deallocate(T* pointer, size_t) noexcept
+			{
+				::operator delete(pointer, std::align_val_t{ SERIES_ALIGNMENT });
+			}
+
+			template<typename U>
+			constexpr bool operator==(const aligned_allocator<U>&) const noexcept { return true; }
+
+			template<typename U>
+			constexpr bool operator!=(const aligned_allocator<U>&) const noexcept { return false; }
+		};
+	}
+
+	template<typename T>
+	using aligned_vector = std::vector<T, internal::aligned_allocator<T>>;
+
+	class ohlcv_series
+	{
+	private:
+		aligned_vector<std::time_t> _timeStamps;
+		aligned_vector<double> _opens;
+		aligned_vector<double> _highs;
+		aligned_vector<double> _lows;
+		aligned_vector<double> _closes;
+		aligned_vector<double> _volumes;
+
+	public:
+		ohlcv_series();
+		explicit ohlcv_series(const std::vector<ohlcv_data>& data);
+
+		size_t size() const noexcept { return _timeStamps.size(); }
+		bool empty() const noexcept { return _timeStamps.empty(); }
+
+		const aligned_vector<std::time_t>& time_stamps() const noexcept { return _timeStamps; }
+		const aligned_vector<double>& opens() const noexcept { return _opens; }
+		const aligned_vector<double>& highs() const noexcept { return _highs; }
+		const aligned_vector<double>& lows() const noexcept { return _lows; }
+		const aligned_vector<double>& closes() const noexcept { return _closes; }
+		const aligned_vector<double>& volumes() const noexcept { return _volumes; }
+
+		ohlcv_data operator[](size_t index) const noexcept;
+		ohlcv_data front() const noexcept { return (*this)[0]; }
+		ohlcv_data back() const noexcept { return (*this)[size() - 1]; }
+
+		void reserve(size_t count);
+		void push_back(const ohlcv_data& data);
+		void clear() noexcept;
+
+		// Range queries cover the candles in [first, last) and expect a non empty range
+		double max_high(size_t first, size_t last) const noexcept;
+		double min_low(size_t first, size_t last) const noexcept;
+		double sum_volume(size_t first, size_t last) const noexcept;
+		double vwap(size_t first, size_t last) const noexcept;
+		ohlcv_data merge(size_t first, size_t last, std::time_t timeStamp) const noexcept;
+
+		ohlcv_series resample(int interval) const;
+		std::vector<ohlcv_data> to_vector() const;
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <functional>
 #include <cassert>
 #include <ctime>
 
@@ -32,6 +33,8 @@ namespace mb
 		constexpr order_book_side side() const noexcept { return _side; }
 	};
 
+	using order_book_visitor = std::function<bool(const order_book_entry&)>;
+
 	class order_book_state
 	{
 	private:
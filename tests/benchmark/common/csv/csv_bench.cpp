@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "common/csv/csv.h"
+#include "trading/ohlcv_data.h"
+
+namespace
+{
+	using namespace mb;
+
+	std::filesystem::path write_ohlcv_file(int rows)
+	{
+		std::filesystem::path path{ std::filesystem::temp_directory_path() / ("marketblocks_bench_" + std::to_string(rows) + ".csv") };
+
+		std::mt19937 generator{ 7 };
+		std::normal_distribution<double> step{ 0.0, 10.0 };
+		std::ofstream stream{ path };
+		stream.precision(10);
+
+		double price = 30000.0;
+		for (int i = 0; i < rows; ++i)
+		{
+			double open = price;
+			price += step(generator);
+
+			stream << 1600000000 + i * 60 << ','
+				<< open << ','
+				<< std::max(open, price) + 5.0 << ','
+				<< std::min(open, price) - 5.0 << ','
+				<< price << ','
+				<< 1.5 + i % 7 << '\n';
+		}
+
+		return path;
+	}
+
+	void BM_ReadCsvOhlcv(benchmark::State& state)
+	{
+		int rows = static_cast<int>(state.range(0));
+		std::filesystem::path path{ write_ohlcv_file(rows) };
+		std::uintmax_t fileSize = std::filesystem::file_size(path);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(read_csv_file<ohlcv_data>(path));
+		}
+
+		state.SetItemsProcessed(state.iterations() * rows);
+		state.SetBytesProcessed(state.iterations() * fileSize);
+
+		std::filesystem::remove(path);
+	}
+}
+
+BENCHMARK(BM_ReadCsvOhlcv)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include "common/security/hmac_signer.h"
+#include "common/security/hash.h"
+#include "common/security/encoding.h"
+
+namespace
+{
+	using namespace mb;
+
+	const std::string SECRET_KEY{ "NhqPtmdSJYdKjVHjA7PZj4Mge3R5YNiP1e3UZjInClVN65XAbvqqM6A7H5fATj0j" };
+	const std::string QUERY{ "symbol=LTCBTC&side=BUY&type=LIMIT&timeInForce=GTC&quantity=1&price=0.1&recvWindow=5000&timestamp=1499827319559" };
+
+	void BM_HmacSha256HexPerCall(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hex_encode(hmac_sha256(QUERY, SECRET_KEY)));
+		}
+
+		state.counters["signs_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+
+	void BM_HmacSha256HexSigner(benchmark::State& state)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(SECRET_KEY) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(signer.sign_hex(QUERY));
+		}
+
+		state.counters["signs_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+
+	void BM_HmacSha256HexSignerReusedBuffer(benchmark::State& state)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(SECRET_KEY) };
+		std::string signature;
+
+		for (auto _ : state)
+		{
+			signer.sign_hex_into(signature, QUERY);
+			benchmark::DoNotOptimize(signature.data());
+		}
+
+		state.counters["signs_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+
+	void BM_HmacSha512Base64PerCall(benchmark::State& state)
+	{
+		std::vector<unsigned char> key{ SECRET_KEY.begin(), SECRET_KEY.end() };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(b64_encode(hmac_sha512(QUERY, key)));
+		}
+
+		state.counters["signs_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+
+	void BM_HmacSha512Base64Signer(benchmark::State& state)
+	{
+		hmac_signer signer{ create_hmac_sha512_signer(std::vector<unsigned char>{ SECRET_KEY.begin(), SECRET_KEY.end() }) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(signer.sign_base64(QUERY));
+		}
+
+		state.counters["signs_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+}
+
+BENCHMARK(BM_HmacSha256HexPerCall);
+BENCHMARK(BM_HmacSha256HexSigner);
+BENCHMARK(BM_HmacSha256HexSignerReusedBuffer);
+BENCHMARK(BM_HmacSha512Base64PerCall);
+BENCHMARK(BM_HmacSha512Base64Signer);
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <unordered_map>
+#include <string>
+
+#include "common/types/concurrent_wrapper.h"
+#include "common/types/read_mostly_wrapper.h"
+
+namespace
+{
+	using namespace mb;
+
+	using pair_map = std::unordered_map<std::string, int>;
+
+	pair_map create_pairs()
+	{
+		return pair_map
+		{
+			{ "BTC/GBP", 0 },
+			{ "ETH/GBP", 1 },
+			{ "ETH/BTC", 2 },
+			{ "LTC/BTC", 3 }
+		};
+	}
+
+	// Mirrors the pair lookup every websocket update does before firing its handlers
+	template<typename Wrapper>
+	void look_up_pair(benchmark::State& state, const Wrapper& wrapper)
+	{
+		const std::string pairName{ "ETH/BTC" };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(wrapper.shared_lock()->at(pairName));
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void BM_ConcurrentWrapperSharedRead(benchmark::State& state)
+	{
+		static concurrent_wrapper<pair_map> wrapper{ create_pairs() };
+		look_up_pair(state, wrapper);
+	}
+
+	void BM_ReadMostlyWrapperSharedRead(benchmark::State& state)
+	{
+		static read_mostly_wrapper<pair_map> wrapper{ create_pairs() };
+		look_up_pair(state, wrapper);
+	}
+}
+
+BENCHMARK(BM_ConcurrentWrapperSharedRead)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ReadMostlyWrapperSharedRead)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "common/types/set_queue.h"
+#include "common/types/bounded_index_set_queue.h"
+
+namespace
+{
+	using namespace mb;
+
+	static constexpr int KEY_COUNT = 1024;
+
+	// Every thread pushes keys from the shared key space, so some pushes are de-duplicated, and pops one item back
+	template<typename Queue>
+	void push_and_pop(benchmark::State& state, Queue& queue)
+	{
+		std::mt19937 generator{ static_cast<unsigned int>(state.thread_index()) };
+		std::uniform_int_distribution<int> keys{ 0, KEY_COUNT - 1 };
+
+		for (auto _ : state)
+		{
+			queue.push(keys(generator));
+			benchmark::DoNotOptimize(queue.try_pop());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void BM_SetQueuePushPop(benchmark::State& state)
+	{
+		static set_queue<int> queue;
+		push_and_pop(state, queue);
+	}
+
+	void BM_BoundedIndexSetQueuePushPop(benchmark::State& state)
+	{
+		static bounded_index_set_queue<int> queue{ KEY_COUNT };
+		push_and_pop(state, queue);
+	}
+}
+
+BENCHMARK(BM_SetQueuePushPop)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_BoundedIndexSetQueuePushPop)->ThreadRange(1, 16)->UseRealTime();
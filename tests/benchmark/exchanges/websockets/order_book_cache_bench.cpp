@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "exchanges/websockets/order_book_cache.h"
+
+namespace
+{
+	using namespace mb;
+
+	static constexpr int UPDATE_COUNT = 4096;
+	static constexpr double MID_PRICE = 30000.0;
+	static constexpr double TICK_SIZE = 0.5;
+
+	order_book_cache create_cache(int levels)
+	{
+		std::vector<order_book_entry> asks;
+		std::vector<order_book_entry> bids;
+
+		for (int i = 1; i <= levels; ++i)
+		{
+			asks.emplace_back(MID_PRICE + i * TICK_SIZE, 1.0, order_book_side::ASK);
+			bids.emplace_back(MID_PRICE - i * TICK_SIZE, 1.0, order_book_side::BID);
+		}
+
+		return order_book_cache{ 0, asks, bids };
+	}
+
+	std::vector<order_book_entry> create_updates(int levels)
+	{
+		std::mt19937 generator{ 7 };
+		std::uniform_int_distribution<int> level{ 1, levels };
+		std::uniform_int_distribution<int> side{ 0, 1 };
+		std::uniform_real_distribution<double> volume{ 0.0, 2.0 };
+
+		std::vector<order_book_entry> updates;
+		updates.reserve(UPDATE_COUNT);
+
+		for (int i = 0; i < UPDATE_COUNT; ++i)
+		{
+			// Roughly a quarter of updates remove a level, which a later update then puts back
+			double updateVolume = std::max(volume(generator) - 0.5, 0.0);
+			double offset = level(generator) * TICK_SIZE;
+
+			updates.emplace_back(side(generator) == 0
+				? order_book_entry{ MID_PRICE + offset, updateVolume, order_book_side::ASK }
+				: order_book_entry{ MID_PRICE - offset, updateVolume, order_book_side::BID });
+		}
+
+		return updates;
+	}
+
+	void BM_OrderBookCacheUpdate(benchmark::State& state)
+	{
+		int levels = static_cast<int>(state.range(0));
+		order_book_cache cache{ create_cache(levels) };
+		std::vector<order_book_entry> updates{ create_updates(levels) };
+		std::time_t timeStamp = 0;
+
+		for (auto _ : state)
+		{
+			for (auto& update : updates)
+			{
+				cache.update_cache(++timeStamp, update);
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * UPDATE_COUNT);
+	}
+
+	void BM_OrderBookCacheSnapshot(benchmark::State& state)
+	{
+		order_book_cache cache{ create_cache(1000) };
+		int depth = static_cast<int>(state.range(0));
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(cache.snapshot(depth));
+		}
+	}
+}
+
+BENCHMARK(BM_OrderBookCacheUpdate)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_OrderBookCacheSnapshot)->Arg(10)->Arg(100)->Arg(0);
\ No newline at end of file
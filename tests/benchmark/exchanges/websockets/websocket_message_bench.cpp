@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "mbtest/mocks.h"
+#include "test_data/test_data_constants.h"
+#include "common/file/file.h"
+#include "common/json/json.h"
+#include "exchanges/binance/binance_websocket.h"
+#include "exchanges/bybit/bybit_websocket.h"
+#include "exchanges/coinbase/coinbase_websocket.h"
+#include "exchanges/digifinex/digifinex_websocket.h"
+#include "exchanges/kraken/kraken_websocket.h"
+
+namespace
+{
+	using namespace mb;
+	using namespace mb::test;
+
+	using ::testing::_;
+	using ::testing::NiceMock;
+	using ::testing::Return;
+
+	using stream_creator = std::unique_ptr<exchange_websocket_stream>(*)(std::unique_ptr<websocket_connection_factory>);
+
+	class null_websocket_connection : public websocket_connection
+	{
+	public:
+		null_websocket_connection()
+			: websocket_connection{ std::weak_ptr<void>() }
+		{}
+
+		ws_connection_status connection_status() const override { return ws_connection_status::OPEN; }
+		void close() override {}
+		void send_message(std::string message) override {}
+	};
+
+	class replay_connection_factory : public websocket_connection_factory
+	{
+	public:
+		void replay(std::string_view message) const { _onMessage(message); }
+
+		std::unique_ptr<websocket_connection> create_connection(std::string url) const override
+		{
+			return std::make_unique<null_websocket_connection>();
+		}
+	};
+
+	std::string read_fixture(std::string_view folder, std::string_view fileName)
+	{
+		std::filesystem::path path{ TEST_DATA_FOLDER };
+		path /= folder;
+		path /= fileName;
+		path.replace_extension(".json");
+
+		return read_file(path);
+	}
+
+	std::unique_ptr<market_api> create_market_api()
+	{
+		std::unique_ptr<NiceMock<mock_exchange>> marketApi{ std::make_unique<NiceMock<mock_exchange>>() };
+
+		ON_CALL(*marketApi, get_ohlcv(_, _, _))
+			.WillByDefault(Return(std::vector<ohlcv_data>{ ohlcv_data{ 1657043700, 19703.50, 19720.0, 19682.1, 19693.6, 2.38715290 } }));
+
+		return marketApi;
+	}
+
+	std::unique_ptr<exchange_websocket_stream> create_binance(std::unique_ptr<websocket_connection_factory> connectionFactory)
+	{
+		return std::make_unique<internal::binance_websocket_stream>(std::move(connectionFactory), create_market_api());
+	}
+
+	std::unique_ptr<exchange_websocket_stream> create_bybit(std::unique_ptr<websocket_connection_factory> connectionFactory)
+	{
+		return std::make_unique<internal::bybit_websocket_stream>(std::move(connectionFactory));
+	}
+
+	std::unique_ptr<exchange_websocket_stream> create_coinbase(std::unique_ptr<websocket_connection_factory> connectionFactory)
+	{
+		return std::make_unique<internal::coinbase_websocket_stream>(std::move(connectionFactory), create_market_api());
+	}
+
+	std::unique_ptr<exchange_websocket_stream> create_digifinex(std::unique_ptr<websocket_connection_factory> connectionFactory)
+	{
+		return std::make_unique<internal::digifinex_websocket_stream>(std::move(connectionFactory), create_market_api());
+	}
+
+	std::unique_ptr<exchange_websocket_stream> create_kraken(std::unique_ptr<websocket_connection_factory> connectionFactory)
+	{
+		return std::make_unique<internal::kraken_websocket_stream>(std::move(connectionFactory));
+	}
+
+	void BM_ParseJson(benchmark::State& state, std::string_view folder, std::string_view fileName)
+	{
+		std::string message{ read_fixture(folder, fileName) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(parse_json(message));
+		}
+
+		state.SetBytesProcessed(state.iterations() * message.size());
+	}
+
+	void BM_OnMessage(benchmark::State& state, stream_creator createStream, std::string_view folder, std::string_view fileName, std::string_view setupFileName)
+	{
+		std::unique_ptr<replay_connection_factory> connectionFactory{ std::make_unique<replay_connection_factory>() };
+		replay_connection_factory* replay = connectionFactory.get();
+
+		std::unique_ptr<exchange_websocket_stream> stream{ createStream(std::move(connectionFactory)) };
+		stream->reset();
+		stream->subscribe(websocket_subscription::create_ohlcv_sub({ tradable_pair{ "BTC", "USD" } }, ohlcv_interval::M5));
+
+		if (!setupFileName.empty())
+		{
+			replay->replay(read_fixture(folder, setupFileName));
+		}
+
+		std::string message{ read_fixture(folder, fileName) };
+
+		for (auto _ : state)
+		{
+			replay->replay(message);
+		}
+
+		state.SetItemsProcessed(state.iterations());
+		state.SetBytesProcessed(state.iterations() * message.size());
+	}
+}
+
+BENCHMARK_CAPTURE(BM_ParseJson, binance_trade_update, "binance/websockets", "trade_update");
+BENCHMARK_CAPTURE(BM_ParseJson, binance_ohlcv_update, "binance/websockets", "ohlcv_update");
+BENCHMARK_CAPTURE(BM_ParseJson, kraken_order_book_snapshot, "kraken_websocket_test", "order_book_snapshot");
+BENCHMARK_CAPTURE(BM_ParseJson, coinbase_get_order_book, "coinbase/responses", "get_order_book");
+
+BENCHMARK_CAPTURE(BM_OnMessage, binance_trade_update, create_binance, "binance/websockets", "trade_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, binance_ohlcv_update, create_binance, "binance/websockets", "ohlcv_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, bybit_trade_update, create_bybit, "bybit/websockets", "trade_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, bybit_ohlcv_update, create_bybit, "bybit/websockets", "ohlcv_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, coinbase_trade_update, create_coinbase, "coinbase/websockets", "trade_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, coinbase_ohlcv_update, create_coinbase, "coinbase/websockets", "ohlcv_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, digifinex_trade_update, create_digifinex, "digifinex/websockets", "trade_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, digifinex_ohlcv_update, create_digifinex, "digifinex/websockets", "ohlcv_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, kraken_trade_update, create_kraken, "kraken/websockets", "trade_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, kraken_ohlcv_update, create_kraken, "kraken/websockets", "ohlcv_update", "");
+BENCHMARK_CAPTURE(BM_OnMessage, kraken_order_book_update, create_kraken, "kraken_websocket_test", "order_book_update_1", "order_book_snapshot");
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "testing/back_testing/back_testing_data.h"
+
+namespace
+{
+	using namespace mb;
+
+	static constexpr int CANDLE_COUNT = 100000;
+	static constexpr int STEP_SIZE = 60;
+	static constexpr std::time_t START_TIME = 1600000000;
+
+	const tradable_pair TEST_PAIR{ "BTC", "GBP" };
+
+	back_testing_data create_back_testing_data()
+	{
+		std::mt19937 generator{ 7 };
+		std::normal_distribution<double> step{ 0.0, 10.0 };
+
+		std::vector<ohlcv_data> candles;
+		candles.reserve(CANDLE_COUNT);
+
+		double price = 30000.0;
+		for (int i = 0; i < CANDLE_COUNT; ++i)
+		{
+			double open = price;
+			price += step(generator);
+			candles.emplace_back(START_TIME + i * STEP_SIZE, open, std::max(open, price) + 5.0, std::min(open, price) - 5.0, price, 1.0);
+		}
+
+		std::time_t endTime = START_TIME + CANDLE_COUNT * STEP_SIZE;
+
+		return back_testing_data
+		{
+			{ TEST_PAIR },
+			{ { TEST_PAIR, std::move(candles) } },
+			START_TIME,
+			endTime,
+			STEP_SIZE,
+			CANDLE_COUNT
+		};
+	}
+
+	void advance(back_testing_data& data)
+	{
+		data.increment();
+
+		if (data.data_time() >= data.end_time())
+		{
+			data.seek(data.start_time());
+		}
+	}
+
+	void BM_BackTestingDataGetOhlcv(benchmark::State& state)
+	{
+		back_testing_data data{ create_back_testing_data() };
+		data.seek(START_TIME + 86400);
+
+		int interval = static_cast<int>(state.range(0));
+		int count = static_cast<int>(state.range(1));
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(data.get_ohlcv(TEST_PAIR, interval, count));
+			advance(data);
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+
+	void BM_BackTestingDataGetTrade(benchmark::State& state)
+	{
+		back_testing_data data{ create_back_testing_data() };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(data.get_trade(TEST_PAIR));
+			advance(data);
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+}
+
+BENCHMARK(BM_BackTestingDataGetOhlcv)->Args({ 60, 50 })->Args({ 300, 50 })->Args({ 3600, 24 });
+BENCHMARK(BM_BackTestingDataGetTrade);
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "mbtest/mocks.h"
+#include "testing/paper_trading/paper_trade_api.h"
+
+namespace
+{
+	using namespace mb;
+	using namespace mb::test;
+
+	using ::testing::NiceMock;
+	using ::testing::Return;
+
+	static constexpr int TRADE_COUNT = 1024;
+	static constexpr double MARKET_PRICE = 20000.0;
+
+	const tradable_pair TEST_PAIR{ "BTC", "GBP" };
+
+	void BM_PaperTradeUpdateWithOpenOrders(benchmark::State& state)
+	{
+		int orderCount = static_cast<int>(state.range(0));
+		std::shared_ptr<NiceMock<mock_websocket_stream>> websocketStream{ std::make_shared<NiceMock<mock_websocket_stream>>() };
+		std::time_t time = 0;
+
+		ON_CALL(*websocketStream, get_last_trade)
+			.WillByDefault(Return(trade_update{ 0, MARKET_PRICE, 1.0 }));
+
+		paper_trade_api tradeApi
+		{
+			paper_trading_config{ 0.1, { { "GBP", 1e12 }, { "BTC", 1e6 } } },
+			websocketStream,
+			"",
+			[&time]() { return time; }
+		};
+
+		// Resting orders are spread either side of the market so none of the replayed trades fill them
+		for (int i = 0; i < orderCount; ++i)
+		{
+			double offset = 100.0 + i % 1000;
+			tradeApi.add_order(i % 2 == 0
+				? create_limit_order(TEST_PAIR, trade_action::BUY, MARKET_PRICE - offset, 0.01)
+				: create_limit_order(TEST_PAIR, trade_action::SELL, MARKET_PRICE + offset, 0.01));
+		}
+
+		std::mt19937 generator{ 7 };
+		std::uniform_real_distribution<double> priceOffset{ -50.0, 50.0 };
+		std::vector<trade_update> trades;
+		trades.reserve(TRADE_COUNT);
+
+		for (int i = 0; i < TRADE_COUNT; ++i)
+		{
+			trades.emplace_back(i, MARKET_PRICE + priceOffset(generator), 0.5);
+		}
+
+		for (auto _ : state)
+		{
+			for (auto& trade : trades)
+			{
+				websocketStream->expose_fire_trade_update(trade_update_message{ TEST_PAIR, trade });
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * TRADE_COUNT);
+	}
+}
+
+BENCHMARK(BM_PaperTradeUpdateWithOpenOrders)->Arg(10)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "trading/moving_candle.h"
+
+namespace
+{
+	using namespace mb;
+
+	static constexpr int TRADE_COUNT = 1000000;
+	static constexpr int DAY_SECONDS = 86400;
+
+	std::vector<trade_update> create_trade_stream(int tradesPerSecond)
+	{
+		std::mt19937 generator{ 7 };
+		std::normal_distribution<double> priceStep{ 0.0, 0.05 };
+		std::exponential_distribution<double> volume{ 2.0 };
+
+		std::vector<trade_update> trades;
+		trades.reserve(TRADE_COUNT);
+
+		double price = 30000.0;
+		for (int i = 0; i < TRADE_COUNT; ++i)
+		{
+			price += priceStep(generator);
+			trades.emplace_back(1000000 + i / tradesPerSecond, price, volume(generator));
+		}
+
+		return trades;
+	}
+
+	void BM_MovingCandlePushAndQuery(benchmark::State& state)
+	{
+		std::vector<trade_update> trades{ create_trade_stream(static_cast<int>(state.range(0))) };
+
+		for (auto _ : state)
+		{
+			moving_candle candle{ DAY_SECONDS };
+
+			for (auto& trade : trades)
+			{
+				candle.push_trade(trade);
+				benchmark::DoNotOptimize(candle.get_ohlcv(trade.time_stamp()));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * TRADE_COUNT);
+	}
+
+	void BM_MovingCandlePushAndQueryWithOffset(benchmark::State& state)
+	{
+		std::vector<trade_update> trades{ create_trade_stream(static_cast<int>(state.range(0))) };
+
+		for (auto _ : state)
+		{
+			moving_candle candle{ DAY_SECONDS, 3600 };
+
+			for (auto& trade : trades)
+			{
+				candle.push_trade(trade);
+				benchmark::DoNotOptimize(candle.get_ohlcv(trade.time_stamp()));
+				benchmark::DoNotOptimize(candle.get_quote_volume(trade.time_stamp()));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * TRADE_COUNT);
+	}
+}
+
+BENCHMARK(BM_MovingCandlePushAndQuery)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MovingCandlePushAndQueryWithOffset)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
\ No newline at end of file
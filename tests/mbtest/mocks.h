@@ -14,7 +14,24 @@ namespace mb::test
 	class mock_http_service : public http_service
 	{
 	public:
+		mock_http_service()
+		{
+			ON_CALL(*this, send_batch).WillByDefault([this](const std::vector<http_request>& requests)
+			{
+				std::vector<http_response> responses;
+				responses.reserve(requests.size());
+
+				for (auto& request : requests)
+				{
+					responses.emplace_back(send(request));
+				}
+
+				return responses;
+			});
+		}
+
 		MOCK_METHOD(http_response, send, (const http_request& request), (const, override));
+		MOCK_METHOD(std::vector<http_response>, send_batch, (const std::vector<http_request>& requests), (const, override));
 	};
 
 	class mock_websocket_stream : public websocket_stream
@@ -36,6 +53,16 @@ namespace mb::test
 		{
 			fire_trade_update(std::move(message));
 		}
+
+		void expose_fire_order_book_update(order_book_update_message message)
+		{
+			fire_order_book_update(std::move(message));
+		}
+
+		void expose_fire_ohlcv_update(ohlcv_update_message message)
+		{
+			fire_ohlcv_update(std::move(message));
+		}
 	};
 
 	class mock_exchange_websocket_stream : public exchange_websocket_stream
@@ -48,9 +75,15 @@ namespace mb::test
 			: exchange_websocket_stream{ id, std::move(url), '\0', std::move(connectionFactory)}
 		{}
 
+		~mock_exchange_websocket_stream() override
+		{
+			shutdown();
+		}
+
 		MOCK_METHOD(void, on_message, (std::string_view message), (override));
 		MOCK_METHOD(void, send_subscribe, (const websocket_subscription& subscription), (override));
 		MOCK_METHOD(void, send_unsubscribe, (const websocket_subscription& subscription), (override));
+		MOCK_METHOD(sequenced_order_book, fetch_order_book_snapshot, (const tradable_pair& pair), (override));
 
 		void expose_update_trade(std::string pairName, trade_update trade)
 		{
@@ -72,6 +105,11 @@ namespace mb::test
 			update_order_book(std::move(pairName), timeStamp, std::move(entry));
 		}
 
+		void expose_update_order_book(std::string pairName, order_book_update_batch update)
+		{
+			update_order_book(std::move(pairName), std::move(update));
+		}
+
 		void expose_set_unsubscribed(const named_subscription& subscription)
 		{
 			set_unsubscribed(subscription);
@@ -118,6 +156,7 @@ namespace mb::test
 	{
 	public:
 		void fire_on_message(std::string_view message) { _onMessage(message); }
+		void fire_on_close() { _onClose(); }
 
 		MOCK_METHOD(std::unique_ptr<websocket_connection>, create_connection, (std::string url), (const, override));
 	};
@@ -140,4 +179,4 @@ namespace mb::test
 		MOCK_METHOD(std::vector<tradable_pair>, get_available_pairs, (), (override));
 		MOCK_METHOD(std::vector<ohlcv_data>, load_data, (const tradable_pair& pair, int stepSize), (override));
 	};
-}
+}
\ No newline at end of file
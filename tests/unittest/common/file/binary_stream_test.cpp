@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include "common/file/binary_stream.h"
+
+namespace mb::test
+{
+	TEST(BinaryStream, ReaderReturnsValuesInWrittenOrder)
+	{
+		binary_writer writer;
+		writer
+			.write(42)
+			.write_string("BTC")
+			.write(1.5)
+			.write_string("");
+
+		binary_reader reader{ writer.data() };
+
+		EXPECT_EQ(reader.read<int>(), 42);
+		EXPECT_EQ(reader.read_string(), "BTC");
+		EXPECT_DOUBLE_EQ(reader.read<double>(), 1.5);
+		EXPECT_EQ(reader.read_string(), "");
+		EXPECT_TRUE(reader.at_end());
+	}
+
+	TEST(BinaryStream, ReaderThrowsIfDataIsTruncated)
+	{
+		binary_writer writer;
+		writer.write_string("GBP");
+
+		std::string truncated{ writer.data().substr(0, writer.data().size() - 1) };
+		binary_reader reader{ truncated };
+
+		EXPECT_THROW(reader.read_string(), mb_exception);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "common/security/hmac_signer.h"
+#include "common/security/hash.h"
+#include "common/security/encoding.h"
+
+namespace
+{
+	constexpr std::string_view TEST_KEY = "Jefe";
+	constexpr std::string_view TEST_MESSAGE = "what do ya want for nothing?";
+}
+
+namespace mb::test
+{
+	TEST(HmacSigner, ComputesCorrectHmacSha256)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(TEST_KEY) };
+
+		EXPECT_EQ(signer.sign_hex(TEST_MESSAGE), "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+	}
+
+	TEST(HmacSigner, ComputesCorrectHmacSha512)
+	{
+		hmac_signer signer{ create_hmac_sha512_signer(std::vector<unsigned char>{ TEST_KEY.begin(), TEST_KEY.end() }) };
+
+		EXPECT_EQ(signer.sign_hex(TEST_MESSAGE), "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea2505549758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+	}
+
+	TEST(HmacSigner, RepeatedSignsAreIndependent)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(TEST_KEY) };
+
+		std::string first{ signer.sign_hex(std::string_view{ "first message" }) };
+		std::string expected{ signer.sign_hex(TEST_MESSAGE) };
+
+		EXPECT_NE(first, expected);
+		EXPECT_EQ(signer.sign_hex(TEST_MESSAGE), expected);
+	}
+
+	TEST(HmacSigner, SigningPartsMatchesSigningConcatenation)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(TEST_KEY) };
+
+		EXPECT_EQ(
+			signer.sign_hex(std::string_view{ "what do ya " }, std::string_view{ "want for nothing?" }),
+			signer.sign_hex(TEST_MESSAGE));
+	}
+
+	TEST(HmacSigner, Base64MatchesExistingEncoding)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(TEST_KEY) };
+
+		EXPECT_EQ(signer.sign_base64(TEST_MESSAGE), b64_encode(hmac_sha256(TEST_MESSAGE, TEST_KEY)));
+	}
+
+	TEST(HmacSigner, SignIntoReusesOutputBuffer)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(TEST_KEY) };
+		std::string output{ "previous signature that is longer than the new one" };
+
+		signer.sign_base64_into(output, TEST_MESSAGE);
+
+		EXPECT_EQ(output, signer.sign_base64(TEST_MESSAGE));
+	}
+
+	TEST(HmacSigner, InterleavedSignersKeepTheirOwnKeys)
+	{
+		hmac_signer first{ create_hmac_sha256_signer(TEST_KEY) };
+		hmac_signer second{ create_hmac_sha512_signer(std::vector<unsigned char>{ 's', 'e', 'c', 'o', 'n', 'd' }) };
+
+		for (int i = 0; i < 3; ++i)
+		{
+			EXPECT_EQ(first.sign_hex(TEST_MESSAGE), hex_encode(hmac_sha256(TEST_MESSAGE, TEST_KEY)));
+			EXPECT_EQ(second.sign_hex(TEST_MESSAGE), hex_encode(hmac_sha512(TEST_MESSAGE, std::string_view{ "second" })));
+		}
+	}
+
+	TEST(HmacSigner, EmptyKeyMatchesPerCallHmac)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(std::vector<unsigned char>{}) };
+
+		EXPECT_EQ(signer.sign_hex(TEST_MESSAGE), hex_encode(hmac_sha256(TEST_MESSAGE, std::string_view{})));
+	}
+
+	TEST(HmacSigner, SignsOnOtherThreads)
+	{
+		hmac_signer signer{ create_hmac_sha256_signer(TEST_KEY) };
+		std::string expected{ signer.sign_hex(TEST_MESSAGE) };
+
+		std::string signature;
+		std::thread{ [&]() { signature = signer.sign_hex(TEST_MESSAGE); } }.join();
+
+		EXPECT_EQ(signature, expected);
+	}
+}
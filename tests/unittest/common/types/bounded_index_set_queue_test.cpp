@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "common/types/bounded_index_set_queue.h"
+
+namespace mb::test
+{
+	TEST(BoundedIndexSetQueue, PopReturnsItemsInPushOrder)
+	{
+		bounded_index_set_queue<int> queue{ 8 };
+
+		queue.push(1);
+		queue.push(2);
+		queue.push(3);
+
+		ASSERT_EQ(queue.size(), 3);
+		EXPECT_EQ(queue.pop(), 1);
+		EXPECT_EQ(queue.pop(), 2);
+		EXPECT_EQ(queue.pop(), 3);
+		EXPECT_TRUE(queue.empty());
+	}
+
+	TEST(BoundedIndexSetQueue, PushDoesNotAddIfKeyIsAlreadyQueued)
+	{
+		bounded_index_set_queue<int> queue{ 8 };
+
+		queue.push(1);
+		queue.push(1);
+		queue.push(1);
+
+		ASSERT_EQ(queue.size(), 1);
+	}
+
+	TEST(BoundedIndexSetQueue, KeyCanBeQueuedAgainAfterPop)
+	{
+		bounded_index_set_queue<int> queue{ 8 };
+
+		queue.push(1);
+		queue.pop();
+		queue.push(1);
+
+		ASSERT_EQ(queue.size(), 1);
+		EXPECT_EQ(queue.pop(), 1);
+	}
+
+	TEST(BoundedIndexSetQueue, EveryKeyFitsWhenKeyCountIsNotAPowerOfTwo)
+	{
+		bounded_index_set_queue<int> queue{ 5 };
+
+		for (int round = 0; round < 3; ++round)
+		{
+			for (int key = 0; key < 5; ++key)
+			{
+				queue.push(int{ key });
+			}
+
+			ASSERT_EQ(queue.size(), 5);
+
+			for (int key = 0; key < 5; ++key)
+			{
+				ASSERT_EQ(queue.pop(), key);
+			}
+		}
+	}
+
+	TEST(BoundedIndexSetQueue, TryPopReturnsEmptyOptionalWhenEmpty)
+	{
+		bounded_index_set_queue<int> queue{ 8 };
+
+		EXPECT_FALSE(queue.try_pop().has_value());
+		EXPECT_THROW(queue.pop(), mb_exception);
+	}
+
+	TEST(BoundedIndexSetQueue, PushThrowsIfKeyIsOutOfRange)
+	{
+		bounded_index_set_queue<int> queue{ 8 };
+
+		EXPECT_THROW(queue.push(8), mb_exception);
+		EXPECT_TRUE(queue.empty());
+	}
+
+	TEST(BoundedIndexSetQueue, UsesKeyFunctionToDeduplicate)
+	{
+		auto keyOf = [](const std::pair<int, std::string>& item) { return static_cast<std::size_t>(item.first); };
+		bounded_index_set_queue<std::pair<int, std::string>, decltype(keyOf)> queue{ 4, keyOf };
+
+		queue.push({ 1, "first" });
+		queue.push({ 1, "second" });
+		queue.push({ 2, "third" });
+
+		ASSERT_EQ(queue.size(), 2);
+		EXPECT_EQ(queue.pop().second, "first");
+		EXPECT_EQ(queue.pop().second, "third");
+	}
+
+	TEST(BoundedIndexSetQueue, PopAfterNotEmptyWaitsForPushToPublish)
+	{
+		constexpr int KEY_COUNT = 8;
+		constexpr int PUSHES_PER_PRODUCER = 20000;
+		constexpr int PRODUCER_COUNT = 4;
+
+		bounded_index_set_queue<int> queue{ KEY_COUNT };
+		std::atomic<bool> producing{ true };
+		std::atomic<int> popCount{ 0 };
+
+		std::thread consumer{ [&]()
+		{
+			while (producing.load() || !queue.empty())
+			{
+				if (!queue.empty())
+				{
+					queue.pop();
+					popCount.fetch_add(1);
+				}
+			}
+		} };
+
+		std::vector<std::thread> producers;
+		for (int i = 0; i < PRODUCER_COUNT; ++i)
+		{
+			producers.emplace_back([&queue, i]()
+			{
+				for (int j = 0; j < PUSHES_PER_PRODUCER; ++j)
+				{
+					queue.push((i + j) % KEY_COUNT);
+				}
+			});
+		}
+
+		for (auto& producer : producers)
+		{
+			producer.join();
+		}
+
+		producing.store(false);
+		consumer.join();
+
+		EXPECT_GT(popCount.load(), 0);
+		EXPECT_TRUE(queue.empty());
+	}
+
+	TEST(BoundedIndexSetQueue, ConcurrentProducersAndConsumersDeliverEveryKey)
+	{
+		constexpr int KEY_COUNT = 64;
+		constexpr int PUSHES_PER_PRODUCER = 20000;
+		constexpr int THREAD_COUNT = 4;
+
+		bounded_index_set_queue<int> queue{ KEY_COUNT };
+		std::vector<std::atomic<int>> popCounts(KEY_COUNT);
+		std::atomic<bool> producing{ true };
+
+		std::vector<std::thread> consumers;
+		for (int i = 0; i < THREAD_COUNT; ++i)
+		{
+			consumers.emplace_back([&]()
+			{
+				while (producing.load() || !queue.empty())
+				{
+					std::optional<int> key{ queue.try_pop() };
+					if (key)
+					{
+						popCounts[*key].fetch_add(1);
+					}
+				}
+			});
+		}
+
+		std::vector<std::thread> producers;
+		for (int i = 0; i < THREAD_COUNT; ++i)
+		{
+			producers.emplace_back([&queue, i]()
+			{
+				for (int j = 0; j < PUSHES_PER_PRODUCER; ++j)
+				{
+					queue.push((i * 7 + j) % KEY_COUNT);
+				}
+			});
+		}
+
+		for (auto& producer : producers)
+		{
+			producer.join();
+		}
+
+		producing.store(false);
+
+		for (auto& consumer : consumers)
+		{
+			consumer.join();
+		}
+
+		int totalPops = 0;
+		for (auto& count : popCounts)
+		{
+			EXPECT_GT(count.load(), 0);
+			totalPops += count.load();
+		}
+
+		EXPECT_TRUE(queue.empty());
+		EXPECT_LE(totalPops, THREAD_COUNT * PUSHES_PER_PRODUCER);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <absl/synchronization/notification.h>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+#include "common/types/read_mostly_wrapper.h"
+
+namespace mb::test
+{
+	using namespace std::chrono_literals;
+
+	TEST(ReadMostlyWrapper, SharedLockHasReadAccessOnly)
+	{
+		read_mostly_wrapper<int> wrapper{ 5 };
+		auto sharedLockedObject{ wrapper.shared_lock() };
+
+		constexpr bool isConst = std::is_same<const int&, decltype(*sharedLockedObject)>::value;
+
+		EXPECT_TRUE(isConst);
+		EXPECT_EQ(5, *sharedLockedObject);
+	}
+
+	TEST(ReadMostlyWrapper, WriteIsVisibleToLaterReaders)
+	{
+		read_mostly_wrapper<std::unordered_map<std::string, int>> wrapper;
+
+		wrapper.unique_lock()->emplace("BTC/GBP", 1);
+
+		EXPECT_EQ(1, wrapper.shared_lock()->at("BTC/GBP"));
+	}
+
+	TEST(ReadMostlyWrapper, ExistingReaderKeepsItsVersionDuringWrite)
+	{
+		read_mostly_wrapper<int> wrapper{ 5 };
+		auto sharedLockedObject{ wrapper.shared_lock() };
+
+		absl::Notification written;
+		std::thread writeThread{ [&wrapper, &written]()
+		{
+			*wrapper.unique_lock() = 6;
+			written.Notify();
+		} };
+
+		// The new version is published straight away, but the write cannot finish while the old one is read
+		bool writeFinished = written.WaitForNotificationWithTimeout(absl::FromChrono(100ms));
+
+		EXPECT_FALSE(writeFinished);
+		EXPECT_EQ(5, *sharedLockedObject);
+
+		{
+			auto moved{ std::move(sharedLockedObject) };
+		}
+
+		writeThread.join();
+
+		EXPECT_EQ(6, *wrapper.shared_lock());
+	}
+
+	TEST(ReadMostlyWrapper, CannotCreateUniqueLockWhileOtherUniqueLockExists)
+	{
+		read_mostly_wrapper<int> wrapper{ 5 };
+		std::vector<read_mostly_wrapper<int>::unique_locked_object> uniqueLockedObjects;
+		uniqueLockedObjects.emplace_back(wrapper.unique_lock());
+
+		absl::Notification done;
+		std::thread secondThread{ [&wrapper, &done]()
+		{
+			auto uniqueLock{ wrapper.unique_lock() };
+			done.Notify();
+		} };
+
+		bool uniqueLockCreated = done.WaitForNotificationWithTimeout(absl::FromChrono(100ms));
+
+		EXPECT_FALSE(uniqueLockCreated);
+
+		uniqueLockedObjects.clear();
+		secondThread.join();
+	}
+
+	TEST(ReadMostlyWrapper, ReadersSeeCompleteVersionsWhileWritersUpdate)
+	{
+		constexpr int WRITE_COUNT = 200;
+
+		read_mostly_wrapper<std::vector<int>> wrapper{ std::vector<int>(16, 0) };
+		std::atomic<bool> writing{ true };
+		std::atomic<bool> tornReadSeen{ false };
+
+		std::vector<std::thread> readers;
+		for (int i = 0; i < 4; ++i)
+		{
+			readers.emplace_back([&]()
+			{
+				while (writing.load())
+				{
+					auto values{ wrapper.shared_lock() };
+					for (int value : *values)
+					{
+						if (value != values->front())
+						{
+							tornReadSeen.store(true);
+						}
+					}
+				}
+			});
+		}
+
+		for (int i = 1; i <= WRITE_COUNT; ++i)
+		{
+			auto values{ wrapper.unique_lock() };
+			std::fill(values->begin(), values->end(), i);
+		}
+
+		writing.store(false);
+
+		for (auto& reader : readers)
+		{
+			reader.join();
+		}
+
+		EXPECT_FALSE(tornReadSeen.load());
+		EXPECT_EQ(WRITE_COUNT, wrapper.shared_lock()->back());
+	}
+}
@@ -66,4 +66,25 @@ namespace mb::test
 
 		ASSERT_FALSE(queue.empty());
 	}
+
+	TEST(SetQueue, TryPopReturnsEmptyOptionalWhenEmpty)
+	{
+		set_queue<int> queue;
+
+		ASSERT_FALSE(queue.try_pop().has_value());
+	}
+
+	TEST(SetQueue, CopyDeduplicatesAgainstItsOwnItems)
+	{
+		set_queue<int> queue;
+		queue.push(1);
+
+		set_queue<int> copy{ queue };
+		queue.pop();
+
+		copy.push(1);
+
+		ASSERT_EQ(copy.size(), 1);
+		ASSERT_EQ(copy.pop(), 1);
+	}
 }
\ No newline at end of file
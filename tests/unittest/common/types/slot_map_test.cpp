@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "common/types/slot_map.h"
+#include "common/file/binary_stream.h"
+
+namespace mb::test
+{
+	TEST(SlotMap, FindReturnsInsertedValue)
+	{
+		slot_map<int> map;
+
+		auto first = map.insert(1);
+		auto second = map.insert(2);
+
+		ASSERT_EQ(map.size(), 2);
+		EXPECT_EQ(*map.find(first), 1);
+		EXPECT_EQ(*map.find(second), 2);
+	}
+
+	TEST(SlotMap, ErasedKeyIsNotFoundAfterSlotIsReused)
+	{
+		slot_map<int> map;
+
+		auto erasedKey = map.insert(1);
+		ASSERT_TRUE(map.erase(erasedKey));
+
+		auto newKey = map.insert(2);
+
+		EXPECT_NE(erasedKey, newKey);
+		EXPECT_EQ(map.find(erasedKey), nullptr);
+		EXPECT_FALSE(map.erase(erasedKey));
+		EXPECT_EQ(*map.find(newKey), 2);
+	}
+
+	TEST(SlotMap, LoadRestoresKeysAndFreeSlots)
+	{
+		slot_map<int> map;
+		auto first = map.insert(1);
+		auto second = map.insert(2);
+		map.erase(first);
+
+		binary_writer writer;
+		map.save(writer, [](binary_writer& writer, std::uint64_t key, int value) { writer.write(value); });
+
+		slot_map<int> restoredMap;
+		binary_reader reader{ writer.data() };
+		restoredMap.load(reader, [](binary_reader& reader, std::uint64_t key) { return reader.read<int>(); });
+
+		EXPECT_EQ(restoredMap.size(), 1);
+		EXPECT_EQ(*restoredMap.find(second), 2);
+		EXPECT_EQ(restoredMap.find(first), nullptr);
+		EXPECT_EQ(restoredMap.insert(3), map.insert(3));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <atomic>
+
+#include "common/types/task_executor.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace mb::test
+{
+	TEST(TaskExecutor, SubmitReturnsTaskResult)
+	{
+		task_executor executor{ 2 };
+
+		std::future<int> first{ executor.submit([]() { return 1; }) };
+		std::future<int> second{ executor.submit([]() { return 2; }) };
+
+		wait_all(first, second);
+
+		EXPECT_EQ(first.get(), 1);
+		EXPECT_EQ(second.get(), 2);
+	}
+
+	TEST(TaskExecutor, SubmitPropagatesTaskException)
+	{
+		task_executor executor{ 1 };
+
+		std::future<void> future{ executor.submit([]() { throw mb_exception{ "Task failed" }; }) };
+
+		EXPECT_THROW(future.get(), mb_exception);
+	}
+
+	TEST(TaskExecutor, DestructorRunsQueuedTasks)
+	{
+		std::atomic<int> completedTasks{ 0 };
+
+		{
+			task_executor executor{ 1 };
+
+			for (int i = 0; i < 10; ++i)
+			{
+				executor.submit([&completedTasks]() { ++completedTasks; });
+			}
+		}
+
+		EXPECT_EQ(completedTasks, 10);
+	}
+}
\ No newline at end of file
@@ -32,4 +32,45 @@ namespace mb::test
 
 		EXPECT_THROW(retry_on_fail<int>(mockAction.AsStdFunction(), toResult, maxRetries), mb_exception);
 	}
+
+	TEST(RetryPolicy, DoesNotRetryBeyondMaxRetries)
+	{
+		retry_policy policy{ retry_policy_config{ 2, std::chrono::milliseconds{ 0 }, std::chrono::milliseconds{ 0 }, 1.0, std::chrono::milliseconds{ 0 } } };
+
+		EXPECT_TRUE(policy.try_acquire_retry(0));
+		EXPECT_TRUE(policy.try_acquire_retry(1));
+		EXPECT_FALSE(policy.try_acquire_retry(2));
+	}
+
+	TEST(RetryPolicy, StopsRetryingWhenBudgetIsExhausted)
+	{
+		retry_policy policy{ retry_policy_config{ 100, std::chrono::milliseconds{ 0 }, std::chrono::milliseconds{ 0 }, 0.5, std::chrono::milliseconds{ 0 } } };
+
+		while (policy.try_acquire_retry(0))
+		{
+		}
+
+		EXPECT_LT(policy.budget(), 1.0);
+
+		policy.record_request();
+		policy.record_request();
+
+		EXPECT_TRUE(policy.try_acquire_retry(0));
+		EXPECT_FALSE(policy.try_acquire_retry(0));
+	}
+
+	TEST(RetryPolicy, BackoffDelayIsBoundedByExponentialCeiling)
+	{
+		constexpr std::chrono::milliseconds baseDelay{ 10 };
+		constexpr std::chrono::milliseconds maxDelay{ 50 };
+
+		retry_policy policy{ retry_policy_config{ 5, baseDelay, maxDelay, 1.0, std::chrono::milliseconds{ 0 } } };
+
+		for (int i = 0; i < 100; ++i)
+		{
+			EXPECT_LE(policy.backoff_delay(0), baseDelay);
+			EXPECT_LE(policy.backoff_delay(1), baseDelay * 2);
+			EXPECT_LE(policy.backoff_delay(10), maxDelay);
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "exchanges/async_exchange.h"
+#include "mbtest/mocks.h"
+
+namespace mb::test
+{
+	using ::testing::_;
+	using ::testing::Return;
+
+	TEST(AsyncExchange, GetPriceReturnsExchangePrice)
+	{
+		auto exchange{ std::make_shared<mock_exchange>() };
+		tradable_pair pair{ "BTC", "GBP" };
+
+		EXPECT_CALL(*exchange, get_price(pair))
+			.WillOnce(Return(100.0));
+
+		task_executor executor{ 2 };
+		async_exchange asyncExchange{ exchange, executor };
+
+		EXPECT_DOUBLE_EQ(asyncExchange.get_price(pair).get(), 100.0);
+	}
+
+	TEST(AsyncExchange, RequestsOnSeveralExchangesCanBeAwaitedTogether)
+	{
+		auto firstExchange{ std::make_shared<mock_exchange>() };
+		auto secondExchange{ std::make_shared<mock_exchange>() };
+		order_request request{ create_market_order(tradable_pair{ "BTC", "GBP" }, trade_action::BUY, 1.0) };
+
+		EXPECT_CALL(*firstExchange, add_order(_))
+			.WillOnce(Return("1"));
+		EXPECT_CALL(*secondExchange, get_price(_))
+			.WillOnce(Return(10.0));
+
+		task_executor executor{ 2 };
+		async_exchange firstAsyncExchange{ firstExchange, executor };
+		async_exchange secondAsyncExchange{ secondExchange, executor };
+
+		std::future<std::string> orderId{ firstAsyncExchange.add_order(request) };
+		std::future<double> price{ secondAsyncExchange.get_price(tradable_pair{ "ETH", "GBP" }) };
+
+		wait_all(orderId, price);
+
+		EXPECT_EQ(orderId.get(), "1");
+		EXPECT_DOUBLE_EQ(price.get(), 10.0);
+	}
+
+	TEST(AsyncExchange, CancelOrderPropagatesExchangeError)
+	{
+		auto exchange{ std::make_shared<mock_exchange>() };
+
+		EXPECT_CALL(*exchange, cancel_order(_))
+			.WillOnce(::testing::Throw(mb_exception{ "Order not found" }));
+
+		task_executor executor{ 1 };
+		async_exchange asyncExchange{ exchange, executor };
+
+		EXPECT_THROW(asyncExchange.cancel_order("123").get(), mb_exception);
+	}
+}
\ No newline at end of file
@@ -139,6 +139,14 @@ namespace mb::test
 		this->_api->get_order_book(tradable_pair{ "BTC", "USD" }, 5);
 	}
 
+	TYPED_TEST_P(ExchangeRequestTests, GetOrderBooks)
+	{
+		this->set_http_service_behaviour("get_order_book");
+
+		EXPECT_CALL(*this->_mockHttpService, send_batch(_));
+		this->_api->get_order_books({ tradable_pair{ "BTC", "USD" } }, 5);
+	}
+
 	TYPED_TEST_P(ExchangeRequestTests, GetFee)
 	{
 		this->set_http_service_behaviour("get_fee");
@@ -185,6 +193,7 @@ namespace mb::test
 		GetOhlcv,
 		GetPrice,
 		GetOrderBook,
+		GetOrderBooks,
 		GetFee,
 		GetBalances,
 		GetOpenOrders,
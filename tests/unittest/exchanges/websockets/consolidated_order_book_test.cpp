@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "exchanges/websockets/consolidated_order_book.h"
+#include "mbtest/mocks.h"
+
+namespace
+{
+	using namespace mb;
+
+	constexpr std::string_view FIRST_EXCHANGE = "first";
+	constexpr std::string_view SECOND_EXCHANGE = "second";
+
+	void fire_update(test::mock_websocket_stream& stream, const tradable_pair& pair, double price, double volume, order_book_side side, bool endOfBatch = true)
+	{
+		stream.expose_fire_order_book_update(order_book_update_message{ pair, order_book_entry{ price, volume, side }, endOfBatch });
+	}
+
+	void assert_entry_eq(const consolidated_order_book_entry& entry, double price, double volume, std::string_view exchangeId)
+	{
+		EXPECT_DOUBLE_EQ(entry.price(), price);
+		EXPECT_DOUBLE_EQ(entry.volume(), volume);
+		EXPECT_EQ(entry.exchange_id(), exchangeId);
+	}
+}
+
+namespace mb::test
+{
+	using ::testing::_;
+	using ::testing::Return;
+
+	TEST(ConsolidatedOrderBook, BestBidOfferSpansExchanges)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream first;
+		mock_websocket_stream second;
+
+		consolidated_order_book book{ { pair } };
+		book.add_stream(FIRST_EXCHANGE, first);
+		book.add_stream(SECOND_EXCHANGE, second);
+
+		fire_update(first, pair, 101.0, 1.0, order_book_side::ASK);
+		fire_update(first, pair, 99.0, 1.0, order_book_side::BID);
+		fire_update(second, pair, 100.5, 2.0, order_book_side::ASK);
+		fire_update(second, pair, 98.0, 3.0, order_book_side::BID);
+
+		best_bid_offer best{ book.get_best_bid_offer(pair) };
+
+		assert_entry_eq(best.ask(), 100.5, 2.0, SECOND_EXCHANGE);
+		assert_entry_eq(best.bid(), 99.0, 1.0, FIRST_EXCHANGE);
+	}
+
+	TEST(ConsolidatedOrderBook, SharedPriceLevelAggregatesVolume)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream first;
+		mock_websocket_stream second;
+
+		consolidated_order_book book{ { pair } };
+		book.add_stream(FIRST_EXCHANGE, first);
+		book.add_stream(SECOND_EXCHANGE, second);
+
+		fire_update(first, pair, 100.0, 1.0, order_book_side::ASK);
+		fire_update(second, pair, 100.0, 3.0, order_book_side::ASK);
+
+		assert_entry_eq(book.get_best_bid_offer(pair).ask(), 100.0, 4.0, SECOND_EXCHANGE);
+
+		std::shared_ptr<const consolidated_depth> depth{ book.get_depth(pair) };
+		ASSERT_EQ(depth->asks().size(), 2);
+		assert_entry_eq(depth->asks()[0], 100.0, 1.0, FIRST_EXCHANGE);
+		assert_entry_eq(depth->asks()[1], 100.0, 3.0, SECOND_EXCHANGE);
+	}
+
+	TEST(ConsolidatedOrderBook, ZeroVolumeRemovesOnlyThatExchange)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream first;
+		mock_websocket_stream second;
+
+		consolidated_order_book book{ { pair } };
+		book.add_stream(FIRST_EXCHANGE, first);
+		book.add_stream(SECOND_EXCHANGE, second);
+
+		fire_update(first, pair, 100.0, 1.0, order_book_side::BID);
+		fire_update(second, pair, 100.0, 2.0, order_book_side::BID);
+		fire_update(second, pair, 100.0, 0.0, order_book_side::BID);
+
+		assert_entry_eq(book.get_best_bid_offer(pair).bid(), 100.0, 1.0, FIRST_EXCHANGE);
+
+		fire_update(first, pair, 100.0, 0.0, order_book_side::BID);
+
+		EXPECT_FALSE(book.get_best_bid_offer(pair).has_bid());
+		EXPECT_TRUE(book.get_depth(pair)->bids().empty());
+	}
+
+	TEST(ConsolidatedOrderBook, PairNamesAreNormalised)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream stream;
+
+		consolidated_order_book book{ { pair } };
+		book.add_stream(FIRST_EXCHANGE, stream);
+
+		fire_update(stream, tradable_pair{ "XBT", "USD" }, 100.0, 1.0, order_book_side::ASK);
+
+		assert_entry_eq(book.get_best_bid_offer(tradable_pair{ "XBT", "USD" }).ask(), 100.0, 1.0, FIRST_EXCHANGE);
+		assert_entry_eq(book.get_best_bid_offer(pair).ask(), 100.0, 1.0, FIRST_EXCHANGE);
+	}
+
+	TEST(ConsolidatedOrderBook, ResetReplacesExchangeLevelsFromSnapshot)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream first;
+		mock_websocket_stream second;
+
+		consolidated_order_book book{ { pair } };
+		book.add_stream(FIRST_EXCHANGE, first);
+		book.add_stream(SECOND_EXCHANGE, second);
+
+		fire_update(first, pair, 100.0, 1.0, order_book_side::ASK);
+		fire_update(second, pair, 102.0, 1.0, order_book_side::ASK);
+
+		order_book_state snapshot{ 0, { order_book_entry{ 103.0, 5.0, order_book_side::ASK } }, {} };
+		EXPECT_CALL(first, get_order_book(pair, _)).WillOnce(Return(snapshot));
+
+		fire_update(first, pair, 0.0, 0.0, order_book_side::ASK);
+
+		std::shared_ptr<const consolidated_depth> depth{ book.get_depth(pair) };
+		ASSERT_EQ(depth->asks().size(), 2);
+		assert_entry_eq(depth->asks()[0], 102.0, 1.0, SECOND_EXCHANGE);
+		assert_entry_eq(depth->asks()[1], 103.0, 5.0, FIRST_EXCHANGE);
+	}
+
+	TEST(ConsolidatedOrderBook, PublishedDepthIsLimited)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream stream;
+
+		consolidated_order_book book{ { pair }, 2 };
+		book.add_stream(FIRST_EXCHANGE, stream);
+
+		fire_update(stream, pair, 100.0, 1.0, order_book_side::ASK);
+		fire_update(stream, pair, 101.0, 1.0, order_book_side::ASK);
+		fire_update(stream, pair, 102.0, 1.0, order_book_side::ASK);
+
+		std::shared_ptr<const consolidated_depth> depth{ book.get_depth(pair) };
+		ASSERT_EQ(depth->asks().size(), 2);
+		assert_entry_eq(depth->asks()[1], 101.0, 1.0, FIRST_EXCHANGE);
+	}
+
+	TEST(ConsolidatedOrderBook, UnknownPairsAreIgnored)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		tradable_pair otherPair{ "ETH", "USD" };
+		mock_websocket_stream stream;
+
+		consolidated_order_book book{ { pair } };
+		book.add_stream(FIRST_EXCHANGE, stream);
+
+		fire_update(stream, otherPair, 100.0, 1.0, order_book_side::ASK);
+
+		EXPECT_FALSE(book.get_best_bid_offer(pair).has_ask());
+		EXPECT_THROW(book.get_best_bid_offer(otherPair), mb_exception);
+	}
+
+	TEST(ConsolidatedOrderBook, ExchangeIdOutlivesCallersString)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream stream;
+
+		consolidated_order_book book{ { pair } };
+
+		{
+			std::string exchangeId{ "temporary exchange id" };
+			book.add_stream(exchangeId, stream);
+			exchangeId.assign(exchangeId.size(), 'x');
+		}
+
+		fire_update(stream, pair, 100.0, 1.0, order_book_side::ASK);
+
+		assert_entry_eq(book.get_best_bid_offer(pair).ask(), 100.0, 1.0, "temporary exchange id");
+		assert_entry_eq(book.get_depth(pair)->asks().front(), 100.0, 1.0, "temporary exchange id");
+	}
+
+	TEST(ConsolidatedOrderBook, BookIsPublishedAtEndOfBatch)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream stream;
+
+		consolidated_order_book book{ { pair } };
+		book.add_stream(FIRST_EXCHANGE, stream);
+
+		fire_update(stream, pair, 100.0, 1.0, order_book_side::ASK, false);
+		fire_update(stream, pair, 99.0, 2.0, order_book_side::BID, false);
+
+		EXPECT_TRUE(book.get_depth(pair)->asks().empty());
+		EXPECT_FALSE(book.get_best_bid_offer(pair).has_bid());
+
+		fire_update(stream, pair, 101.0, 1.0, order_book_side::ASK);
+
+		std::shared_ptr<const consolidated_depth> depth{ book.get_depth(pair) };
+		EXPECT_EQ(depth->asks().size(), 2);
+		EXPECT_EQ(depth->bids().size(), 1);
+		assert_entry_eq(book.get_best_bid_offer(pair).bid(), 99.0, 2.0, FIRST_EXCHANGE);
+	}
+
+	TEST(ConsolidatedOrderBook, DepthReadsSeeCompletePublishedBooks)
+	{
+		tradable_pair pair{ "BTC", "USD" };
+		mock_websocket_stream stream;
+
+		consolidated_order_book book{ { pair } };
+		book.add_stream(FIRST_EXCHANGE, stream);
+
+		std::atomic<bool> writing{ true };
+		std::thread writer{ [&]()
+		{
+			for (int i = 1; i <= 2000; ++i)
+			{
+				fire_update(stream, pair, 100.0, i, order_book_side::ASK, false);
+				fire_update(stream, pair, 99.0, i, order_book_side::BID);
+			}
+
+			writing = false;
+		} };
+
+		while (writing)
+		{
+			std::shared_ptr<const consolidated_depth> depth{ book.get_depth(pair) };
+
+			if (!depth->asks().empty())
+			{
+				ASSERT_EQ(depth->bids().size(), 1);
+				EXPECT_DOUBLE_EQ(depth->asks().front().volume(), depth->bids().front().volume());
+			}
+		}
+
+		writer.join();
+		EXPECT_DOUBLE_EQ(book.get_depth(pair)->asks().front().volume(), 2000.0);
+	}
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include "exchanges/websockets/exchange_websocket_stream.h"
 #include "mbtest/mocks.h"
 #include "mbtest/assertion_helpers.h"
@@ -14,6 +18,91 @@ namespace
 		std::unique_ptr<mock_websocket_connection_factory> mockConnectionFactory{ std::make_unique<mock_websocket_connection_factory>() };
 		return mock_exchange_websocket_stream{ "test", "test", std::move(mockConnectionFactory) };
 	}
+
+	template<typename Predicate>
+	bool wait_until(const Predicate& predicate)
+	{
+		for (int i = 0; i < 500; ++i)
+		{
+			if (predicate())
+			{
+				return true;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+		}
+
+		return false;
+	}
+
+	order_book_update_batch create_update(long long firstSequence, long long lastSequence, order_book_entry entry)
+	{
+		order_book_level_update level{ entry.side(), decimal::from_double(entry.price(), DEFAULT_PRICE_SCALE), entry.volume() };
+		return order_book_update_batch{ static_cast<std::time_t>(lastSequence), firstSequence, lastSequence, { std::move(level) } };
+	}
+
+	sequenced_order_book create_snapshot(long long sequence, order_book_entry ask)
+	{
+		return sequenced_order_book{ order_book_state{ static_cast<std::time_t>(sequence), { std::move(ask) }, {} }, sequence };
+	}
+
+	class price_scale_stream : public mock_exchange_websocket_stream
+	{
+	private:
+		int _priceScale;
+		std::atomic<int> _lookupCount;
+
+	protected:
+		int get_price_scale(const tradable_pair& pair) override
+		{
+			++_lookupCount;
+			return _priceScale;
+		}
+
+	public:
+		explicit price_scale_stream(int priceScale)
+			: mock_exchange_websocket_stream{ "test", "test", std::make_unique<mock_websocket_connection_factory>() }, _priceScale{ priceScale }, _lookupCount{ 0 }
+		{}
+
+		~price_scale_stream() override
+		{
+			shutdown();
+		}
+
+		int lookup_count() const noexcept { return _lookupCount; }
+	};
+
+	template<typename Action>
+	void assert_action_completes_during_resync(const Action& action)
+	{
+		tradable_pair pair{ "test", "test" };
+		mock_exchange_websocket_stream test{ create_mock_stream() };
+
+		std::promise<void> resyncPaused;
+		std::atomic<bool> firstUpdate{ true };
+
+		// The resync holds the sequencer while it fires handlers, so the action runs while the book is still being rebuilt
+		test.add_order_book_update_handler([&](order_book_update_message)
+		{
+			if (firstUpdate.exchange(false))
+			{
+				resyncPaused.set_value();
+				std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
+			}
+		});
+
+		EXPECT_CALL(test, send_subscribe(::testing::_));
+		EXPECT_CALL(test, fetch_order_book_snapshot(pair)).WillOnce(::testing::Return(create_snapshot(5, order_book_entry{ 1.0, 2.0, order_book_side::ASK })));
+
+		test.subscribe(websocket_subscription::create_order_book_sub({ pair }));
+		test.expose_update_order_book(pair.to_string(), create_update(4, 6, order_book_entry{ 1.5, 1.0, order_book_side::ASK }));
+
+		resyncPaused.get_future().wait();
+		std::future<void> actionDone{ std::async(std::launch::async, [&]() { action(test, pair); }) };
+
+		ASSERT_EQ(actionDone.wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+		EXPECT_EQ(test.get_order_book(pair).time_stamp(), 0);
+	}
 }
 
 namespace mb::test
@@ -48,12 +137,12 @@ namespace mb::test
 	{
 		tradable_pair pair{ "test", "test" };
 
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{1.0, 2.0, order_book_side::ASK},
 			order_book_entry{1.1, 3.0, order_book_side::ASK}
 		};
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{0.9, 4.0, order_book_side::BID},
 			order_book_entry{0.8, 5.0, order_book_side::BID}
@@ -77,12 +166,12 @@ namespace mb::test
 	{
 		tradable_pair pair{ "test", "test" };
 
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{1.0, 2.0, order_book_side::ASK},
 			order_book_entry{1.1, 3.0, order_book_side::ASK}
 		};
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{0.9, 4.0, order_book_side::BID},
 			order_book_entry{0.8, 5.0, order_book_side::BID}
@@ -199,12 +288,12 @@ namespace mb::test
 		tradable_pair pair{ "test", "test" };
 		mock_exchange_websocket_stream test{ create_mock_stream() };
 
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{1.0, 2.0, order_book_side::ASK},
 			order_book_entry{1.1, 3.0, order_book_side::ASK}
 		};
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{0.9, 4.0, order_book_side::BID},
 			order_book_entry{0.8, 5.0, order_book_side::BID}
@@ -244,6 +333,26 @@ namespace mb::test
 		ASSERT_TRUE(eventFired);
 	}
 
+	TEST(ExchangeWebsocketStream, HandlerCanSubscribeToNewPair)
+	{
+		tradable_pair pair{ "test", "test" };
+		tradable_pair newPair{ "new", "test" };
+		mock_exchange_websocket_stream test{ create_mock_stream() };
+
+		EXPECT_CALL(test, send_subscribe(_)).Times(2);
+
+		test.add_trade_update_handler([&test, &newPair](trade_update_message)
+		{
+			test.subscribe(websocket_subscription::create_trade_sub({ newPair }));
+		});
+
+		test.subscribe(websocket_subscription::create_trade_sub({ pair }));
+
+		std::future<void> update{ std::async(std::launch::async, [&]() { test.expose_update_trade(pair.to_string(), trade_update{ 1, 2.0, 3.0 }); }) };
+
+		ASSERT_EQ(update.wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+	}
+
 	TEST(ExchangeWebsocketStream, DoesNotCrashIfEventHandlerNotSet)
 	{
 		tradable_pair pair{ "test", "test" };
@@ -254,4 +363,163 @@ namespace mb::test
 
 		ASSERT_NO_THROW(test.expose_update_trade(pair.to_string(), trade));
 	}
-}
\ No newline at end of file
+
+	TEST(ExchangeWebsocketStream, ReconnectsAndReplaysSubscriptionsAfterUnexpectedClose)
+	{
+		tradable_pair pair{ "test", "test" };
+
+		std::unique_ptr<mock_websocket_connection_factory> mockConnectionFactory{ std::make_unique<mock_websocket_connection_factory>() };
+		mock_websocket_connection_factory* connectionFactory{ mockConnectionFactory.get() };
+
+		EXPECT_CALL(*connectionFactory, create_connection(_))
+			.Times(2)
+			.WillRepeatedly([](std::string) { return std::make_unique<mock_websocket_connection>(); });
+
+		mock_exchange_websocket_stream test{ "test", "test", std::move(mockConnectionFactory) };
+
+		std::promise<websocket_subscription> replayedSubscription;
+
+		EXPECT_CALL(test, send_subscribe(_))
+			.WillOnce(Return())
+			.WillOnce([&replayedSubscription](const websocket_subscription& subscription) { replayedSubscription.set_value(subscription); });
+
+		test.reset();
+		test.subscribe(websocket_subscription::create_trade_sub({ pair }));
+
+		connectionFactory->fire_on_close();
+
+		std::future<websocket_subscription> replayed{ replayedSubscription.get_future() };
+		ASSERT_EQ(replayed.wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+		EXPECT_EQ(replayed.get(), websocket_subscription::create_trade_sub({ pair }));
+	}
+
+	TEST(ExchangeWebsocketStream, SequencedOrderBookIsInitialisedFromSnapshot)
+	{
+		tradable_pair pair{ "test", "test" };
+		order_book_entry snapshotAsk{ 1.0, 2.0, order_book_side::ASK };
+		mock_exchange_websocket_stream test{ create_mock_stream() };
+
+		EXPECT_CALL(test, send_subscribe(_));
+		EXPECT_CALL(test, fetch_order_book_snapshot(pair)).WillOnce(Return(create_snapshot(5, snapshotAsk)));
+
+		test.subscribe(websocket_subscription::create_order_book_sub({ pair }));
+		test.expose_update_order_book(pair.to_string(), create_update(4, 6, order_book_entry{ 1.5, 1.0, order_book_side::ASK }));
+
+		ASSERT_TRUE(wait_until([&]() { return test.get_order_book(pair).time_stamp() == 6; }));
+
+		order_book_state expectedState
+		{
+			6,
+			{ snapshotAsk, order_book_entry{ 1.5, 1.0, order_book_side::ASK } },
+			{}
+		};
+
+		assert_order_book_state_eq(expectedState, test.get_order_book(pair));
+	}
+
+	TEST(ExchangeWebsocketStream, SequenceGapResyncsOnlyAffectedOrderBook)
+	{
+		tradable_pair gapPair{ "gap", "test" };
+		tradable_pair otherPair{ "other", "test" };
+		order_book_entry ask{ 1.0, 2.0, order_book_side::ASK };
+		mock_exchange_websocket_stream test{ create_mock_stream() };
+
+		EXPECT_CALL(test, send_subscribe(_));
+		EXPECT_CALL(test, fetch_order_book_snapshot(gapPair))
+			.WillOnce(Return(create_snapshot(5, ask)))
+			.WillOnce(Return(create_snapshot(20, ask)));
+		EXPECT_CALL(test, fetch_order_book_snapshot(otherPair))
+			.WillOnce(Return(create_snapshot(5, ask)));
+
+		test.subscribe(websocket_subscription::create_order_book_sub({ gapPair, otherPair }));
+		test.expose_update_order_book(gapPair.to_string(), create_update(1, 5, ask));
+		test.expose_update_order_book(otherPair.to_string(), create_update(1, 5, ask));
+
+		ASSERT_TRUE(wait_until([&]() { return test.get_order_book(gapPair).time_stamp() == 5 && test.get_order_book(otherPair).time_stamp() == 5; }));
+
+		test.expose_update_order_book(gapPair.to_string(), create_update(10, 11, ask));
+		test.expose_update_order_book(otherPair.to_string(), create_update(6, 7, ask));
+
+		EXPECT_EQ(test.get_order_book(otherPair).time_stamp(), 7);
+		ASSERT_TRUE(wait_until([&]() { return test.get_order_book(gapPair).time_stamp() == 20; }));
+		EXPECT_EQ(test.order_book_gap_count(), 1);
+	}
+
+	TEST(ExchangeWebsocketStream, DestroyingStreamWaitsForInFlightResync)
+	{
+		tradable_pair pair{ "test", "test" };
+		std::promise<void> resyncStarted;
+		std::atomic<bool> resyncFinished{ false };
+		std::unique_ptr<mock_exchange_websocket_stream> test{ std::make_unique<mock_exchange_websocket_stream>("test", "test", std::make_unique<mock_websocket_connection_factory>()) };
+
+		EXPECT_CALL(*test, send_subscribe(_));
+		EXPECT_CALL(*test, fetch_order_book_snapshot(pair)).WillOnce([&](const tradable_pair&)
+		{
+			resyncStarted.set_value();
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
+			resyncFinished = true;
+
+			return create_snapshot(5, order_book_entry{ 1.0, 2.0, order_book_side::ASK });
+		});
+
+		test->subscribe(websocket_subscription::create_order_book_sub({ pair }));
+		test->expose_update_order_book(pair.to_string(), create_update(4, 6, order_book_entry{ 1.5, 1.0, order_book_side::ASK }));
+
+		resyncStarted.get_future().wait();
+		test.reset();
+
+		EXPECT_TRUE(resyncFinished);
+	}
+
+	TEST(ExchangeWebsocketStream, DisconnectDuringResyncDoesNotDeadlock)
+	{
+		assert_action_completes_during_resync([](mock_exchange_websocket_stream& test, const tradable_pair&)
+		{
+			test.disconnect();
+		});
+	}
+
+	TEST(ExchangeWebsocketStream, UnsubscribeDuringResyncDoesNotDeadlock)
+	{
+		assert_action_completes_during_resync([](mock_exchange_websocket_stream& test, const tradable_pair& pair)
+		{
+			test.expose_set_unsubscribed(named_subscription::create_order_book_sub(pair.to_string()));
+		});
+	}
+
+	TEST(ExchangeWebsocketStream, PriceScaleIsLoadedByResyncRatherThanSubscribe)
+	{
+		tradable_pair pair{ "test", "test" };
+		price_scale_stream test{ 1 };
+
+		// Both snapshot asks round to the same level at a scale of 1
+		sequenced_order_book snapshot
+		{
+			order_book_state
+			{
+				5,
+				{ order_book_entry{ 1.01, 2.0, order_book_side::ASK }, order_book_entry{ 1.04, 3.0, order_book_side::ASK } },
+				{}
+			},
+			5
+		};
+
+		EXPECT_CALL(test, send_subscribe(_));
+		EXPECT_CALL(test, fetch_order_book_snapshot(pair)).WillOnce(Return(snapshot));
+
+		test.subscribe(websocket_subscription::create_order_book_sub({ pair }));
+
+		EXPECT_EQ(test.lookup_count(), 0);
+
+		test.expose_update_order_book(pair.to_string(), create_update(4, 6, order_book_entry{ 1.5, 1.0, order_book_side::ASK }));
+
+		ASSERT_TRUE(wait_until([&]() { return test.get_order_book(pair).time_stamp() == 6; }));
+
+		order_book_state book{ test.get_order_book(pair) };
+
+		EXPECT_EQ(test.lookup_count(), 1);
+		ASSERT_EQ(book.asks().size(), 2);
+		EXPECT_DOUBLE_EQ(book.asks()[0].volume(), 3.0);
+		EXPECT_DOUBLE_EQ(book.asks()[1].price(), 1.5);
+	}
+}
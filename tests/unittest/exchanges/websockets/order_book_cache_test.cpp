@@ -8,7 +8,7 @@ namespace
 	using namespace mb;
 	using namespace mb::test;
 
-	void assert_snapshot_equal_to_maps(const ask_cache& asks, const bid_cache& bids, const order_book_state& snapshot)
+	void assert_snapshot_equal_to_maps(const std::vector<order_book_entry>& asks, const std::vector<order_book_entry>& bids, const order_book_state& snapshot)
 	{
 		ASSERT_EQ(asks.size(), snapshot.asks().size());
 		ASSERT_EQ(bids.size(), snapshot.bids().size());
@@ -37,14 +37,14 @@ namespace mb::test
 {
 	TEST(OrderBookCache, ValidInputs)
 	{
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
 			order_book_entry{ 30986.75, 0.03, order_book_side::ASK },
 			order_book_entry{ 30995.72, 0.160, order_book_side::ASK },
 		};
 
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 			order_book_entry{ 30944.65, 0.03, order_book_side::BID },
@@ -58,14 +58,14 @@ namespace mb::test
 
 	TEST(OrderBookCache, DifferentNumberOfAsksAndBids)
 	{
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
 			order_book_entry{ 30986.75, 0.03, order_book_side::ASK },
 			order_book_entry{ 30995.72, 0.160, order_book_side::ASK },
 		};
 
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 			order_book_entry{ 30944.65, 0.03, order_book_side::BID },
@@ -78,14 +78,14 @@ namespace mb::test
 
 	TEST(OrderBookCache, SnapshotDepthSpecifiesNumberOfEntries)
 	{
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
 			order_book_entry{ 30986.75, 0.03, order_book_side::ASK },
 			order_book_entry{ 30995.72, 0.160, order_book_side::ASK },
 		};
 
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 			order_book_entry{ 30944.65, 0.03, order_book_side::BID },
@@ -94,12 +94,12 @@ namespace mb::test
 
 		order_book_cache cache{ 1, asks, bids };
 
-		ask_cache expectedAsks
+		std::vector<order_book_entry> expectedAsks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK }
 		};
 
-		bid_cache expectedBids
+		std::vector<order_book_entry> expectedBids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID }
 		};
@@ -109,14 +109,14 @@ namespace mb::test
 
 	TEST(OrderBookCache, CachingNewEntryInsertsInCorrectPosition)
 	{
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
 			order_book_entry{ 30986.75, 0.03, order_book_side::ASK },
 			order_book_entry{ 30995.72, 0.160, order_book_side::ASK },
 		};
 
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 			order_book_entry{ 30944.65, 0.03, order_book_side::BID },
@@ -127,7 +127,7 @@ namespace mb::test
 
 		order_book_entry newEntry{ 30948.32, 0.025, order_book_side::BID };
 
-		bid_cache expectedBids
+		std::vector<order_book_entry> expectedBids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 			newEntry,
@@ -142,14 +142,14 @@ namespace mb::test
 
 	TEST(OrderBookCache, CachingEntryAtExistingPriceUpdatesVolume)
 	{
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
 			order_book_entry{ 30986.75, 0.03, order_book_side::ASK },
 			order_book_entry{ 30995.72, 0.160, order_book_side::ASK },
 		};
 
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 			order_book_entry{ 30944.65, 0.03, order_book_side::BID },
@@ -160,7 +160,7 @@ namespace mb::test
 
 		order_book_entry newEntry{ 30944.65, 0.025, order_book_side::BID };
 
-		bid_cache expectedBids
+		std::vector<order_book_entry> expectedBids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 			order_book_entry{ 30944.65, 0.025, order_book_side::BID },
@@ -174,14 +174,14 @@ namespace mb::test
 
 	TEST(OrderBookCache, CachingEntryAtExistingPriceWithZeroVolumeRemoves)
 	{
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
 			order_book_entry{ 30986.75, 0.03, order_book_side::ASK },
 			order_book_entry{ 30995.72, 0.160, order_book_side::ASK },
 		};
 
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 			order_book_entry{ 30944.65, 0.03, order_book_side::BID },
@@ -192,7 +192,7 @@ namespace mb::test
 
 		order_book_entry newEntry{ 30995.72, 0.0, order_book_side::ASK };
 
-		ask_cache expectedAsks
+		std::vector<order_book_entry> expectedAsks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
 			order_book_entry{ 30986.75, 0.03, order_book_side::ASK }
@@ -205,12 +205,12 @@ namespace mb::test
 
 	TEST(OrderBookCache, CachingNewEntrtUpdatesTimeStamp)
 	{
-		ask_cache asks
+		std::vector<order_book_entry> asks
 		{
 			order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
 		};
 
-		bid_cache bids
+		std::vector<order_book_entry> bids
 		{
 			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
 		};
@@ -223,4 +223,125 @@ namespace mb::test
 
 		ASSERT_EQ(2, cache.snapshot().time_stamp());
 	}
+
+	TEST(OrderBookCache, PricesEqualAtPriceScaleShareALevel)
+	{
+		order_book_cache cache{ 1, std::vector<order_book_entry>{}, std::vector<order_book_entry>{}, 2 };
+
+		cache.update_cache(2, order_book_entry{ 0.1 + 0.2, 1.0, order_book_side::ASK });
+		cache.update_cache(3, order_book_entry{ 0.3, 2.0, order_book_side::ASK });
+
+		order_book_state snapshot{ cache.snapshot() };
+
+		ASSERT_EQ(1, snapshot.asks().size());
+		ASSERT_DOUBLE_EQ(2.0, snapshot.asks()[0].volume());
+	}
+
+	TEST(OrderBookCache, CachingDecimalPriceUpdatesSameLevelAsDouble)
+	{
+		order_book_cache cache
+		{
+			1,
+			std::vector<order_book_entry>{},
+			std::vector<order_book_entry>{ order_book_entry{ 30944.65, 0.03, order_book_side::BID } }
+		};
+
+		cache.update_cache(2, order_book_side::BID, parse_decimal("30944.65", 2), 0.025);
+		cache.update_cache(2, order_book_side::BID, parse_decimal("30956.2", 1), 0.105);
+
+		std::vector<order_book_entry> expectedBids
+		{
+			order_book_entry{ 30956.20, 0.105, order_book_side::BID },
+			order_book_entry{ 30944.65, 0.025, order_book_side::BID }
+		};
+
+		assert_snapshot_equal_to_maps(std::vector<order_book_entry>{}, expectedBids, cache.snapshot());
+	}
+
+	TEST(OrderBookCache, CachingDecimalPriceWithZeroVolumeRemoves)
+	{
+		order_book_cache cache
+		{
+			1,
+			std::vector<order_book_entry>{ order_book_entry{ 30964.51, 0.105, order_book_side::ASK } },
+			std::vector<order_book_entry>{}
+		};
+
+		cache.update_cache(2, order_book_side::ASK, parse_decimal("30964.510", 3), 0.0);
+
+		ASSERT_TRUE(cache.snapshot().asks().empty());
+	}
+
+	TEST(OrderBookCache, PriceTooLargeForScaleReducesScale)
+	{
+		order_book_cache cache
+		{
+			1,
+			std::vector<order_book_entry>{ order_book_entry{ 2.5, 1.0, order_book_side::ASK } },
+			std::vector<order_book_entry>{}
+		};
+
+		cache.update_cache(2, order_book_entry{ 1234567890.12, 3.0, order_book_side::ASK });
+		cache.update_cache(3, order_book_side::ASK, parse_decimal("98765432109.5", 1), 4.0);
+
+		std::vector<order_book_entry> expectedAsks
+		{
+			order_book_entry{ 2.5, 1.0, order_book_side::ASK },
+			order_book_entry{ 1234567890.12, 3.0, order_book_side::ASK },
+			order_book_entry{ 98765432109.5, 4.0, order_book_side::ASK }
+		};
+
+		ASSERT_EQ(7, cache.price_scale());
+		assert_snapshot_equal_to_maps(expectedAsks, std::vector<order_book_entry>{}, cache.snapshot());
+	}
+
+	TEST(OrderBookCache, SnapshotWithLargePricesFitsScale)
+	{
+		order_book_state snapshot
+		{
+			1,
+			{ order_book_entry{ 1500000000.5, 1.0, order_book_side::ASK } },
+			{ order_book_entry{ 1499999999.5, 2.0, order_book_side::BID } }
+		};
+
+		order_book_cache cache{ from_snapshot(snapshot, 10) };
+
+		ASSERT_EQ(9, cache.price_scale());
+		assert_snapshot_equal_to_maps(
+			std::vector<order_book_entry>{ order_book_entry{ 1500000000.5, 1.0, order_book_side::ASK } },
+			std::vector<order_book_entry>{ order_book_entry{ 1499999999.5, 2.0, order_book_side::BID } },
+			cache.snapshot());
+	}
+
+	TEST(OrderBookCache, SnapshotIsKeyedAtPriceScale)
+	{
+		order_book_state snapshot
+		{
+			1,
+			{
+				order_book_entry{ 30986.75, 0.03, order_book_side::ASK },
+				order_book_entry{ 30964.51, 0.105, order_book_side::ASK },
+				order_book_entry{ 30964.514, 0.2, order_book_side::ASK }
+			},
+			{
+				order_book_entry{ 30944.65, 0.03, order_book_side::BID },
+				order_book_entry{ 30956.20, 0.0, order_book_side::BID }
+			}
+		};
+
+		order_book_cache cache{ from_snapshot(snapshot, 2) };
+
+		std::vector<order_book_entry> expectedAsks
+		{
+			order_book_entry{ 30964.514, 0.2, order_book_side::ASK },
+			order_book_entry{ 30986.75, 0.03, order_book_side::ASK }
+		};
+
+		std::vector<order_book_entry> expectedBids
+		{
+			order_book_entry{ 30944.65, 0.03, order_book_side::BID }
+		};
+
+		assert_snapshot_equal_to_maps(expectedAsks, expectedBids, cache.snapshot());
+	}
 }
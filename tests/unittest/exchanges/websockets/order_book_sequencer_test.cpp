@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "exchanges/websockets/order_book_sequencer.h"
+
+namespace
+{
+	using namespace mb;
+
+	order_book_update_batch create_update(long long firstSequence, long long lastSequence)
+	{
+		return order_book_update_batch
+		{
+			static_cast<std::time_t>(lastSequence),
+			firstSequence,
+			lastSequence,
+			{ order_book_level_update{ order_book_side::ASK, decimal{ 1, 0 }, 2.0 } }
+		};
+	}
+}
+
+namespace mb::test
+{
+	TEST(OrderBookSequencer, FirstUpdateRequiresSnapshot)
+	{
+		order_book_sequencer sequencer;
+		order_book_update_batch update{ create_update(1, 2) };
+
+		EXPECT_EQ(sequencer.process("BTCUSD", update), sequence_result::SNAPSHOT_REQUIRED);
+		EXPECT_FALSE(sequencer.is_synchronised("BTCUSD"));
+	}
+
+	TEST(OrderBookSequencer, UpdatesAreBufferedUntilSynchronised)
+	{
+		order_book_sequencer sequencer;
+		order_book_update_batch first{ create_update(1, 5) };
+		order_book_update_batch second{ create_update(6, 8) };
+		order_book_update_batch third{ create_update(9, 12) };
+
+		sequencer.process("BTCUSD", first);
+
+		EXPECT_EQ(sequencer.process("BTCUSD", second), sequence_result::BUFFERED);
+		EXPECT_EQ(sequencer.process("BTCUSD", third), sequence_result::BUFFERED);
+
+		std::vector<order_book_update_batch> pendingUpdates{ sequencer.synchronise("BTCUSD", 7) };
+
+		ASSERT_EQ(pendingUpdates.size(), 2);
+		EXPECT_EQ(pendingUpdates[0].last_sequence(), 8);
+		EXPECT_EQ(pendingUpdates[1].last_sequence(), 12);
+		EXPECT_TRUE(sequencer.is_synchronised("BTCUSD"));
+	}
+
+	TEST(OrderBookSequencer, ContiguousUpdateIsApplied)
+	{
+		order_book_sequencer sequencer;
+		order_book_update_batch first{ create_update(1, 5) };
+		order_book_update_batch next{ create_update(6, 9) };
+
+		sequencer.process("BTCUSD", first);
+		sequencer.synchronise("BTCUSD", 5);
+
+		EXPECT_EQ(sequencer.process("BTCUSD", next), sequence_result::APPLY);
+	}
+
+	TEST(OrderBookSequencer, StaleUpdateIsDropped)
+	{
+		order_book_sequencer sequencer;
+		order_book_update_batch first{ create_update(1, 5) };
+		order_book_update_batch stale{ create_update(3, 4) };
+
+		sequencer.process("BTCUSD", first);
+		sequencer.synchronise("BTCUSD", 5);
+
+		EXPECT_EQ(sequencer.process("BTCUSD", stale), sequence_result::STALE);
+	}
+
+	TEST(OrderBookSequencer, GapRequiresSnapshotForAffectedPairOnly)
+	{
+		order_book_sequencer sequencer;
+		order_book_update_batch btcFirst{ create_update(1, 5) };
+		order_book_update_batch ethFirst{ create_update(1, 5) };
+		order_book_update_batch btcGap{ create_update(8, 9) };
+		order_book_update_batch ethNext{ create_update(6, 7) };
+
+		sequencer.process("BTCUSD", btcFirst);
+		sequencer.process("ETHUSD", ethFirst);
+		sequencer.synchronise("BTCUSD", 5);
+		sequencer.synchronise("ETHUSD", 5);
+
+		EXPECT_EQ(sequencer.process("BTCUSD", btcGap), sequence_result::SNAPSHOT_REQUIRED);
+		EXPECT_EQ(sequencer.process("ETHUSD", ethNext), sequence_result::APPLY);
+		EXPECT_FALSE(sequencer.is_synchronised("BTCUSD"));
+		EXPECT_TRUE(sequencer.is_synchronised("ETHUSD"));
+		EXPECT_EQ(sequencer.gap_count(), 1);
+	}
+
+	TEST(OrderBookSequencer, GapInBufferedUpdatesLeavesBookUnsynchronised)
+	{
+		order_book_sequencer sequencer;
+		order_book_update_batch first{ create_update(1, 5) };
+		order_book_update_batch second{ create_update(10, 12) };
+
+		sequencer.process("BTCUSD", first);
+		sequencer.process("BTCUSD", second);
+
+		EXPECT_TRUE(sequencer.synchronise("BTCUSD", 6).empty());
+		EXPECT_FALSE(sequencer.is_synchronised("BTCUSD"));
+	}
+}
\ No newline at end of file
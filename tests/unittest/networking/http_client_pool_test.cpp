@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <optional>
+#include <thread>
+
+#include "networking/http/http_client_pool.h"
+
+namespace mb::test
+{
+	TEST(HttpClientPool, CheckoutReusesReturnedClient)
+	{
+		http_client_pool pool;
+		CURL* firstHandle;
+
+		{
+			pooled_http_client client{ pool.checkout() };
+			firstHandle = client.handle();
+		}
+
+		ASSERT_EQ(pool.idle_count(), 1);
+
+		pooled_http_client client{ pool.checkout() };
+
+		EXPECT_EQ(client.handle(), firstHandle);
+		EXPECT_EQ(pool.idle_count(), 0);
+		EXPECT_EQ(pool.metrics().client_count(), 1);
+	}
+
+	TEST(HttpClientPool, ConcurrentCheckoutsUseSeparateClients)
+	{
+		http_client_pool pool;
+
+		{
+			pooled_http_client first{ pool.checkout() };
+			pooled_http_client second{ pool.checkout() };
+
+			EXPECT_NE(first.handle(), second.handle());
+		}
+
+		EXPECT_EQ(pool.idle_count(), 2);
+		EXPECT_EQ(pool.metrics().client_count(), 2);
+	}
+
+	TEST(HttpClientPool, CheckoutPrefersClientReleasedOnSameThread)
+	{
+		http_client_pool pool;
+		std::promise<void> checkedOut;
+		std::promise<void> ownReleased;
+		CURL* ownHandle;
+
+		std::optional<pooled_http_client> ownClient{ pool.checkout() };
+		ownHandle = ownClient->handle();
+
+		std::thread other{ [&]()
+		{
+			pooled_http_client client{ pool.checkout() };
+			checkedOut.set_value();
+			ownReleased.get_future().wait();
+		} };
+
+		checkedOut.get_future().wait();
+		ownClient.reset();
+		ownReleased.set_value();
+		other.join();
+
+		ASSERT_EQ(pool.idle_count(), 2);
+
+		pooled_http_client client{ pool.checkout() };
+
+		EXPECT_EQ(client.handle(), ownHandle);
+	}
+
+	TEST(HttpClientPool, MultiHandleIsKeptPerThread)
+	{
+		http_client_pool pool;
+		CURLM* ownHandle = pool.multi_handle();
+		CURLM* otherHandle = nullptr;
+
+		std::thread other{ [&pool, &otherHandle]() { otherHandle = pool.multi_handle(); } };
+		other.join();
+
+		EXPECT_EQ(pool.multi_handle(), ownHandle);
+		EXPECT_NE(otherHandle, ownHandle);
+	}
+
+	TEST(HttpClientPool, IdleClientsAreCappedAtMaxIdleCount)
+	{
+		http_client_pool pool{ 2 };
+		CURL* lastHandle;
+
+		{
+			pooled_http_client first{ pool.checkout() };
+			pooled_http_client second{ pool.checkout() };
+			pooled_http_client third{ pool.checkout() };
+			lastHandle = first.handle();
+		}
+
+		ASSERT_EQ(pool.idle_count(), 2);
+
+		pooled_http_client client{ pool.checkout() };
+
+		EXPECT_EQ(client.handle(), lastHandle);
+	}
+
+	TEST(HttpClientPool, MultiHandleIsReleasedWhenThreadExits)
+	{
+		http_client_pool pool;
+		pool.multi_handle();
+
+		std::thread other{ [&pool]() { pool.multi_handle(); } };
+		other.join();
+
+		EXPECT_EQ(pool.multi_handle_count(), 1);
+	}
+
+	TEST(HttpClientPool, ThreadCanOutlivePool)
+	{
+		std::optional<http_client_pool> pool{ std::in_place };
+		std::promise<void> created;
+		std::promise<void> poolDestroyed;
+
+		std::thread other{ [&]()
+		{
+			pool->multi_handle();
+			created.set_value();
+			poolDestroyed.get_future().wait();
+		} };
+
+		created.get_future().wait();
+		EXPECT_EQ(pool->multi_handle_count(), 1);
+
+		pool.reset();
+		poolDestroyed.set_value();
+		other.join();
+	}
+
+	TEST(HttpClientPool, MetricsReportReuseRateAndAverageLatency)
+	{
+		http_client_metrics metrics{ 4, 3, 1, 2.0 };
+
+		EXPECT_DOUBLE_EQ(metrics.connection_reuse_rate(), 0.75);
+		EXPECT_DOUBLE_EQ(metrics.average_latency(), 0.5);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "networking/http/http_retry.h"
+
+namespace mb::test
+{
+	TEST(HttpRetry, ConnectionFailuresAreAlwaysRetryable)
+	{
+		http_error error{ "", http_error_type::CONNECTION_FAILED };
+
+		EXPECT_TRUE(is_retryable(error, http_verb::GET));
+		EXPECT_TRUE(is_retryable(error, http_verb::POST));
+	}
+
+	TEST(HttpRetry, TransferFailuresAreOnlyRetryableForIdempotentRequests)
+	{
+		http_error error{ "", http_error_type::TRANSFER_FAILED };
+
+		EXPECT_TRUE(is_retryable(error, http_verb::GET));
+		EXPECT_FALSE(is_retryable(error, http_verb::POST));
+		EXPECT_FALSE(is_retryable(error, http_verb::HTTP_DELETE));
+	}
+
+	TEST(HttpRetry, FatalErrorsAreNotRetryable)
+	{
+		EXPECT_FALSE(is_retryable(http_error{ "" }, http_verb::GET));
+	}
+
+	TEST(HttpRetry, ServerErrorsAreOnlyRetryableForIdempotentRequests)
+	{
+		EXPECT_TRUE(is_retryable(503, http_verb::GET));
+		EXPECT_TRUE(is_retryable(504, http_verb::GET));
+		EXPECT_FALSE(is_retryable(503, http_verb::POST));
+	}
+
+	TEST(HttpRetry, TooManyRequestsIsRetryable)
+	{
+		EXPECT_TRUE(is_retryable(429, http_verb::GET));
+		EXPECT_TRUE(is_retryable(429, http_verb::POST));
+	}
+
+	TEST(HttpRetry, ClientErrorsAreNotRetryable)
+	{
+		EXPECT_FALSE(is_retryable(200, http_verb::GET));
+		EXPECT_FALSE(is_retryable(400, http_verb::GET));
+		EXPECT_FALSE(is_retryable(418, http_verb::GET));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "networking/http/http_service.h"
+#include "networking/http/http_error.h"
+
+namespace
+{
+	using namespace mb;
+
+	constexpr int DEFAULT_MAX_CONCURRENT_REQUESTS = 8;
+
+	/*
+	* Batches are sent to file URLs, which curl serves through the same multi handle as HTTP transfers,
+	* so the tests exercise the batch loop without a server.
+	*/
+	class HttpServiceBatchTest : public testing::Test
+	{
+	protected:
+		std::filesystem::path _path;
+
+		std::string file_url(const std::string& fileName) const
+		{
+			std::string path{ (_path / fileName).generic_string() };
+
+			return path.front() == '/'
+				? "file://" + path
+				: "file:///" + path;
+		}
+
+		std::vector<http_request> create_requests(int count)
+		{
+			std::vector<http_request> requests;
+
+			for (int i = 0; i < count; ++i)
+			{
+				std::string fileName{ "response" + std::to_string(i) };
+				std::ofstream{ _path / fileName } << "response " << i;
+
+				requests.emplace_back(http_verb::GET, file_url(fileName));
+			}
+
+			return requests;
+		}
+
+	public:
+		void SetUp() override
+		{
+			_path = std::filesystem::temp_directory_path() / "mb_http_service_test";
+			std::filesystem::remove_all(_path);
+			std::filesystem::create_directories(_path);
+		}
+
+		void TearDown() override
+		{
+			http_service::set_max_concurrent_requests(DEFAULT_MAX_CONCURRENT_REQUESTS);
+			std::filesystem::remove_all(_path);
+		}
+	};
+}
+
+namespace mb::test
+{
+	TEST_F(HttpServiceBatchTest, ResponsesMatchRequestOrder)
+	{
+		http_service service;
+		std::vector<http_request> requests{ create_requests(20) };
+
+		std::vector<http_response> responses{ service.send_batch(requests) };
+
+		ASSERT_EQ(responses.size(), requests.size());
+
+		for (size_t i = 0; i < responses.size(); ++i)
+		{
+			EXPECT_EQ(responses[i].message(), "response " + std::to_string(i));
+		}
+	}
+
+	TEST_F(HttpServiceBatchTest, TransfersRunConcurrentlyUpToLimit)
+	{
+		http_service::set_max_concurrent_requests(4);
+		http_service service;
+
+		std::vector<http_response> responses{ service.send_batch(create_requests(12)) };
+
+		EXPECT_EQ(responses.size(), 12);
+		EXPECT_EQ(service.metrics().request_count(), 12);
+		EXPECT_EQ(service.metrics().client_count(), 4);
+	}
+
+	TEST_F(HttpServiceBatchTest, FailedTransferDoesNotStopOthers)
+	{
+		http_service service;
+		std::vector<http_request> requests{ create_requests(4) };
+		requests.emplace(requests.begin() + 1, http_verb::GET, file_url("missing"));
+
+		EXPECT_THROW(service.send_batch(requests), http_error);
+		EXPECT_EQ(service.metrics().request_count(), 4);
+	}
+
+	TEST_F(HttpServiceBatchTest, ThrottledTransfersAreScheduledNotDropped)
+	{
+		http_service service;
+		service.set_rate_limiter(std::make_shared<rate_limiter>(rate_limit_config{ 1.0, 20.0, {} }));
+
+		auto start{ std::chrono::steady_clock::now() };
+		std::vector<http_response> responses{ service.send_batch(create_requests(5)) };
+
+		ASSERT_EQ(responses.size(), 5);
+		EXPECT_EQ(responses.back().message(), "response 4");
+		EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{ 190 });
+		EXPECT_EQ(service.get_rate_limiter()->throttled_count(), 4);
+	}
+}
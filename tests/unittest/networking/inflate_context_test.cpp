@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "networking/websocket/inflate_context.h"
+#include "networking/websocket/websocket_error.h"
+
+namespace
+{
+	std::string deflate_payload(std::string_view payload, int windowBits)
+	{
+		z_stream stream{};
+		deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+
+		std::string output(deflateBound(&stream, static_cast<uLong>(payload.size())), '\0');
+
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(payload.data()));
+		stream.avail_in = static_cast<uInt>(payload.size());
+		stream.next_out = reinterpret_cast<Bytef*>(output.data());
+		stream.avail_out = static_cast<uInt>(output.size());
+
+		deflate(&stream, Z_FINISH);
+		output.resize(stream.total_out);
+		deflateEnd(&stream);
+
+		return output;
+	}
+
+	std::string create_message(size_t size)
+	{
+		std::string message;
+
+		while (message.size() < size)
+		{
+			message.append(R"({"method":"trades.update","params":[true,[{"price":"100.5","amount":"0.25"}],"BTC_USDT"]})");
+		}
+
+		return message;
+	}
+}
+
+namespace mb::test
+{
+	TEST(InflateContext, InflatesZlibPayload)
+	{
+		std::string message{ create_message(100) };
+		inflate_context context;
+
+		EXPECT_EQ(context.inflate(deflate_payload(message, 15)), message);
+	}
+
+	TEST(InflateContext, InflatesGzipPayload)
+	{
+		std::string message{ create_message(100) };
+		inflate_context context;
+
+		EXPECT_EQ(context.inflate(deflate_payload(message, 15 + 16)), message);
+	}
+
+	TEST(InflateContext, InflatesRawDeflatePayload)
+	{
+		std::string message{ create_message(100) };
+		inflate_context context;
+
+		EXPECT_EQ(context.inflate(deflate_payload(message, -15)), message);
+	}
+
+	TEST(InflateContext, InflatesPayloadLargerThanBuffer)
+	{
+		std::string message{ create_message(1000000) };
+		inflate_context context;
+
+		EXPECT_EQ(context.inflate(deflate_payload(message, 15)), message);
+	}
+
+	TEST(InflateContext, IsReusableAcrossFormats)
+	{
+		std::string first{ create_message(100) };
+		std::string second{ create_message(5000) };
+		inflate_context context;
+
+		EXPECT_EQ(context.inflate(deflate_payload(first, 15 + 16)), first);
+		EXPECT_EQ(context.inflate(deflate_payload(second, -15)), second);
+		EXPECT_EQ(context.inflate(deflate_payload(first, 15)), first);
+	}
+
+	TEST(InflateContext, ThrowsOnCorruptPayload)
+	{
+		std::string payload{ deflate_payload(create_message(100), 15) };
+		payload[5] = static_cast<char>(0xff);
+		payload[6] = static_cast<char>(0xff);
+
+		inflate_context context;
+
+		EXPECT_THROW(context.inflate(payload), websocket_error);
+	}
+
+	TEST(InflateContext, ThrowsOnTruncatedPayload)
+	{
+		std::string payload{ deflate_payload(create_message(100000), 15) };
+		payload.resize(payload.size() / 2);
+
+		inflate_context context;
+
+		EXPECT_THROW(context.inflate(payload), websocket_error);
+	}
+
+	TEST(InflateContext, ThrowsOnPayloadMissingChecksum)
+	{
+		std::string payload{ deflate_payload(create_message(100), 15) };
+		payload.resize(payload.size() - 4);
+
+		inflate_context context;
+
+		EXPECT_THROW(context.inflate(payload), websocket_error);
+	}
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "networking/http/rate_limiter.h"
+#include "networking/url.h"
+
+namespace mb::test
+{
+	TEST(RateLimiter, RequestsWithinCapacityAreNotDelayed)
+	{
+		rate_limiter limiter{ rate_limit_config{ 10.0, 1.0, {} } };
+
+		EXPECT_EQ(limiter.reserve(4.0), std::chrono::microseconds::zero());
+		EXPECT_EQ(limiter.reserve(6.0), std::chrono::microseconds::zero());
+	}
+
+	TEST(RateLimiter, RequestsBeyondCapacityWaitForRefill)
+	{
+		rate_limiter limiter{ rate_limit_config{ 10.0, 10.0, {} } };
+
+		limiter.reserve(10.0);
+
+		std::chrono::microseconds firstDelay{ limiter.reserve(5.0) };
+		std::chrono::microseconds secondDelay{ limiter.reserve(5.0) };
+
+		EXPECT_NEAR(firstDelay.count(), 500000, 1000);
+		EXPECT_NEAR(secondDelay.count(), 1000000, 1000);
+	}
+
+	TEST(RateLimiter, AcquireRecordsThrottledTime)
+	{
+		rate_limiter limiter{ rate_limit_config{ 1.0, 1000.0, { { "/api/v3/depth", 5.0 } } } };
+
+		limiter.acquire(std::string_view{ "/api/v3/depth" });
+
+		EXPECT_EQ(limiter.throttled_count(), 1);
+		EXPECT_GT(limiter.throttled_time(), std::chrono::microseconds::zero());
+	}
+
+	TEST(RateLimiter, ReserveReturnsDelayWithoutWaiting)
+	{
+		rate_limiter limiter{ rate_limit_config{ 1.0, 1.0, { { "/api/v3/depth", 5.0 } } } };
+
+		auto start{ std::chrono::steady_clock::now() };
+		std::chrono::microseconds delay{ limiter.reserve(std::string_view{ "/api/v3/depth" }) };
+
+		EXPECT_NEAR(delay.count(), 4000000, 1000);
+		EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{ 1 });
+		EXPECT_EQ(limiter.throttled_count(), 1);
+	}
+
+	TEST(RateLimiter, DisabledLimiterNeverDelays)
+	{
+		rate_limiter limiter{ rate_limit_config{} };
+
+		EXPECT_EQ(limiter.reserve(1000.0), std::chrono::microseconds::zero());
+	}
+
+	TEST(RateLimitConfig, UnknownEndpointHasDefaultWeight)
+	{
+		rate_limit_config config{ 10.0, 1.0, { { "/api/v3/exchangeInfo", 20.0 } } };
+
+		EXPECT_DOUBLE_EQ(config.endpoint_weight("/api/v3/exchangeInfo"), 20.0);
+		EXPECT_DOUBLE_EQ(config.endpoint_weight("/api/v3/time"), 1.0);
+	}
+
+	TEST(RateLimitConfig, ReadUsesDefaultsForMissingProperties)
+	{
+		rate_limit_config defaultConfig{ 10.0, 1.0, { { "/depth", 2.0 } } };
+		json_document json{ parse_json(R"({ "rateLimitCapacity": 50.0 })") };
+
+		rate_limit_config config{ read_rate_limit_config(json, defaultConfig) };
+
+		EXPECT_DOUBLE_EQ(config.capacity(), 50.0);
+		EXPECT_DOUBLE_EQ(config.refill_rate(), 1.0);
+		EXPECT_DOUBLE_EQ(config.endpoint_weight("/depth"), 2.0);
+	}
+
+	TEST(Url, GetUrlPathStripsHostAndQuery)
+	{
+		EXPECT_EQ(get_url_path("https://api.binance.com/api/v3/depth?symbol=BTCUSDT"), "/api/v3/depth");
+		EXPECT_EQ(get_url_path("https://api.kraken.com/0/public/Ticker"), "/0/public/Ticker");
+		EXPECT_EQ(get_url_path("https://api.kraken.com"), "/");
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "networking/http/response_cache.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace mb::test
+{
+	TEST(ResponseCache, ReturnsCachedValueWithinTtl)
+	{
+		response_cache cache;
+		int fetchCount = 0;
+
+		auto fetch = [&fetchCount]() { return ++fetchCount; };
+
+		EXPECT_EQ(cache.get<int>("/status", "", std::chrono::hours{ 1 }, fetch), 1);
+		EXPECT_EQ(cache.get<int>("/status", "", std::chrono::hours{ 1 }, fetch), 1);
+		EXPECT_EQ(cache.get<int>("/status", "pair=BTCUSD", std::chrono::hours{ 1 }, fetch), 2);
+
+		EXPECT_EQ(cache.hit_count(), 1);
+		EXPECT_EQ(cache.miss_count(), 2);
+	}
+
+	TEST(ResponseCache, ZeroTtlIsNotCached)
+	{
+		response_cache cache;
+		int fetchCount = 0;
+
+		auto fetch = [&fetchCount]() { return ++fetchCount; };
+
+		cache.get<int>("/status", "", std::chrono::milliseconds::zero(), fetch);
+
+		EXPECT_EQ(cache.get<int>("/status", "", std::chrono::milliseconds::zero(), fetch), 2);
+	}
+
+	TEST(ResponseCache, FailedFetchIsNotCached)
+	{
+		response_cache cache;
+
+		EXPECT_THROW(cache.get<int>("/status", "", std::chrono::hours{ 1 }, []() -> int { throw mb_exception{ "Request failed" }; }), mb_exception);
+		EXPECT_EQ(cache.get<int>("/status", "", std::chrono::hours{ 1 }, []() { return 5; }), 5);
+	}
+
+	TEST(ResponseCache, ConcurrentIdenticalRequestsShareOneFetch)
+	{
+		response_cache cache;
+		std::atomic<int> fetchCount{ 0 };
+		std::atomic<bool> fetchStarted{ false };
+		std::atomic<bool> releaseFetch{ false };
+
+		auto fetch = [&]()
+		{
+			++fetchCount;
+			fetchStarted = true;
+
+			while (!releaseFetch)
+			{
+				std::this_thread::yield();
+			}
+
+			return 10;
+		};
+
+		int firstResult = 0;
+		std::thread first{ [&]() { firstResult = cache.get<int>("/pairs", "", std::chrono::hours{ 1 }, fetch); } };
+
+		while (!fetchStarted)
+		{
+			std::this_thread::yield();
+		}
+
+		int secondResult = 0;
+		std::thread second{ [&]() { secondResult = cache.get<int>("/pairs", "", std::chrono::hours{ 1 }, fetch); } };
+
+		while (cache.hit_count() == 0)
+		{
+			std::this_thread::yield();
+		}
+
+		releaseFetch = true;
+		first.join();
+		second.join();
+
+		EXPECT_EQ(fetchCount, 1);
+		EXPECT_EQ(firstResult, 10);
+		EXPECT_EQ(secondResult, 10);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
+#include "runner/live_runner.h"
+#include "runner/live_test_runner.h"
+#include "mbtest/mocks.h"
+
+namespace
+{
+	using namespace mb;
+
+	class event_driven_stub_strategy
+	{
+	private:
+		std::vector<unique_websocket_subscription> _interests;
+		std::vector<std::unordered_set<tradable_pair>> _wakeUps;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+
+	public:
+		explicit event_driven_stub_strategy(std::vector<unique_websocket_subscription> interests)
+			: _interests{ std::move(interests) }
+		{}
+
+		std::vector<unique_websocket_subscription> market_data_interests() const { return _interests; }
+
+		void on_market_data(const std::unordered_set<tradable_pair>& changedPairs)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ _mutex };
+				_wakeUps.push_back(changedPairs);
+			}
+
+			_condition.notify_all();
+		}
+
+		// Only needed so the polling paths of the runners type check too
+		void run_iteration() {}
+		report_result_list get_test_results() const { return {}; }
+
+		std::vector<std::unordered_set<tradable_pair>> wait_for_wake_ups(size_t count)
+		{
+			std::unique_lock<std::mutex> lock{ _mutex };
+			_condition.wait_for(lock, std::chrono::seconds{ 5 }, [this, count]() { return _wakeUps.size() >= count; });
+
+			return _wakeUps;
+		}
+	};
+
+	std::shared_ptr<test::mock_websocket_stream> add_mock_exchange(std::vector<std::shared_ptr<exchange>>& exchanges)
+	{
+		auto stream = std::make_shared<test::mock_websocket_stream>();
+		exchanges.push_back(std::make_shared<test::mock_exchange>(stream));
+
+		return stream;
+	}
+}
+
+namespace mb::internal
+{
+	// Instantiating every member checks both runners against an event driven strategy
+	template class live_runner<event_driven_stub_strategy>;
+	template class live_test_runner<event_driven_stub_strategy>;
+}
+
+namespace mb::test
+{
+	TEST(LiveRunner, FiredUpdateWakesStrategyWithChangedPair)
+	{
+		tradable_pair btcPair{ "BTC", "GBP" };
+		tradable_pair ethPair{ "ETH", "GBP" };
+
+		std::vector<std::shared_ptr<exchange>> exchanges;
+		std::shared_ptr<mock_websocket_stream> stream{ add_mock_exchange(exchanges) };
+
+		internal::live_runner<event_driven_stub_strategy> runner{ [&exchanges](const runner_config&) { return exchanges; } };
+		runner.create_exchanges(runner_config{});
+
+		event_driven_stub_strategy strategy
+		{
+			{
+				unique_websocket_subscription::create_trade_sub(btcPair),
+				unique_websocket_subscription::create_trade_sub(ethPair)
+			}
+		};
+
+		std::future<void> run{ std::async(std::launch::async, [&]() { runner.run(strategy); }) };
+
+		// The first wake up covers every interest, whether or not it has changed yet
+		std::unordered_set<tradable_pair> allPairs{ btcPair, ethPair };
+		ASSERT_EQ(allPairs, strategy.wait_for_wake_ups(1).at(0));
+
+		stream->expose_fire_trade_update(trade_update_message{ ethPair, trade_update{ 1, 1.0, 1.0 } });
+
+		std::vector<std::unordered_set<tradable_pair>> wakeUps{ strategy.wait_for_wake_ups(2) };
+		ASSERT_EQ(2, wakeUps.size());
+
+		std::unordered_set<tradable_pair> changedPairs{ ethPair };
+		EXPECT_EQ(changedPairs, wakeUps[1]);
+
+		runner.stop();
+		EXPECT_EQ(std::future_status::ready, run.wait_for(std::chrono::seconds{ 5 }));
+	}
+
+	TEST(LiveRunner, StopUnblocksIdleRun)
+	{
+		std::vector<std::shared_ptr<exchange>> exchanges;
+		add_mock_exchange(exchanges);
+
+		internal::live_runner<event_driven_stub_strategy> runner{ [&exchanges](const runner_config&) { return exchanges; } };
+		runner.create_exchanges(runner_config{});
+
+		event_driven_stub_strategy strategy{ {} };
+		std::future<void> run{ std::async(std::launch::async, [&]() { runner.run(strategy); }) };
+
+		// With no interests and no run interval the runner waits on the signal until it is stopped
+		EXPECT_EQ(std::future_status::timeout, run.wait_for(std::chrono::milliseconds{ 50 }));
+
+		runner.stop();
+		EXPECT_EQ(std::future_status::ready, run.wait_for(std::chrono::seconds{ 5 }));
+	}
+
+	TEST(LiveRunner, RunningOnMarketDataStopsWhenSignalStops)
+	{
+		market_data_signal signal;
+		event_driven_stub_strategy strategy{ {} };
+		int iterations = 0;
+
+		std::future<void> run{ std::async(std::launch::async, [&]()
+		{
+			internal::run_on_market_data(strategy, signal, 0, [&iterations]() { ++iterations; });
+		}) };
+
+		signal.notify(tradable_pair{ "BTC", "GBP" });
+		strategy.wait_for_wake_ups(1);
+
+		signal.stop();
+		ASSERT_EQ(std::future_status::ready, run.wait_for(std::chrono::seconds{ 5 }));
+		EXPECT_EQ(1, iterations);
+	}
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "runner/market_data_signal.h"
+#include "runner/event_driven_strategy.h"
+#include "mbtest/mocks.h"
+
+namespace
+{
+	using namespace mb;
+
+	class polling_strategy
+	{
+	public:
+		void run_iteration() {}
+	};
+
+	class event_driven_strategy
+	{
+	public:
+		std::vector<unique_websocket_subscription> market_data_interests() const { return {}; }
+		void on_market_data(const std::unordered_set<tradable_pair>& changedPairs) {}
+	};
+
+	class trade_interest_strategy
+	{
+	public:
+		std::vector<unique_websocket_subscription> market_data_interests() const
+		{
+			return { unique_websocket_subscription::create_trade_sub(tradable_pair{ "BTC", "GBP" }) };
+		}
+
+		void on_market_data(const std::unordered_set<tradable_pair>& changedPairs) {}
+	};
+}
+
+namespace mb::test
+{
+	using namespace std::chrono_literals;
+
+	TEST(MarketDataSignal, WaitReturnsNotifiedPairs)
+	{
+		market_data_signal signal;
+
+		signal.notify(tradable_pair{ "BTC", "GBP" });
+		signal.notify(tradable_pair{ "ETH", "GBP" });
+
+		std::unordered_set<tradable_pair> expected{ tradable_pair{ "BTC", "GBP" }, tradable_pair{ "ETH", "GBP" } };
+
+		EXPECT_EQ(expected, signal.wait());
+	}
+
+	TEST(MarketDataSignal, RepeatedNotificationsForPairAreCoalesced)
+	{
+		market_data_signal signal;
+
+		signal.notify(tradable_pair{ "BTC", "GBP" });
+		signal.notify(tradable_pair{ "BTC", "GBP" });
+		signal.notify(tradable_pair{ "BTC", "GBP" });
+
+		EXPECT_EQ(1, signal.wait().size());
+		EXPECT_TRUE(signal.wait_for(0ms).empty());
+	}
+
+	TEST(MarketDataSignal, WaitForReturnsNoPairsOnTimeout)
+	{
+		market_data_signal signal;
+
+		EXPECT_TRUE(signal.wait_for(10ms).empty());
+	}
+
+	TEST(MarketDataSignal, NotifyWakesWaitingThread)
+	{
+		market_data_signal signal;
+		std::unordered_set<tradable_pair> changedPairs;
+
+		std::thread waitThread{ [&signal, &changedPairs]() { changedPairs = signal.wait(); } };
+		signal.notify(tradable_pair{ "BTC", "GBP" });
+		waitThread.join();
+
+		std::unordered_set<tradable_pair> expected{ tradable_pair{ "BTC", "GBP" } };
+
+		EXPECT_EQ(expected, changedPairs);
+	}
+
+	TEST(MarketDataSignal, StopWakesWaitingThreadAndIgnoresLaterNotifications)
+	{
+		market_data_signal signal;
+
+		std::thread waitThread{ [&signal]() { EXPECT_TRUE(signal.wait().empty()); } };
+		signal.stop();
+		waitThread.join();
+
+		signal.notify(tradable_pair{ "BTC", "GBP" });
+
+		EXPECT_TRUE(signal.stopped());
+		EXPECT_TRUE(signal.wait().empty());
+	}
+
+	TEST(MarketDataSignal, WatchMarketDataOnlyNotifiesDeclaredInterests)
+	{
+		mock_websocket_stream stream;
+		market_data_signal signal;
+
+		tradable_pair tradePair{ "BTC", "GBP" };
+		tradable_pair ohlcvPair{ "ETH", "GBP" };
+
+		watch_market_data(stream, signal,
+			{
+				unique_websocket_subscription::create_trade_sub(tradePair),
+				unique_websocket_subscription::create_ohlcv_sub(ohlcvPair, ohlcv_interval::M5)
+			});
+
+		stream.expose_fire_order_book_update(order_book_update_message{ tradePair, order_book_entry{ 1.0, 1.0, order_book_side::ASK } });
+		stream.expose_fire_ohlcv_update(ohlcv_update_message{ ohlcvPair, ohlcv_interval::M1, ohlcv_data{} });
+		stream.expose_fire_trade_update(trade_update_message{ ohlcvPair, trade_update{ 1, 1.0, 1.0 } });
+
+		EXPECT_TRUE(signal.wait_for(0ms).empty());
+
+		stream.expose_fire_trade_update(trade_update_message{ tradePair, trade_update{ 1, 1.0, 1.0 } });
+		stream.expose_fire_ohlcv_update(ohlcv_update_message{ ohlcvPair, ohlcv_interval::M5, ohlcv_data{} });
+
+		std::unordered_set<tradable_pair> expected{ tradePair, ohlcvPair };
+
+		EXPECT_EQ(expected, signal.wait_for(0ms));
+	}
+
+	TEST(MarketDataSignal, StrategiesWithInterestsAndHandlerAreEventDriven)
+	{
+		EXPECT_FALSE(internal::is_event_driven<polling_strategy>::value);
+		EXPECT_TRUE(internal::is_event_driven<event_driven_strategy>::value);
+	}
+
+	TEST(MarketDataSignal, WatchingWhileStreamFiresUpdatesIsSafe)
+	{
+		mock_websocket_stream stream;
+		market_data_signal signal;
+		tradable_pair pair{ "BTC", "GBP" };
+		std::atomic<bool> firing{ true };
+
+		std::thread fireThread{ [&]()
+		{
+			while (firing)
+			{
+				stream.expose_fire_trade_update(trade_update_message{ pair, trade_update{ 1, 1.0, 1.0 } });
+			}
+		} };
+
+		watch_market_data(stream, signal, { unique_websocket_subscription::create_trade_sub(pair) });
+
+		std::unordered_set<tradable_pair> expected{ pair };
+		EXPECT_EQ(expected, signal.wait());
+
+		firing = false;
+		fireThread.join();
+	}
+
+	TEST(MarketDataSignal, WatchingStrategyInterestsWakesForEachInterest)
+	{
+		std::vector<std::shared_ptr<exchange>> exchanges{ std::make_shared<mock_exchange>(std::make_shared<mock_websocket_stream>()) };
+		market_data_signal signal;
+
+		internal::watch_strategy_interests(exchanges, signal, trade_interest_strategy{});
+
+		std::unordered_set<tradable_pair> expected{ tradable_pair{ "BTC", "GBP" } };
+		EXPECT_EQ(expected, signal.wait_for(0ms));
+	}
+}
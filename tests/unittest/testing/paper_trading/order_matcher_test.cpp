@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "testing/paper_trading/order_matcher.h"
+
+namespace
+{
+	using namespace mb;
+
+	using fill_list = std::vector<std::pair<paper_order_id, double>>;
+
+	fill_list match(order_matcher& matcher, double price)
+	{
+		fill_list fills;
+		matcher.match(price, [&fills](paper_order_id orderId, double fillPrice)
+		{
+			fills.emplace_back(orderId, fillPrice);
+			return true;
+		});
+
+		return fills;
+	}
+}
+
+namespace mb::test
+{
+	static tradable_pair TEST_PAIR{ "BTC", "GBP" };
+
+	TEST(OrderMatcher, OnlyCrossingLimitOrdersAreFilledAtLimitPrice)
+	{
+		order_matcher matcher;
+		matcher.add(1, to_paper_order(create_limit_order(TEST_PAIR, trade_action::BUY, 10.0, 1.0), 0), 20.0);
+		matcher.add(2, to_paper_order(create_limit_order(TEST_PAIR, trade_action::BUY, 15.0, 1.0), 0), 20.0);
+		matcher.add(3, to_paper_order(create_limit_order(TEST_PAIR, trade_action::SELL, 30.0, 1.0), 0), 20.0);
+
+		EXPECT_TRUE(match(matcher, 20.0).empty());
+		EXPECT_EQ(match(matcher, 12.0), (fill_list{ { 2, 15.0 } }));
+		EXPECT_EQ(match(matcher, 35.0), (fill_list{ { 3, 30.0 } }));
+		EXPECT_EQ(match(matcher, 10.0), (fill_list{ { 1, 10.0 } }));
+	}
+
+	TEST(OrderMatcher, StopOrdersAreFilledAtStopPriceWhenTriggered)
+	{
+		order_matcher matcher;
+		matcher.add(1, to_paper_order(create_stop_loss_order(TEST_PAIR, trade_action::SELL, 15.0, 1.0), 0), 20.0);
+		matcher.add(2, to_paper_order(create_stop_loss_order(TEST_PAIR, trade_action::BUY, 25.0, 1.0), 0), 20.0);
+
+		EXPECT_TRUE(match(matcher, 18.0).empty());
+		EXPECT_EQ(match(matcher, 14.0), (fill_list{ { 1, 15.0 } }));
+		EXPECT_EQ(match(matcher, 26.0), (fill_list{ { 2, 25.0 } }));
+	}
+
+	TEST(OrderMatcher, TrailingStopFollowsExtremeAndFillsAtCurrentPrice)
+	{
+		order_matcher matcher;
+		matcher.add(1, to_paper_order(create_trailing_stop_loss_order(TEST_PAIR, trade_action::SELL, 0.1, 1.0), 0), 20.0);
+
+		EXPECT_TRUE(match(matcher, 25.0).empty());
+		EXPECT_DOUBLE_EQ(matcher.trailing_extreme(1), 25.0);
+		EXPECT_TRUE(match(matcher, 23.0).empty());
+		EXPECT_EQ(match(matcher, 22.0), (fill_list{ { 1, 22.0 } }));
+	}
+
+	TEST(OrderMatcher, RemovedOrdersAreNotFilled)
+	{
+		order_matcher matcher;
+		matcher.add(1, to_paper_order(create_limit_order(TEST_PAIR, trade_action::BUY, 10.0, 1.0), 0), 20.0);
+		matcher.add(2, to_paper_order(create_trailing_stop_loss_order(TEST_PAIR, trade_action::BUY, 0.1, 1.0), 0), 0.0);
+
+		EXPECT_TRUE(matcher.remove(1));
+		EXPECT_TRUE(matcher.remove(2));
+		EXPECT_FALSE(matcher.remove(3));
+		EXPECT_TRUE(match(matcher, 5.0).empty());
+	}
+	TEST(OrderMatcher, PartiallyFilledOrdersRemainResting)
+	{
+		order_matcher matcher;
+		matcher.add(1, to_paper_order(create_limit_order(TEST_PAIR, trade_action::BUY, 15.0, 1.0), 0), 20.0);
+		matcher.add(2, to_paper_order(create_stop_loss_order(TEST_PAIR, trade_action::SELL, 12.0, 1.0), 0), 20.0);
+
+		fill_list fills;
+		auto partialFill = [&fills](paper_order_id orderId, double fillPrice)
+		{
+			fills.emplace_back(orderId, fillPrice);
+			return false;
+		};
+
+		matcher.match(14.0, partialFill);
+		matcher.match(11.0, partialFill);
+		matcher.match(30.0, partialFill);
+
+		EXPECT_EQ(fills, (fill_list{ { 1, 15.0 }, { 1, 15.0 }, { 2, 12.0 }, { 2, 30.0 } }));
+	}
+}
\ No newline at end of file
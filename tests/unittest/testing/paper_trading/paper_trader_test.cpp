@@ -10,6 +10,8 @@ namespace
 	using namespace mb;
 	using namespace mb::test;
 
+	using ::testing::_;
+	using ::testing::AnyNumber;
 	using ::testing::Return;
 
 	class PaperTradeApiTest : public testing::Test
@@ -37,6 +39,39 @@ namespace
 			}
 		};
 
+		std::shared_ptr<mock_websocket_stream> _simulatedWebsocketStream;
+		std::time_t _simulatedTime;
+
+		std::unique_ptr<paper_trade_api> create_simulated_api(order_book_state orderBook, fill_model fillModel, bool queuePosition, int orderEntryLatency, int cancelLatency)
+		{
+			_simulatedWebsocketStream = std::make_shared<mock_websocket_stream>();
+			_simulatedTime = 0;
+
+			ON_CALL(*_simulatedWebsocketStream, get_order_book)
+				.WillByDefault(Return(std::move(orderBook)));
+
+			fire_simulated_trade(DefaultPrice, 1.0, false);
+
+			return std::make_unique<paper_trade_api>(
+				paper_trading_config{ Fee, { { "GBP", InitialGbpBalance }, { "BTC", InitialBtcBalance } }, fillModel, 0, queuePosition, orderEntryLatency, cancelLatency },
+				_simulatedWebsocketStream,
+				"",
+				[this]() { return _simulatedTime; });
+		}
+
+		void fire_simulated_trade(double price, double volume, bool fireHandler = true)
+		{
+			trade_update update{ _simulatedTime, price, volume };
+
+			ON_CALL(*_simulatedWebsocketStream, get_last_trade)
+				.WillByDefault(Return(update));
+
+			if (fireHandler)
+			{
+				_simulatedWebsocketStream->expose_fire_trade_update(trade_update_message{ _pair, std::move(update) });
+			}
+		}
+
 	public:
 		PaperTradeApiTest()
 			: _pair{ "BTC", "GBP" }
@@ -179,4 +214,130 @@ namespace mb::test
 		set_price(22.0, true);
 		ASSERT_EQ(order_status::CLOSED, this->_paperTradeApi->get_order_status(orderId));
 	}
+
+	TEST_F(PaperTradeApiTest, LoadStateRestoresBalancesAndOrders)
+	{
+		order_request marketOrder{ create_market_order(this->_pair, trade_action::BUY, 1.0) };
+		order_request limitOrder{ create_limit_order(this->_pair, trade_action::BUY, 10.0, 1.0) };
+		this->_paperTradeApi->add_order(marketOrder);
+		std::string limitOrderId{ this->_paperTradeApi->add_order(limitOrder) };
+
+		binary_writer writer;
+		this->_paperTradeApi->save_state(writer);
+
+		paper_trade_api restoredApi
+		{
+			paper_trading_config{ Fee, {} },
+			std::make_shared<mock_websocket_stream>(),
+			"",
+			now_t
+		};
+
+		binary_reader reader{ writer.data() };
+		restoredApi.load_state(reader);
+
+		EXPECT_EQ(this->_paperTradeApi->get_balances(), restoredApi.get_balances());
+		EXPECT_EQ(restoredApi.get_closed_orders().size(), 1);
+		EXPECT_EQ(order_status::OPEN, restoredApi.get_order_status(limitOrderId));
+		EXPECT_TRUE(reader.at_end());
+	}
+
+	TEST_F(PaperTradeApiTest, MarketOrderFillsAtOrderBookVolumeWeightedPrice)
+	{
+		std::unique_ptr<paper_trade_api> paperTradeApi{ create_simulated_api(order_book_state
+		{
+			now_t(),
+			{ { 20.0, 1.0, order_book_side::ASK }, { 22.0, 1.0, order_book_side::ASK } },
+			{ { 19.0, 1.0, order_book_side::BID } }
+		}, fill_model::ORDER_BOOK, false, 0, 0) };
+
+		order_confirmation confirmation{ paperTradeApi->add_order_confirm(create_market_order(this->_pair, trade_action::BUY, 1.5)) };
+
+		EXPECT_EQ(order_status::CLOSED, confirmation.orderstatus());
+		EXPECT_DOUBLE_EQ(confirmation.filled_qty(), 1.5);
+		EXPECT_DOUBLE_EQ(confirmation.price(), 31.0 / 1.5);
+		EXPECT_DOUBLE_EQ(paperTradeApi->get_balances().at("BTC"), 3.0);
+	}
+
+	TEST_F(PaperTradeApiTest, MarketableLimitOrderRestsRemainderAfterPartialFill)
+	{
+		std::unique_ptr<paper_trade_api> paperTradeApi{ create_simulated_api(order_book_state
+		{
+			now_t(),
+			{ { 20.0, 0.25, order_book_side::ASK }, { 25.0, 1.0, order_book_side::ASK } },
+			{ { 19.0, 1.0, order_book_side::BID } }
+		}, fill_model::ORDER_BOOK, false, 0, 0) };
+
+		order_confirmation confirmation{ paperTradeApi->add_order_confirm(create_limit_order(this->_pair, trade_action::BUY, 21.0, 1.0)) };
+
+		EXPECT_EQ(order_status::PARTIALLY_FILLED, confirmation.orderstatus());
+		EXPECT_DOUBLE_EQ(confirmation.filled_qty(), 0.25);
+		EXPECT_DOUBLE_EQ(confirmation.price(), 20.0);
+
+		std::vector<order_description> openOrders{ paperTradeApi->get_open_orders() };
+		ASSERT_EQ(openOrders.size(), 1);
+		EXPECT_DOUBLE_EQ(openOrders.front().volume(), 0.75);
+	}
+
+	TEST_F(PaperTradeApiTest, QueuedLimitOrderFillsOnlyAfterVolumeAheadHasTraded)
+	{
+		std::unique_ptr<paper_trade_api> paperTradeApi{ create_simulated_api(order_book_state
+		{
+			now_t(),
+			{ { 21.0, 1.0, order_book_side::ASK } },
+			{ { 20.0, 3.0, order_book_side::BID }, { 19.0, 2.0, order_book_side::BID } }
+		}, fill_model::LAST_TRADE, true, 0, 0) };
+
+		std::string orderId{ paperTradeApi->add_order(create_limit_order(this->_pair, trade_action::BUY, 19.0, 1.0)) };
+
+		fire_simulated_trade(19.0, 1.5);
+		EXPECT_EQ(order_status::OPEN, paperTradeApi->get_order_status(orderId));
+
+		fire_simulated_trade(19.0, 1.0);
+		EXPECT_EQ(order_status::PARTIALLY_FILLED, paperTradeApi->get_order_status(orderId));
+
+		fire_simulated_trade(18.5, 0.1);
+		EXPECT_EQ(order_status::CLOSED, paperTradeApi->get_order_status(orderId));
+		EXPECT_DOUBLE_EQ(paperTradeApi->get_balances().at("BTC"), InitialBtcBalance + 1.0);
+	}
+
+	TEST_F(PaperTradeApiTest, QueuePositionSubscribesToOrderBookUnderLastTradeModel)
+	{
+		std::unique_ptr<paper_trade_api> paperTradeApi{ create_simulated_api(order_book_state{ now_t(), {}, {} }, fill_model::LAST_TRADE, true, 0, 0) };
+
+		ON_CALL(*_simulatedWebsocketStream, get_subscription_status)
+			.WillByDefault(Return(subscription_status::UNSUBSCRIBED));
+
+		EXPECT_CALL(*_simulatedWebsocketStream, subscribe(_))
+			.Times(AnyNumber());
+		EXPECT_CALL(*_simulatedWebsocketStream, subscribe(websocket_subscription::create_order_book_sub({ this->_pair })));
+
+		paperTradeApi->add_order(create_limit_order(this->_pair, trade_action::BUY, 19.0, 1.0));
+	}
+
+	TEST_F(PaperTradeApiTest, OrderEntryAndCancelLatencyDelayActions)
+	{
+		std::unique_ptr<paper_trade_api> paperTradeApi{ create_simulated_api(order_book_state{ now_t(), {}, {} }, fill_model::LAST_TRADE, false, 5, 5) };
+
+		std::string marketOrderId{ paperTradeApi->add_order(create_market_order(this->_pair, trade_action::BUY, 1.0)) };
+
+		_simulatedTime = 3;
+		fire_simulated_trade(20.0, 1.0);
+		EXPECT_EQ(order_status::OPEN, paperTradeApi->get_order_status(marketOrderId));
+
+		_simulatedTime = 5;
+		fire_simulated_trade(20.0, 1.0);
+		EXPECT_EQ(order_status::CLOSED, paperTradeApi->get_order_status(marketOrderId));
+
+		std::string limitOrderId{ paperTradeApi->add_order(create_limit_order(this->_pair, trade_action::SELL, 40.0, 1.0)) };
+
+		_simulatedTime = 10;
+		fire_simulated_trade(20.0, 1.0);
+		paperTradeApi->cancel_order(limitOrderId);
+
+		_simulatedTime = 12;
+		fire_simulated_trade(45.0, 1.0);
+		EXPECT_EQ(order_status::CLOSED, paperTradeApi->get_order_status(limitOrderId));
+		EXPECT_EQ(paperTradeApi->get_closed_orders().size(), 2);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "testing/reporting/trade_journal.h"
+#include "common/file/file.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace
+{
+	using namespace mb;
+
+	class TradeJournalTest : public testing::Test
+	{
+	protected:
+		std::filesystem::path _path;
+
+	public:
+		void SetUp() override
+		{
+			_path = std::filesystem::temp_directory_path() / "mb_trade_journal_test";
+			std::filesystem::remove_all(_path);
+			std::filesystem::create_directories(_path);
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(_path);
+		}
+	};
+}
+
+namespace mb::test
+{
+	TEST_F(TradeJournalTest, DestructorWritesAllQueuedOrders)
+	{
+		{
+			trade_journal journal{ _path / "trades.csv", _path / "trades.bin" };
+
+			journal.append({ order_description{ 1, "1", order_type::MARKET, "BTC/GBP", trade_action::BUY, 20.0, 1.0 } });
+			journal.append({
+				order_description{ 2, "2", order_type::LIMIT, "BTC/GBP", trade_action::SELL, 25.0, 0.5 },
+				order_description{ 3, "3", order_type::LIMIT, "ETH/GBP", trade_action::BUY, 10.0, 2.0 } });
+		}
+
+		int lineCount = 0;
+		stream_file(_path / "trades.csv", [&lineCount](const std::string& line) { ++lineCount; });
+		EXPECT_EQ(lineCount, 3);
+
+		std::vector<order_description> orders{ read_binary_trade_journal(_path / "trades.bin") };
+		ASSERT_EQ(orders.size(), 3);
+		EXPECT_EQ(orders[1].order_id(), "2");
+		EXPECT_EQ(orders[2].pair_name(), "ETH/GBP");
+		EXPECT_DOUBLE_EQ(orders[2].volume(), 2.0);
+	}
+
+	TEST_F(TradeJournalTest, FlushWaitsForQueuedOrders)
+	{
+		trade_journal journal{ _path / "trades.csv", std::nullopt };
+
+		journal.append({ order_description{ 1, "1", order_type::MARKET, "BTC/GBP", trade_action::BUY, 20.0, 1.0 } });
+		journal.flush();
+
+		EXPECT_GT(std::filesystem::file_size(_path / "trades.csv"), 0);
+		EXPECT_FALSE(std::filesystem::exists(_path / "trades.bin"));
+	}
+
+	TEST_F(TradeJournalTest, SmallBatchesAreBufferedUntilFlush)
+	{
+		trade_journal journal{ _path / "trades.csv", std::nullopt };
+
+		journal.append({ order_description{ 1, "1", order_type::MARKET, "BTC/GBP", trade_action::BUY, 20.0, 1.0 } });
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+
+		EXPECT_EQ(std::filesystem::file_size(_path / "trades.csv"), 0);
+
+		journal.flush();
+
+		EXPECT_GT(std::filesystem::file_size(_path / "trades.csv"), 0);
+	}
+
+	TEST_F(TradeJournalTest, ThrowsIfJournalCannotBeOpened)
+	{
+		EXPECT_THROW(trade_journal(_path / "missing" / "trades.csv", std::nullopt), mb_exception);
+	}
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <unordered_set>
+
+#include "trading/decimal.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace mb::test
+{
+	TEST(Decimal, ParsesToRequestedScale)
+	{
+		decimal value{ parse_decimal("30964.51", 4) };
+
+		ASSERT_EQ(309645100, value.mantissa());
+		ASSERT_EQ(4, value.scale());
+		ASSERT_DOUBLE_EQ(30964.51, value.to_double());
+	}
+
+	TEST(Decimal, ParseRoundsHalfAwayFromZero)
+	{
+		ASSERT_EQ(decimal(124, 2), parse_decimal("1.235", 2));
+		ASSERT_EQ(decimal(123, 2), parse_decimal("1.23499999", 2));
+		ASSERT_EQ(decimal(-124, 2), parse_decimal("-1.2351", 2));
+		ASSERT_EQ(decimal(5, 0), parse_decimal("4.5", 0));
+	}
+
+	TEST(Decimal, ParseRejectsInvalidText)
+	{
+		ASSERT_THROW(parse_decimal("", 2), mb_exception);
+		ASSERT_THROW(parse_decimal("-", 2), mb_exception);
+		ASSERT_THROW(parse_decimal("1.2.3", 2), mb_exception);
+		ASSERT_THROW(parse_decimal("1e5", 2), mb_exception);
+		ASSERT_THROW(parse_decimal("99999999999", 10), mb_exception);
+		ASSERT_THROW(parse_decimal("1.0", 19), mb_exception);
+	}
+
+	TEST(Decimal, FromDoubleRoundsToNearestTick)
+	{
+		ASSERT_EQ(decimal(30, 2), decimal::from_double(0.1 + 0.2, 2));
+		ASSERT_EQ(decimal(3094465, 2), decimal::from_double(30944.65, 2));
+		ASSERT_THROW(decimal::from_double(1e10, 10), mb_exception);
+	}
+
+	TEST(Decimal, RescaleRoundsWhenReducingScale)
+	{
+		decimal value{ 123456, 4 };
+
+		ASSERT_EQ(decimal(1234560, 5), value.rescale(5));
+		ASSERT_EQ(decimal(1235, 2), value.rescale(2));
+		ASSERT_EQ(decimal(12, 0), value.rescale(0));
+	}
+
+	TEST(Decimal, ArithmeticAndComparisonAlignScales)
+	{
+		decimal l{ parse_decimal("1.5", 1) };
+		decimal r{ parse_decimal("0.25", 2) };
+
+		ASSERT_EQ(decimal(175, 2), l + r);
+		ASSERT_EQ(decimal(125, 2), l - r);
+		ASSERT_TRUE(r < l);
+		ASSERT_TRUE(l >= r);
+		ASSERT_EQ(decimal(150, 2), l);
+		ASSERT_NE(decimal(151, 2), l);
+	}
+
+	TEST(Decimal, EqualValuesHashEqually)
+	{
+		std::unordered_set<decimal> values{ decimal{ 150, 2 } };
+
+		ASSERT_EQ(1, values.count(decimal{ 15, 1 }));
+		ASSERT_EQ(1, values.count(decimal{ 15000, 4 }));
+		ASSERT_EQ(0, values.count(decimal{ 151, 2 }));
+	}
+
+	TEST(Decimal, ToStringKeepsScale)
+	{
+		ASSERT_EQ("30964.5100", to_string(parse_decimal("30964.51", 4)));
+		ASSERT_EQ("0.0005", to_string(decimal{ 5, 4 }));
+		ASSERT_EQ("-0.05", to_string(decimal{ -5, 2 }));
+		ASSERT_EQ("42", to_string(decimal{ 42, 0 }));
+	}
+
+	TEST(Decimal, ScaleOfStepSize)
+	{
+		ASSERT_EQ(2, decimal_scale("0.01000000"));
+		ASSERT_EQ(8, decimal_scale("0.00000001"));
+		ASSERT_EQ(0, decimal_scale("1.00000000"));
+		ASSERT_EQ(0, decimal_scale("10"));
+		ASSERT_EQ(1, decimal_scale("0.5"));
+	}
+
+	TEST(Decimal, FittingScaleOfDouble)
+	{
+		ASSERT_EQ(10, fitting_scale(30964.51, 10));
+		ASSERT_EQ(9, fitting_scale(1234567890.12, 10));
+		ASSERT_EQ(7, fitting_scale(-98765432109.5, 10));
+		ASSERT_EQ(0, fitting_scale(1e19, 10));
+	}
+
+	TEST(Decimal, FittingScaleOfText)
+	{
+		ASSERT_EQ(10, fitting_scale("30964.51", 10));
+		ASSERT_EQ(8, fitting_scale("1234567890.12", 10));
+		ASSERT_EQ(10, fitting_scale("0.00000123", 10));
+		ASSERT_EQ(10, fitting_scale("-000123.4", 10));
+		ASSERT_EQ(0, fitting_scale("123456789012345678901", 10));
+	}
+
+	TEST(Decimal, LargeTextParsesAtFittingScale)
+	{
+		std::string_view text{ "1234567890.123456789" };
+		decimal value{ parse_decimal(text, fitting_scale(text, 10)) };
+
+		ASSERT_EQ(8, value.scale());
+		ASSERT_EQ("1234567890.12345679", to_string(value));
+	}
+}
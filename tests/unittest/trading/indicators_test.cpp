@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+#include "trading/indicators.h"
+#include "common/exceptions/mb_exception.h"
+
+namespace
+{
+	using namespace mb;
+
+	struct price_columns
+	{
+		std::vector<double> highs;
+		std::vector<double> lows;
+		std::vector<double> closes;
+		std::vector<ohlcv_data> candles;
+	};
+
+	price_columns create_random_walk(size_t count)
+	{
+		std::mt19937 generator{ 7 };
+		std::normal_distribution<double> step{ 0.0, 25.0 };
+		std::uniform_real_distribution<double> wick{ 0.0, 40.0 };
+
+		price_columns columns;
+		double close = 30000.0;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			double open = close;
+			close = std::max(1.0, close + step(generator));
+			double high = std::max(open, close) + wick(generator);
+			double low = std::min(open, close) - wick(generator);
+
+			columns.highs.push_back(high);
+			columns.lows.push_back(low);
+			columns.closes.push_back(close);
+			columns.candles.emplace_back(static_cast<std::time_t>(i * 60), open, high, low, close, 1.0);
+		}
+
+		return columns;
+	}
+
+	void assert_series_near(const std::vector<double>& expected, const std::vector<double>& actual)
+	{
+		ASSERT_EQ(expected.size(), actual.size());
+
+		for (size_t i = 0; i < expected.size(); ++i)
+		{
+			if (std::isnan(expected[i]))
+			{
+				EXPECT_TRUE(std::isnan(actual[i])) << "index " << i;
+			}
+			else
+			{
+				EXPECT_NEAR(expected[i], actual[i], 1e-9 * std::max(1.0, std::abs(expected[i]))) << "index " << i;
+			}
+		}
+	}
+
+	template<typename Indicator, typename Input, typename Select>
+	std::vector<double> run_incremental(Indicator indicator, const std::vector<Input>& inputs, Select select)
+	{
+		std::vector<double> values;
+		values.reserve(inputs.size());
+
+		for (auto& input : inputs)
+		{
+			double peeked = select(indicator.peek(input));
+			indicator.update(input);
+
+			double value = select(indicator.value());
+			EXPECT_TRUE(std::isnan(peeked) ? std::isnan(value) : peeked == value);
+
+			values.push_back(value);
+		}
+
+		return values;
+	}
+
+	double same(double value) { return value; }
+}
+
+namespace mb::test
+{
+	TEST(Indicators, SimpleMovingAverageMatchesKnownValues)
+	{
+		simple_moving_average sma{ 3 };
+
+		sma.update(1.0);
+		sma.update(2.0);
+		EXPECT_FALSE(sma.ready());
+		EXPECT_TRUE(std::isnan(sma.value()));
+
+		sma.update(3.0);
+		EXPECT_DOUBLE_EQ(2.0, sma.value());
+
+		sma.update(7.0);
+		EXPECT_DOUBLE_EQ(4.0, sma.value());
+
+		sma.reset();
+		EXPECT_FALSE(sma.ready());
+	}
+
+	TEST(Indicators, RelativeStrengthIndexIsBoundedByDirection)
+	{
+		relative_strength_index rising{ 3 };
+		relative_strength_index flat{ 3 };
+
+		for (double price : { 1.0, 2.0, 3.0, 4.0 })
+		{
+			rising.update(price);
+			flat.update(5.0);
+		}
+
+		EXPECT_DOUBLE_EQ(100.0, rising.value());
+		EXPECT_DOUBLE_EQ(50.0, flat.value());
+
+		rising.update(1.0);
+		EXPECT_NEAR(100.0 - 100.0 / (1.0 + (2.0 / 3.0) / 1.0), rising.value(), 1e-12);
+	}
+
+	TEST(Indicators, AverageTrueRangeUsesPreviousCloseGaps)
+	{
+		average_true_range atr{ 2 };
+
+		atr.update(ohlcv_data{ 0, 10, 11, 9, 10, 1 });
+		EXPECT_TRUE(std::isnan(atr.value()));
+
+		atr.update(ohlcv_data{ 60, 14, 15, 14, 15, 1 });
+		EXPECT_DOUBLE_EQ((2.0 + 5.0) / 2.0, atr.value());
+
+		atr.update(ohlcv_data{ 120, 15, 16, 15, 15, 1 });
+		EXPECT_DOUBLE_EQ((3.5 + 1.0) / 2.0, atr.value());
+	}
+
+	TEST(Indicators, ThrowsForNonPositivePeriod)
+	{
+		EXPECT_THROW(simple_moving_average{ 0 }, mb_exception);
+		EXPECT_THROW(calculate_ema({ 1.0 }, -1), mb_exception);
+	}
+
+	TEST(Indicators, IncrementalMatchesBatch)
+	{
+		price_columns columns{ create_random_walk(5000) };
+
+		for (int period : { 1, 2, 14, 50 })
+		{
+			assert_series_near(calculate_sma(columns.closes, period), run_incremental(simple_moving_average{ period }, columns.closes, same));
+			assert_series_near(calculate_ema(columns.closes, period), run_incremental(exponential_moving_average{ period }, columns.closes, same));
+			assert_series_near(calculate_rsi(columns.closes, period), run_incremental(relative_strength_index{ period }, columns.closes, same));
+			assert_series_near(
+				calculate_atr(columns.highs, columns.lows, columns.closes, period),
+				run_incremental(average_true_range{ period }, columns.candles, same));
+		}
+	}
+
+	TEST(Indicators, IncrementalBollingerBandsMatchBatch)
+	{
+		price_columns columns{ create_random_walk(5000) };
+
+		// Very short windows are dominated by the square root of near zero variances, so are only checked above
+		for (int period : { 1, 14, 50 })
+		{
+			bollinger_band_series bands{ calculate_bollinger_bands(columns.closes, period, 2.5) };
+
+			assert_series_near(bands.lower(), run_incremental(bollinger_bands{ period, 2.5 }, columns.closes, [](auto bands) { return bands.lower(); }));
+			assert_series_near(bands.middle(), run_incremental(bollinger_bands{ period, 2.5 }, columns.closes, [](auto bands) { return bands.middle(); }));
+			assert_series_near(bands.upper(), run_incremental(bollinger_bands{ period, 2.5 }, columns.closes, [](auto bands) { return bands.upper(); }));
+		}
+	}
+
+	TEST(Indicators, BatchReturnsNotReadyForShortSeries)
+	{
+		std::vector<double> prices{ 1.0, 2.0 };
+
+		for (double value : calculate_sma(prices, 3))
+		{
+			EXPECT_TRUE(std::isnan(value));
+		}
+
+		for (double value : calculate_rsi(prices, 2))
+		{
+			EXPECT_TRUE(std::isnan(value));
+		}
+	}
+
+	TEST(Indicators, OhlcvIndicatorCommitsCandleWhenIntervalCloses)
+	{
+		ohlcv_indicator<simple_moving_average> indicator{ 2 };
+
+		indicator.update(ohlcv_data{ 0, 1, 1, 1, 1, 1 });
+		indicator.update(ohlcv_data{ 0, 1, 3, 1, 3, 1 });
+		EXPECT_TRUE(std::isnan(indicator.value()));
+
+		indicator.update(ohlcv_data{ 60, 3, 5, 3, 5, 1 });
+		EXPECT_DOUBLE_EQ(4.0, indicator.value());
+
+		indicator.update(ohlcv_data{ 60, 3, 9, 3, 9, 1 });
+		EXPECT_DOUBLE_EQ(6.0, indicator.value());
+
+		indicator.update(ohlcv_data{ 0, 1, 1, 1, 100, 1 });
+		EXPECT_DOUBLE_EQ(6.0, indicator.value());
+		EXPECT_TRUE(std::isnan(indicator.indicator().value()));
+
+		indicator.update(ohlcv_data{ 120, 9, 9, 1, 1, 1 });
+		EXPECT_DOUBLE_EQ(5.0, indicator.value());
+		EXPECT_DOUBLE_EQ(6.0, indicator.indicator().value());
+	}
+}
\ No newline at end of file
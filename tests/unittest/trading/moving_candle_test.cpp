@@ -1,8 +1,137 @@
 #include <gtest/gtest.h>
+#include <random>
 
 #include "mbtest/assertion_helpers.h"
 #include "trading/moving_candle.h"
 
+namespace
+{
+	using namespace mb;
+
+	class rescanning_moving_candle
+	{
+	private:
+		int _interval;
+		int _offset;
+		std::deque<trade_update> _trades;
+		std::time_t _startTime;
+
+		void update_values(std::time_t currentTime)
+		{
+			if (currentTime - _offset >= _startTime + _interval)
+			{
+				_startTime = currentTime - _interval - _offset;
+			}
+
+			while (_trades.size() > 1 && _trades[1].time_stamp() <= _startTime)
+			{
+				_trades.pop_front();
+			}
+
+			if (_trades.front().time_stamp() < _startTime)
+			{
+				trade_update fillTrade{ _startTime, _trades.front().price(), 0.0 };
+				_trades.pop_front();
+				_trades.push_front(std::move(fillTrade));
+			}
+		}
+
+		std::vector<trade_update> get_offset_trades() const
+		{
+			std::vector<trade_update> trades;
+
+			for (auto& trade : _trades)
+			{
+				if (_offset != 0 && trade.time_stamp() > _startTime + _interval - _offset)
+				{
+					break;
+				}
+
+				trades.push_back(trade);
+			}
+
+			return trades;
+		}
+
+	public:
+		rescanning_moving_candle(int interval, int offset)
+			: _interval{ interval }, _offset{ offset }, _trades{}, _startTime{ 0 }
+		{}
+
+		void push_trade(trade_update trade)
+		{
+			if (_startTime == 0)
+			{
+				_startTime = trade.time_stamp();
+			}
+
+			_trades.push_back(std::move(trade));
+			update_values(_trades.back().time_stamp());
+		}
+
+		ohlcv_data get_ohlcv(std::time_t time)
+		{
+			update_values(time);
+			std::vector<trade_update> trades{ get_offset_trades() };
+
+			double high{ trades.front().price() };
+			double low{ trades.front().price() };
+			double volume = 0.0;
+
+			for (auto& trade : trades)
+			{
+				high = std::max(high, trade.price());
+				low = std::min(low, trade.price());
+				volume += trade.volume();
+			}
+
+			return ohlcv_data{ _startTime - _offset, trades.front().price(), high, low, trades.back().price(), volume };
+		}
+
+		double get_quote_volume(std::time_t time)
+		{
+			update_values(time);
+
+			double quoteVolume = 0.0;
+			for (auto& trade : get_offset_trades())
+			{
+				quoteVolume += trade.price() * trade.volume();
+			}
+
+			return quoteVolume;
+		}
+	};
+
+	void assert_matches_rescanning_candle(int interval, int offset)
+	{
+		std::mt19937 generator{ 42 };
+		std::uniform_int_distribution<int> timeStep{ 0, 7 };
+		std::uniform_real_distribution<double> price{ 90.0, 110.0 };
+		std::uniform_real_distribution<double> volume{ 0.1, 5.0 };
+
+		moving_candle movingCandle{ interval, offset };
+		rescanning_moving_candle expectedCandle{ interval, offset };
+		std::time_t time = 1000;
+
+		for (int i = 0; i < 2000; ++i)
+		{
+			time += timeStep(generator);
+			trade_update trade{ time, price(generator), volume(generator) };
+
+			movingCandle.push_trade(trade);
+			expectedCandle.push_trade(trade);
+
+			if (i % 3 == 0)
+			{
+				time += timeStep(generator);
+			}
+
+			test::assert_ohlcv_data_eq(expectedCandle.get_ohlcv(time), movingCandle.get_ohlcv(time));
+			ASSERT_NEAR(expectedCandle.get_quote_volume(time), movingCandle.get_quote_volume(time), 1e-6);
+		}
+	}
+}
+
 namespace mb::test
 {
 	TEST(MovingCandle, PushTradeAddsTradeToCandle)
@@ -49,4 +178,53 @@ namespace mb::test
 		ohlcv_data expectedOhlcv{ 15, 3.0, 7.0, 3.0, 7.0, 14.0 };
 		assert_ohlcv_data_eq(expectedOhlcv, movingCandle.get_ohlcv(75));
 	}
+
+	TEST(MovingCandle, OffsetCandleExcludesTradesAfterOffsetCloseTime)
+	{
+		moving_candle movingCandle{ 60, 10 };
+
+		movingCandle.push_trade(trade_update{ 10, 1.0, 2.0 });
+		movingCandle.push_trade(trade_update{ 40, 3.0, 4.0 });
+		movingCandle.push_trade(trade_update{ 65, 5.0, 6.0 });
+
+		ohlcv_data expectedOhlcv{ 0, 1.0, 3.0, 1.0, 3.0, 6.0 };
+		assert_ohlcv_data_eq(expectedOhlcv, movingCandle.get_ohlcv(65));
+	}
+
+	TEST(MovingCandle, QuoteVolumeTracksWindow)
+	{
+		moving_candle movingCandle{ 60 };
+
+		movingCandle.push_trade(trade_update{ 10, 1.0, 2.0 });
+		movingCandle.push_trade(trade_update{ 12, 3.0, 4.0 });
+		movingCandle.push_trade(trade_update{ 20, 5.0, 6.0 });
+
+		EXPECT_DOUBLE_EQ(movingCandle.get_quote_volume(20), 44.0);
+
+		movingCandle.push_trade(trade_update{ 75, 7.0, 8.0 });
+
+		EXPECT_DOUBLE_EQ(movingCandle.get_quote_volume(75), 86.0);
+	}
+
+	TEST(MovingCandle, ResetClearsCandle)
+	{
+		moving_candle movingCandle{ 60 };
+
+		movingCandle.push_trade(trade_update{ 10, 1.0, 2.0 });
+		movingCandle.reset();
+		movingCandle.push_trade(trade_update{ 100, 4.0, 1.0 });
+
+		ohlcv_data expectedOhlcv{ 100, 4.0, 4.0, 4.0, 4.0, 1.0 };
+		assert_ohlcv_data_eq(expectedOhlcv, movingCandle.get_ohlcv(100));
+	}
+
+	TEST(MovingCandle, MatchesRescanningCandle)
+	{
+		assert_matches_rescanning_candle(60, 0);
+	}
+
+	TEST(MovingCandle, MatchesRescanningCandleWithOffset)
+	{
+		assert_matches_rescanning_candle(60, 15);
+	}
 }
\ No newline at end of file
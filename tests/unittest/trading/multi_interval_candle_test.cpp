@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "trading/multi_interval_candle.h"
+#include "trading/ohlcv_from_trades.h"
+#include "mbtest/assertion_helpers.h"
+
+namespace mb::test
+{
+	static ohlcv_data MINUTE_OHLCV = ohlcv_data
+	{
+		120, 2, 4, 1, 3, 0.1
+	};
+
+	static ohlcv_data FIVE_MINUTE_OHLCV = ohlcv_data
+	{
+		0, 1, 5, 0.5, 3, 2.0
+	};
+
+	TEST(MultiIntervalCandle, GetOhlcvReturnsSeedValues)
+	{
+		multi_interval_candle candle;
+		candle.add_interval(60, MINUTE_OHLCV);
+		candle.add_interval(300, FIVE_MINUTE_OHLCV);
+
+		assert_ohlcv_data_eq(MINUTE_OHLCV, candle.get_ohlcv(60, 120));
+		assert_ohlcv_data_eq(FIVE_MINUTE_OHLCV, candle.get_ohlcv(300, 120));
+	}
+
+	TEST(MultiIntervalCandle, TradeUpdatesEveryInterval)
+	{
+		multi_interval_candle candle;
+		candle.add_interval(60, MINUTE_OHLCV);
+		candle.add_interval(300, FIVE_MINUTE_OHLCV);
+
+		candle.add_trade(150, 6, 1.0);
+
+		assert_ohlcv_data_eq(ohlcv_data{ 120, 2, 6, 1, 6, 1.1 }, candle.get_ohlcv(60, 150));
+		assert_ohlcv_data_eq(ohlcv_data{ 0, 1, 6, 0.5, 6, 3.0 }, candle.get_ohlcv(300, 150));
+	}
+
+	TEST(MultiIntervalCandle, ClosedBucketsRollIntoCoarserInterval)
+	{
+		multi_interval_candle candle;
+		candle.add_interval(60, MINUTE_OHLCV);
+		candle.add_interval(300, FIVE_MINUTE_OHLCV);
+
+		candle.add_trade(150, 6, 1.0);
+		candle.add_trade(190, 0.25, 2.0);
+		candle.add_trade(250, 4, 0.5);
+
+		assert_ohlcv_data_eq(ohlcv_data{ 240, 0.25, 4, 0.25, 4, 0.5 }, candle.get_ohlcv(60, 250));
+		assert_ohlcv_data_eq(ohlcv_data{ 0, 1, 6, 0.25, 4, 5.5 }, candle.get_ohlcv(300, 250));
+
+		candle.add_trade(300, 7, 1.0);
+
+		assert_ohlcv_data_eq(ohlcv_data{ 300, 7, 7, 4, 7, 1.0 }, candle.get_ohlcv(300, 300));
+	}
+
+	TEST(MultiIntervalCandle, VisitReportsIntervalsFromFinest)
+	{
+		multi_interval_candle candle;
+		candle.add_interval(300, FIVE_MINUTE_OHLCV);
+		candle.add_interval(60, MINUTE_OHLCV);
+
+		std::vector<int> intervals;
+		candle.visit(120, [&intervals](int interval, const ohlcv_data&) { intervals.push_back(interval); });
+
+		EXPECT_EQ(intervals, (std::vector<int>{ 60, 300 }));
+	}
+
+	TEST(MultiIntervalCandle, RemovedIntervalKeepsCoarserState)
+	{
+		multi_interval_candle candle;
+		candle.add_interval(60, MINUTE_OHLCV);
+		candle.add_interval(300, FIVE_MINUTE_OHLCV);
+
+		candle.add_trade(150, 6, 1.0);
+		candle.remove_interval(60);
+		candle.add_trade(160, 0.25, 1.0);
+
+		EXPECT_FALSE(candle.has_interval(60));
+		EXPECT_THROW(candle.get_ohlcv(60, 160), mb_exception);
+		assert_ohlcv_data_eq(ohlcv_data{ 0, 1, 6, 0.25, 0.25, 4.0 }, candle.get_ohlcv(300, 160));
+	}
+
+	static void assert_matches_independent_builders(int maxLateness)
+	{
+		std::vector<int> intervals{ 60, 300, 3600 };
+		std::vector<ohlcv_data> seeds
+		{
+			ohlcv_data{ 3600 + 1800 + 240, 100, 101, 99, 100.5, 3.0 },
+			ohlcv_data{ 3600 + 1800, 99, 102, 98, 100.5, 12.0 },
+			ohlcv_data{ 3600, 97, 103, 96, 100.5, 40.0 }
+		};
+
+		multi_interval_candle candle;
+		std::vector<ohlcv_from_trades> expectedCandles;
+
+		for (size_t i = 0; i < intervals.size(); ++i)
+		{
+			candle.add_interval(intervals[i], seeds[i]);
+			expectedCandles.emplace_back(seeds[i], intervals[i]);
+		}
+
+		std::mt19937 generator{ 11 };
+		std::uniform_int_distribution<int> timeStep{ 0, 40 };
+		std::uniform_int_distribution<int> lateness{ 0, maxLateness };
+		std::uniform_real_distribution<double> price{ 95.0, 105.0 };
+		std::uniform_real_distribution<double> volume{ 0.01, 2.0 };
+
+		std::time_t time = 3600 + 1800 + 240;
+
+		for (int i = 0; i < 5000; ++i)
+		{
+			time += timeStep(generator);
+			std::time_t tradeTime = time - lateness(generator);
+			double tradePrice = price(generator);
+			double tradeVolume = volume(generator);
+
+			candle.add_trade(tradeTime, tradePrice, tradeVolume);
+
+			for (size_t j = 0; j < intervals.size(); ++j)
+			{
+				expectedCandles[j].add_trade(tradeTime, tradePrice, tradeVolume);
+
+				ohlcv_data expected{ expectedCandles[j].get_ohlcv(time) };
+				ohlcv_data actual{ candle.get_ohlcv(intervals[j], time) };
+
+				ASSERT_EQ(expected.time_stamp(), actual.time_stamp());
+				ASSERT_DOUBLE_EQ(expected.open(), actual.open());
+				ASSERT_DOUBLE_EQ(expected.high(), actual.high());
+				ASSERT_DOUBLE_EQ(expected.low(), actual.low());
+				ASSERT_DOUBLE_EQ(expected.close(), actual.close());
+				ASSERT_NEAR(expected.volume(), actual.volume(), 1e-9);
+			}
+		}
+	}
+
+	TEST(MultiIntervalCandle, LateTradeUpdatesIntervalsStillContainingIt)
+	{
+		multi_interval_candle candle;
+		candle.add_interval(60, MINUTE_OHLCV);
+		candle.add_interval(300, FIVE_MINUTE_OHLCV);
+
+		candle.add_trade(150, 6, 1.0);
+		candle.add_trade(250, 4, 0.5);
+		candle.add_trade(200, 8, 2.0);
+
+		assert_ohlcv_data_eq(ohlcv_data{ 240, 6, 6, 4, 4, 0.5 }, candle.get_ohlcv(60, 250));
+		assert_ohlcv_data_eq(ohlcv_data{ 0, 1, 8, 0.5, 4, 5.5 }, candle.get_ohlcv(300, 250));
+	}
+
+	TEST(MultiIntervalCandle, LateTradeRollsCoarserInterval)
+	{
+		multi_interval_candle candle;
+		candle.add_interval(60, MINUTE_OHLCV);
+		candle.add_interval(300, FIVE_MINUTE_OHLCV);
+
+		candle.add_trade(150, 6, 1.0);
+		candle.add_trade(370, 4, 0.5);
+		candle.add_trade(310, 8, 2.0);
+		candle.add_trade(290, 9, 1.0);
+
+		assert_ohlcv_data_eq(ohlcv_data{ 360, 6, 6, 4, 4, 0.5 }, candle.get_ohlcv(60, 370));
+		assert_ohlcv_data_eq(ohlcv_data{ 300, 6, 8, 4, 4, 2.5 }, candle.get_ohlcv(300, 370));
+	}
+
+	TEST(MultiIntervalCandle, MatchesIndependentBuilders)
+	{
+		assert_matches_independent_builders(0);
+	}
+
+	TEST(MultiIntervalCandle, MatchesIndependentBuildersWithLateTrades)
+	{
+		assert_matches_independent_builders(90);
+	}
+}
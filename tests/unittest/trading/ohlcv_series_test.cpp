@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "trading/ohlcv_series.h"
+#include "common/exceptions/mb_exception.h"
+#include "mbtest/assertion_helpers.h"
+
+namespace
+{
+	using namespace mb;
+
+	std::vector<ohlcv_data> create_candles(size_t count)
+	{
+		std::mt19937 generator{ 11 };
+		std::uniform_real_distribution<double> price{ 100.0, 200.0 };
+		std::uniform_real_distribution<double> volume{ 0.0, 5.0 };
+
+		std::vector<ohlcv_data> candles;
+		for (size_t i = 0; i < count; ++i)
+		{
+			double open = price(generator);
+			double close = price(generator);
+			double high = std::max(open, close) + 1.0;
+			double low = std::min(open, close) - 1.0;
+
+			candles.emplace_back(static_cast<std::time_t>(i * 60), open, high, low, close, volume(generator));
+		}
+
+		return candles;
+	}
+
+	ohlcv_data merge_scalar(const std::vector<ohlcv_data>& candles, size_t first, size_t last, std::time_t timeStamp)
+	{
+		double high = candles[first].high();
+		double low = candles[first].low();
+		double volume = 0.0;
+
+		for (size_t i = first; i < last; ++i)
+		{
+			high = std::max(high, candles[i].high());
+			low = std::min(low, candles[i].low());
+			volume += candles[i].volume();
+		}
+
+		return ohlcv_data{ timeStamp, candles[first].open(), high, low, candles[last - 1].close(), volume };
+	}
+}
+
+namespace mb::test
+{
+	TEST(OhlcvSeries, ConvertsToAndFromVector)
+	{
+		std::vector<ohlcv_data> candles{ create_candles(7) };
+		ohlcv_series series{ candles };
+
+		ASSERT_EQ(candles.size(), series.size());
+		EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(series.closes().data()) % 64);
+
+		std::vector<ohlcv_data> converted{ series.to_vector() };
+		for (size_t i = 0; i < candles.size(); ++i)
+		{
+			assert_ohlcv_data_eq(candles[i], converted[i]);
+		}
+
+		assert_ohlcv_data_eq(candles.front(), series.front());
+		assert_ohlcv_data_eq(candles.back(), series.back());
+	}
+
+	TEST(OhlcvSeries, RangeKernelsMatchScalarMerge)
+	{
+		std::vector<ohlcv_data> candles{ create_candles(103) };
+		ohlcv_series series{ candles };
+
+		for (size_t first : { 0, 1, 3, 50 })
+		{
+			for (size_t last : { first + 1, first + 2, first + 5, first + 8, size_t{ 103 } })
+			{
+				assert_ohlcv_data_eq(merge_scalar(candles, first, last, 42), series.merge(first, last, 42));
+			}
+		}
+	}
+
+	TEST(OhlcvSeries, VwapWeightsTypicalPriceByVolume)
+	{
+		ohlcv_series series{ std::vector<ohlcv_data>
+		{
+			ohlcv_data{ 0, 2, 4, 1, 4, 1 },
+			ohlcv_data{ 60, 4, 7, 4, 7, 3 },
+			ohlcv_data{ 120, 7, 8, 5, 5, 0 }
+		} };
+
+		EXPECT_DOUBLE_EQ((3.0 * 1 + 6.0 * 3) / 4.0, series.vwap(0, 3));
+		EXPECT_DOUBLE_EQ(5.0, series.vwap(2, 3));
+	}
+
+	TEST(OhlcvSeries, ResampleMergesCandlesByInterval)
+	{
+		std::vector<ohlcv_data> candles{ create_candles(20) };
+		ohlcv_series resampled{ ohlcv_series{ candles }.resample(300) };
+
+		ASSERT_EQ(4, resampled.size());
+		for (size_t i = 0; i < resampled.size(); ++i)
+		{
+			assert_ohlcv_data_eq(merge_scalar(candles, i * 5, i * 5 + 5, static_cast<std::time_t>(i * 300)), resampled[i]);
+		}
+	}
+
+	TEST(OhlcvSeries, ResampleStartsBucketsOnIntervalBoundaries)
+	{
+		ohlcv_series series{ std::vector<ohlcv_data>
+		{
+			ohlcv_data{ 240, 1, 2, 1, 2, 1 },
+			ohlcv_data{ 300, 2, 3, 2, 3, 1 },
+			ohlcv_data{ 900, 3, 4, 3, 4, 1 }
+		} };
+
+		ohlcv_series resampled{ series.resample(300) };
+
+		ASSERT_EQ(3, resampled.size());
+		assert_ohlcv_data_eq(ohlcv_data{ 0, 1, 2, 1, 2, 1 }, resampled[0]);
+		assert_ohlcv_data_eq(ohlcv_data{ 300, 2, 3, 2, 3, 1 }, resampled[1]);
+		assert_ohlcv_data_eq(ohlcv_data{ 900, 3, 4, 3, 4, 1 }, resampled[2]);
+		EXPECT_THROW(series.resample(0), mb_exception);
+	}
+}
\ No newline at end of file